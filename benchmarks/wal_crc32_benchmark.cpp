@@ -0,0 +1,108 @@
+// SPDX-FileCopyrightText: 2026 AlayaDB.AI
+//
+// SPDX-License-Identifier: AGPL-3.0-only
+
+// WAL frame CRC-32 microbenchmark: bitwise oracle versus slice-by-8,
+// slice-by-16, PCLMULQDQ folding, and the runtime-dispatched kernel that
+// wal::crc32() uses. Sizes span one bare frame header up to a large payload.
+//
+// Usage: wal_crc32_benchmark [bytes...]
+
+#include <algorithm>
+#include <chrono>
+#include <cstddef>
+#include <cstdint>
+#include <iomanip>
+#include <iostream>
+#include <random>
+#include <string>
+#include <utility>
+#include <vector>
+
+#include "simd/cpu_features.hpp"
+#include "wal/crc32.hpp"
+
+namespace {
+
+constexpr std::size_t kTargetBytes = std::size_t{256} << 20U;
+constexpr std::size_t kWarmupIterations = 16;
+
+struct Kernel {
+  const char *name_;
+  alaya::wal::Crc32UpdateFn update_;
+};
+
+// Returns throughput in MB/s over about kTargetBytes of hashing.
+auto run_benchmark(alaya::wal::Crc32UpdateFn update, const std::vector<std::byte> &buffer)
+    -> double {
+  const auto size = buffer.size();
+  const auto iterations = std::max<std::size_t>(kTargetBytes / std::max<std::size_t>(size, 1), 1);
+  volatile std::uint32_t sink = 0;
+  for (std::size_t i = 0; i < kWarmupIterations; ++i) {
+    sink = update(0xffffffffU, buffer.data(), size);
+  }
+  const auto start = std::chrono::steady_clock::now();
+  for (std::size_t i = 0; i < iterations; ++i) {
+    sink = update(0xffffffffU, buffer.data(), size);
+  }
+  const auto end = std::chrono::steady_clock::now();
+  (void)sink;
+  const auto seconds = std::chrono::duration<double>(end - start).count();
+  return static_cast<double>(size * iterations) / seconds / 1.0e6;
+}
+
+}  // namespace
+
+auto main(int argc, char *argv[]) -> int {
+  // A bare 36+4 byte frame, a small mutation, a 4 KiB page, and large payloads.
+  std::vector<std::size_t> sizes = {40, 256, 4096, 65536, 1U << 20U};
+  if (argc > 1) {
+    sizes.clear();
+    for (int i = 1; i < argc; ++i) {
+      sizes.push_back(std::stoull(argv[i]));
+    }
+  }
+
+  std::vector<Kernel> kernels = {
+      {"bitwise", alaya::wal::crc32_update_bitwise},
+      {"slice8", alaya::wal::crc32_update_slice8},
+      {"slice16", alaya::wal::crc32_update_slice16},
+  };
+#ifdef ALAYA_ARCH_X86
+  const auto &features = alaya::simd::get_cpu_features();
+  if (features.pclmul_ && features.sse4_1_) {
+    kernels.push_back({"pclmul", alaya::wal::crc32_update_pclmul});
+  }
+#endif
+  kernels.push_back({"AUTO", alaya::wal::get_crc32_update_func()});
+
+  std::cout << "# WAL CRC-32 Benchmark (MB/s)\n\n| Bytes |";
+  for (const auto &kernel : kernels) {
+    std::cout << ' ' << kernel.name_ << " |";
+  }
+  std::cout << "\n|-------|";
+  for (std::size_t i = 0; i < kernels.size(); ++i) {
+    std::cout << "------|";
+  }
+  std::cout << '\n';
+
+  std::mt19937 rng(42);
+  for (const auto size : sizes) {
+    std::vector<std::byte> buffer(size);
+    for (auto &byte : buffer) {
+      byte = static_cast<std::byte>(rng());
+    }
+    const auto expected = alaya::wal::crc32_update_bitwise(0xffffffffU, buffer.data(), size);
+    std::cout << "| " << size << " |";
+    for (const auto &kernel : kernels) {
+      if (kernel.update_(0xffffffffU, buffer.data(), size) != expected) {
+        std::cerr << kernel.name_ << " disagrees with bitwise at " << size << " bytes\n";
+        return 1;
+      }
+      std::cout << ' ' << std::fixed << std::setprecision(0)
+                << run_benchmark(kernel.update_, buffer) << " |";
+    }
+    std::cout << '\n';
+  }
+  return 0;
+}
@@ -4,7 +4,7 @@
 
 # AlayaLaser.cmake - the LASER disk-index module: backend wiring and the alaya_laser INTERFACE target.
 #
-# Backend selection (libaio / thread pool; the Windows IOCP backend was removed) is validated and pinned in
+# Backend selection (libaio / io_uring / thread pool; the Windows IOCP backend was removed) is validated and pinned in
 # AlayaOptions.cmake; this module resolves the backend's system dependencies and defines the consumer surface.
 
 include_guard(GLOBAL)
@@ -35,6 +35,11 @@ elseif(ALAYA_LASER_USE_THREADPOOL)
   else()
     set(_alaya_laser_backend_message "thread pool (portable fallback)")
   endif()
+elseif(ALAYA_LASER_USE_IO_URING)
+  # liburing is already a required Linux dependency (AlayaDependencies.cmake).
+  set(_alaya_laser_backend_libs liburing::liburing)
+  set(_alaya_laser_backend_definition ALAYA_LASER_USE_IO_URING=1)
+  set(_alaya_laser_backend_message "io_uring (Linux x86_64)")
 else()
   find_library(AIO_LIBRARY aio)
   find_path(AIO_INCLUDE_DIR libaio.h)
@@ -64,6 +64,8 @@ option(ALAYA_LASER_USE_THREADPOOL "Use the portable thread-pool LASER I/O backen
        ${ALAYA_LASER_USE_THREADPOOL_DEFAULT}
 )
 
+option(ALAYA_LASER_USE_IO_URING "Use the io_uring LASER I/O backend (Linux 5.11+) instead of libaio" OFF)
+
 # The Windows IOCP LASER backend was removed; the option is kept only so an explicit -DALAYA_LASER_USE_IOCP=ON fails
 # loudly in AlayaLaser.cmake instead of silently selecting a backend that no longer exists.
 option(ALAYA_LASER_USE_IOCP "Removed Windows IOCP LASER I/O backend (unsupported)" OFF)
@@ -166,7 +166,11 @@ struct SearchStats {
   std::uint64_t filter_candidates{};
   std::uint64_t rerank_count{};
   std::uint64_t budget_wait_nanoseconds{};
-  std::uint64_t reserved[4]{};
+  // Page reads a paged search sent to the device, and the reads it saved by
+  // joining another search's in-flight read of the same page.
+  std::uint64_t device_reads{};
+  std::uint64_t coalesced_reads{};
+  std::uint64_t reserved[2]{};
 
   SearchStats() : header(current_struct_header<SearchStats>()) {}
 };
@@ -22,6 +22,7 @@
 #include "core/resource_contexts.hpp"
 #include "core/value_types.hpp"
 #include "index/collection/artifact_manifest_v2.hpp"
+#include "index/collection/verified_digest_cache.hpp"
 #include "platform/detect.hpp"
 #include "platform/fs.hpp"
 
@@ -258,7 +259,10 @@ class ArtifactControlPlaneTransaction {
         artifact.required = binding.spec.required;
         artifact.size_bytes = static_cast<std::uint64_t>(bytes);
         artifact.checksum_algorithm = ChecksumAlgorithmV2::sha256;
-        artifact.digest = sha256_file(binding.absolute_path);
+        // Seeds the cache for payloads that were already on disk; freshly
+        // written ones are too new to be remembered.
+        artifact.digest = sha256_file_cached(binding.absolute_path,
+                                             std::addressof(VerifiedDigestCache::instance()));
         artifact.ready = true;
         artifact.reader_compatibility = binding.spec.reader_compatibility;
         segment.artifacts.push_back(std::move(artifact));
@@ -477,6 +481,11 @@ class ArtifactControlPlaneTransaction {
           if (!entry.is_directory()) {
             continue;
           }
+          // Native LASER build staging left by an interrupted seal.
+          if (entry.path().filename().string().starts_with(".build_")) {
+            std::filesystem::remove_all(entry.path());
+            continue;
+          }
           const auto relative =
               std::filesystem::relative(entry.path(), collection_root).lexically_normal();
           if (live_directories.contains(relative)) {
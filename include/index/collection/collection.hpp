@@ -29,6 +29,7 @@
 #include "index/collection/detail/canonical_flat_segment.hpp"
 #include "index/collection/detail/collection_segment_factory.hpp"
 #include "index/collection/detail/collection_target_builder.hpp"
+#include "index/collection/maintenance_scheduler.hpp"
 #include "index/collection/process_lock.hpp"
 // The active (writable) LASER stack -- MutableLaserSegment/QGUpdater -- is
 // Linux-only: it needs flock, O_DIRECT, libaio and sync_file_range. Sealed
@@ -74,6 +75,29 @@ using CollectionProjection = internal::collection::Projection;
 using CollectionRecord = internal::collection::CollectionRecord;
 using CollectionFilter = internal::collection::LogicalFilter;
 using CollectionSearchStatistics = internal::collection::CollectionSearchStats;
+using CollectionManifestReaderOptions = internal::collection::ManifestReaderOptions;
+
+// Background maintenance policy. Runtime only: not persisted in the facade
+// schema, so open() takes it from CollectionOpenOptions.
+struct CollectionMaintenanceOptions {
+  // Workers that run auto-seal, compaction and GC. The default, zero, seals
+  // inline on the writing thread once auto_seal_rows is reached. With
+  // workers, a write returns before its seal; wait_for_maintenance() waits
+  // for that work and reports its first failure.
+  std::uint32_t worker_threads{};
+  // Caps build_threads for background builds; zero keeps build_threads.
+  std::uint32_t build_threads{};
+  // Raises the workers' nice value (Linux only).
+  int nice{10};
+  // Writes wait for the background seal while the active generation holds
+  // at least this many rows. Zero picks 4 * auto_seal_rows.
+  std::uint64_t hard_cap_rows{};
+  // Compacts in the background once this many sealed segments are routed;
+  // zero never does.
+  std::uint32_t compact_min_segments{};
+  // Runs gc() after each background seal or compaction.
+  bool gc_after_rotation{true};
+};
 
 struct CollectionOptions {
   std::filesystem::path root{};
@@ -93,10 +117,16 @@ struct CollectionOptions {
   // Zero disables automatic rotation. A positive value rotates after the
   // active generation reaches this many physical rows.
   std::uint64_t auto_seal_rows{};
+  CollectionMaintenanceOptions maintenance{};
+  // How sealed segments verify their artifacts when the Collection opens
+  // them. Runtime only, like maintenance.
+  CollectionManifestReaderOptions manifest_reader{};
 };
 
 struct CollectionOpenOptions {
   bool read_only{};
+  CollectionMaintenanceOptions maintenance{};
+  CollectionManifestReaderOptions manifest_reader{};
 };
 
 enum class CollectionSealFailPoint : std::uint8_t {
@@ -135,6 +165,8 @@ struct CollectionSealReceipt {
   std::uint64_t manifest_generation{};
   core::AlgorithmId built_algorithm{core::algorithm::flat};
   std::uint32_t effective_ef_construction{};
+  // Rows whose graph edges were carried over from a predecessor segment.
+  core::RowCount reused_topology_rows{};
   bool flat_fallback{};
   std::string fallback_reason{};
 };
@@ -171,6 +203,52 @@ struct CollectionCompactReceipt {
   std::string fallback_reason{};
 };
 
+// Collection::relayout() rewrites one sealed LASER segment in the page order
+// its sampled queries suggest (see alaya::laser::VisitSketch); segments
+// sample only when x_laser_visit_sample_every or ALAYA_LASER_VISIT_SAMPLE is
+// set.
+struct CollectionRelayoutOptions {
+  // Segments with fewer sampled queries are left alone.
+  std::uint64_t min_sampled_queries{256};
+};
+
+struct CollectionRelayoutReceipt {
+  std::uint64_t source_segment_id{};
+  std::uint64_t relayout_segment_id{};
+  core::RowCount rows{};
+  std::uint64_t sampled_queries{};
+  std::uint64_t output_bytes{};
+  std::uint64_t manifest_generation{};
+};
+
+// Collection::rebuild() rebuilds every row into one sealed segment. Unset
+// fields keep the Collection's current build options; set ones become its
+// options once the rebuilt segment is routed.
+struct CollectionRebuildOptions {
+  std::optional<core::AlgorithmId> target_algorithm{};
+  std::optional<CollectionQuantization> quantization{};
+  std::optional<std::uint32_t> max_neighbors{};
+  std::optional<std::uint32_t> ef_construction{};
+  std::optional<std::uint32_t> build_threads{};
+};
+
+struct CollectionRebuildReceipt {
+  std::vector<std::uint64_t> source_segment_ids{};
+  std::uint64_t rebuilt_segment_id{};
+  std::uint64_t successor_segment_id{};
+  std::uint64_t wal_cut{};
+  core::RowCount rebuilt_rows{};
+  std::uint64_t rebuilt_bytes{};
+  std::uint64_t manifest_generation{};
+  core::AlgorithmId built_algorithm{core::algorithm::flat};
+  std::uint32_t effective_ef_construction{};
+  // Rows whose edges came from the largest sealed source's graph (L2 LASER
+  // targets only) instead of being linked again.
+  core::RowCount reused_topology_rows{};
+  bool flat_fallback{};
+  std::string fallback_reason{};
+};
+
 struct CollectionGcReceipt {
   core::RowCount pending{};
   core::RowCount reclaimed{};
@@ -235,6 +313,14 @@ struct CollectionStatistics {
   core::RowCount gc_pending_count{};
   core::AlgorithmId active_segment_algorithm{core::algorithm::flat};
   std::uint64_t compacted_bytes{};
+  std::uint64_t background_seals{};
+  std::uint64_t background_failures{};
+  // Writes that waited for a background seal at the hard cap.
+  std::uint64_t admission_waits{};
+  // Committed logical-WAL transactions replayed when this handle was opened.
+  std::uint64_t recovery_replayed_transactions{};
+  std::uint64_t recovery_replayed_rows{};
+  std::uint64_t recovery_replay_nanoseconds{};
   internal::collection::LifecycleState lifecycle{internal::collection::LifecycleState::open};
 
   CollectionStatistics() : header(core::current_struct_header<CollectionStatistics>()) {}
@@ -383,8 +469,35 @@ class Collection {
 
   [[nodiscard]] auto compact(core::SealContext &context) -> core::Result<CollectionCompactReceipt>;
 
+  // Rewrites the sealed LASER segment with the most sampled queries so rows
+  // its queries expand together share pages, and regenerates its static
+  // cache from the same counts. The copy replaces the source through the
+  // manifest like compact(); row ids are unchanged.
+  [[nodiscard]] auto relayout(CollectionRelayoutOptions options = {})
+      -> core::Result<CollectionRelayoutReceipt>;
+
+  [[nodiscard]] auto relayout(core::SealContext &context, CollectionRelayoutOptions options = {})
+      -> core::Result<CollectionRelayoutReceipt>;
+
+  // Online rebuild: seals the active segment like seal(), but the successor
+  // is built from the rows of every sealed segment as well, so the
+  // Collection ends up with one sealed segment built with `options`. Rows
+  // come from a pinned routing snapshot; reads keep using the old segments
+  // and writes land in the new active segment until the rebuilt segment is
+  // routed, and rows overwritten meanwhile keep their newer version. The
+  // replaced segments are reclaimed by gc().
+  [[nodiscard]] auto rebuild(CollectionRebuildOptions options = {})
+      -> core::Result<CollectionRebuildReceipt>;
+
+  [[nodiscard]] auto rebuild(core::SealContext &context, CollectionRebuildOptions options = {})
+      -> core::Result<CollectionRebuildReceipt>;
+
   [[nodiscard]] auto gc() -> core::Result<CollectionGcReceipt>;
 
+  // Waits until no background seal, compaction or GC is queued or running
+  // and returns the first background failure since the previous call.
+  [[nodiscard]] auto wait_for_maintenance() -> core::Status;
+
   [[nodiscard]] auto stats() const -> CollectionStatistics;
 
   [[nodiscard]] auto size() const -> core::RowCount { return stats().size; }
@@ -419,7 +532,15 @@ class Collection {
         process_lock_(std::move(process_lock)),
         implementation_(std::move(implementation)),
         control_state_(std::move(control_state)),
-        read_only_(read_only) {}
+        read_only_(read_only) {
+    const auto &maintenance = options_.maintenance;
+    if (!read_only_ && maintenance.worker_threads != 0 &&
+        (options_.auto_seal_rows != 0 || maintenance.compact_min_segments != 0)) {
+      maintenance_ = std::make_unique<internal::collection::MaintenanceScheduler>(
+          internal::collection::MaintenanceBudget{maintenance.worker_threads, maintenance.nice},
+          [this](internal::collection::MaintenanceTask task) { return run_maintenance(task); });
+    }
+  }
 
   [[nodiscard]] static auto error(core::StatusCode code,
                                   core::OperationStage stage,
@@ -516,6 +637,13 @@ class Collection {
     internal::collection::detail::CollectionTargetBuildResult built_target{};
   };
 
+  // What prepare_successor_locked() folds into the successor beyond the
+  // active segment, and which options it builds with. SuccessorPlan{} is seal().
+  struct SuccessorPlan {
+    bool include_sealed{};
+    const CollectionOptions *build_options{};
+  };
+
   static void fire_seal_failpoint(const CollectionSealOptions &options,
                                   CollectionSealFailPoint point);
 
@@ -527,7 +655,8 @@ class Collection {
       const internal::collection::RoutingSnapshot &snapshot,
       std::span<const internal::collection::RowAddress> sources,
       std::uint64_t target_segment_id,
-      std::uint64_t target_generation) -> core::Result<ReplacementBuildData>;
+      std::uint64_t target_generation,
+      bool keep_row_ids = false) -> core::Result<ReplacementBuildData>;
 
   [[nodiscard]] auto checkpoint_locked(core::CheckpointContext &context)
       -> core::Result<CollectionCheckpointReceipt>;
@@ -556,7 +685,8 @@ class Collection {
   // equivalent handle; that scheduling policy is intentionally out of
   // scope for this change.
   [[nodiscard]] auto prepare_successor_locked(core::SealContext &context,
-                                              const CollectionSealOptions &options)
+                                              const CollectionSealOptions &options,
+                                              const SuccessorPlan &plan)
       -> core::Result<CollectionRotationHandle>;
 
   // Atomically switches query routing from the predecessor segment(s) to
@@ -577,9 +707,49 @@ class Collection {
       const internal::collection::RoutingSnapshot &snapshot,
       std::span<const internal::collection::RowAddress> sources) const -> core::Status;
 
+  // The control-plane steps compact and relayout share around building their
+  // replacement segment: claim an idle control state, record the mapping,
+  // publish the built target in place of `sources`, then return to idle.
+  [[nodiscard]] auto begin_replacement_locked(const core::SealContext &context) -> core::Status;
+
+  [[nodiscard]] auto stage_replacement_locked(
+      internal::collection::CollectionControlOperation operation,
+      std::string_view mapping_prefix,
+      std::span<const internal::collection::RowAddress> sources,
+      std::uint64_t target_segment_id,
+      std::uint64_t target_generation,
+      std::uint64_t wal_cut,
+      const std::vector<internal::collection::SegmentReplacement> &replacements) -> core::Status;
+
+  [[nodiscard]] auto replacement_publication(internal::collection::ArtifactManifestV2 base_manifest,
+                                             std::uint64_t target_segment_id,
+                                             std::uint64_t target_generation,
+                                             std::uint64_t metadata_epoch) const
+      -> internal::collection::detail::CollectionTargetPublication;
+
+  [[nodiscard]] auto publish_replacement_segment_locked(
+      core::SealContext &context,
+      internal::collection::RoutingSnapshotPtr pinned,
+      std::span<const internal::collection::RowAddress> sources,
+      std::uint64_t target_segment_id,
+      std::uint64_t target_generation,
+      core::AnySegment segment,
+      const ReplacementBuildData &build_data) -> core::Status;
+
+  [[nodiscard]] auto finish_replacement_locked(std::uint64_t target_segment_id,
+                                               std::uint64_t target_generation) -> core::Status;
+
   [[nodiscard]] auto compact_locked(core::SealContext &context)
       -> core::Result<CollectionCompactReceipt>;
 
+  [[nodiscard]] auto relayout_locked(core::SealContext &context,
+                                     const CollectionRelayoutOptions &options)
+      -> core::Result<CollectionRelayoutReceipt>;
+
+  [[nodiscard]] auto rebuild_locked(core::SealContext &context,
+                                    const CollectionRebuildOptions &options)
+      -> core::Result<CollectionRebuildReceipt>;
+
   [[nodiscard]] auto gc_locked() -> core::Result<CollectionGcReceipt>;
 
   [[nodiscard]] auto write(const CollectionItem &item,
@@ -589,6 +759,12 @@ class Collection {
 
   void maybe_auto_seal() noexcept;
 
+  // Holds a write while the active generation is at the hard cap until the
+  // background seal that the cap triggers has run.
+  void await_admission() noexcept;
+
+  [[nodiscard]] auto run_maintenance(internal::collection::MaintenanceTask task) -> core::Status;
+
   [[nodiscard]] auto execute_search(const core::TypedTensorView &queries,
                                     const core::SearchOptions &options,
                                     core::SearchContext &context,
@@ -616,6 +792,11 @@ class Collection {
   std::optional<PendingRotation> pending_rotation_{};
   bool read_only_{};
   std::atomic<bool> closed_{false};
+  std::atomic<std::uint64_t> background_seals_{};
+  std::atomic<std::uint64_t> admission_waits_{};
+  // Last member: destroyed first, so workers are joined while everything
+  // they touch is still alive.
+  std::unique_ptr<internal::collection::MaintenanceScheduler> maintenance_{};
 };
 
 }  // namespace alaya
@@ -4,17 +4,25 @@
 
 #pragma once
 
+#include <algorithm>
 #include <cstddef>
 #include <cstdint>
+#include <exception>
 #include <filesystem>
 #include <fstream>
+#include <limits>
 #include <map>
+#include <memory>
+#include <mutex>
 #include <optional>
+#include <ranges>
 #include <span>
 #include <sstream>
 #include <stdexcept>
 #include <string>
 #include <string_view>
+#include <system_error>
+#include <thread>
 #include <utility>
 #include <vector>
 
@@ -37,63 +45,126 @@ struct CollectionCheckpointImage {
   std::string checkpoint_name{};
 };
 
+// What changed between two checkpoint cuts. `state.rows` and `removed` are
+// in LogicalIdLess order; the retry ledgers hold only new or replaced
+// receipts.
+struct CollectionCheckpointDelta {
+  std::uint64_t generation{};
+  std::uint64_t visibility_watermark{};
+  std::uint64_t durable_watermark{};
+  std::uint64_t metadata_epoch{};
+  std::uint64_t wal_cut{};
+  std::uint64_t previous_cut{};
+  WalMutationTransaction state{};
+  std::vector<core::LogicalId> removed{};
+  std::map<std::string, MutationReceipt, std::less<>> retry_receipts{};
+  std::map<std::string, BatchMutationReceipt, std::less<>> batch_retry_receipts{};
+  std::vector<std::string> removed_retry_tokens{};
+  std::vector<std::string> removed_batch_retry_tokens{};
+};
+
+// A checkpoint is a chain of images named by CURRENT: one full base image
+// followed by delta images, each holding only the rows and retry receipts
+// that changed since the image before it. A checkpoint taken while the
+// store still remembers what the previous image covered writes a delta, so
+// its I/O follows the amount of change, not the collection size. Once
+// `max_deltas` deltas follow the base, a background thread folds the chain
+// into a new base and swaps CURRENT over to it. load() reads and decodes
+// every image of the chain in parallel and folds them in order.
+//
+// Image files are never overwritten while CURRENT names them, and a file
+// leaves the directory only after a durable CURRENT stops naming it, so a
+// crash at any point leaves a complete chain behind.
 class CollectionCheckpointStore {
  public:
-  [[nodiscard]] static auto write(
-      const std::filesystem::path &wal_directory,
+  // Larger `max_deltas` settings are clamped to this, which bounds CURRENT.
+  inline static constexpr std::uint32_t kMaximumDeltas = 1024;
+
+  // `max_deltas` == 0 writes a full base image on every checkpoint.
+  CollectionCheckpointStore(std::filesystem::path wal_directory, std::uint32_t max_deltas)
+      : directory_(std::move(wal_directory)), max_deltas_(std::min(max_deltas, kMaximumDeltas)) {}
+
+  CollectionCheckpointStore(const CollectionCheckpointStore &) = delete;
+  auto operator=(const CollectionCheckpointStore &) -> CollectionCheckpointStore & = delete;
+
+  ~CollectionCheckpointStore() { wait_for_merge(); }
+
+  [[nodiscard]] auto directory() const noexcept -> const std::filesystem::path & {
+    return directory_;
+  }
+
+  // Callers serialize write() with each other; a running merge may overlap.
+  // The first write() after load() has nothing to diff against and writes a
+  // full base.
+  [[nodiscard]] auto write(
       const RoutingSnapshot &snapshot,
       const std::map<std::string, MutationReceipt, std::less<>> &retry_receipts,
       const std::map<std::string, BatchMutationReceipt, std::less<>> &batch_retry_receipts)
       -> core::Result<CheckpointReceipt> {
     try {
-      std::filesystem::create_directories(wal_directory);
-      CollectionCheckpointImage image;
-      image.generation = snapshot.generation;
-      image.visibility_watermark = snapshot.visibility_watermark;
-      image.durable_watermark = snapshot.visibility_watermark;
-      image.metadata_epoch = snapshot.metadata_epoch;
-      image.wal_cut = snapshot.visibility_watermark;
-      image.checkpoint_name = "checkpoint_" + std::to_string(image.wal_cut) + ".bin";
-      image.retry_receipts = retry_receipts;
-      image.batch_retry_receipts = batch_retry_receipts;
-      image.state.batch_op_id = image.wal_cut;
-      image.state.batch_mode = BatchMutationMode::all_or_nothing;
-      image.state.durability = WriteDurability::wal_fsync;
-      image.state.rows.reserve(snapshot.versions.size());
-      for (const auto &[logical_id, version] : snapshot.versions) {
-        WalMutationRow row;
-        row.op_id = version.upsert_sequence;
-        row.action = version.state == VersionState::live ? SegmentMutationAction::write
-                                                         : SegmentMutationAction::erase;
-        row.status = version.state == VersionState::live ? RowMutationStatus::inserted
-                                                         : RowMutationStatus::deleted;
-        row.logical_id = logical_id;
-        row.target = version.address;
-        row.payload = version.payload;
-        image.state.rows.push_back(std::move(row));
+      std::filesystem::create_directories(directory_);
+      const auto wal_cut = snapshot.visibility_watermark;
+      std::size_t deltas{};
+      {
+        std::lock_guard lock(mutex_);
+        deltas = chain_.empty() ? 0 : chain_.size() - 1;
+      }
+      // A chain twice the bound means merges keep failing or falling behind;
+      // the checkpoint then rebases on its own.
+      const bool delta = baseline_.has_value() && max_deltas_ != 0 &&
+                         deltas < std::size_t{2} * max_deltas_;
+      std::vector<std::byte> bytes;
+      if (delta) {
+        bytes = encode_delta(diff(*baseline_, snapshot, retry_receipts, batch_retry_receipts));
+      } else {
+        // Superseding the whole chain: a merge still reading it is obsolete.
+        wait_for_merge();
+        CollectionCheckpointImage image;
+        image.generation = snapshot.generation;
+        image.visibility_watermark = snapshot.visibility_watermark;
+        image.durable_watermark = snapshot.visibility_watermark;
+        image.metadata_epoch = snapshot.metadata_epoch;
+        image.wal_cut = wal_cut;
+        image.retry_receipts = retry_receipts;
+        image.batch_retry_receipts = batch_retry_receipts;
+        image.state.batch_op_id = wal_cut;
+        image.state.batch_mode = BatchMutationMode::all_or_nothing;
+        image.state.durability = WriteDurability::wal_fsync;
+        image.state.rows.reserve(snapshot.versions.size());
+        for (const auto &[logical_id, version] : snapshot.versions) {
+          image.state.rows.push_back(to_row(logical_id, version));
+        }
+        bytes = encode(image);
       }
-      const auto bytes = encode(image);
-      const auto temporary = wal_directory / (image.checkpoint_name + ".tmp");
-      const auto final = wal_directory / image.checkpoint_name;
-      write_file(temporary, bytes);
-      platform::sync_file_or_throw(temporary);
-      platform::atomic_replace(temporary, final);
-      platform::sync_directory_or_throw(wal_directory);
-
-      const auto current_temporary = wal_directory / "CURRENT.tmp";
-      const auto current = wal_directory / "CURRENT";
-      const auto current_body = "checkpoint=" + image.checkpoint_name +
-                                "\nwal_cut=" + std::to_string(image.wal_cut) + "\n";
-      write_file(current_temporary,
-                 std::span(reinterpret_cast<const std::byte *>(current_body.data()),
-                           current_body.size()));
-      platform::sync_file_or_throw(current_temporary);
-      platform::atomic_replace(current_temporary, current);
-      platform::sync_directory_or_throw(wal_directory);
-      return CheckpointReceipt{image.durable_watermark,
-                               image.wal_cut,
-                               image.metadata_epoch,
-                               image.checkpoint_name};
+
+      std::string name;
+      std::vector<ChainImage> superseded;
+      {
+        std::lock_guard lock(mutex_);
+        name = unused_name(wal_cut);
+        reserved_.push_back(name);
+      }
+      write_image(name, bytes);
+      {
+        std::lock_guard lock(mutex_);
+        std::erase(reserved_, name);
+        auto chain = chain_;
+        if (!delta) {
+          superseded = std::exchange(chain, {});
+        }
+        chain.push_back(ChainImage{name, wal_cut});
+        publish_current(chain);
+        chain_ = std::move(chain);
+      }
+      remove_images(superseded);
+
+      baseline_ = Baseline{snapshot.versions, retry_receipts, batch_retry_receipts};
+      maybe_start_merge();
+      return CheckpointReceipt{snapshot.visibility_watermark,
+                               wal_cut,
+                               snapshot.metadata_epoch,
+                               std::move(name),
+                               take_merge_failure()};
     } catch (const std::invalid_argument &error) {
       return core::Status::error(core::StatusCode::invalid_argument,
                                  core::OperationStage::checkpoint,
@@ -109,37 +180,54 @@ class CollectionCheckpointStore {
     }
   }
 
-  [[nodiscard]] static auto load(const std::filesystem::path &wal_directory)
-      -> core::Result<std::optional<CollectionCheckpointImage>> {
+  // Folds the chain CURRENT names into one image and remembers the chain, so
+  // later writes and merges know which files are live.
+  [[nodiscard]] auto load() -> core::Result<std::optional<CollectionCheckpointImage>> {
     try {
-      const auto current = wal_directory / "CURRENT";
+      const auto current = directory_ / "CURRENT";
       if (!std::filesystem::exists(current)) {
         return std::optional<CollectionCheckpointImage>{};
       }
-      const auto body = read_file(current, 4096);
+      const auto body = read_file(current, kMaximumCurrentBytes);
       const std::string text(reinterpret_cast<const char *>(body.data()), body.size());
-      std::string checkpoint_name;
+      std::vector<std::string> names;
       std::optional<std::uint64_t> wal_cut;
       std::istringstream lines(text);
       for (std::string line; std::getline(lines, line);) {
         if (line.starts_with("checkpoint=")) {
-          checkpoint_name = line.substr(std::string("checkpoint=").size());
+          if (!names.empty()) {
+            throw std::invalid_argument("checkpoint CURRENT names more than one base image");
+          }
+          names.push_back(line.substr(std::string("checkpoint=").size()));
+        } else if (line.starts_with("delta=")) {
+          if (names.empty()) {
+            throw std::invalid_argument("checkpoint CURRENT names a delta before its base");
+          }
+          names.push_back(line.substr(std::string("delta=").size()));
         } else if (line.starts_with("wal_cut=")) {
           wal_cut = parse_u64(line.substr(std::string("wal_cut=").size()));
         } else if (!line.empty()) {
           throw std::invalid_argument("checkpoint CURRENT contains an unknown field");
         }
       }
-      if (checkpoint_name.empty() || checkpoint_name.find('/') != std::string::npos ||
-          checkpoint_name.find('\\') != std::string::npos || !wal_cut.has_value()) {
+      if (names.empty() || !wal_cut.has_value() ||
+          std::ranges::any_of(names, [](const std::string &name) {
+            return name.empty() || name.find('/') != std::string::npos ||
+                   name.find('\\') != std::string::npos;
+          })) {
         throw std::invalid_argument("checkpoint CURRENT is malformed");
       }
-      auto image = decode(
-          read_file(wal_directory / checkpoint_name, logical_wal_detail::kMaximumPayloadBytes));
+      auto image = read_chain(names);
       if (image.wal_cut != *wal_cut) {
         throw std::invalid_argument("checkpoint CURRENT WAL cut does not match the image");
       }
-      image.checkpoint_name = std::move(checkpoint_name);
+      image.checkpoint_name = names.back();
+      std::lock_guard lock(mutex_);
+      chain_.clear();
+      for (auto &name : names) {
+        chain_.push_back(ChainImage{std::move(name), {}});
+      }
+      chain_.back().wal_cut = image.wal_cut;
       return std::optional<CollectionCheckpointImage>(std::move(image));
     } catch (const std::invalid_argument &error) {
       return core::Status::error(core::StatusCode::corruption,
@@ -156,6 +244,32 @@ class CollectionCheckpointStore {
     }
   }
 
+  // Images CURRENT names: the base followed by its deltas.
+  [[nodiscard]] auto chain() const -> std::vector<std::string> {
+    std::lock_guard lock(mutex_);
+    std::vector<std::string> names;
+    names.reserve(chain_.size());
+    for (const auto &image : chain_) {
+      names.push_back(image.name);
+    }
+    return names;
+  }
+
+  // Blocks until no background merge runs. Safe to call from any thread.
+  void wait_for_merge() {
+    std::lock_guard lock(merger_mutex_);
+    if (merger_.joinable()) {
+      merger_.join();
+    }
+  }
+
+  // A failed merge leaves the longer chain in place; the first failure since
+  // the last call is kept. write() hands it out with its receipt.
+  [[nodiscard]] auto take_merge_failure() -> core::Status {
+    std::lock_guard lock(mutex_);
+    return std::exchange(merge_failure_, core::Status::success());
+  }
+
   static void apply_to_manifest(const CheckpointReceipt &checkpoint, ArtifactManifestV2 &manifest) {
     manifest.wal_cut = checkpoint.wal_cut;
     manifest.collection.metadata_epoch = checkpoint.metadata_epoch;
@@ -168,44 +282,369 @@ class CollectionCheckpointStore {
   }
 
  private:
-  inline static constexpr std::uint32_t kMagic = 0x37504B43U;    // "CKP7".
-  inline static constexpr std::uint32_t kTrailer = 0x37444E45U;  // "END7".
+  inline static constexpr std::uint32_t kMagic = 0x37504B43U;       // "CKP7".
+  inline static constexpr std::uint32_t kDeltaMagic = 0x37444B43U;  // "CKD7".
+  inline static constexpr std::uint32_t kTrailer = 0x37444E45U;     // "END7".
   inline static constexpr std::uint16_t kVersion = 1;
+  // A chain holds at most 2 * kMaximumDeltas deltas after its base (write()
+  // rebases beyond that); each CURRENT line, wal_cut= included, fits in 96
+  // bytes ("checkpoint=checkpoint_<u64>.<u64>.bin").
+  inline static constexpr std::uint64_t kMaximumCurrentBytes =
+      (std::uint64_t{2} * kMaximumDeltas + 2) * 96;
 
-  [[nodiscard]] static auto encode(const CollectionCheckpointImage &image)
-      -> std::vector<std::byte> {
-    std::vector<std::byte> payload;
-    logical_wal_detail::put_u64(payload, image.generation);
-    logical_wal_detail::put_u64(payload, image.visibility_watermark);
-    logical_wal_detail::put_u64(payload, image.durable_watermark);
-    logical_wal_detail::put_u64(payload, image.metadata_epoch);
-    logical_wal_detail::put_u64(payload, image.wal_cut);
-    const auto state = encode_wal_transaction(image.state);
-    logical_wal_detail::put_u64(payload, state.size());
-    payload.insert(payload.end(), state.begin(), state.end());
-    mutation_wal_codec_detail::put_u32(payload,
-                                       static_cast<std::uint32_t>(image.retry_receipts.size()));
-    for (const auto &[token, receipt] : image.retry_receipts) {
-      mutation_wal_codec_detail::put_string(payload, token);
-      encode_receipt(payload, receipt);
+  struct ChainImage {
+    std::string name{};
+    std::uint64_t wal_cut{};
+  };
+
+  // What the last image written covered. The version map is a structural
+  // copy, so an unchanged row is the very same entry in both maps and the
+  // diff finds changed rows by identity without comparing payloads.
+  struct Baseline {
+    VersionMap versions{};
+    std::map<std::string, MutationReceipt, std::less<>> retry_receipts{};
+    std::map<std::string, BatchMutationReceipt, std::less<>> batch_retry_receipts{};
+  };
+
+  [[nodiscard]] static auto to_row(const core::LogicalId &logical_id, const VersionEntry &version)
+      -> WalMutationRow {
+    WalMutationRow row;
+    row.op_id = version.upsert_sequence;
+    row.action = version.state == VersionState::live ? SegmentMutationAction::write
+                                                     : SegmentMutationAction::erase;
+    row.status = version.state == VersionState::live ? RowMutationStatus::inserted
+                                                     : RowMutationStatus::deleted;
+    row.logical_id = logical_id;
+    row.target = version.address;
+    row.payload = version.payload;
+    return row;
+  }
+
+  // Walks two key-ordered maps in step and reports keys only in `before`,
+  // and keys new in `after` or whose value `changed`. Every entry of both maps
+  // is visited, so a delta costs a full pass even when few rows changed.
+  template <class Map, class Less, class Changed, class OnRemoved, class OnChanged>
+  static void diff_maps(const Map &before,
+                        const Map &after,
+                        Less less,
+                        Changed changed,
+                        OnRemoved on_removed,
+                        OnChanged on_changed) {
+    auto old_entry = before.begin();
+    auto new_entry = after.begin();
+    while (old_entry != before.end() || new_entry != after.end()) {
+      if (new_entry == after.end() ||
+          (old_entry != before.end() && less(old_entry->first, new_entry->first))) {
+        on_removed(old_entry->first);
+        ++old_entry;
+      } else if (old_entry == before.end() || less(new_entry->first, old_entry->first)) {
+        on_changed(*new_entry);
+        ++new_entry;
+      } else {
+        if (changed(*old_entry, *new_entry)) {
+          on_changed(*new_entry);
+        }
+        ++old_entry;
+        ++new_entry;
+      }
     }
-    mutation_wal_codec_detail::put_u32(payload,
-                                       static_cast<std::uint32_t>(
-                                           image.batch_retry_receipts.size()));
-    for (const auto &[token, receipt] : image.batch_retry_receipts) {
-      mutation_wal_codec_detail::put_string(payload, token);
-      mutation_wal_codec_detail::put_u64(payload, receipt.batch_op_id);
-      mutation_wal_codec_detail::put_u64(payload, receipt.visibility_watermark);
-      mutation_wal_codec_detail::put_u64(payload, receipt.durable_watermark);
-      mutation_wal_codec_detail::put_u8(payload, receipt.searchable ? 1 : 0);
-      mutation_wal_codec_detail::put_u8(payload, static_cast<std::uint8_t>(receipt.durability));
-      mutation_wal_codec_detail::put_u32(payload, static_cast<std::uint32_t>(receipt.rows.size()));
-      for (const auto &row : receipt.rows) {
-        encode_receipt(payload, row);
+  }
+
+  [[nodiscard]] auto diff(
+      const Baseline &baseline,
+      const RoutingSnapshot &snapshot,
+      const std::map<std::string, MutationReceipt, std::less<>> &retry_receipts,
+      const std::map<std::string, BatchMutationReceipt, std::less<>> &batch_retry_receipts) const
+      -> CollectionCheckpointDelta {
+    CollectionCheckpointDelta delta;
+    delta.generation = snapshot.generation;
+    delta.visibility_watermark = snapshot.visibility_watermark;
+    delta.durable_watermark = snapshot.visibility_watermark;
+    delta.metadata_epoch = snapshot.metadata_epoch;
+    delta.wal_cut = snapshot.visibility_watermark;
+    {
+      std::lock_guard lock(mutex_);
+      delta.previous_cut = chain_.back().wal_cut;
+    }
+    delta.state.batch_op_id = delta.wal_cut;
+    delta.state.batch_mode = BatchMutationMode::all_or_nothing;
+    delta.state.durability = WriteDurability::wal_fsync;
+    diff_maps(
+        baseline.versions,
+        snapshot.versions,
+        LogicalIdLess{},
+        [](const auto &lhs, const auto &rhs) { return &lhs != &rhs; },
+        [&](const core::LogicalId &logical_id) { delta.removed.push_back(logical_id); },
+        [&](const auto &entry) { delta.state.rows.push_back(to_row(entry.first, entry.second)); });
+    const auto receipt_changed = [](const auto &lhs, const auto &rhs) {
+      return lhs.second != rhs.second;
+    };
+    diff_maps(
+        baseline.retry_receipts,
+        retry_receipts,
+        std::less<>{},
+        receipt_changed,
+        [&](const std::string &token) { delta.removed_retry_tokens.push_back(token); },
+        [&](const auto &entry) { delta.retry_receipts.insert(delta.retry_receipts.end(), entry); });
+    diff_maps(
+        baseline.batch_retry_receipts,
+        batch_retry_receipts,
+        std::less<>{},
+        receipt_changed,
+        [&](const std::string &token) { delta.removed_batch_retry_tokens.push_back(token); },
+        [&](const auto &entry) {
+          delta.batch_retry_receipts.insert(delta.batch_retry_receipts.end(), entry);
+        });
+    return delta;
+  }
+
+  // Applies `delta` to the image it follows.
+  static void fold(CollectionCheckpointImage &image, CollectionCheckpointDelta &&delta) {
+    if (delta.previous_cut != image.wal_cut || delta.wal_cut < delta.previous_cut) {
+      throw std::invalid_argument("checkpoint delta does not follow the image before it");
+    }
+    const LogicalIdLess less;
+    const auto ascending = [&](const auto &ids) {
+      return std::ranges::adjacent_find(ids, [&](const auto &lhs, const auto &rhs) {
+               return !less(lhs, rhs);
+             }) == ids.end();
+    };
+    if (!ascending(delta.removed) ||
+        !ascending(delta.state.rows | std::views::transform(&WalMutationRow::logical_id))) {
+      throw std::invalid_argument("checkpoint delta rows are not in key order");
+    }
+    auto &rows = image.state.rows;
+    std::vector<WalMutationRow> merged;
+    merged.reserve(rows.size() + delta.state.rows.size());
+    std::size_t next_removed{};
+    const auto keep = [&](WalMutationRow &row) {
+      while (next_removed < delta.removed.size() &&
+             less(delta.removed[next_removed], row.logical_id)) {
+        ++next_removed;
+      }
+      if (next_removed < delta.removed.size() &&
+          !less(row.logical_id, delta.removed[next_removed])) {
+        return;
+      }
+      merged.push_back(std::move(row));
+    };
+    std::size_t next_row{};
+    for (auto &row : delta.state.rows) {
+      while (next_row < rows.size() && less(rows[next_row].logical_id, row.logical_id)) {
+        keep(rows[next_row++]);
       }
+      if (next_row < rows.size() && !less(row.logical_id, rows[next_row].logical_id)) {
+        ++next_row;
+      }
+      merged.push_back(std::move(row));
+    }
+    while (next_row < rows.size()) {
+      keep(rows[next_row++]);
+    }
+    rows = std::move(merged);
+
+    image.generation = delta.generation;
+    image.visibility_watermark = delta.visibility_watermark;
+    image.durable_watermark = delta.durable_watermark;
+    image.metadata_epoch = delta.metadata_epoch;
+    image.wal_cut = delta.wal_cut;
+    image.state.batch_op_id = delta.wal_cut;
+    for (const auto &token : delta.removed_retry_tokens) {
+      image.retry_receipts.erase(token);
+    }
+    for (auto &[token, receipt] : delta.retry_receipts) {
+      image.retry_receipts.insert_or_assign(token, std::move(receipt));
+    }
+    for (const auto &token : delta.removed_batch_retry_tokens) {
+      image.batch_retry_receipts.erase(token);
+    }
+    for (auto &[token, receipt] : delta.batch_retry_receipts) {
+      image.batch_retry_receipts.insert_or_assign(token, std::move(receipt));
+    }
+  }
+
+  // Reads and decodes every image of a chain, one worker per image up to the
+  // hardware's concurrency, then folds them in chain order.
+  [[nodiscard]] auto read_chain(const std::vector<std::string> &names) const
+      -> CollectionCheckpointImage {
+    CollectionCheckpointImage base;
+    std::vector<CollectionCheckpointDelta> deltas(names.size() - 1);
+    std::vector<std::exception_ptr> errors(names.size());
+    const auto decode_one = [&](std::size_t index) {
+      try {
+        auto bytes =
+            read_file(directory_ / names[index], logical_wal_detail::kMaximumPayloadBytes);
+        if (index == 0) {
+          base = decode(bytes);
+        } else {
+          deltas[index - 1] = decode_delta(bytes);
+        }
+      } catch (...) {
+        errors[index] = std::current_exception();
+      }
+    };
+    const auto workers = std::min<std::size_t>(
+        names.size(), std::max(1U, std::thread::hardware_concurrency()));
+    std::vector<std::thread> helpers;
+    helpers.reserve(workers - 1);
+    for (std::size_t worker = 1; worker < workers; ++worker) {
+      helpers.emplace_back([&, worker] {
+        for (std::size_t index = worker; index < names.size(); index += workers) {
+          decode_one(index);
+        }
+      });
+    }
+    for (std::size_t index = 0; index < names.size(); index += workers) {
+      decode_one(index);
+    }
+    for (auto &helper : helpers) {
+      helper.join();
+    }
+    for (const auto &error : errors) {
+      if (error != nullptr) {
+        std::rethrow_exception(error);
+      }
+    }
+    for (auto &delta : deltas) {
+      fold(base, std::move(delta));
     }
+    return base;
+  }
+
+  // Caller holds mutex_. The plain checkpoint_<cut>.bin name unless a live
+  // or in-flight image already uses it.
+  [[nodiscard]] auto unused_name(std::uint64_t wal_cut) const -> std::string {
+    const auto taken = [&](const std::string &name) {
+      return std::ranges::any_of(chain_, [&](const auto &image) { return image.name == name; }) ||
+             std::ranges::find(reserved_, name) != reserved_.end();
+    };
+    auto name = "checkpoint_" + std::to_string(wal_cut) + ".bin";
+    for (std::uint64_t suffix = 1; taken(name); ++suffix) {
+      name = "checkpoint_" + std::to_string(wal_cut) + "." + std::to_string(suffix) + ".bin";
+    }
+    return name;
+  }
+
+  void write_image(const std::string &name, std::span<const std::byte> bytes) const {
+    const auto temporary = directory_ / (name + ".tmp");
+    const auto final = directory_ / name;
+    write_file(temporary, bytes);
+    platform::sync_file_or_throw(temporary);
+    platform::atomic_replace(temporary, final);
+    platform::sync_directory_or_throw(directory_);
+  }
+
+  // Caller holds mutex_.
+  void publish_current(const std::vector<ChainImage> &chain) const {
+    std::string body = "checkpoint=" + chain.front().name + "\n";
+    for (std::size_t index = 1; index < chain.size(); ++index) {
+      body += "delta=" + chain[index].name + "\n";
+    }
+    body += "wal_cut=" + std::to_string(chain.back().wal_cut) + "\n";
+    const auto temporary = directory_ / "CURRENT.tmp";
+    write_file(temporary,
+               std::span(reinterpret_cast<const std::byte *>(body.data()), body.size()));
+    platform::sync_file_or_throw(temporary);
+    platform::atomic_replace(temporary, directory_ / "CURRENT");
+    platform::sync_directory_or_throw(directory_);
+  }
+
+  // Best effort: a leftover image is unreferenced garbage, never state.
+  void remove_images(const std::vector<ChainImage> &images) const {
+    for (const auto &image : images) {
+      std::error_code ignored;
+      std::filesystem::remove(directory_ / image.name, ignored);
+    }
+  }
+
+  void maybe_start_merge() {
+    std::vector<std::string> inputs;
+    std::string output;
+    {
+      std::lock_guard lock(mutex_);
+      if (max_deltas_ == 0 || chain_.size() <= max_deltas_ || merging_) {
+        return;
+      }
+      for (const auto &image : chain_) {
+        inputs.push_back(image.name);
+      }
+      output = unused_name(chain_.back().wal_cut);
+      reserved_.push_back(output);
+      merging_ = true;
+    }
+    try {
+      std::lock_guard merger_lock(merger_mutex_);
+      if (merger_.joinable()) {
+        merger_.join();
+      }
+      merger_ = std::thread([this, inputs, output] { merge(inputs, output); });
+    } catch (const std::system_error &error) {
+      // The checkpoint itself is durable; only the merge is skipped.
+      std::lock_guard lock(mutex_);
+      std::erase(reserved_, output);
+      merging_ = false;
+      if (merge_failure_.ok()) {
+        merge_failure_ = core::Status::error(core::StatusCode::io_error,
+                                             core::OperationStage::checkpoint,
+                                             core::StatusDetail::none,
+                                             error.what());
+      }
+    }
+  }
+
+  // Folds `inputs`, a prefix of the chain when the merge started, into a new
+  // base named `output`. Deltas written meanwhile stay chained after it.
+  void merge(const std::vector<std::string> &inputs, const std::string &output) {
+    std::vector<ChainImage> folded;
+    auto status = core::Status::success();
+    try {
+      auto image = read_chain(inputs);
+      write_image(output, encode(image));
+      std::lock_guard lock(mutex_);
+      const bool prefix =
+          chain_.size() >= inputs.size() &&
+          std::equal(inputs.begin(),
+                     inputs.end(),
+                     chain_.begin(),
+                     [](const auto &name, const auto &live) { return name == live.name; });
+      if (prefix) {
+        std::vector<ChainImage> chain{ChainImage{output, image.wal_cut}};
+        chain.insert(chain.end(),
+                     chain_.begin() + static_cast<std::ptrdiff_t>(inputs.size()),
+                     chain_.end());
+        publish_current(chain);
+        folded.assign(chain_.begin(), chain_.begin() + static_cast<std::ptrdiff_t>(inputs.size()));
+        chain_ = std::move(chain);
+      } else {
+        folded.push_back(ChainImage{output, image.wal_cut});
+      }
+    } catch (const std::invalid_argument &error) {
+      status = core::Status::error(core::StatusCode::corruption,
+                                   core::OperationStage::checkpoint,
+                                   core::StatusDetail::malformed_struct,
+                                   error.what());
+    } catch (const std::exception &error) {
+      status = core::Status::error(core::StatusCode::io_error,
+                                   core::OperationStage::checkpoint,
+                                   core::StatusDetail::none,
+                                   error.what());
+    } catch (...) {
+      status = core::status_from_exception(core::OperationStage::checkpoint);
+    }
+    remove_images(folded);
+    std::lock_guard lock(mutex_);
+    std::erase(reserved_, output);
+    merging_ = false;
+    if (!status.ok() && merge_failure_.ok()) {
+      merge_failure_ = std::move(status);
+    }
+  }
+
+  [[nodiscard]] static auto frame(std::uint32_t magic, std::span<const std::byte> payload)
+      -> std::vector<std::byte> {
     std::vector<std::byte> output;
-    logical_wal_detail::put_u32(output, kMagic);
+    output.reserve(payload.size() + 24);
+    logical_wal_detail::put_u32(output, magic);
     logical_wal_detail::put_u16(output, kVersion);
     logical_wal_detail::put_u16(output, 0);
     logical_wal_detail::put_u64(output, payload.size());
@@ -215,9 +654,10 @@ class CollectionCheckpointStore {
     return output;
   }
 
-  [[nodiscard]] static auto decode(std::span<const std::byte> bytes) -> CollectionCheckpointImage {
+  [[nodiscard]] static auto unframe(std::span<const std::byte> bytes, std::uint32_t magic)
+      -> std::span<const std::byte> {
     constexpr std::size_t kHeader = 20;
-    if (bytes.size() < kHeader + 4 || logical_wal_detail::get_u32(bytes, 0) != kMagic ||
+    if (bytes.size() < kHeader + 4 || logical_wal_detail::get_u32(bytes, 0) != magic ||
         logical_wal_detail::get_u16(bytes, 4) != kVersion) {
       throw std::invalid_argument("checkpoint image header is invalid");
     }
@@ -230,6 +670,26 @@ class CollectionCheckpointStore {
     if (logical_wal_detail::crc32(payload) != logical_wal_detail::get_u32(bytes, 16)) {
       throw std::invalid_argument("checkpoint image checksum is invalid");
     }
+    return payload;
+  }
+
+  [[nodiscard]] static auto encode(const CollectionCheckpointImage &image)
+      -> std::vector<std::byte> {
+    std::vector<std::byte> payload;
+    logical_wal_detail::put_u64(payload, image.generation);
+    logical_wal_detail::put_u64(payload, image.visibility_watermark);
+    logical_wal_detail::put_u64(payload, image.durable_watermark);
+    logical_wal_detail::put_u64(payload, image.metadata_epoch);
+    logical_wal_detail::put_u64(payload, image.wal_cut);
+    const auto state = encode_wal_transaction(image.state);
+    logical_wal_detail::put_u64(payload, state.size());
+    payload.insert(payload.end(), state.begin(), state.end());
+    encode_ledgers(payload, image.retry_receipts, image.batch_retry_receipts);
+    return frame(kMagic, payload);
+  }
+
+  [[nodiscard]] static auto decode(std::span<const std::byte> bytes) -> CollectionCheckpointImage {
+    const auto payload = unframe(bytes, kMagic);
     if (payload.size() < 48) {
       throw std::invalid_argument("checkpoint image payload is truncated");
     }
@@ -245,6 +705,123 @@ class CollectionCheckpointStore {
     }
     image.state = decode_wal_transaction(payload.subspan(48, state_size));
     mutation_wal_codec_detail::Decoder decoder(payload.subspan(48 + state_size));
+    decode_ledgers(decoder, image.retry_receipts, image.batch_retry_receipts);
+    if (!decoder.empty()) {
+      throw std::invalid_argument("checkpoint image has trailing receipt bytes");
+    }
+    return image;
+  }
+
+  [[nodiscard]] static auto encode_delta(const CollectionCheckpointDelta &delta)
+      -> std::vector<std::byte> {
+    std::vector<std::byte> payload;
+    logical_wal_detail::put_u64(payload, delta.generation);
+    logical_wal_detail::put_u64(payload, delta.visibility_watermark);
+    logical_wal_detail::put_u64(payload, delta.durable_watermark);
+    logical_wal_detail::put_u64(payload, delta.metadata_epoch);
+    logical_wal_detail::put_u64(payload, delta.wal_cut);
+    logical_wal_detail::put_u64(payload, delta.previous_cut);
+    const auto state = encode_wal_transaction(delta.state);
+    logical_wal_detail::put_u64(payload, state.size());
+    payload.insert(payload.end(), state.begin(), state.end());
+    put_count(payload, delta.removed.size());
+    for (const auto &logical_id : delta.removed) {
+      mutation_wal_codec_detail::encode_logical_id(payload, logical_id);
+    }
+    encode_ledgers(payload, delta.retry_receipts, delta.batch_retry_receipts);
+    for (const auto *tokens : {&delta.removed_retry_tokens, &delta.removed_batch_retry_tokens}) {
+      put_count(payload, tokens->size());
+      for (const auto &token : *tokens) {
+        mutation_wal_codec_detail::put_string(payload, token);
+      }
+    }
+    return frame(kDeltaMagic, payload);
+  }
+
+  [[nodiscard]] static auto decode_delta(std::span<const std::byte> bytes)
+      -> CollectionCheckpointDelta {
+    const auto payload = unframe(bytes, kDeltaMagic);
+    if (payload.size() < 56) {
+      throw std::invalid_argument("checkpoint delta payload is truncated");
+    }
+    CollectionCheckpointDelta delta;
+    delta.generation = logical_wal_detail::get_u64(payload, 0);
+    delta.visibility_watermark = logical_wal_detail::get_u64(payload, 8);
+    delta.durable_watermark = logical_wal_detail::get_u64(payload, 16);
+    delta.metadata_epoch = logical_wal_detail::get_u64(payload, 24);
+    delta.wal_cut = logical_wal_detail::get_u64(payload, 32);
+    delta.previous_cut = logical_wal_detail::get_u64(payload, 40);
+    const auto state_size = logical_wal_detail::get_u64(payload, 48);
+    if (state_size > payload.size() - 56) {
+      throw std::invalid_argument("checkpoint delta state payload is truncated");
+    }
+    delta.state = decode_wal_transaction(payload.subspan(56, state_size));
+    mutation_wal_codec_detail::Decoder decoder(payload.subspan(56 + state_size));
+    const auto removed = get_count(decoder);
+    delta.removed.reserve(removed);
+    for (std::uint32_t index = 0; index < removed; ++index) {
+      delta.removed.push_back(mutation_wal_codec_detail::decode_logical_id(decoder));
+    }
+    decode_ledgers(decoder, delta.retry_receipts, delta.batch_retry_receipts);
+    for (auto *tokens : {&delta.removed_retry_tokens, &delta.removed_batch_retry_tokens}) {
+      const auto count = get_count(decoder);
+      tokens->reserve(count);
+      for (std::uint32_t index = 0; index < count; ++index) {
+        tokens->push_back(decoder.string());
+      }
+    }
+    if (!decoder.empty()) {
+      throw std::invalid_argument("checkpoint delta has trailing bytes");
+    }
+    return delta;
+  }
+
+  static void put_count(std::vector<std::byte> &output, std::size_t count) {
+    if (count > mutation_wal_codec_detail::kMaximumRows) {
+      throw std::invalid_argument("checkpoint section has too many entries");
+    }
+    mutation_wal_codec_detail::put_u32(output, static_cast<std::uint32_t>(count));
+  }
+
+  [[nodiscard]] static auto get_count(mutation_wal_codec_detail::Decoder &decoder)
+      -> std::uint32_t {
+    const auto count = decoder.u32();
+    if (count > mutation_wal_codec_detail::kMaximumRows) {
+      throw std::invalid_argument("checkpoint section is too large");
+    }
+    return count;
+  }
+
+  static void encode_ledgers(
+      std::vector<std::byte> &payload,
+      const std::map<std::string, MutationReceipt, std::less<>> &retry_receipts,
+      const std::map<std::string, BatchMutationReceipt, std::less<>> &batch_retry_receipts) {
+    mutation_wal_codec_detail::put_u32(payload,
+                                       static_cast<std::uint32_t>(retry_receipts.size()));
+    for (const auto &[token, receipt] : retry_receipts) {
+      mutation_wal_codec_detail::put_string(payload, token);
+      encode_receipt(payload, receipt);
+    }
+    mutation_wal_codec_detail::put_u32(payload,
+                                       static_cast<std::uint32_t>(batch_retry_receipts.size()));
+    for (const auto &[token, receipt] : batch_retry_receipts) {
+      mutation_wal_codec_detail::put_string(payload, token);
+      mutation_wal_codec_detail::put_u64(payload, receipt.batch_op_id);
+      mutation_wal_codec_detail::put_u64(payload, receipt.visibility_watermark);
+      mutation_wal_codec_detail::put_u64(payload, receipt.durable_watermark);
+      mutation_wal_codec_detail::put_u8(payload, receipt.searchable ? 1 : 0);
+      mutation_wal_codec_detail::put_u8(payload, static_cast<std::uint8_t>(receipt.durability));
+      mutation_wal_codec_detail::put_u32(payload, static_cast<std::uint32_t>(receipt.rows.size()));
+      for (const auto &row : receipt.rows) {
+        encode_receipt(payload, row);
+      }
+    }
+  }
+
+  static void decode_ledgers(
+      mutation_wal_codec_detail::Decoder &decoder,
+      std::map<std::string, MutationReceipt, std::less<>> &retry_receipts,
+      std::map<std::string, BatchMutationReceipt, std::less<>> &batch_retry_receipts) {
     const auto retry_count = decoder.u32();
     if (retry_count > mutation_wal_codec_detail::kMaximumRows) {
       throw std::invalid_argument("checkpoint retry ledger is too large");
@@ -252,7 +829,7 @@ class CollectionCheckpointStore {
     for (std::uint32_t index = 0; index < retry_count; ++index) {
       auto token = decoder.string();
       auto receipt = decode_receipt(decoder);
-      if (!image.retry_receipts.emplace(std::move(token), std::move(receipt)).second) {
+      if (!retry_receipts.emplace(std::move(token), std::move(receipt)).second) {
         throw std::invalid_argument("checkpoint retry ledger contains a duplicate token");
       }
     }
@@ -277,14 +854,10 @@ class CollectionCheckpointStore {
       for (std::uint32_t row = 0; row < row_count; ++row) {
         receipt.rows.push_back(decode_receipt(decoder));
       }
-      if (!image.batch_retry_receipts.emplace(std::move(token), std::move(receipt)).second) {
+      if (!batch_retry_receipts.emplace(std::move(token), std::move(receipt)).second) {
         throw std::invalid_argument("checkpoint batch retry ledger contains a duplicate token");
       }
     }
-    if (!decoder.empty()) {
-      throw std::invalid_argument("checkpoint image has trailing receipt bytes");
-    }
-    return image;
   }
 
   static void encode_receipt(std::vector<std::byte> &output, const MutationReceipt &receipt) {
@@ -366,6 +939,20 @@ class CollectionCheckpointStore {
     }
     return result;
   }
+
+  std::filesystem::path directory_{};
+  std::uint32_t max_deltas_{};
+  // Touched only by write(), which its callers serialize.
+  std::optional<Baseline> baseline_{};
+  // Guards merger_ itself: write() and close() may both wait for a merge.
+  // Never taken by the merge thread.
+  std::mutex merger_mutex_{};
+  std::thread merger_{};
+  mutable std::mutex mutex_{};
+  std::vector<ChainImage> chain_{};
+  std::vector<std::string> reserved_{};  // names of images being written
+  bool merging_{};
+  core::Status merge_failure_{core::Status::success()};
 };
 
 }  // namespace alaya::internal::collection
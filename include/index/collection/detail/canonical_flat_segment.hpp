@@ -5,18 +5,26 @@
 #pragma once
 
 #include <algorithm>
+#include <array>
+#include <atomic>
+#include <bit>
 #include <cmath>
 #include <cstddef>
 #include <cstdint>
+#include <cstring>
 #include <limits>
 #include <map>
 #include <memory>
 #include <mutex>
+#include <new>
 #include <set>
 #include <utility>
 #include <vector>
 
 #include "index/collection/types.hpp"
+#include "platform/detect.hpp"
+#include "simd/distance_ip.hpp"
+#include "simd/distance_l2.hpp"
 
 namespace alaya::internal::collection::detail {
 
@@ -24,10 +32,25 @@ namespace alaya::internal::collection::detail {
 // deliberately not a public DiskFlatSegment mutation API: the Collection owns
 // logical IDs, metadata, WAL ordering and visibility, while this operation
 // table owns only exact-searchable physical rows for the active generation.
+//
+// Published rows live in an append-only, row-major arena indexed by row ID.
+// Mutations stay serialized under mutex_; searches never take it. A writer
+// fills a row's vector, sequence and norm first and only then sets its live
+// bit with release semantics, so a reader that observes the bit also observes
+// the row. Tombstones just clear the bit. A slot is never rewritten in place:
+// re-publishing an already written row ID (possible only when recovery
+// replays over live state) writes the row into a copy of its chunk and only
+// then swaps the directory slot, which keeps in-flight readers on the old,
+// still valid, chunk.
 class CanonicalFlatSegment {
  public:
   CanonicalFlatSegment(CollectionSchema schema, std::uint64_t segment_id, std::uint64_t generation)
-      : schema_(schema), segment_id_(segment_id), generation_(generation) {}
+      : schema_(schema),
+        segment_id_(segment_id),
+        generation_(generation),
+        row_bytes_(static_cast<std::size_t>(schema.dim) *
+                   core::scalar_type_size(schema.scalar_type)),
+        row_stride_((row_bytes_ + kRowAlignment - 1) / kRowAlignment * kRowAlignment) {}
 
   [[nodiscard]] auto descriptor() const noexcept -> core::Descriptor {
     core::Descriptor descriptor;
@@ -192,17 +215,44 @@ class CanonicalFlatSegment {
     std::lock_guard lock(mutex_);
     stats = core::SegmentStats{};
     stats.snapshot_version = applied_watermark_;
-    stats.live_rows = rows_.size();
-    stats.allocated_rows = rows_.size();
+    stats.live_rows = live_rows_;
+    stats.allocated_rows = live_rows_;
     stats.pending_rows = transactions_.size();
     stats.health = core::SegmentHealth::healthy;
     return core::Status::success();
   }
 
  private:
-  struct PublishedRow {
-    OwnedVector vector{};
-    std::uint64_t sequence{};
+  // Rows are grouped in fixed-size chunks so the arena grows without moving
+  // vectors a concurrent search may be reading.
+  static constexpr std::uint64_t kChunkRows = 1024;
+  static constexpr std::uint64_t kChunkWords = kChunkRows / 64;
+  static constexpr std::size_t kRowAlignment = 64;
+  static constexpr std::uint64_t kMaxRows = std::uint64_t{1} << 32U;
+
+  struct AlignedFreeDeleter {
+    void operator()(std::byte *pointer) const noexcept { alaya_aligned_free_impl(pointer); }
+  };
+
+  struct Chunk {
+    std::unique_ptr<std::byte, AlignedFreeDeleter> vectors{};
+    std::array<std::atomic<std::uint64_t>, kChunkWords> live{};
+    std::array<std::uint64_t, kChunkWords> written{};  // writer-only
+    std::array<std::uint64_t, kChunkRows> sequences{};
+    std::array<float, kChunkRows> inverse_norms{};  // cosine only
+  };
+
+  // A fixed-capacity spine of chunk slots. The writer appends chunks in place
+  // (slot first, then size, with release) and swaps a slot to a copied chunk;
+  // only a full spine is replaced, by one of twice the capacity, so growth
+  // copies O(chunks) pointers in total and retired spines stay few. Retired
+  // spines and chunks are kept until destruction because a search may still
+  // hold a pointer into them.
+  struct Directory {
+    explicit Directory(std::size_t capacity) : chunks(capacity) {}
+
+    std::vector<std::atomic<Chunk *>> chunks;
+    std::atomic<std::size_t> size{};
   };
 
   struct OwnedRow {
@@ -245,6 +295,9 @@ class CanonicalFlatSegment {
         payload.target.segment_id != segment_id_ || payload.target.generation != generation_) {
       return malformed_mutation("canonical Flat mutation row identity is invalid");
     }
+    if (static_cast<std::uint64_t>(payload.target.row_id) >= kMaxRows) {
+      return malformed_mutation("canonical Flat mutation row ID exceeds the arena capacity");
+    }
     OwnedRow result;
     result.action = payload.action;
     result.op_id = payload.op_id;
@@ -277,29 +330,158 @@ class CanonicalFlatSegment {
       }
       if (row.previous.has_value() && row.previous->segment_id == segment_id_ &&
           row.previous->generation == generation_) {
-        rows_.erase(static_cast<std::uint64_t>(row.previous->row_id));
+        clear_row_locked(static_cast<std::uint64_t>(row.previous->row_id));
       }
       if (row.action == SegmentMutationAction::write && row.vector.has_value()) {
-        rows_.insert_or_assign(static_cast<std::uint64_t>(row.target.row_id),
-                               PublishedRow{*row.vector, row.upsert_sequence});
+        write_row_locked(static_cast<std::uint64_t>(row.target.row_id),
+                         *row.vector,
+                         row.upsert_sequence);
       }
       applied_ops_.insert(row.op_id);
       applied_watermark_ = std::max(applied_watermark_, row.op_id);
     }
   }
 
+  [[nodiscard]] auto writer_directory() const noexcept -> Directory * {
+    return directories_.empty() ? nullptr : directories_.back().get();
+  }
+
+  void publish_directory_locked(std::unique_ptr<Directory> next) {
+    directories_.push_back(std::move(next));
+    directory_.store(directories_.back().get(), std::memory_order_release);
+  }
+
+  [[nodiscard]] auto allocate_chunk() const -> std::unique_ptr<Chunk> {
+    auto chunk = std::make_unique<Chunk>();
+    auto *vectors =
+        static_cast<std::byte *>(alaya_aligned_alloc_impl(kChunkRows * row_stride_, kRowAlignment));
+    if (vectors == nullptr) {
+      throw std::bad_alloc{};
+    }
+    chunk->vectors.reset(vectors);
+    return chunk;
+  }
+
+  // Returns the chunk slot that holds row_id, growing the directory and
+  // appending chunks as needed.
+  [[nodiscard]] auto chunk_for_row_locked(std::uint64_t row_id) -> Chunk & {
+    const auto chunk_index = static_cast<std::size_t>(row_id / kChunkRows);
+    const auto offset = row_id % kChunkRows;
+    auto *current = writer_directory();
+    if (current == nullptr || chunk_index >= current->chunks.size()) {
+      const auto size = current == nullptr ? 0 : current->size.load(std::memory_order_relaxed);
+      auto next = std::make_unique<Directory>(
+          std::max<std::size_t>(chunk_index + 1, std::max<std::size_t>(size * 2, 16)));
+      for (std::size_t index = 0; index < size; ++index) {
+        next->chunks[index].store(current->chunks[index].load(std::memory_order_relaxed),
+                                  std::memory_order_relaxed);
+      }
+      next->size.store(size, std::memory_order_relaxed);
+      publish_directory_locked(std::move(next));
+      current = writer_directory();
+    }
+    for (auto size = current->size.load(std::memory_order_relaxed); size <= chunk_index; ++size) {
+      chunks_.push_back(allocate_chunk());
+      current->chunks[size].store(chunks_.back().get(), std::memory_order_relaxed);
+      current->size.store(size + 1, std::memory_order_release);
+    }
+    return *current->chunks[chunk_index].load(std::memory_order_relaxed);
+  }
+
+  [[nodiscard]] auto copy_chunk(const Chunk &chunk) const -> std::unique_ptr<Chunk> {
+    auto copy = allocate_chunk();
+    std::memcpy(copy->vectors.get(), chunk.vectors.get(), kChunkRows * row_stride_);
+    for (std::uint64_t word = 0; word < kChunkWords; ++word) {
+      copy->live[word].store(chunk.live[word].load(std::memory_order_relaxed),
+                             std::memory_order_relaxed);
+    }
+    copy->written = chunk.written;
+    copy->sequences = chunk.sequences;
+    copy->inverse_norms = chunk.inverse_norms;
+    return copy;
+  }
+
+  // Fills the vector, sequence and norm of a slot no reader can reach yet.
+  void fill_row(Chunk &chunk,
+                std::uint64_t offset,
+                const OwnedVector &vector,
+                std::uint64_t sequence) const {
+    const auto stored = vector.view();
+    auto *destination = chunk.vectors.get() + offset * row_stride_;
+    std::memcpy(destination, stored.data, row_bytes_);
+    std::memset(destination + row_bytes_, 0, row_stride_ - row_bytes_);
+    chunk.sequences[offset] = sequence;
+    if (schema_.metric == core::Metric::cosine) {
+      chunk.inverse_norms[offset] = inverse_norm(destination);
+    }
+    chunk.written[offset / 64] |= std::uint64_t{1} << (offset % 64);
+  }
+
+  void write_row_locked(std::uint64_t row_id, const OwnedVector &vector, std::uint64_t sequence) {
+    auto &chunk = chunk_for_row_locked(row_id);
+    const auto offset = row_id % kChunkRows;
+    const auto word = offset / 64;
+    const auto bit = std::uint64_t{1} << (offset % 64);
+    if ((chunk.written[word] & bit) == 0) {
+      // A fresh slot is unreachable until its live bit is set.
+      fill_row(chunk, offset, vector, sequence);
+      if ((chunk.live[word].fetch_or(bit, std::memory_order_release) & bit) == 0) {
+        ++live_rows_;
+      }
+    } else {
+      // A written slot may be under a reader: the copy is complete, live bit
+      // included, before the release store makes it reachable.
+      auto copy = copy_chunk(chunk);
+      fill_row(*copy, offset, vector, sequence);
+      if ((copy->live[word].fetch_or(bit, std::memory_order_relaxed) & bit) == 0) {
+        ++live_rows_;
+      }
+      writer_directory()
+          ->chunks[static_cast<std::size_t>(row_id / kChunkRows)]
+          .store(copy.get(), std::memory_order_release);
+      chunks_.push_back(std::move(copy));
+    }
+    if (row_id >= published_rows_.load(std::memory_order_relaxed)) {
+      published_rows_.store(row_id + 1, std::memory_order_release);
+    }
+  }
+
+  void clear_row_locked(std::uint64_t row_id) {
+    const auto *current = writer_directory();
+    const auto chunk_index = static_cast<std::size_t>(row_id / kChunkRows);
+    if (current == nullptr || chunk_index >= current->size.load(std::memory_order_relaxed)) {
+      return;
+    }
+    const auto offset = row_id % kChunkRows;
+    const auto bit = std::uint64_t{1} << (offset % 64);
+    auto &live = current->chunks[chunk_index].load(std::memory_order_relaxed)->live[offset / 64];
+    if ((live.fetch_and(~bit, std::memory_order_release) & bit) != 0) {
+      --live_rows_;
+    }
+  }
+
+  [[nodiscard]] auto inverse_norm(const std::byte *row) const -> float {
+    if (schema_.scalar_type != core::ScalarType::float32) {
+      return 0.0F;
+    }
+    const auto *values = reinterpret_cast<const float *>(row);
+    double squared{};
+    for (std::uint32_t index = 0; index < schema_.dim; ++index) {
+      squared += static_cast<double>(values[index]) * static_cast<double>(values[index]);
+    }
+    return squared == 0 ? 0.0F : static_cast<float>(1.0 / std::sqrt(squared));
+  }
+
   template <class T>
-  [[nodiscard]] static auto distance_typed(const core::TypedTensorView &queries,
-                                           core::RowCount query_index,
-                                           const OwnedVector &stored,
+  [[nodiscard]] static auto distance_typed(const T *left,
+                                           const T *right,
+                                           std::uint32_t dim,
                                            core::Metric metric) -> float {
-    const auto *left = queries.row<T>(query_index);
-    const auto *right = stored.view().row<T>(0);
     double dot{};
     double left_norm{};
     double right_norm{};
     double l2{};
-    for (std::uint32_t index = 0; index < queries.dim; ++index) {
+    for (std::uint32_t index = 0; index < dim; ++index) {
       const auto lhs = static_cast<double>(left[index]);
       const auto rhs = static_cast<double>(right[index]);
       const auto difference = lhs - rhs;
@@ -320,18 +502,106 @@ class CanonicalFlatSegment {
     return static_cast<float>(-dot / std::sqrt(left_norm * right_norm));
   }
 
-  [[nodiscard]] auto distance(const core::TypedTensorView &queries,
-                              core::RowCount query_index,
-                              const OwnedVector &stored) const -> float {
-    switch (schema_.scalar_type) {
-      case core::ScalarType::float32:
-        return distance_typed<float>(queries, query_index, stored, schema_.metric);
-      case core::ScalarType::int8:
-        return distance_typed<std::int8_t>(queries, query_index, stored, schema_.metric);
-      case core::ScalarType::uint8:
-        return distance_typed<std::uint8_t>(queries, query_index, stored, schema_.metric);
-    }
-    return std::numeric_limits<float>::quiet_NaN();
+  [[nodiscard]] static auto ranks_before(const ScoredRow &left, const ScoredRow &right) noexcept
+      -> bool {
+    return left.score != right.score ? left.score < right.score : left.row_id < right.row_id;
+  }
+
+  // Visits every live row below `rows` and keeps the best `limit` in a
+  // bounded max-heap; `score` maps (chunk, offset-in-chunk) to a distance.
+  template <class Score>
+  static void scan_arena(const Directory &directory,
+                         std::uint64_t rows,
+                         std::uint64_t limit,
+                         const Score &score,
+                         std::vector<ScoredRow> &heap) {
+    heap.clear();
+    const auto chunk_count = std::min<std::uint64_t>(directory.size.load(std::memory_order_acquire),
+                                                     (rows + kChunkRows - 1) / kChunkRows);
+    for (std::uint64_t chunk_index = 0; chunk_index < chunk_count; ++chunk_index) {
+      const auto &chunk =
+          *directory.chunks[static_cast<std::size_t>(chunk_index)].load(std::memory_order_acquire);
+      const auto first_row = chunk_index * kChunkRows;
+      const auto chunk_rows = std::min(kChunkRows, rows - first_row);
+      for (std::uint64_t word = 0; word * 64 < chunk_rows; ++word) {
+        auto bits = chunk.live[word].load(std::memory_order_acquire);
+        if (chunk_rows - word * 64 < 64) {
+          bits &= (std::uint64_t{1} << (chunk_rows - word * 64)) - 1;
+        }
+        for (; bits != 0; bits &= bits - 1) {
+          const auto offset = word * 64 + static_cast<std::uint64_t>(std::countr_zero(bits));
+          const ScoredRow candidate{first_row + offset,
+                                    chunk.sequences[offset],
+                                    score(chunk, offset)};
+          if (heap.size() < limit) {
+            heap.push_back(candidate);
+            std::push_heap(heap.begin(), heap.end(), ranks_before);
+          } else if (ranks_before(candidate, heap.front())) {
+            std::pop_heap(heap.begin(), heap.end(), ranks_before);
+            heap.back() = candidate;
+            std::push_heap(heap.begin(), heap.end(), ranks_before);
+          }
+        }
+      }
+    }
+    std::sort_heap(heap.begin(), heap.end(), ranks_before);
+  }
+
+  void scan_query(const Directory &directory,
+                  std::uint64_t rows,
+                  const core::TypedTensorView &queries,
+                  core::RowCount query_index,
+                  std::uint64_t limit,
+                  std::vector<ScoredRow> &heap) const {
+    const auto dim = schema_.dim;
+    const auto metric = schema_.metric;
+    const auto stride = row_stride_;
+    if (schema_.scalar_type == core::ScalarType::float32) {
+      // Hoist SIMD dispatch out of the per-row loop. The ip kernel returns
+      // -dot, which is already the inner-product distance.
+      using KernelFn = float (*)(const float *__restrict, const float *__restrict, size_t);
+      const KernelFn kernel = metric == core::Metric::l2
+                                  ? static_cast<KernelFn>(simd::get_l2_sqr_func())
+                                  : static_cast<KernelFn>(simd::get_ip_sqr_func());
+      const auto *query = queries.row<float>(query_index);
+      const auto row = [&](const Chunk &chunk, std::uint64_t offset) {
+        return reinterpret_cast<const float *>(chunk.vectors.get() + offset * stride);
+      };
+      if (metric != core::Metric::cosine) {
+        const auto score = [&](const Chunk &chunk, std::uint64_t offset) {
+          return kernel(query, row(chunk, offset), dim);
+        };
+        scan_arena(directory, rows, limit, score, heap);
+        return;
+      }
+      double query_squared{};
+      for (std::uint32_t index = 0; index < dim; ++index) {
+        query_squared += static_cast<double>(query[index]) * static_cast<double>(query[index]);
+      }
+      const auto query_scale =
+          query_squared == 0 ? 0.0F : static_cast<float>(1.0 / std::sqrt(query_squared));
+      const auto score = [&](const Chunk &chunk, std::uint64_t offset) {
+        const auto row_scale = chunk.inverse_norms[offset];
+        if (query_scale == 0 || row_scale == 0) {
+          return 0.0F;
+        }
+        return kernel(query, row(chunk, offset), dim) * query_scale * row_scale;
+      };
+      scan_arena(directory, rows, limit, score, heap);
+      return;
+    }
+    const auto scan_typed = [&]<class T>(const T *query) {
+      const auto score = [&](const Chunk &chunk, std::uint64_t offset) {
+        const auto *row = reinterpret_cast<const T *>(chunk.vectors.get() + offset * stride);
+        return distance_typed<T>(query, row, dim, metric);
+      };
+      scan_arena(directory, rows, limit, score, heap);
+    };
+    if (schema_.scalar_type == core::ScalarType::int8) {
+      scan_typed(queries.row<std::int8_t>(query_index));
+    } else {
+      scan_typed(queries.row<std::uint8_t>(query_index));
+    }
   }
 
   [[nodiscard]] auto execute_search(const core::SearchRequest &request) const -> core::Status {
@@ -366,11 +636,10 @@ class CanonicalFlatSegment {
       return status;
     }
 
-    std::map<std::uint64_t, PublishedRow> rows;
-    {
-      std::lock_guard lock(mutex_);
-      rows = rows_;
-    }
+    // The row count is published after the directory that covers it, so
+    // acquiring the count first guarantees the directory is large enough.
+    const auto rows = published_rows_.load(std::memory_order_acquire);
+    const auto *directory = directory_.load(std::memory_order_acquire);
     auto &response = *request.response;
     response.query_count = request.queries.rows;
     response.score_kind = core::ScoreKind::distance;
@@ -378,24 +647,21 @@ class CanonicalFlatSegment {
     response.result_flags = core::ResultFlag::exact_reranked;
     response.offsets[0] = 0;
     core::RowCount cursor{};
+    std::vector<ScoredRow> heap;
+    heap.reserve(static_cast<std::size_t>(std::min<std::uint64_t>(request.options.top_k, rows)));
     for (core::RowCount query_index = 0; query_index < request.queries.rows; ++query_index) {
-      std::vector<ScoredRow> scored;
-      scored.reserve(rows.size());
-      for (const auto &[row_id, row] : rows) {
-        scored.push_back(
-            {row_id, row.sequence, distance(request.queries, query_index, row.vector)});
+      heap.clear();
+      if (directory != nullptr && request.options.top_k != 0) {
+        scan_query(*directory, rows, request.queries, query_index, request.options.top_k, heap);
       }
-      std::sort(scored.begin(), scored.end(), [](const ScoredRow &left, const ScoredRow &right) {
-        return left.score != right.score ? left.score < right.score : left.row_id < right.row_id;
-      });
-      const auto count = std::min<std::uint64_t>(scored.size(), request.options.top_k);
-      for (std::uint64_t index = 0; index < count; ++index) {
-        auto hit = core::SearchHit(core::SegmentRowId(scored[index].row_id),
-                                   scored[index].score,
+      const auto count = static_cast<std::uint64_t>(heap.size());
+      for (const auto &scored : heap) {
+        auto hit = core::SearchHit(core::SegmentRowId(scored.row_id),
+                                   scored.score,
                                    core::ScoreKind::distance,
                                    schema_.metric,
                                    core::ResultFlag::exact_reranked);
-        hit.row_version = scored[index].sequence;
+        hit.row_version = scored.sequence;
         response.hits[static_cast<std::size_t>(cursor++)] = hit;
       }
       const auto response_index = static_cast<std::size_t>(query_index);
@@ -412,8 +678,14 @@ class CanonicalFlatSegment {
   CollectionSchema schema_{};
   std::uint64_t segment_id_{};
   std::uint64_t generation_{};
+  std::size_t row_bytes_{};
+  std::size_t row_stride_{};
   mutable std::mutex mutex_{};
-  std::map<std::uint64_t, PublishedRow> rows_{};
+  std::vector<std::unique_ptr<Chunk>> chunks_{};
+  std::vector<std::unique_ptr<Directory>> directories_{};
+  std::atomic<const Directory *> directory_{};
+  std::atomic<std::uint64_t> published_rows_{};
+  std::uint64_t live_rows_{};
   std::map<std::uint64_t, Transaction> transactions_{};
   std::set<std::uint64_t> applied_ops_{};
   std::uint64_t applied_watermark_{};
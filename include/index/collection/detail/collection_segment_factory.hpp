@@ -16,7 +16,8 @@ class CollectionSegmentFactory {
   [[nodiscard]] static auto open_entry(const std::filesystem::path &collection_root,
                                        const SegmentEntryV2 &entry,
                                        const CollectionSchema &schema,
-                                       core::OpenContext &context)
+                                       core::OpenContext &context,
+                                       const ManifestReaderOptions &reader_options = {})
       -> core::Result<core::AnySegment> {
     const auto *registration = find_collection_target_registration(entry.factory_key);
     if (registration == nullptr) {
@@ -32,7 +33,7 @@ class CollectionSegmentFactory {
                                  core::StatusDetail::malformed_struct,
                                  "Collection segment factory key disagrees with algorithm_id");
     }
-    return registration->open(collection_root, entry, schema, context);
+    return registration->open(collection_root, entry, schema, context, reader_options);
   }
 };
 
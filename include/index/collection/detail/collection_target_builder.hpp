@@ -11,8 +11,8 @@
 #include <cstdint>
 #include <cstdlib>
 #include <filesystem>
-#include <fstream>
 #include <limits>
+#include <map>
 #include <memory>
 #include <numeric>
 #include <optional>
@@ -27,15 +27,17 @@
 #include "index/collection/artifact_transaction.hpp"
 #include "index/collection/detail/collection_flat_target.hpp"
 #include "index/collection/detail/collection_normalized_segment.hpp"
+#include "index/collection/manifest_dual_reader.hpp"
 #include "index/disk/laser_segment.hpp"
 #include "index/disk/laser_segment_importer.hpp"
+#include "index/disk/laser_segment_relayout.hpp"
+#include "index/disk/laser_segment_topology.hpp"
 #include "index/graph/seal_topology/qg_builder.hpp"
 #include "platform/fs.hpp"
 
 #if defined(ALAYA_ENABLE_LASER) && ALAYA_ENABLE_LASER != 0
   #include "index/graph/laser/qg/qg_builder.hpp"
   #include "index/graph/vamana/vamana_builder.hpp"
-  #include "index/graph/vamana/vamana_writer.hpp"
 #endif
 
 namespace alaya {
@@ -63,6 +65,14 @@ struct CollectionTargetPublication {
   std::optional<ArtifactManifestV2> base_manifest{};
 };
 
+// A sealed LASER segment whose graph a rebuild may start from instead of
+// linking every row again. rows[i] is built live row i's row id in that
+// segment, or ::alaya::kNoPredecessorRow.
+struct CollectionTopologySeed {
+  std::filesystem::path segment_dir{};
+  std::vector<std::uint32_t> rows{};
+};
+
 struct CollectionTargetBuildParams {
   CollectionQuantization quantization{};
   std::uint32_t max_neighbors{32};
@@ -70,6 +80,8 @@ struct CollectionTargetBuildParams {
   std::uint32_t thread_count{1};
   float alpha{1.2F};
   std::uint64_t seed{1234};
+  // Optional, not owned; targets without an incremental path ignore it.
+  const CollectionTopologySeed *topology_seed{};
 };
 
 struct CollectionTargetBuildResult {
@@ -80,6 +92,9 @@ struct CollectionTargetBuildResult {
   std::string factory_key{};
   std::uint64_t artifact_bytes{};
   std::uint32_t effective_ef_construction{};
+  // Rows whose edges were carried over from CollectionTargetBuildParams::
+  // topology_seed rather than linked from scratch.
+  core::RowCount reused_topology_rows{};
   bool flat_fallback{};
   std::string fallback_reason{};
 };
@@ -99,7 +114,8 @@ using BuildTargetFn =
 using OpenTargetFn = core::Result<core::AnySegment> (*)(const std::filesystem::path &,
                                                         const SegmentEntryV2 &,
                                                         const CollectionSchema &,
-                                                        core::OpenContext &);
+                                                        core::OpenContext &,
+                                                        const ManifestReaderOptions &);
 
 struct CollectionTargetRegistration {
   core::AlgorithmId algorithm_id{};
@@ -147,22 +163,38 @@ struct CollectionTargetRegistration {
     const CollectionTargetPublication &publication,
     core::BuildContext &context) -> core::Result<CollectionTargetBuildResult>;
 
+// Rewrites the sealed LASER segment at `source_dir` with the page layout and
+// static cache chosen from `sketch` (relayout_laser_segment) as the segment
+// named by `publication`, then publishes it like a freshly built target. Row
+// ids and labels are unchanged, so the replacement maps every source row to
+// itself.
+[[nodiscard]] inline auto relayout_laser_collection_target(
+    core::AlgorithmId exposed_algorithm,
+    const CollectionSchema &schema,
+    const std::filesystem::path &source_dir,
+    const ::alaya::laser::VisitSketch &sketch,
+    const CollectionTargetPublication &publication,
+    core::BuildContext &context) -> core::Result<CollectionTargetBuildResult>;
+
 [[nodiscard]] inline auto open_flat_collection_target(const std::filesystem::path &root,
                                                       const SegmentEntryV2 &entry,
                                                       const CollectionSchema &schema,
-                                                      core::OpenContext &context)
+                                                      core::OpenContext &context,
+                                                      const ManifestReaderOptions &reader_options)
     -> core::Result<core::AnySegment>;
 
 [[nodiscard]] inline auto open_qg_collection_target(const std::filesystem::path &root,
                                                     const SegmentEntryV2 &entry,
                                                     const CollectionSchema &schema,
-                                                    core::OpenContext &context)
+                                                    core::OpenContext &context,
+                                                    const ManifestReaderOptions &reader_options)
     -> core::Result<core::AnySegment>;
 
 [[nodiscard]] inline auto open_laser_collection_target(const std::filesystem::path &root,
                                                        const SegmentEntryV2 &entry,
                                                        const CollectionSchema &schema,
-                                                       core::OpenContext &context)
+                                                       core::OpenContext &context,
+                                                       const ManifestReaderOptions &reader_options)
     -> core::Result<core::AnySegment>;
 
 inline constexpr std::array<CollectionTargetRegistration, 3> kCollectionTargetRegistrations{
@@ -385,35 +417,6 @@ namespace laser_target_detail {
   return core::Status::success();
 }
 
-// Streams `vectors` (row-major, `row_count * dim` floats) to
-// "{prefix}_pca_base.fbin" in the two-int32-header layout
-// QGBuilder::build() requires as input (see qg_builder.hpp's doc comment on
-// build(): "The input vector file must be at path:
-// {filename}_pca_base.fbin"). "pca_base" is QGBuilder's historical name for
-// this slot; the Collection target builder runs no actual PCA step here, it
-// just supplies the schema's raw float32 vectors directly (residual_dim=0,
-// since the QuantizedGraph below is constructed with main_dim == dim).
-inline auto write_pca_base_fbin(const std::string &prefix,
-                                std::span<const float> vectors,
-                                std::uint32_t row_count,
-                                std::uint32_t dim) -> void {
-  std::ofstream out(prefix + "_pca_base.fbin", std::ios::binary | std::ios::trunc);
-  if (!out) {
-    throw std::runtime_error("Collection LASER target: cannot open pca_base scratch file: " +
-                             prefix);
-  }
-  const auto n = static_cast<std::int32_t>(row_count);
-  const auto d = static_cast<std::int32_t>(dim);
-  out.write(reinterpret_cast<const char *>(&n), sizeof(n));
-  out.write(reinterpret_cast<const char *>(&d), sizeof(d));
-  out.write(reinterpret_cast<const char *>(vectors.data()),
-            static_cast<std::streamsize>(vectors.size() * sizeof(float)));
-  if (!out) {
-    throw std::runtime_error("Collection LASER target: failed writing pca_base scratch file: " +
-                             prefix);
-  }
-}
-
 [[nodiscard]] inline auto build_memqg_topology(std::span<const float> vectors,
                                                std::uint32_t count,
                                                std::uint32_t dim,
@@ -445,12 +448,47 @@ inline auto write_pca_base_fbin(const std::string &prefix,
   return ::alaya::FrozenGraphSnapshot(std::move(adjacency), source.entry_point(), max_degree);
 }
 
-// RAII scratch directory for the raw native LASER files (Vamana graph +
-// QGBuilder's out-of-core .index/_rotator/_cache_ids/_cache_nodes output --
-// the LASER packer remains file-oriented, see QGBuilder::build_from_graph()'s
-// doc comment) before LaserSegmentImporter copies/links the pieces it wants
-// into the final Collection-owned segment directory. Removed on scope exit
-// regardless of success or failure -- only the importer's copies survive.
+// Starts the L2 topology from `seed`'s segment when at least half of the
+// rows are carried over; below that a fresh build gives the better graph for
+// about the same cost. Every row is still in memory, so a predecessor that
+// cannot be read only loses the shortcut and the caller builds from scratch.
+[[nodiscard]] inline auto extend_seed_topology(const CollectionTopologySeed &seed,
+                                               std::span<const float> vectors,
+                                               std::uint32_t count,
+                                               std::uint32_t dim,
+                                               const ::alaya::vamana::VamanaBuildParams &params,
+                                               core::RowCount &carried)
+    -> std::optional<::alaya::FrozenGraphSnapshot> {
+  if (seed.rows.size() != count) {
+    return std::nullopt;
+  }
+  carried = static_cast<core::RowCount>(
+      std::ranges::count_if(seed.rows, [](std::uint32_t row) {
+        return row != ::alaya::kNoPredecessorRow;
+      }));
+  if (carried * 2 < count) {
+    carried = 0;
+    return std::nullopt;
+  }
+  try {
+    const auto predecessor = ::alaya::disk::load_laser_segment_topology(seed.segment_dir);
+    if (predecessor.max_degree() == params.R) {
+      auto extended =
+          ::alaya::extend_vamana_snapshot(predecessor, seed.rows, vectors.data(), dim, params);
+      if (extended.has_value()) {
+        return extended;
+      }
+    }
+  } catch (const std::exception &) {
+  }
+  carried = 0;
+  return std::nullopt;
+}
+
+// RAII staging directory for the native LASER files, created beside the
+// final segment under "<collection_root>/segments/" so the importer can
+// rename them into place instead of copying. Removed on scope exit
+// regardless of success or failure -- only what the importer moved survives.
 struct ScratchDir {
   std::filesystem::path path;
   explicit ScratchDir(std::filesystem::path scratch_path) : path(std::move(scratch_path)) {
@@ -497,18 +535,83 @@ struct ScratchDir {
   return translated;
 }
 
+#if defined(ALAYA_ENABLE_LASER) && ALAYA_ENABLE_LASER != 0
+// Shared tail of every LASER target producer: opens the segment already
+// imported at `seg_dir` ("<collection_root>/segments/<segment_id>"), mints its
+// manifest-v2 entry through publish_reference() and erases it to AnySegment
+// under the exposed algorithm id. Throws what LaserSegment throws; callers
+// translate exceptions.
+[[nodiscard]] inline auto publish_laser_collection_target(
+    core::AlgorithmId exposed_algorithm,
+    const CollectionSchema &schema,
+    const std::filesystem::path &seg_dir,
+    const CollectionTargetPublication &publication,
+    core::BuildContext &context) -> core::Result<CollectionTargetBuildResult> {
+  core::OpenContext open_context;
+  open_context.deadline = context.deadline;
+  open_context.cancellation = context.cancellation;
+  auto opened =
+      ::alaya::disk::LaserSegment::open_directory(seg_dir, core::OpenOptions{}, open_context);
+  if (!opened.ok()) {
+    return opened.status();
+  }
+  auto laser_segment = std::move(opened).value();
+
+  core::SegmentStats stats{};
+  auto stats_status = laser_segment->stats(stats);
+  if (!stats_status.ok()) {
+    return stats_status;
+  }
+
+  const auto reference = exposed_algorithm == core::algorithm::qg
+                             ? laser_publication_from_collection(publication,
+                                                                 core::algorithm::qg,
+                                                                 "qg",
+                                                                 kQgLaserImplementationKey,
+                                                                 /*numeric_score_comparable=*/true)
+                             : laser_publication_from_collection(publication);
+  auto publish_status = laser_segment->publish_reference(reference, context);
+  if (!publish_status.ok()) {
+    return publish_status;
+  }
+
+  auto erased_result =
+      ::alaya::disk::LaserSegment::into_any(std::move(laser_segment), exposed_algorithm);
+  if (!erased_result.ok()) {
+    return erased_result.status();
+  }
+  auto erased = std::move(erased_result).value();
+  if (schema.metric == core::Metric::cosine) {
+    auto normalized = make_l2_normalized_query_segment(std::move(erased));
+    if (!normalized.ok()) {
+      return normalized.status();
+    }
+    erased = std::move(normalized).value();
+  }
+
+  const auto *registration = find_collection_target_registration(exposed_algorithm);
+  CollectionTargetBuildResult result;
+  result.segment = std::move(erased);
+  result.requested_algorithm = exposed_algorithm;
+  result.built_algorithm = exposed_algorithm;
+  result.implementation_key = registration->implementation_key;
+  result.factory_key = registration->factory_key;
+  result.artifact_bytes = stats.resident_bytes;
+  return result;
+}
+#endif
+
 // Builds a native on-disk LASER segment from this Collection's currently
 // live rows and registers it into the Collection's manifest-v2 control
 // plane. The memory-QG builder remains only as the topology producer for the
 // IP/cosine bridge; both public qg and direct LASER targets arrive here.
-// LASER's on-disk packer (VamanaBuilder ->
-// QGBuilder -> LaserSegmentImporter) is inherently file-oriented, so this
-// function's shape is: harvest vectors -> build raw native files in a scratch
-// dir -> import them into
-// "<collection_root>/segments/<segment_id>" (the exact directory
-// LaserSegment::publish_reference() requires its open handle to already sit
-// at) -> open that directory -> publish_reference() to mint the manifest-v2
-// SegmentEntryV2 -> erase to AnySegment.
+// The topology and vectors go from memory straight into
+// QGBuilder::build_in_memory(), which writes the native files once into a
+// staging dir on the Collection's own filesystem; LaserSegmentImporter then
+// renames them into "<collection_root>/segments/<segment_id>" (the exact
+// directory LaserSegment::publish_reference() requires its open handle to
+// already sit at) -> open that directory -> publish_reference() to mint the
+// manifest-v2 SegmentEntryV2 -> erase to AnySegment.
 [[nodiscard]] inline auto build_laser_collection_target_impl(
     core::AlgorithmId exposed_algorithm,
     const CollectionSchema &schema,
@@ -538,10 +641,11 @@ struct ScratchDir {
                                "Collection LASER builder received an invalid exposed algorithm id");
   }
   const bool qg_same_id_swap = exposed_algorithm == core::algorithm::qg;
-  // L2 keeps the established Vamana topology path byte-for-byte. IP/cosine
-  // build a metric-aware memory-QG topology below and pass its frozen snapshot
-  // to the same LASER packer; a future rotate optimization can still thread a
-  // predecessor snapshot here to avoid rebuilding either topology.
+  // L2 keeps the established Vamana topology path byte-for-byte, or extends
+  // a predecessor segment's graph when params.topology_seed offers one.
+  // IP/cosine build a metric-aware memory-QG topology below and pass its
+  // frozen snapshot to the same LASER packer; memqg has no incremental path,
+  // so they always rebuild.
 
   auto harvested = harvest_memory_graph_vectors<float>(schema, rows, "LASER");
   if (!harvested.ok()) {
@@ -563,15 +667,20 @@ struct ScratchDir {
   }
 
   try {
+    const auto seg_dir = publication.collection_root / "segments" / publication.segment_id;
+    // LaserSegmentImporter::import_from() requires seg_dir's parent to
+    // already exist (it deliberately does not create ancestor directories,
+    // only its own atomic tmp-dir + rename at that level). This can be the
+    // first sealed build for a fresh Collection root, so "segments/" may not
+    // exist yet.
+    std::filesystem::create_directories(seg_dir.parent_path());
     const auto tick = std::chrono::steady_clock::now().time_since_epoch().count();
-    laser_target_detail::ScratchDir raw_dir(std::filesystem::temp_directory_path() /
-                                            ("alayalite-laser-collection-build-" +
-                                             std::to_string(::alaya::platform::get_pid()) + "-" +
-                                             std::to_string(tick) + "-" + publication.segment_id));
+    laser_target_detail::ScratchDir raw_dir(
+        seg_dir.parent_path() / (".build_" + publication.segment_id + "_" +
+                                 std::to_string(::alaya::platform::get_pid()) + "_" +
+                                 std::to_string(tick)));
     const std::string raw_prefix = (raw_dir.path / ("dsqg_" + publication.segment_id)).string();
 
-    laser_target_detail::write_pca_base_fbin(raw_prefix, vectors, count, schema.dim);
-
     alaya::vamana::VamanaBuildParams vamana_params;
     // Vamana is native L2 and honors the requested R. IP/cosine temporarily
     // source topology from memqg, whose physical degree is fixed at 32, so
@@ -584,16 +693,22 @@ struct ScratchDir {
     vamana_params.alpha = params.alpha;
     vamana_params.num_threads = params.thread_count;
     vamana_params.seed = params.seed;
-    const std::string vamana_path = raw_prefix + "_vamana.index";
     std::optional<::alaya::FrozenGraphSnapshot> metric_topology;
-    if (schema.metric == core::Metric::l2) {
+    core::RowCount reused_topology_rows{};
+    if (schema.metric == core::Metric::l2 && params.topology_seed != nullptr) {
+      metric_topology = laser_target_detail::extend_seed_topology(*params.topology_seed,
+                                                                  vectors,
+                                                                  count,
+                                                                  schema.dim,
+                                                                  vamana_params,
+                                                                  reused_topology_rows);
+    }
+    if (!metric_topology.has_value() && schema.metric == core::Metric::l2) {
       alaya::vamana::VamanaBuilder vamana_builder(vectors.data(), count, schema.dim, vamana_params);
       vamana_builder.build();
-      alaya::vamana::save_graph(vamana_builder.graph(),
-                                vamana_path,
-                                vamana_params.R,
-                                vamana_builder.medoid());
-    } else {
+      metric_topology.emplace(
+          ::alaya::FrozenGraphSnapshot::from_vamana(std::move(vamana_builder)));
+    } else if (!metric_topology.has_value()) {
       // VamanaBuilder is intentionally L2-only. Reuse the existing memqg
       // metric-aware topology and hand its finalized graph to the LASER
       // packer instead of feeding negative-IP distances into L2 pruning.
@@ -618,11 +733,15 @@ struct ScratchDir {
     alaya::laser::QGBuilder qg_builder(quantized_graph,
                                        /*ef_build=*/params.ef_construction,
                                        /*num_threads=*/params.thread_count);
-    if (metric_topology.has_value()) {
-      qg_builder.build_from_graph(*metric_topology, raw_prefix.c_str());
-    } else {
-      qg_builder.build(vamana_path.c_str(), raw_prefix.c_str());
-    }
+    // Hash each native file as the builder writes it, so publishing the
+    // segment's manifest does not read the renamed artifacts back.
+    std::map<std::string, ::alaya::internal::collection::Sha256> artifact_hashers;
+    qg_builder.set_file_bytes_observer(
+        [&artifact_hashers](const std::string &path, const char *bytes, size_t len) {
+          artifact_hashers[std::filesystem::path(path).filename().string()].update(
+              std::span(reinterpret_cast<const std::byte *>(bytes), len));
+        });
+    qg_builder.build_in_memory(*metric_topology, vectors.data(), raw_prefix.c_str());
 
     // Post-seal row IDs are already dense 0..N-1 in vector order
     // (harvest_memory_graph_vectors() verified this above), and that dense
@@ -654,67 +773,22 @@ struct ScratchDir {
       }
     }
 
+    // The staged files already sit on the segment's filesystem and were
+    // synced when written, and raw_dir is discarded afterwards: rename them
+    // into place rather than copying.
+    import_params.move_files = true;
+    for (auto &[name, hasher] : artifact_hashers) {
+      import_params.source_digests.emplace(name, hasher.finalize());
+    }
     ::alaya::disk::LaserSegmentImporter importer(schema.dim, schema.metric, import_params);
-    const auto seg_dir = publication.collection_root / "segments" / publication.segment_id;
-    // LaserSegmentImporter::import_from() requires seg_dir's parent to
-    // already exist (it deliberately does not create ancestor directories,
-    // only its own atomic tmp-dir + rename at that level). This can be the
-    // first sealed build for a fresh Collection root, so "segments/" may not
-    // exist yet.
-    std::filesystem::create_directories(seg_dir.parent_path());
     (void)importer.import_from(raw_dir.path, labels.data(), labels.size(), seg_dir);
 
-    core::OpenContext open_context;
-    open_context.deadline = context.deadline;
-    open_context.cancellation = context.cancellation;
-    auto opened =
-        ::alaya::disk::LaserSegment::open_directory(seg_dir, core::OpenOptions{}, open_context);
-    if (!opened.ok()) {
-      return opened.status();
-    }
-    auto laser_segment = std::move(opened).value();
-
-    core::SegmentStats stats{};
-    auto stats_status = laser_segment->stats(stats);
-    if (!stats_status.ok()) {
-      return stats_status;
-    }
-
-    const auto reference =
-        qg_same_id_swap ? laser_publication_from_collection(publication,
-                                                            core::algorithm::qg,
-                                                            "qg",
-                                                            kQgLaserImplementationKey,
-                                                            /*numeric_score_comparable=*/true)
-                        : laser_publication_from_collection(publication);
-    auto publish_status = laser_segment->publish_reference(reference, context);
-    if (!publish_status.ok()) {
-      return publish_status;
-    }
-
-    auto erased_result =
-        ::alaya::disk::LaserSegment::into_any(std::move(laser_segment), exposed_algorithm);
-    if (!erased_result.ok()) {
-      return erased_result.status();
+    auto result =
+        publish_laser_collection_target(exposed_algorithm, schema, seg_dir, publication, context);
+    if (result.ok()) {
+      result.value().effective_ef_construction = params.ef_construction;
+      result.value().reused_topology_rows = reused_topology_rows;
     }
-    auto erased = std::move(erased_result).value();
-    if (schema.metric == core::Metric::cosine) {
-      auto normalized = make_l2_normalized_query_segment(std::move(erased));
-      if (!normalized.ok()) {
-        return normalized.status();
-      }
-      erased = std::move(normalized).value();
-    }
-
-    const auto *registration = find_collection_target_registration(exposed_algorithm);
-    CollectionTargetBuildResult result;
-    result.segment = std::move(erased);
-    result.requested_algorithm = exposed_algorithm;
-    result.built_algorithm = exposed_algorithm;
-    result.implementation_key = registration->implementation_key;
-    result.factory_key = registration->factory_key;
-    result.artifact_bytes = stats.resident_bytes;
-    result.effective_ef_construction = params.ef_construction;
     return result;
   } catch (...) {
     return core::status_from_exception(core::OperationStage::build);
@@ -750,11 +824,47 @@ struct ScratchDir {
                                             context);
 }
 
+[[nodiscard]] inline auto relayout_laser_collection_target(
+    core::AlgorithmId exposed_algorithm,
+    const CollectionSchema &schema,
+    const std::filesystem::path &source_dir,
+    const ::alaya::laser::VisitSketch &sketch,
+    const CollectionTargetPublication &publication,
+    core::BuildContext &context) -> core::Result<CollectionTargetBuildResult> {
+#if !(defined(ALAYA_ENABLE_LASER) && ALAYA_ENABLE_LASER != 0)
+  (void)exposed_algorithm;
+  (void)schema;
+  (void)source_dir;
+  (void)sketch;
+  (void)publication;
+  (void)context;
+  return core::Status::error(core::StatusCode::not_supported,
+                             core::OperationStage::build,
+                             core::StatusDetail::operation_slot_absent,
+                             "Collection LASER relayout requires ALAYA_ENABLE_LASER");
+#else
+  try {
+    const auto seg_dir = publication.collection_root / "segments" / publication.segment_id;
+    (void)::alaya::disk::relayout_laser_segment(source_dir, sketch, seg_dir);
+    return publish_laser_collection_target(exposed_algorithm,
+                                           schema,
+                                           seg_dir,
+                                           publication,
+                                           context);
+  } catch (...) {
+    return core::status_from_exception(core::OperationStage::build);
+  }
+#endif
+}
+
 [[nodiscard]] inline auto open_flat_collection_target(const std::filesystem::path &root,
                                                       const SegmentEntryV2 &entry,
                                                       const CollectionSchema &schema,
-                                                      core::OpenContext &context)
+                                                      core::OpenContext &context,
+                                                      const ManifestReaderOptions &reader_options)
     -> core::Result<core::AnySegment> {
+  // The Flat entry opens its native artifacts directly; no manifest read.
+  (void)reader_options;
   return open_collection_flat_entry(root, entry, schema.scalar_type, context);
 }
 
@@ -767,12 +877,14 @@ struct ScratchDir {
 // the *collection*-level manifest-v2 entry (not a second manifest.txt read
 // off some cached path), matching how open_qg_collection_target() above
 // always re-resolves from `entry` too.
-[[nodiscard]] inline auto open_laser_collection_target_impl(core::AlgorithmId exposed_algorithm,
-                                                            std::string_view required_feature,
-                                                            const std::filesystem::path &root,
-                                                            const SegmentEntryV2 &entry,
-                                                            const CollectionSchema &schema,
-                                                            core::OpenContext &context)
+[[nodiscard]] inline auto open_laser_collection_target_impl(
+    core::AlgorithmId exposed_algorithm,
+    std::string_view required_feature,
+    const std::filesystem::path &root,
+    const SegmentEntryV2 &entry,
+    const CollectionSchema &schema,
+    core::OpenContext &context,
+    const ManifestReaderOptions &reader_options)
     -> core::Result<core::AnySegment> {
   const auto feature =
       std::ranges::find(entry.reader_compatibility.required_features, required_feature);
@@ -792,7 +904,7 @@ struct ScratchDir {
                                                              entry.segment_id,
                                                              core::OpenOptions{},
                                                              context,
-                                                             {},
+                                                             reader_options,
                                                              exposed_algorithm);
   if (!opened.ok()) {
     return opened.status();
@@ -826,20 +938,23 @@ struct ScratchDir {
 [[nodiscard]] inline auto open_laser_collection_target(const std::filesystem::path &root,
                                                        const SegmentEntryV2 &entry,
                                                        const CollectionSchema &schema,
-                                                       core::OpenContext &context)
+                                                       core::OpenContext &context,
+                                                       const ManifestReaderOptions &reader_options)
     -> core::Result<core::AnySegment> {
   return open_laser_collection_target_impl(core::algorithm::laser,
                                            "disk_laser_segment",
                                            root,
                                            entry,
                                            schema,
-                                           context);
+                                           context,
+                                           reader_options);
 }
 
 [[nodiscard]] inline auto open_qg_collection_target(const std::filesystem::path &root,
                                                     const SegmentEntryV2 &entry,
                                                     const CollectionSchema &schema,
-                                                    core::OpenContext &context)
+                                                    core::OpenContext &context,
+                                                    const ManifestReaderOptions &reader_options)
     -> core::Result<core::AnySegment> {
   const auto has_feature = [&](std::string_view feature) {
     return std::ranges::find(entry.reader_compatibility.required_features, feature) !=
@@ -851,7 +966,8 @@ struct ScratchDir {
                                              root,
                                              entry,
                                              schema,
-                                             context);
+                                             context,
+                                             reader_options);
   }
   if (has_feature("qg_segment")) {
     return core::Status::error(core::StatusCode::not_supported,
@@ -34,6 +34,12 @@ enum class CollectionControlOperation : std::uint8_t {
   idle = 0,
   seal = 1,
   compact = 2,
+  // Same rows, new physical layout (Collection::relayout); sources are
+  // reclaimed like compaction inputs.
+  relayout = 3,
+  // A seal whose sources also include every sealed segment
+  // (Collection::rebuild); recovers like seal.
+  rebuild = 4,
 };
 
 enum class CollectionControlPhase : std::uint8_t {
@@ -278,7 +284,7 @@ class CollectionControlStore {
       if (state.format_version != 1 || state.active_segment_id == 0 ||
           state.active_generation == 0 || state.next_segment_id == 0 || source_count > 4096 ||
           static_cast<std::uint8_t>(state.operation) >
-              static_cast<std::uint8_t>(CollectionControlOperation::compact) ||
+              static_cast<std::uint8_t>(CollectionControlOperation::rebuild) ||
           static_cast<std::uint8_t>(state.phase) >
               static_cast<std::uint8_t>(CollectionControlPhase::manifest_published)) {
         throw std::invalid_argument("Gate-10 control state identity or range is invalid");
@@ -5,12 +5,13 @@
 #pragma once
 
 #include <algorithm>
-#include <array>
+#include <condition_variable>
 #include <cstddef>
 #include <cstdint>
 #include <cstring>
 #include <filesystem>
 #include <fstream>
+#include <functional>
 #include <limits>
 #include <memory>
 #include <mutex>
@@ -24,7 +25,9 @@
 
 #include "core/status.hpp"
 #include "platform/fs.hpp"
+#include "wal/append_file.hpp"
 #include "wal/frame.hpp"
+#include "wal/frame_stream.hpp"
 
 namespace alaya::internal::collection {
 
@@ -63,6 +66,20 @@ struct LogicalWalScan {
   bool stopped_at_corrupt_or_torn_tail{};
 };
 
+// A verified frame as CollectionLogicalWal::open() streams it to its replay
+// callback. `payload` is only valid for the duration of the call.
+struct LogicalWalFrameView {
+  LogicalWalRecordType type{LogicalWalRecordType::prepare};
+  std::uint8_t flags{};
+  std::uint64_t op_id{};
+  std::uint64_t batch_id{};
+  std::span<const std::byte> payload{};
+  std::uint64_t offset{};
+  std::uint64_t size{};
+};
+
+using LogicalWalReplay = std::function<core::Status(const LogicalWalFrameView &)>;
+
 namespace logical_wal_detail {
 
 // Physical WAL v1 framing now lives in the bottom-layer `wal/` module
@@ -129,14 +146,23 @@ class CollectionLogicalWal {
 
   ~CollectionLogicalWal() {
     std::lock_guard lock(mutex_);
-    if (stream_.is_open()) {
-      stream_.close();
+    try {
+      flush_buffer();
+    } catch (...) {
+      // Buffered frames carry no durability promise; losing them is allowed.
     }
   }
 
+  // Streams the verified prefix of the WAL through `replay` in file order,
+  // then truncates a torn tail and opens the file for appends. Frames are
+  // read ahead and CRC-checked off this thread but never retained, so the
+  // memory open() needs does not grow with the WAL. A failed `replay`, or a
+  // frame type outside this family, fails the open before the file is
+  // touched.
   [[nodiscard]] static auto open(const std::filesystem::path &root,
                                  std::string_view namespace_name = kCollectionWalNamespace,
-                                 bool read_only = false)
+                                 bool read_only = false,
+                                 const LogicalWalReplay &replay = {})
       -> core::Result<std::unique_ptr<CollectionLogicalWal>> {
     if (root.empty() || namespace_name != kCollectionWalNamespace) {
       return core::Status::error(core::StatusCode::invalid_argument,
@@ -146,8 +172,7 @@ class CollectionLogicalWal {
     }
     try {
       auto wal = std::unique_ptr<CollectionLogicalWal>(
-          new CollectionLogicalWal(root / ".alaya_internal" / std::string(kCollectionWalNamespace),
-                                   read_only));
+          new CollectionLogicalWal(directory_for(root), read_only));
       if (read_only && (!std::filesystem::is_directory(wal->directory_) ||
                         !std::filesystem::is_regular_file(wal->path_))) {
         return readonly_status(
@@ -165,11 +190,11 @@ class CollectionLogicalWal {
         create.close();
         platform::sync_directory_or_throw(wal->directory_);
       }
-      auto scanned = scan_file(wal->path_);
-      if (!scanned.ok()) {
-        return scanned.status();
+      auto streamed = stream_file(wal->path_, replay);
+      if (!streamed.ok()) {
+        return streamed.status();
       }
-      wal->recovery_scan_ = std::move(scanned).value();
+      wal->recovery_scan_ = std::move(streamed).value();
       if (wal->recovery_scan_.stopped_at_corrupt_or_torn_tail) {
         if (read_only) {
           return readonly_status(
@@ -180,7 +205,7 @@ class CollectionLogicalWal {
         platform::sync_file_or_throw(wal->path_);
       }
       if (!read_only) {
-        wal->open_stream();
+        wal->open_file();
       }
       return wal;
     } catch (const std::exception &error) {
@@ -190,6 +215,12 @@ class CollectionLogicalWal {
     }
   }
 
+  // Where open() keeps the WAL and its checkpoints under `root`.
+  [[nodiscard]] static auto directory_for(const std::filesystem::path &root)
+      -> std::filesystem::path {
+    return root / ".alaya_internal" / std::string(kCollectionWalNamespace);
+  }
+
   [[nodiscard]] auto append(LogicalWalRecordType type,
                             std::uint8_t flags,
                             std::uint64_t op_id,
@@ -202,21 +233,40 @@ class CollectionLogicalWal {
     try {
       const auto frame = logical_wal_detail::make_frame(type, flags, op_id, batch_id, payload);
       std::lock_guard lock(mutex_);
-      stream_.write(reinterpret_cast<const char *>(frame.data()),
-                    static_cast<std::streamsize>(frame.size()));
-      if (!stream_) {
-        return logical_wal_detail::io_error(core::OperationStage::mutation_prepare,
-                                            "cannot append collection logical WAL frame");
+      if (buffer_.size() + frame.size() > kWriteBufferBytes) {
+        flush_buffer();
       }
+      const auto buffered = buffer_.size();
+      buffer_.insert(buffer_.end(), frame.begin(), frame.end());
+      appended_position_ += frame.size();
       if (sync != LogicalWalSync::buffered) {
-        stream_.flush();
-        if (!stream_) {
-          return logical_wal_detail::io_error(core::OperationStage::mutation_prepare,
-                                              "cannot flush collection logical WAL frame");
+        const auto start = file_->end();
+        try {
+          flush_buffer();
+        } catch (...) {
+          // The caller aborts on this error, so the frame must not reach the
+          // log with a later flush. Frames buffered before it stay queued.
+          buffer_.resize(buffered);
+          appended_position_ -= frame.size();
+          throw;
+        }
+        if (sync == LogicalWalSync::flush) {
+          // A group sync will follow; start the device write now.
+          file_->start_writeback(start);
         }
       }
       if (sync == LogicalWalSync::fsync) {
-        platform::sync_file_or_throw(path_);
+        try {
+          file_->sync_data();
+        } catch (const std::exception &error) {
+          // The frame is already in the file; as in sync_through(), no later
+          // sync may vouch for it.
+          std::lock_guard sync_lock(sync_mutex_);
+          sync_failure_ =
+              logical_wal_detail::io_error(core::OperationStage::mutation_prepare, error.what());
+          throw;
+        }
+        note_synced(appended_position_);
       }
       return core::Status::success();
     } catch (const std::exception &error) {
@@ -235,36 +285,25 @@ class CollectionLogicalWal {
     }
     try {
       std::lock_guard lock(mutex_);
-      if (stream_.is_open()) {
-        stream_.close();  // Also promotes any searchable-only buffered prefix into the checkpoint.
-      }
+      flush_buffer();  // Also promotes any searchable-only buffered prefix into the checkpoint.
       const auto temporary = directory_ / "logical.wal.checkpoint.tmp";
       const auto frame =
           logical_wal_detail::make_frame(LogicalWalRecordType::checkpoint, 0, wal_cut, wal_cut, {});
+      std::filesystem::remove(temporary);
       {
-        std::ofstream output(temporary, std::ios::binary | std::ios::trunc);
-        output.write(reinterpret_cast<const char *>(frame.data()),
-                     static_cast<std::streamsize>(frame.size()));
-        output.flush();
-        if (!output) {
-          return logical_wal_detail::io_error(core::OperationStage::checkpoint,
-                                              "cannot write collection WAL checkpoint cut");
-        }
+        // The replacement WAL gets its block reservation here, off the
+        // commit path, before it becomes live.
+        alaya::wal::AppendFile output(temporary, 0);
+        output.write(frame);
+        output.sync_data();
       }
-      platform::sync_file_or_throw(temporary);
       platform::atomic_replace(temporary, path_);
       platform::sync_directory_or_throw(directory_);
-      recovery_scan_.frames.clear();
-      recovery_scan_.frames.push_back(LogicalWalFrame{LogicalWalRecordType::checkpoint,
-                                                      0,
-                                                      wal_cut,
-                                                      wal_cut,
-                                                      {},
-                                                      0,
-                                                      frame.size()});
       recovery_scan_.valid_bytes = frame.size();
       recovery_scan_.stopped_at_corrupt_or_torn_tail = false;
-      open_stream();
+      open_file();
+      appended_position_ += frame.size();
+      note_synced(appended_position_);
       return core::Status::success();
     } catch (const std::exception &error) {
       return logical_wal_detail::io_error(core::OperationStage::checkpoint, error.what());
@@ -273,6 +312,57 @@ class CollectionLogicalWal {
     }
   }
 
+  // Group commit. Appenders hand frames to the file under `mutex_` without
+  // syncing and remember appended_position(); sync_through() then makes that
+  // prefix durable. The first caller to find no sync in flight becomes the
+  // leader: it writes out everything appended so far as one batch, issues a
+  // single fdatasync with `mutex_` released so later appenders keep queueing,
+  // and wakes every waiter whose position the sync covered. A waiter left
+  // uncovered leads the next round. A failed sync is sticky: the kernel may
+  // already have dropped the dirty pages, so no later sync can vouch for them.
+  [[nodiscard]] auto appended_position() const -> std::uint64_t {
+    std::lock_guard lock(mutex_);
+    return appended_position_;
+  }
+
+  [[nodiscard]] auto sync_through(std::uint64_t position) -> core::Status {
+    if (read_only_) {
+      return readonly_status("read-only Collection WAL cannot sync records");
+    }
+    std::unique_lock sync_lock(sync_mutex_);
+    while (synced_position_ < position) {
+      if (!sync_failure_.ok()) {
+        return sync_failure_;
+      }
+      if (sync_in_flight_) {
+        sync_changed_.wait(sync_lock);
+        continue;
+      }
+      sync_in_flight_ = true;
+      sync_lock.unlock();
+      std::uint64_t covered{};
+      auto status = flush_and_sync(covered);
+      sync_lock.lock();
+      sync_in_flight_ = false;
+      if (status.ok()) {
+        synced_position_ = std::max(synced_position_, covered);
+      } else {
+        sync_failure_ = std::move(status);
+      }
+      sync_changed_.notify_all();
+    }
+    return core::Status::success();
+  }
+
+  // Number of fdatasync calls sync_through() has issued; a measure of how
+  // well concurrent writers are being grouped.
+  [[nodiscard]] auto group_sync_count() const -> std::uint64_t {
+    std::lock_guard sync_lock(sync_mutex_);
+    return group_sync_count_;
+  }
+
+  // The verified prefix open() found. Its frames were streamed to the replay
+  // callback and are not kept here.
   [[nodiscard]] auto recovery_scan() const -> const LogicalWalScan & { return recovery_scan_; }
   [[nodiscard]] auto path() const -> const std::filesystem::path & { return path_; }
   [[nodiscard]] auto directory() const -> const std::filesystem::path & { return directory_; }
@@ -316,6 +406,45 @@ class CollectionLogicalWal {
     }
   }
 
+  // scan_file() without keeping the frames: each one goes to `replay` (which
+  // may be empty) as soon as its CRC has been checked.
+  [[nodiscard]] static auto stream_file(const std::filesystem::path &path,
+                                        const LogicalWalReplay &replay)
+      -> core::Result<LogicalWalScan> {
+    try {
+      alaya::wal::FrameStream stream(path);
+      while (const auto frame = stream.next()) {
+        const auto type = logical_wal_detail::parse_record_type(frame->type);
+        if (!type.has_value()) {
+          return core::Status::error(core::StatusCode::corruption,
+                                     core::OperationStage::mutation_replay,
+                                     core::StatusDetail::malformed_struct,
+                                     "collection WAL contains an unknown record type");
+        }
+        if (replay) {
+          auto status = replay(LogicalWalFrameView{*type,
+                                                   frame->flags,
+                                                   frame->op_id,
+                                                   frame->batch_id,
+                                                   frame->payload,
+                                                   frame->offset,
+                                                   frame->size});
+          if (!status.ok()) {
+            return status;
+          }
+        }
+      }
+      LogicalWalScan result;
+      result.valid_bytes = stream.valid_bytes();
+      result.stopped_at_corrupt_or_torn_tail = stream.stopped_at_corrupt_or_torn_tail();
+      return result;
+    } catch (const std::exception &error) {
+      return logical_wal_detail::io_error(core::OperationStage::mutation_replay, error.what());
+    } catch (...) {
+      return core::status_from_exception(core::OperationStage::mutation_replay);
+    }
+  }
+
  private:
   explicit CollectionLogicalWal(std::filesystem::path directory, bool read_only)
       : directory_(std::move(directory)),
@@ -329,15 +458,50 @@ class CollectionLogicalWal {
                                std::move(diagnostic));
   }
 
-  void open_stream() {
-    // Keeping weak searchable frames in this userspace buffer makes the
-    // crash-loss contract observable under SIGKILL. A later durable commit or
-    // checkpoint deliberately flushes/promotes the preceding prefix.
-    stream_.rdbuf()->pubsetbuf(write_buffer_.data(),
-                               static_cast<std::streamsize>(write_buffer_.size()));
-    stream_.open(path_, std::ios::binary | std::ios::app);
-    if (!stream_) {
-      throw std::runtime_error("cannot open collection logical WAL for append");
+  // Keeps one descriptor on the WAL for its whole life instead of reopening
+  // it by path for every sync. Called with `mutex_` held (or before the WAL
+  // is shared).
+  void open_file() {
+    file_ = std::make_shared<alaya::wal::AppendFile>(path_, std::filesystem::file_size(path_));
+    buffer_.reserve(kWriteBufferBytes);
+  }
+
+  // Keeping weak searchable frames in this userspace buffer makes the
+  // crash-loss contract observable under SIGKILL. A later durable commit or
+  // checkpoint deliberately flushes/promotes the preceding prefix.
+  void flush_buffer() {
+    if (file_ != nullptr && !buffer_.empty()) {
+      file_->write(buffer_);
+      buffer_.clear();
+    }
+  }
+
+  // Called with `mutex_` held once everything through `position` is durable.
+  void note_synced(std::uint64_t position) {
+    std::lock_guard sync_lock(sync_mutex_);
+    synced_position_ = std::max(synced_position_, position);
+    sync_changed_.notify_all();
+  }
+
+  [[nodiscard]] auto flush_and_sync(std::uint64_t &covered) -> core::Status {
+    try {
+      std::shared_ptr<alaya::wal::AppendFile> file;
+      {
+        std::lock_guard lock(mutex_);
+        flush_buffer();
+        covered = appended_position_;
+        file = file_;
+      }
+      // A checkpoint may swap `file_` meanwhile; syncing the retired file is
+      // then redundant but harmless, since the cut is durable by itself.
+      file->sync_data();
+      std::lock_guard sync_lock(sync_mutex_);
+      ++group_sync_count_;
+      return core::Status::success();
+    } catch (const std::exception &error) {
+      return logical_wal_detail::io_error(core::OperationStage::completion, error.what());
+    } catch (...) {
+      return core::status_from_exception(core::OperationStage::completion);
     }
   }
 
@@ -345,9 +509,20 @@ class CollectionLogicalWal {
   std::filesystem::path path_{};
   bool read_only_{};
   LogicalWalScan recovery_scan_{};
+  inline static constexpr std::size_t kWriteBufferBytes = std::size_t{1} << 20U;
+
   mutable std::mutex mutex_{};
-  std::array<char, 1U << 20U> write_buffer_{};
-  std::ofstream stream_{};
+  std::shared_ptr<alaya::wal::AppendFile> file_{};
+  std::vector<std::byte> buffer_{};
+  // Monotonic count of bytes appended since open (guarded by
+  // `mutex_`); a checkpoint cut does not rewind it.
+  std::uint64_t appended_position_{};
+  mutable std::mutex sync_mutex_{};
+  std::condition_variable sync_changed_{};
+  std::uint64_t synced_position_{};
+  std::uint64_t group_sync_count_{};
+  bool sync_in_flight_{};
+  core::Status sync_failure_{};
 };
 
 }  // namespace alaya::internal::collection
@@ -0,0 +1,207 @@
+// SPDX-FileCopyrightText: 2026 AlayaDB.AI
+// SPDX-License-Identifier: AGPL-3.0-only
+
+#pragma once
+
+#include <algorithm>
+#include <array>
+#include <cerrno>
+#include <condition_variable>
+#include <cstddef>
+#include <cstdint>
+#include <deque>
+#include <functional>
+#include <mutex>
+#include <thread>
+#include <utility>
+#include <vector>
+
+#ifdef __linux__
+  #include <sys/resource.h>
+  #include <sys/syscall.h>
+  #include <unistd.h>
+#endif
+
+#include "core/status.hpp"
+
+namespace alaya::internal::collection {
+
+enum class MaintenanceTask : std::uint8_t {
+  seal = 0,
+  compact = 1,
+  gc = 2,
+};
+
+inline constexpr std::size_t kMaintenanceTaskCount = 3;
+
+struct MaintenanceBudget {
+  std::uint32_t threads{1};
+  // Added to each worker's nice value (Linux only; ignored elsewhere).
+  int nice{};
+};
+
+struct MaintenanceCounters {
+  std::uint64_t completed{};
+  std::uint64_t failed{};
+};
+
+// Runs Collection control-plane work off the threads that trigger it.
+// Requests coalesce per task kind: a kind is queued at most once, and a
+// request that arrives while the same kind runs queues exactly one rerun, so
+// work that became due mid-run is not lost and a burst of writes costs one
+// seal. Kinds never run concurrently with themselves. The runner reports
+// failures as statuses; the first one since the last take_failure() is kept.
+class MaintenanceScheduler {
+ public:
+  using Runner = std::function<core::Status(MaintenanceTask)>;
+
+  MaintenanceScheduler(MaintenanceBudget budget, Runner runner)
+      : budget_(budget), runner_(std::move(runner)) {
+    workers_.reserve(budget_.threads);
+    for (std::uint32_t index = 0; index < budget_.threads; ++index) {
+      workers_.emplace_back([this] { work(); });
+    }
+  }
+
+  MaintenanceScheduler(const MaintenanceScheduler &) = delete;
+  auto operator=(const MaintenanceScheduler &) -> MaintenanceScheduler & = delete;
+
+  ~MaintenanceScheduler() { stop(); }
+
+  void schedule(MaintenanceTask task) {
+    {
+      std::lock_guard lock(mutex_);
+      auto &slot = slots_[index(task)];
+      if (stopping_ || slot.queued) {
+        return;
+      }
+      slot.queued = true;
+      if (!slot.running) {
+        queue_.push_back(task);
+      }
+    }
+    changed_.notify_all();
+  }
+
+  // Blocks until `task` is neither queued nor running, or the scheduler
+  // stops. Must not be called from a runner.
+  void wait(MaintenanceTask task) {
+    std::unique_lock lock(mutex_);
+    changed_.wait(lock, [&] {
+      const auto &slot = slots_[index(task)];
+      return stopping_ || (!slot.queued && !slot.running);
+    });
+  }
+
+  void wait_idle() {
+    std::unique_lock lock(mutex_);
+    changed_.wait(lock, [&] {
+      return stopping_ || std::ranges::none_of(slots_, [](const Slot &slot) {
+               return slot.queued || slot.running;
+             });
+    });
+  }
+
+  [[nodiscard]] auto take_failure() -> core::Status {
+    std::lock_guard lock(mutex_);
+    return std::exchange(failure_, core::Status::success());
+  }
+
+  [[nodiscard]] auto counters(MaintenanceTask task) const -> MaintenanceCounters {
+    std::lock_guard lock(mutex_);
+    return slots_[index(task)].counters;
+  }
+
+  // Drops queued work, lets running tasks finish and joins the workers.
+  // Idempotent.
+  void stop() {
+    {
+      std::lock_guard lock(mutex_);
+      stopping_ = true;
+      queue_.clear();
+      for (auto &slot : slots_) {
+        slot.queued = false;
+      }
+    }
+    changed_.notify_all();
+    for (auto &worker : workers_) {
+      if (worker.joinable() && worker.get_id() != std::this_thread::get_id()) {
+        worker.join();
+      }
+    }
+  }
+
+ private:
+  struct Slot {
+    bool queued{};
+    bool running{};
+    MaintenanceCounters counters{};
+  };
+
+  [[nodiscard]] static auto index(MaintenanceTask task) -> std::size_t {
+    return static_cast<std::size_t>(task);
+  }
+
+  void lower_priority() const {
+#ifdef __linux__
+    if (budget_.nice > 0) {
+      // PRIO_PROCESS with a thread id adjusts only the calling thread.
+      const auto tid = static_cast<id_t>(::syscall(SYS_gettid));
+      errno = 0;
+      const auto current = ::getpriority(PRIO_PROCESS, tid);
+      if (errno == 0) {
+        (void)::setpriority(PRIO_PROCESS, tid, current + budget_.nice);
+      }
+    }
+#endif
+  }
+
+  void work() {
+    lower_priority();
+    std::unique_lock lock(mutex_);
+    while (true) {
+      changed_.wait(lock, [&] { return stopping_ || !queue_.empty(); });
+      if (stopping_) {
+        return;
+      }
+      const auto task = queue_.front();
+      queue_.pop_front();
+      auto &slot = slots_[index(task)];
+      slot.queued = false;
+      slot.running = true;
+      lock.unlock();
+      auto status = core::Status::success();
+      try {
+        status = runner_(task);
+      } catch (...) {
+        status = core::status_from_exception(core::OperationStage::build);
+      }
+      lock.lock();
+      slot.running = false;
+      if (status.ok()) {
+        ++slot.counters.completed;
+      } else {
+        ++slot.counters.failed;
+        if (failure_.ok()) {
+          failure_ = std::move(status);
+        }
+      }
+      if (slot.queued && !stopping_) {
+        queue_.push_back(task);
+      }
+      changed_.notify_all();
+    }
+  }
+
+  MaintenanceBudget budget_{};
+  Runner runner_{};
+  mutable std::mutex mutex_{};
+  std::condition_variable changed_{};
+  std::array<Slot, kMaintenanceTaskCount> slots_{};
+  std::deque<MaintenanceTask> queue_{};
+  core::Status failure_{core::Status::success()};
+  bool stopping_{};
+  std::vector<std::thread> workers_{};
+};
+
+}  // namespace alaya::internal::collection
@@ -4,34 +4,105 @@
 
 #pragma once
 
+#include <algorithm>
+#include <atomic>
 #include <cstddef>
 #include <cstdint>
+#include <exception>
 #include <filesystem>
+#include <future>
+#include <memory>
+#include <mutex>
 #include <set>
 #include <string>
 #include <string_view>
+#include <thread>
 #include <vector>
 
 #include "core/status.hpp"
 #include "core/value_types.hpp"
 #include "index/collection/artifact_manifest_v2.hpp"
 #include "index/collection/artifact_transaction.hpp"
+#include "index/collection/verified_digest_cache.hpp"
 #include "platform/fs.hpp"
 
 namespace alaya::internal::collection {
 
+// Artifact hashing that CollectionManifestDualReader::open deferred. The task
+// owns its thread: stop() or destruction abandons the artifacts not hashed
+// yet and joins it, and a stopped task reports cancelled.
+class ArtifactVerificationTask {
+ public:
+  ArtifactVerificationTask(const ArtifactVerificationTask &) = delete;
+  auto operator=(const ArtifactVerificationTask &) -> ArtifactVerificationTask & = delete;
+  ArtifactVerificationTask(ArtifactVerificationTask &&) = delete;
+  auto operator=(ArtifactVerificationTask &&) -> ArtifactVerificationTask & = delete;
+
+  ~ArtifactVerificationTask() { stop(); }
+
+  // Blocks until hashing settles and returns its verdict.
+  [[nodiscard]] auto wait() const -> core::Status { return verdict_.get(); }
+
+  void stop() noexcept {
+    stop_requested_.store(true, std::memory_order_release);
+    std::lock_guard lock(join_mutex_);
+    if (thread_.joinable()) {
+      thread_.join();
+    }
+  }
+
+ private:
+  friend class CollectionManifestDualReader;
+
+  ArtifactVerificationTask() = default;
+
+  std::atomic<bool> stop_requested_{};
+  std::shared_future<core::Status> verdict_{};
+  std::mutex join_mutex_;
+  std::thread thread_;
+};
+
 struct UnifiedManifestView {
   ArtifactManifestV2 manifest{};
+  // Background content verification; null when open() already hashed
+  // everything (or was told not to).
+  std::shared_ptr<ArtifactVerificationTask> verification{};
 
   [[nodiscard]] auto field_was_defaulted(
       [[maybe_unused]] std::string_view field_path) const noexcept -> bool {
     return false;
   }
+
+  // Blocks until background hashing settles and returns its verdict.
+  [[nodiscard]] auto wait_for_verification() const -> core::Status {
+    return verification != nullptr ? verification->wait() : core::Status::success();
+  }
 };
 
+enum class ArtifactVerification : std::uint8_t {
+  // Hash every routed artifact before open() returns.
+  eager = 0,
+  // Check READY markers, presence, and sizes before returning; hash on the
+  // thread of UnifiedManifestView::verification. Whoever keeps the view owns
+  // the verdict: a Collection checks it before its first search.
+  background = 1,
+};
+
+inline constexpr std::string_view kVerifiedDigestSidecarFilename = "verified_digests.v1";
+
 struct ManifestReaderOptions {
   std::uint32_t reader_version{kArtifactManifestV2SchemaVersion};
   bool verify_artifacts{true};
+  ArtifactVerification verification{ArtifactVerification::eager};
+  // Accept a digest VerifiedDigestCache already holds for an artifact's
+  // current file identity instead of hashing it again.
+  bool trust_verified_digests{true};
+  // With trust_verified_digests, also seed the cache from the collection's
+  // verified-digest sidecar and write it back after verifying, so a restart
+  // skips unchanged artifacts too. Read-only opens turn the write off.
+  bool persist_verified_digests{true};
+  // Artifacts hashed at once; 0 means one per hardware thread.
+  std::uint32_t verification_threads{0};
   // Keep qg_segment recognizable so dispatch can return the deliberate
   // legacy/re-seal diagnostic instead of an unknown-feature error.
   std::set<std::string> available_features{"manifest_v2",
@@ -65,12 +136,48 @@ class CollectionManifestDualReader {
         return compatible;
       }
       if (options.verify_artifacts) {
-        auto verified = verify_v2_artifacts(collection_root, view.manifest, options);
+        std::vector<PendingDigest> pending;
+        auto verified = verify_v2_structure(collection_root, view.manifest, pending);
         if (!verified.ok()) {
           return verified;
         }
+        if (options.verification == ArtifactVerification::background) {
+          std::shared_ptr<ArtifactVerificationTask> task(new ArtifactVerificationTask());
+          std::promise<core::Status> verdict;
+          task->verdict_ = verdict.get_future().share();
+          task->thread_ = std::thread([collection_root,
+                                       pending = std::move(pending),
+                                       options,
+                                       verdict = std::move(verdict),
+                                       stop = &task->stop_requested_]() mutable noexcept {
+            verdict.set_value(verify_digests(collection_root, pending, options, stop));
+          });
+          view.verification = std::move(task);
+        } else {
+          verified = verify_digests(collection_root, pending, options);
+          if (!verified.ok()) {
+            return verified;
+          }
+        }
       }
       return view;
+    } catch (...) {
+      return current_exception_status();
+    }
+  }
+
+ private:
+  struct PendingDigest {
+    std::filesystem::path path{};
+    std::string relative_path{};
+    Sha256Digest expected{};
+  };
+
+  // Maps the exception in flight: malformed input is corruption, anything
+  // else the filesystem threw is an I/O failure.
+  [[nodiscard]] static auto current_exception_status() noexcept -> core::Status {
+    try {
+      throw;
     } catch (const std::invalid_argument &error) {
       return core::Status::error(core::StatusCode::corruption,
                                  core::OperationStage::open,
@@ -86,7 +193,6 @@ class CollectionManifestDualReader {
     }
   }
 
- private:
   [[nodiscard]] static auto compatibility_supported(const ReaderCompatibilityV2 &compatibility,
                                                     const ManifestReaderOptions &options,
                                                     std::string_view subject) -> core::Status {
@@ -135,11 +241,12 @@ class CollectionManifestDualReader {
                                std::move(diagnostic));
   }
 
-  [[nodiscard]] static auto verify_v2_artifacts(const std::filesystem::path &collection_root,
+  // Everything except artifact contents: READY markers and their bindings,
+  // artifact presence, and sizes. Queues each artifact for hashing.
+  [[nodiscard]] static auto verify_v2_structure(const std::filesystem::path &collection_root,
                                                 const ArtifactManifestV2 &manifest,
-                                                const ManifestReaderOptions &options)
+                                                std::vector<PendingDigest> &pending)
       -> core::Status {
-    (void)options;
     for (const auto &segment : manifest.segments) {
       const auto ready_path = collection_root / segment.ready_marker;
       if (!std::filesystem::is_regular_file(ready_path)) {
@@ -174,9 +281,7 @@ class CollectionManifestDualReader {
         if (std::filesystem::file_size(artifact_path) != artifact.size_bytes) {
           return corrupt("manifest v2 artifact size mismatch: " + artifact.relative_path);
         }
-        if (sha256_file(artifact_path) != artifact.digest) {
-          return corrupt("manifest v2 artifact SHA-256 mismatch: " + artifact.relative_path);
-        }
+        pending.push_back({artifact_path, artifact.relative_path, artifact.digest});
         if (artifact.logical_name == "artifact_manifest_v2") {
           owned_manifest = std::addressof(artifact);
         }
@@ -188,6 +293,84 @@ class CollectionManifestDualReader {
     }
     return core::Status::success();
   }
+  // Hashes the queued artifacts on up to verification_threads threads, the
+  // calling thread included, and reports the first failure in manifest order.
+  // Setting `stop` abandons the artifacts not started yet.
+  [[nodiscard]] static auto verify_digests(const std::filesystem::path &collection_root,
+                                           const std::vector<PendingDigest> &pending,
+                                           const ManifestReaderOptions &options,
+                                           const std::atomic<bool> *stop = nullptr) noexcept
+      -> core::Status {
+    try {
+      VerifiedDigestCache *cache{};
+      const auto sidecar = collection_root / ".alaya_internal" / kVerifiedDigestSidecarFilename;
+      if (options.trust_verified_digests) {
+        cache = std::addressof(VerifiedDigestCache::instance());
+        VerifiedDigestSidecar::load(sidecar, *cache);
+      }
+      std::vector<core::Status> results(pending.size());
+      std::atomic<std::size_t> next{};
+      const auto drain = [&]() noexcept {
+        for (auto index = next.fetch_add(1); index < pending.size(); index = next.fetch_add(1)) {
+          if (stop != nullptr && stop->load(std::memory_order_acquire)) {
+            return;
+          }
+          try {
+            // A remembered digest that disagrees is rechecked from the bytes:
+            // the sidecar behind the cache is a hint, not evidence.
+            if (sha256_file_cached(pending[index].path, cache) != pending[index].expected &&
+                (cache == nullptr || sha256_file(pending[index].path) != pending[index].expected)) {
+              results[index] =
+                  corrupt("manifest v2 artifact SHA-256 mismatch: " + pending[index].relative_path);
+            }
+          } catch (...) {
+            results[index] = current_exception_status();
+          }
+        }
+      };
+      const auto hardware = std::max(1U, std::thread::hardware_concurrency());
+      const auto threads = std::min<std::size_t>(
+          options.verification_threads == 0 ? hardware : options.verification_threads,
+          pending.size());
+      std::vector<std::thread> helpers;
+      if (threads > 1) {
+        helpers.reserve(threads - 1);
+        try {
+          for (std::size_t index = 1; index < threads; ++index) {
+            helpers.emplace_back(drain);
+          }
+        } catch (...) {
+          // Fewer helpers only means a slower drain.
+        }
+      }
+      drain();
+      for (auto &helper : helpers) {
+        helper.join();
+      }
+      for (auto &result : results) {
+        if (!result.ok()) {
+          return std::move(result);
+        }
+      }
+      if (stop != nullptr && stop->load(std::memory_order_acquire)) {
+        return core::Status::error(core::StatusCode::cancelled,
+                                   core::OperationStage::open,
+                                   core::StatusDetail::none,
+                                   "artifact verification stopped before it finished");
+      }
+      if (cache != nullptr && options.persist_verified_digests) {
+        std::vector<std::filesystem::path> files;
+        files.reserve(pending.size());
+        for (const auto &digest : pending) {
+          files.push_back(digest.path);
+        }
+        VerifiedDigestSidecar::store(sidecar, files, *cache);
+      }
+      return core::Status::success();
+    } catch (...) {
+      return current_exception_status();
+    }
+  }
 };
 
 }  // namespace alaya::internal::collection
@@ -31,6 +31,9 @@ struct WalMutationRow {
   std::optional<RowAddress> previous{};
   RecordPayload payload{};
   std::string retry_token{};
+  // encode_wal_payload(payload), when the writer encoded it before taking the
+  // mutation lock. Not part of the record; empty means encode on append.
+  std::vector<std::byte> encoded_payload{};
 };
 
 struct WalMutationTransaction {
@@ -218,14 +221,26 @@ inline void encode_logical_id(std::vector<std::byte> &output, const core::Logica
 
 }  // namespace mutation_wal_codec_detail
 
+// The bytes encode_wal_transaction() writes for one row's payload.
+[[nodiscard]] inline auto encode_wal_payload(const RecordPayload &payload)
+    -> std::vector<std::byte> {
+  std::vector<std::byte> output;
+  mutation_wal_codec_detail::encode_payload(output, payload);
+  return output;
+}
+
 [[nodiscard]] inline auto encode_wal_transaction(const WalMutationTransaction &transaction)
     -> std::vector<std::byte> {
   using namespace mutation_wal_codec_detail;  // NOLINT(build/namespaces)
   if (transaction.rows.size() > kMaximumRows) {
     throw std::invalid_argument("mutation WAL transaction has too many rows");
   }
+  std::size_t encoded_bytes = 256;
+  for (const auto &row : transaction.rows) {
+    encoded_bytes += row.encoded_payload.size();
+  }
   std::vector<std::byte> output;
-  output.reserve(256);
+  output.reserve(encoded_bytes);
   logical_wal_detail::put_u16(output, kPayloadVersion);
   put_u8(output, static_cast<std::uint8_t>(transaction.batch_mode));
   put_u8(output, static_cast<std::uint8_t>(transaction.durability));
@@ -242,7 +257,11 @@ inline void encode_logical_id(std::vector<std::byte> &output, const core::Logica
     if (row.previous.has_value()) {
       put_address(output, *row.previous);
     }
-    encode_payload(output, row.payload);
+    if (row.encoded_payload.empty()) {
+      encode_payload(output, row.payload);
+    } else {
+      output.insert(output.end(), row.encoded_payload.begin(), row.encoded_payload.end());
+    }
     put_string(output, row.retry_token);
   }
   return output;
@@ -0,0 +1,365 @@
+// SPDX-FileCopyrightText: 2026 AlayaDB.AI
+//
+// SPDX-License-Identifier: AGPL-3.0-only
+
+#pragma once
+
+#include <algorithm>
+#include <cstddef>
+#include <cstdint>
+#include <functional>
+#include <iterator>
+#include <memory>
+#include <stdexcept>
+#include <utility>
+#include <vector>
+
+namespace alaya::internal::collection {
+
+// Ordered map with structural sharing, used for the RoutingSnapshot version
+// and reverse maps. Copying a map shares its whole tree in O(1); a later
+// mutation copies only the O(log N) nodes on the path to the touched key, so
+// a published snapshot keeps seeing its own tree while the writer's dark copy
+// diverges. Nodes reached only through this map's own (uniquely owned) path
+// are updated in place, which makes a private, never-copied map behave like a
+// plain AVL tree without per-mutation allocations.
+//
+// Entries are held behind shared_ptr<const value_type>, so copying a node on
+// the mutation path never deep-copies a neighbour's payload. Iterators are
+// const-only and, like std::map, are invalidated by mutating the same map
+// object; iterators over a different copy stay valid.
+template <class Key, class Value, class Compare = std::less<Key>>
+class PersistentMap {
+  struct Node;
+  using NodePtr = std::shared_ptr<Node>;
+
+ public:
+  using key_type = Key;
+  using mapped_type = Value;
+  using value_type = std::pair<const Key, Value>;
+  using size_type = std::size_t;
+  using difference_type = std::ptrdiff_t;
+  using key_compare = Compare;
+
+  class const_iterator {
+   public:
+    using iterator_concept = std::forward_iterator_tag;
+    using iterator_category = std::forward_iterator_tag;
+    using value_type = PersistentMap::value_type;
+    using difference_type = std::ptrdiff_t;
+    using pointer = const value_type *;
+    using reference = const value_type &;
+
+    const_iterator() = default;
+
+    [[nodiscard]] auto operator*() const -> reference { return *current_->entry; }
+    [[nodiscard]] auto operator->() const -> pointer { return current_->entry.get(); }
+
+    auto operator++() -> const_iterator & {
+      if (stack_.empty()) {
+        // Iterators returned by find() carry only their node; the ancestor
+        // path is rebuilt on the first increment instead of on every lookup.
+        rebuild_path();
+      }
+      const auto *node = stack_.back();
+      stack_.pop_back();
+      push_left_spine(node->right.get());
+      current_ = stack_.empty() ? nullptr : stack_.back();
+      return *this;
+    }
+
+    auto operator++(int) -> const_iterator {
+      auto previous = *this;
+      ++*this;
+      return previous;
+    }
+
+    [[nodiscard]] friend auto operator==(const const_iterator &lhs,
+                                         const const_iterator &rhs) noexcept -> bool {
+      return lhs.current_ == rhs.current_;
+    }
+
+   private:
+    friend class PersistentMap;
+
+    const_iterator(const Node *root, const Node *current, const Compare *compare)
+        : root_(root), current_(current), compare_(compare) {}
+
+    void push_left_spine(const Node *node) {
+      for (; node != nullptr; node = node->left.get()) {
+        stack_.push_back(node);
+      }
+    }
+
+    void rebuild_path() {
+      const auto &key = current_->entry->first;
+      for (const auto *node = root_; node != current_;) {
+        if ((*compare_)(key, node->entry->first)) {
+          stack_.push_back(node);
+          node = node->left.get();
+        } else {
+          node = node->right.get();
+        }
+      }
+      stack_.push_back(current_);
+    }
+
+    const Node *root_{};
+    const Node *current_{};
+    const Compare *compare_{};
+    std::vector<const Node *> stack_{};
+  };
+
+  using iterator = const_iterator;
+
+  PersistentMap() = default;
+  explicit PersistentMap(const Compare &compare) : compare_(compare) {}
+
+  [[nodiscard]] auto size() const noexcept -> size_type { return size_; }
+  [[nodiscard]] auto empty() const noexcept -> bool { return size_ == 0; }
+
+  [[nodiscard]] auto begin() const -> const_iterator {
+    const_iterator result(root_.get(), nullptr, &compare_);
+    result.push_left_spine(root_.get());
+    result.current_ = result.stack_.empty() ? nullptr : result.stack_.back();
+    return result;
+  }
+
+  [[nodiscard]] auto end() const -> const_iterator { return {root_.get(), nullptr, &compare_}; }
+
+  [[nodiscard]] auto find(const Key &key) const -> const_iterator {
+    return {root_.get(), find_node(key), &compare_};
+  }
+
+  [[nodiscard]] auto contains(const Key &key) const -> bool { return find_node(key) != nullptr; }
+
+  [[nodiscard]] auto at(const Key &key) const -> const Value & {
+    const auto *node = find_node(key);
+    if (node == nullptr) {
+      throw std::out_of_range("PersistentMap::at: key is absent");
+    }
+    return node->entry->second;
+  }
+
+  // Returns whether the key was newly inserted, mirroring std::map.
+  auto insert_or_assign(const Key &key, Value value) -> std::pair<const_iterator, bool> {
+    auto entry = std::make_shared<const value_type>(key, std::move(value));
+    InsertResult result;
+    insert_at(root_, std::move(entry), true, result);
+    size_ += result.inserted ? 1U : 0U;
+    return {const_iterator(root_.get(), result.node, &compare_), result.inserted};
+  }
+
+  auto emplace(const Key &key, Value value) -> std::pair<const_iterator, bool> {
+    if (const auto *existing = find_node(key); existing != nullptr) {
+      return {const_iterator(root_.get(), existing, &compare_), false};
+    }
+    return insert_or_assign(key, std::move(value));
+  }
+
+  auto erase(const Key &key) -> size_type {
+    if (find_node(key) == nullptr) {
+      return 0;
+    }
+    erase_at(root_, key);
+    --size_;
+    return 1;
+  }
+
+  void clear() noexcept {
+    root_.reset();
+    size_ = 0;
+  }
+
+  // Rebuilds a perfectly balanced tree from the surviving entries in O(N).
+  // Surviving payloads are shared with every other copy, never duplicated.
+  template <class Predicate>
+  friend auto erase_if(PersistentMap &map, Predicate predicate) -> size_type {
+    std::vector<std::shared_ptr<const value_type>> survivors;
+    survivors.reserve(map.size_);
+    collect_if(map.root_.get(), predicate, survivors);
+    const auto removed = map.size_ - survivors.size();
+    if (removed != 0) {
+      map.root_ = build_balanced(survivors, 0, survivors.size());
+      map.size_ = survivors.size();
+    }
+    return removed;
+  }
+
+ private:
+  struct Node {
+    explicit Node(std::shared_ptr<const value_type> value) : entry(std::move(value)) {}
+
+    std::shared_ptr<const value_type> entry{};
+    NodePtr left{};
+    NodePtr right{};
+    std::uint8_t height{1};
+  };
+
+  struct InsertResult {
+    const Node *node{};
+    bool inserted{};
+  };
+
+  [[nodiscard]] auto find_node(const Key &key) const -> const Node * {
+    const auto *node = root_.get();
+    while (node != nullptr) {
+      if (compare_(key, node->entry->first)) {
+        node = node->left.get();
+      } else if (compare_(node->entry->first, key)) {
+        node = node->right.get();
+      } else {
+        return node;
+      }
+    }
+    return nullptr;
+  }
+
+  // A slot's node may be mutated in place only when this slot holds the sole
+  // reference. The slot is itself reached through uniquely owned ancestors,
+  // so a use count of one proves no other map (or published snapshot) can
+  // observe the node.
+  static void make_unique(NodePtr &slot) {
+    if (slot.use_count() != 1) {
+      slot = std::make_shared<Node>(*slot);
+    }
+  }
+
+  [[nodiscard]] static auto height(const NodePtr &node) noexcept -> int {
+    return node == nullptr ? 0 : node->height;
+  }
+
+  static void update_height(Node &node) noexcept {
+    node.height = static_cast<std::uint8_t>(1 + std::max(height(node.left), height(node.right)));
+  }
+
+  static void rotate_right(NodePtr &slot) {
+    make_unique(slot->left);
+    auto pivot = std::move(slot->left);
+    slot->left = std::move(pivot->right);
+    update_height(*slot);
+    pivot->right = std::move(slot);
+    update_height(*pivot);
+    slot = std::move(pivot);
+  }
+
+  static void rotate_left(NodePtr &slot) {
+    make_unique(slot->right);
+    auto pivot = std::move(slot->right);
+    slot->right = std::move(pivot->left);
+    update_height(*slot);
+    pivot->left = std::move(slot);
+    update_height(*pivot);
+    slot = std::move(pivot);
+  }
+
+  // Expects a uniquely owned slot whose children are AVL trees of heights
+  // differing by at most two.
+  static void rebalance(NodePtr &slot) {
+    const auto balance = height(slot->left) - height(slot->right);
+    if (balance > 1) {
+      if (height(slot->left->left) < height(slot->left->right)) {
+        make_unique(slot->left);
+        rotate_left(slot->left);
+      }
+      rotate_right(slot);
+    } else if (balance < -1) {
+      if (height(slot->right->right) < height(slot->right->left)) {
+        make_unique(slot->right);
+        rotate_right(slot->right);
+      }
+      rotate_left(slot);
+    } else {
+      update_height(*slot);
+    }
+  }
+
+  void insert_at(NodePtr &slot,
+                 std::shared_ptr<const value_type> entry,
+                 bool assign,
+                 InsertResult &result) {
+    if (slot == nullptr) {
+      slot = std::make_shared<Node>(std::move(entry));
+      result = {slot.get(), true};
+      return;
+    }
+    make_unique(slot);
+    if (compare_(entry->first, slot->entry->first)) {
+      insert_at(slot->left, std::move(entry), assign, result);
+    } else if (compare_(slot->entry->first, entry->first)) {
+      insert_at(slot->right, std::move(entry), assign, result);
+    } else {
+      if (assign) {
+        slot->entry = std::move(entry);
+      }
+      result = {slot.get(), false};
+      return;
+    }
+    if (result.inserted) {
+      rebalance(slot);
+      // A rotation may have moved the inserted node, but never freed it.
+    }
+  }
+
+  static auto take_minimum(NodePtr &slot) -> std::shared_ptr<const value_type> {
+    make_unique(slot);
+    if (slot->left == nullptr) {
+      auto entry = std::move(slot->entry);
+      slot = std::move(slot->right);
+      return entry;
+    }
+    auto entry = take_minimum(slot->left);
+    rebalance(slot);
+    return entry;
+  }
+
+  void erase_at(NodePtr &slot, const Key &key) {
+    make_unique(slot);
+    if (compare_(key, slot->entry->first)) {
+      erase_at(slot->left, key);
+    } else if (compare_(slot->entry->first, key)) {
+      erase_at(slot->right, key);
+    } else if (slot->left == nullptr || slot->right == nullptr) {
+      auto child = slot->left != nullptr ? std::move(slot->left) : std::move(slot->right);
+      slot = std::move(child);
+      return;
+    } else {
+      slot->entry = take_minimum(slot->right);
+    }
+    rebalance(slot);
+  }
+
+  template <class Predicate>
+  static void collect_if(const Node *node,
+                         Predicate &predicate,
+                         std::vector<std::shared_ptr<const value_type>> &survivors) {
+    if (node == nullptr) {
+      return;
+    }
+    collect_if(node->left.get(), predicate, survivors);
+    if (!predicate(*node->entry)) {
+      survivors.push_back(node->entry);
+    }
+    collect_if(node->right.get(), predicate, survivors);
+  }
+
+  static auto build_balanced(const std::vector<std::shared_ptr<const value_type>> &entries,
+                             std::size_t first,
+                             std::size_t last) -> NodePtr {
+    if (first == last) {
+      return {};
+    }
+    const auto middle = first + (last - first) / 2;
+    auto node = std::make_shared<Node>(entries[middle]);
+    node->left = build_balanced(entries, first, middle);
+    node->right = build_balanced(entries, middle + 1, last);
+    update_height(*node);
+    return node;
+  }
+
+  NodePtr root_{};
+  size_type size_{};
+  [[no_unique_address]] Compare compare_{};
+};
+
+}  // namespace alaya::internal::collection
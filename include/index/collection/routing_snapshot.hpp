@@ -7,13 +7,13 @@
 #include <atomic>
 #include <cstdint>
 #include <functional>
-#include <map>
 #include <memory>
 #include <shared_mutex>
 #include <unordered_map>
 #include <utility>
 #include <vector>
 
+#include "index/collection/persistent_map.hpp"
 #include "index/collection/types.hpp"
 
 namespace alaya::internal::collection {
@@ -50,8 +50,12 @@ struct SegmentEntry {
   mutable std::shared_mutex operation_mutex{};
 };
 
-using VersionMap = std::map<core::LogicalId, VersionEntry, LogicalIdLess>;
-using ReverseMap = std::map<RowAddress, ReverseEntry>;
+// Both maps share structure between snapshot generations: copying a
+// RoutingSnapshot to build the next dark epoch is O(segments), and each
+// mutated row then costs O(log N) path copies instead of a deep copy of every
+// row's payload. A pinned epoch keeps its own tree for as long as it is held.
+using VersionMap = PersistentMap<core::LogicalId, VersionEntry, LogicalIdLess>;
+using ReverseMap = PersistentMap<RowAddress, ReverseEntry>;
 
 struct SegmentIdentity {
   std::uint64_t segment_id{};
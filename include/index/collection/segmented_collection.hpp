@@ -30,6 +30,7 @@
 
 #include "index/collection/collection_checkpoint.hpp"
 #include "index/collection/experimental_snapshot_writer.hpp"
+#include "index/collection/manifest_dual_reader.hpp"
 
 namespace alaya::internal::collection {
 
@@ -133,9 +134,14 @@ class SegmentedCollection {
   [[nodiscard]] auto stats() const -> CollectionStats;
 
   [[nodiscard]] auto close() -> core::Status {
-    std::lock_guard lock(lifecycle_mutex_);
-    if (lifecycle_ == LifecycleState::open) {
-      lifecycle_ = LifecycleState::closing;
+    {
+      std::lock_guard lock(lifecycle_mutex_);
+      if (lifecycle_ == LifecycleState::open) {
+        lifecycle_ = LifecycleState::closing;
+      }
+    }
+    if (config_.artifact_verification != nullptr) {
+      config_.artifact_verification->stop();
     }
     return core::Status::success();
   }
@@ -472,12 +478,116 @@ class SegmentedCollection {
                                    core::FilterExecution execution)
       -> core::Result<CollectionSearchResult>;
 
+  struct SegmentDispatch;
+
+  static void run_segment_dispatch(SegmentDispatch &dispatch,
+                                   const CollectionSearchRequest &request,
+                                   core::FilterExecution execution) noexcept;
+
+  // Gives each dispatch its part of the caller's scratch lease and I/O
+  // credits, so concurrent segments never spend the whole budget each.
+  static void share_search_budget(std::vector<std::unique_ptr<SegmentDispatch>> &dispatches,
+                                  const core::SearchContext &context,
+                                  SegmentFanout fanout) noexcept;
+
+  static void run_segment_dispatches(std::vector<std::unique_ptr<SegmentDispatch>> &dispatches,
+                                     const CollectionSearchRequest &request,
+                                     core::FilterExecution execution);
+
   [[nodiscard]] auto normalize_scores(const std::vector<Candidate> &candidates,
                                       const core::TypedTensorView &query,
                                       core::SearchContext *context,
                                       CollectionSearchStats *stats)
       -> core::Result<std::vector<CollectionHit>>;
 
+  // The half of a write that needs no collection state: validation, the
+  // owned vector copy and its WAL encoding. Writers run it before taking
+  // mutation_mutex_, so it overlaps the staging and group sync of the
+  // transactions ahead of them. An invalid row keeps its error in `status`
+  // and reports it at the point the locked path used to.
+  struct PreparedPayload {
+    core::Status status{core::Status::success()};
+    RecordPayload payload{};
+    std::vector<std::byte> encoded{};
+  };
+
+  [[nodiscard]] auto prepare_payload(const core::LogicalId &logical_id,
+                                     const core::TypedTensorView &vector,
+                                     const Metadata &metadata,
+                                     const std::string &document) const -> PreparedPayload;
+
+  [[nodiscard]] auto prepare_batch_payloads(const BatchMutationRequest &request) const
+      -> std::vector<PreparedPayload>;
+
+  [[nodiscard]] auto write_locked(const WriteRequest &request,
+                                  PreparedPayload prepared,
+                                  core::MutationContext &context) -> core::Result<MutationReceipt>;
+
+  [[nodiscard]] auto erase_locked(const core::LogicalId &logical_id,
+                                  core::MutationContext &context,
+                                  const WriteOptions &options) -> core::Result<MutationReceipt>;
+
+  [[nodiscard]] auto delete_by_filter_locked(const LogicalFilter &filter,
+                                             core::MutationContext &context)
+      -> core::Result<std::vector<MutationReceipt>>;
+
+  [[nodiscard]] auto mutate_batch_locked(const BatchMutationRequest &request,
+                                         std::vector<PreparedPayload> &prepared,
+                                         core::MutationContext &context)
+      -> core::Result<BatchMutationReceipt>;
+
+  // Group commit: a wal_fsync mutation writes its COMMIT frame through to the
+  // kernel under mutation_mutex_ but waits for the fdatasync only after
+  // releasing it, so writers queued behind it append their own frames while
+  // the sync is in flight and the next sync covers all of them. The rows are
+  // searchable from their publication, before the sync (see
+  // DurabilityState::wal_fsync). Everything published so far was appended at
+  // or before `position`, so once the sync returns the durable watermark
+  // advances to the visibility watermark seen here, in the snapshot and in
+  // the receipts. A failed sync leaves published rows that may not survive a
+  // crash, so it latches recovery-required.
+  template <typename T>
+  [[nodiscard]] auto complete_group_commit(std::unique_lock<std::mutex> &mutation_lock,
+                                           core::Result<T> result) -> core::Result<T> {
+    if (!std::exchange(group_sync_pending_, false)) {
+      return result;
+    }
+    const auto position = wal_->appended_position();
+    const auto watermark = load_snapshot()->visibility_watermark;
+    mutation_lock.unlock();
+    auto synced = failpoint(MutationFailPoint::before_group_sync)
+                      ? injected_failure(MutationFailPoint::before_group_sync)
+                      : wal_->sync_through(position);
+    if (!synced.ok()) {
+      latch_recovery_required("a group WAL sync failed after its mutations were published");
+      if (result.ok()) {
+        return synced;
+      }
+      return result;
+    }
+    mutation_lock.lock();
+    advance_durable_watermark(watermark);
+    if (result.ok()) {
+      stamp_durable_watermark(result.value(), watermark);
+    }
+    return result;
+  }
+
+  // A retried receipt may report a wal_fsync write whose group sync is still
+  // running; the retry then waits for that sync as the original call did.
+  template <typename Receipt>
+  void await_group_sync_for(const Receipt &receipt) {
+    if (receipt.durability == DurabilityState::wal_fsync &&
+        receipt.durable_watermark < receipt.visibility_watermark) {
+      group_sync_pending_ = true;
+    }
+  }
+
+  void advance_durable_watermark(std::uint64_t watermark);
+  void stamp_durable_watermark(MutationReceipt &receipt, std::uint64_t watermark);
+  void stamp_durable_watermark(std::vector<MutationReceipt> &receipts, std::uint64_t watermark);
+  void stamp_durable_watermark(BatchMutationReceipt &receipt, std::uint64_t watermark);
+
   [[nodiscard]] auto mutate_locked(RoutingSnapshotPtr current,
                                    const core::LogicalId &logical_id,
                                    SegmentMutationAction action,
@@ -485,13 +595,16 @@ class SegmentedCollection {
                                    RowMutationStatus row_status,
                                    core::MutationContext &context,
                                    const WriteOptions &options,
-                                   std::uint64_t batch_op_id = 0) -> core::Result<MutationReceipt>;
+                                   std::uint64_t batch_op_id = 0,
+                                   std::vector<std::byte> encoded_payload = {})
+      -> core::Result<MutationReceipt>;
 
   struct ValidatedBatchRow {
     bool valid{};
     SegmentMutationAction action{SegmentMutationAction::write};
     RowMutationStatus status{RowMutationStatus::invalid_argument};
     RecordPayload payload{};
+    std::vector<std::byte> encoded_payload{};
     std::optional<RowAddress> previous{};
   };
 
@@ -500,7 +613,8 @@ class SegmentedCollection {
       -> core::Status;
 
   [[nodiscard]] auto validate_batch_row(const RoutingSnapshotPtr &current,
-                                        const BatchRowMutation &row) const -> ValidatedBatchRow;
+                                        const BatchRowMutation &row,
+                                        PreparedPayload &prepared) const -> ValidatedBatchRow;
 
   [[nodiscard]] auto make_non_searchable_receipt(const RoutingSnapshotPtr &current,
                                                  std::uint64_t batch_op_id,
@@ -509,6 +623,7 @@ class SegmentedCollection {
 
   [[nodiscard]] auto mutate_batch_row_locked(RoutingSnapshotPtr current,
                                              const BatchRowMutation &row,
+                                             PreparedPayload &prepared,
                                              core::MutationContext &context,
                                              const WriteOptions &options,
                                              std::uint64_t batch_op_id)
@@ -516,6 +631,7 @@ class SegmentedCollection {
 
   [[nodiscard]] auto mutate_atomic_batch_locked(RoutingSnapshotPtr current,
                                                 const BatchMutationRequest &request,
+                                                std::vector<PreparedPayload> &prepared,
                                                 core::MutationContext &context,
                                                 std::uint64_t batch_op_id)
       -> core::Result<BatchMutationReceipt>;
@@ -538,7 +654,8 @@ class SegmentedCollection {
   [[nodiscard]] static auto injected_failure(MutationFailPoint point) -> core::Status {
     const auto stage = point == MutationFailPoint::after_commit ||
                                point == MutationFailPoint::after_publish ||
-                               point == MutationFailPoint::after_engine_publish_before_snapshot
+                               point == MutationFailPoint::after_engine_publish_before_snapshot ||
+                               point == MutationFailPoint::before_group_sync
                            ? core::OperationStage::mutation_publish
                        : point == MutationFailPoint::after_stage ||
                                point == MutationFailPoint::metadata_stage_failure
@@ -614,7 +731,7 @@ class SegmentedCollection {
 
   [[nodiscard]] auto execute_transaction_locked(RoutingSnapshotPtr current,
                                                 const std::shared_ptr<SegmentEntry> &target,
-                                                const WalMutationTransaction &transaction,
+                                                WalMutationTransaction &transaction,
                                                 core::MutationContext &context,
                                                 std::uint64_t transaction_id)
       -> core::Result<std::vector<MutationReceipt>>;
@@ -622,6 +739,12 @@ class SegmentedCollection {
   [[nodiscard]] auto replay_engine_transaction(const WalMutationTransaction &transaction)
       -> core::Status;
 
+  // Replays non-empty committed transactions that all target one segment
+  // instance, in order. The target lookup, its row-id floor, and a read-only
+  // reader's applied-watermark check are done once for the whole run.
+  [[nodiscard]] auto replay_engine_run(std::span<const WalMutationTransaction *const> run)
+      -> core::Status;
+
   void install_recovered_receipts(const WalMutationTransaction &transaction,
                                   const RoutingSnapshot &snapshot,
                                   DurabilityState durability);
@@ -629,6 +752,8 @@ class SegmentedCollection {
   [[nodiscard]] auto apply_checkpoint_image(std::shared_ptr<RoutingSnapshot> &snapshot,
                                             CollectionCheckpointImage image) -> core::Status;
 
+  // Loads the checkpoint into `snapshot`, then opens `wal_` and replays the
+  // committed tail into `snapshot` while the WAL streams.
   [[nodiscard]] auto recover_durable_state(std::shared_ptr<RoutingSnapshot> &snapshot)
       -> core::Status;
 
@@ -704,25 +829,55 @@ class SegmentedCollection {
                                            const OwnedVector &vector,
                                            core::Metric metric) -> core::Result<float>;
 
+  [[nodiscard]] static auto hit_precedes(const CollectionHit &lhs, const CollectionHit &rhs)
+      -> bool {
+    if (lhs.score != rhs.score) {
+      return lhs.score_kind == core::ScoreKind::similarity ? lhs.score > rhs.score
+                                                           : lhs.score < rhs.score;
+    }
+    const auto logical_order = lhs.logical_id.compare(rhs.logical_id);
+    if (logical_order != 0) {
+      return logical_order < 0;
+    }
+    return lhs.source < rhs.source;
+  }
+
   static void sort_hits(std::vector<CollectionHit> &hits) {
-    std::sort(hits.begin(), hits.end(), [](const CollectionHit &lhs, const CollectionHit &rhs) {
-      if (lhs.score != rhs.score) {
-        return lhs.score_kind == core::ScoreKind::similarity ? lhs.score > rhs.score
-                                                             : lhs.score < rhs.score;
-      }
-      const auto logical_order = lhs.logical_id.compare(rhs.logical_id);
-      if (logical_order != 0) {
-        return logical_order < 0;
-      }
-      return lhs.source < rhs.source;
-    });
+    std::sort(hits.begin(), hits.end(), hit_precedes);
   }
 
+  // Orders hits exactly like sort_hits, given that they are laid out as one
+  // run per segment ending at run_ends. Segments return hits best-first, so
+  // runs are normally already sorted and only need a k-way merge.
+  static void merge_hit_runs(std::vector<CollectionHit> &hits,
+                             const std::vector<std::size_t> &run_ends);
+
   [[nodiscard]] static auto is_nan_score(float score) noexcept -> bool {
     const auto bits = std::bit_cast<std::uint32_t>(score);
     return (bits & 0x7F800000U) == 0x7F800000U && (bits & 0x007FFFFFU) != 0;
   }
 
+  // Applies one committed WAL row to an unpublished snapshot and keeps the
+  // live/tombstone/known-row counts exact without a full recount.
+  static void apply_row_to_snapshot(RoutingSnapshot &snapshot, const WalMutationRow &row) {
+    snapshot.visibility_watermark = std::max(snapshot.visibility_watermark, row.op_id);
+    if (snapshot.reverse.insert_or_assign(row.target, ReverseEntry{row.logical_id, row.op_id})
+            .second) {
+      ++snapshot.known_row_counts[SegmentIdentity{row.target.segment_id, row.target.generation}];
+    }
+    const auto previous = snapshot.versions.find(row.logical_id);
+    if (previous != snapshot.versions.end()) {
+      auto &count = previous->second.state == VersionState::live ? snapshot.searchable_live_count
+                                                                 : snapshot.tombstone_count;
+      --count;
+    }
+    const auto state = row.action == SegmentMutationAction::write ? VersionState::live
+                                                                  : VersionState::tombstone;
+    snapshot.versions.insert_or_assign(row.logical_id,
+                                       VersionEntry{row.target, row.op_id, state, row.payload});
+    ++(state == VersionState::live ? snapshot.searchable_live_count : snapshot.tombstone_count);
+  }
+
   static void recalculate_counts(RoutingSnapshot &snapshot) {
     snapshot.searchable_live_count = 0;
     snapshot.tombstone_count = 0;
@@ -785,10 +940,13 @@ class SegmentedCollection {
   CollectionSchema schema_{};
   CollectionConfig config_{};
   std::unique_ptr<CollectionLogicalWal> wal_{};
+  std::unique_ptr<CollectionCheckpointStore> checkpoints_{};
   std::map<std::string, MutationReceipt, std::less<>> retry_receipts_{};
   std::map<std::string, BatchMutationReceipt, std::less<>> batch_retry_receipts_{};
   std::shared_ptr<RoutingSnapshot> load_or_initializing_snapshot_{};
   std::uint64_t maximum_recovered_op_id_{};
+  // Written once by open() before the first snapshot is published.
+  CollectionReplayProgress recovery_replay_{};
   RoutingSnapshotPtr snapshot_{};
   mutable std::mutex lifecycle_mutex_{};
   std::condition_variable lifecycle_changed_{};
@@ -802,6 +960,8 @@ class SegmentedCollection {
   std::mutex drain_mutex_{};
   std::mutex checkpoint_mutex_{};
   std::mutex mutation_mutex_{};
+  // Set under mutation_mutex_ when a durable frame still awaits its group sync.
+  bool group_sync_pending_{};
   std::atomic_uint64_t next_op_id_{1};
   std::atomic_uint64_t accepted_count_{};
   std::atomic_uint64_t pending_count_{};
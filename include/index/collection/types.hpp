@@ -4,6 +4,7 @@
 
 #pragma once
 
+#include <chrono>
 #include <compare>
 #include <cstddef>
 #include <cstdint>
@@ -12,6 +13,7 @@
 #include <functional>
 #include <limits>
 #include <map>
+#include <memory>
 #include <optional>
 #include <span>
 #include <string>
@@ -28,6 +30,8 @@ namespace alaya::internal::collection {
 // meaning to the opaque operation payload frozen by contract v3; they are not
 // a second engine boundary and are not bound into Python.
 
+class ArtifactVerificationTask;
+
 struct LogicalIdLess {
   [[nodiscard]] auto operator()(const core::LogicalId &lhs,
                                 const core::LogicalId &rhs) const noexcept -> bool {
@@ -247,11 +251,20 @@ struct CollectionSearchStats {
   // observed. It includes exact-rerank distance work and the remainder of that
   // normalization pass, making it a low-overhead stage-tax measurement.
   std::uint64_t rerank_nanoseconds{};
-  std::uint64_t reserved[3]{};
+  // Page reads the segments sent to the device, and the reads they saved by
+  // joining a concurrent search's in-flight read of the same page.
+  std::uint64_t device_reads{};
+  std::uint64_t coalesced_reads{};
+  std::uint64_t reserved[1]{};
 
   CollectionSearchStats() : header(core::current_struct_header<CollectionSearchStats>()) {}
 };
 
+// How one search round drives the segments of a routing snapshot. parallel
+// issues every segment at once on the shared adapter workers, so the round
+// costs the slowest segment rather than the sum of all of them.
+enum class SegmentFanout : std::uint8_t { sequential = 0, parallel = 1 };
+
 struct CollectionSearchRequest {
   core::TypedTensorView queries{};
   core::SearchOptions options{};
@@ -259,6 +272,7 @@ struct CollectionSearchRequest {
   core::SearchContext *context{};
   CollectionSearchStats *stats{};
   std::uint32_t maximum_overfetch_rounds{4};
+  SegmentFanout fanout{SegmentFanout::parallel};
 };
 
 enum class Projection : std::uint8_t {
@@ -344,6 +358,11 @@ enum class RowMutationStatus : std::uint8_t {
 enum class DurabilityState : std::uint8_t {
   memory_only = 0,
   searchable_not_durable = 1,
+  // The row is published, and so searchable, before the group fdatasync
+  // that makes it durable returns; a crash in that window loses a row that
+  // concurrent readers may already have seen. The receipt is delivered only
+  // after the sync, and until then the snapshot's durable_watermark stays
+  // below the row's sequence.
   wal_fsync = 2,
 };
 
@@ -358,6 +377,8 @@ struct MutationReceipt {
   DurabilityState durability{DurabilityState::memory_only};
   RowMutationStatus row_status{RowMutationStatus::aborted};
   std::string retry_token{};
+
+  auto operator==(const MutationReceipt &) const -> bool = default;
 };
 
 enum class BatchMutationMode : std::uint8_t {
@@ -391,6 +412,8 @@ struct BatchMutationReceipt {
   DurabilityState durability{DurabilityState::memory_only};
   std::string retry_token{};
   std::vector<MutationReceipt> rows{};
+
+  auto operator==(const BatchMutationReceipt &) const -> bool = default;
 };
 
 enum class MutationFailPoint : std::uint8_t {
@@ -404,6 +427,9 @@ enum class MutationFailPoint : std::uint8_t {
   // B-03/B-11 (2B): the C6 window -- the active engine's physical publish has
   // succeeded but the Collection's logical routing snapshot has NOT been swapped.
   after_engine_publish_before_snapshot = 7,
+  // Group commit: the mutation is published and mutation_mutex_ released,
+  // but the fdatasync that makes it durable has not run.
+  before_group_sync = 8,
 };
 
 struct CheckpointReceipt {
@@ -411,6 +437,9 @@ struct CheckpointReceipt {
   std::uint64_t wal_cut{};
   std::uint64_t metadata_epoch{};
   std::string checkpoint_name{};
+  // Why a background merge of the checkpoint chain failed, reported by the
+  // first checkpoint that finds it. The unmerged chain is still valid.
+  core::Status merge_status{};
 };
 
 struct ActiveRotationReceipt {
@@ -445,6 +474,21 @@ struct PersistenceOptions {
 struct WalPersistenceOptions {
   std::filesystem::path root{};
   std::string namespace_name{"collection_wal_v1"};
+  // Delta checkpoint images allowed after a base image before a background
+  // merge folds the chain into a new base. 0 writes a full image every time.
+  // Values above CollectionCheckpointStore::kMaximumDeltas (1024) are clamped.
+  std::uint32_t checkpoint_max_deltas{8};
+};
+
+// Progress of the logical-WAL replay that open() runs after the checkpoint is
+// loaded. The WAL is replayed as it streams, so progress is also reported in
+// bytes of the WAL read so far.
+struct CollectionReplayProgress {
+  std::uint64_t wal_bytes_scanned{};
+  std::uint64_t wal_bytes_total{};
+  std::uint64_t transactions_replayed{};
+  std::uint64_t rows_replayed{};
+  std::chrono::nanoseconds elapsed{};
 };
 
 struct CollectionRecoveryOptions {
@@ -456,6 +500,10 @@ struct CollectionRecoveryOptions {
   // deleted external ID. The importer uses this floor to preserve that
   // committed visibility cut without inventing a logical row/version.
   std::uint64_t minimum_visibility_watermark{};
+  // Called on the opening thread after every replay_progress_interval
+  // replayed transactions and once more when the replay finishes.
+  std::function<void(const CollectionReplayProgress &)> replay_progress{};
+  std::uint64_t replay_progress_interval{4096};
 };
 
 struct CollectionConfig {
@@ -466,6 +514,9 @@ struct CollectionConfig {
   bool read_only{};
   MutationFailPoint fail_point{MutationFailPoint::none};
   std::function<void(MutationFailPoint)> failpoint_hook{};
+  // Background hashing of the sealed segments' artifacts, when open deferred
+  // it. Searches wait for its verdict; close() stops it.
+  std::shared_ptr<ArtifactVerificationTask> artifact_verification{};
 };
 
 enum class LifecycleState : std::uint8_t { open = 0, closing = 1, closed = 2 };
@@ -485,6 +536,10 @@ struct CollectionStats {
   std::uint64_t visibility_watermark{};
   std::uint64_t durable_watermark{};
   std::uint64_t metadata_epoch{};
+  // What open() replayed from the logical WAL.
+  std::uint64_t recovery_replayed_transactions{};
+  std::uint64_t recovery_replayed_rows{};
+  std::uint64_t recovery_replay_nanoseconds{};
   LifecycleState lifecycle{LifecycleState::open};
 
   CollectionStats() : header(core::current_struct_header<CollectionStats>()) {}
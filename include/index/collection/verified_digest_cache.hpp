@@ -0,0 +1,216 @@
+// SPDX-FileCopyrightText: 2026 AlayaDB.AI
+//
+// SPDX-License-Identifier: AGPL-3.0-only
+
+#pragma once
+
+#include <atomic>
+#include <chrono>
+#include <cstddef>
+#include <cstdint>
+#include <deque>
+#include <filesystem>
+#include <map>
+#include <mutex>
+#include <optional>
+#include <span>
+#include <sstream>
+#include <string>
+#include <system_error>
+
+#include "index/collection/sha256.hpp"
+#include "platform/fs.hpp"
+
+namespace alaya::internal::collection {
+
+// Process-wide memo of artifact digests this process computed itself, keyed by
+// platform::FileIdentity rather than by path. Every segment open reads the
+// whole collection manifest, so without it a collection with N segments
+// hashes every artifact N times. An entry only answers for a file whose
+// device, inode, size, mtime, and ctime all still match; any rewrite misses
+// and is hashed afresh. It does not catch media corruption under an unchanged
+// file, which is why the reader lets callers turn it off.
+//
+// Timestamps come from a coarse clock, so a rewrite in the same tick as the
+// hash could keep the old identity. Files changed within `racy_window` of the
+// moment they were hashed are therefore never remembered (git's "racily
+// clean" rule); the default also covers one-second-granularity filesystems.
+class VerifiedDigestCache {
+ public:
+  static constexpr std::size_t kDefaultCapacity = 1U << 16U;
+  static constexpr std::chrono::nanoseconds kDefaultRacyWindow = std::chrono::seconds(2);
+
+  // Never destroyed: a background verifier may still be running at exit.
+  [[nodiscard]] static auto instance() -> VerifiedDigestCache & {
+    static auto *cache = new VerifiedDigestCache(kDefaultCapacity);
+    return *cache;
+  }
+
+  explicit VerifiedDigestCache(std::size_t capacity,
+                               std::chrono::nanoseconds racy_window = kDefaultRacyWindow)
+      : capacity_(capacity == 0 ? 1 : capacity), racy_window_(racy_window) {}
+
+  [[nodiscard]] auto find(const platform::FileIdentity &identity) const
+      -> std::optional<Sha256Digest> {
+    std::lock_guard lock(mutex_);
+    const auto found = entries_.find(identity);
+    if (found == entries_.end()) {
+      return std::nullopt;
+    }
+    return found->second;
+  }
+
+  // `hashed_at` is the wall-clock time, in nanoseconds since the epoch, taken
+  // before `identity` was read. Oldest entries are evicted first once the
+  // cache is full.
+  void remember(const platform::FileIdentity &identity,
+                const Sha256Digest &digest,
+                std::int64_t hashed_at) {
+    if (identity.ctime_ns > hashed_at - racy_window_.count()) {
+      return;
+    }
+    insert(identity, digest);
+  }
+
+  // For a digest taken from the bytes as this process wrote them, of a file
+  // it created privately and never writes again. The racy window guards
+  // against someone else rewriting a file within the hashing tick, which
+  // cannot happen here, so the entry is kept however fresh the file is.
+  // `identity` must be read after the last write, link, or rename of the file
+  // itself.
+  void remember_written(const platform::FileIdentity &identity, const Sha256Digest &digest) {
+    insert(identity, digest);
+  }
+
+  void clear() {
+    std::lock_guard lock(mutex_);
+    entries_.clear();
+    insertion_order_.clear();
+  }
+
+  [[nodiscard]] auto size() const -> std::size_t {
+    std::lock_guard lock(mutex_);
+    return entries_.size();
+  }
+
+ private:
+  void insert(const platform::FileIdentity &identity, const Sha256Digest &digest) {
+    std::lock_guard lock(mutex_);
+    const auto [entry, inserted] = entries_.insert_or_assign(identity, digest);
+    if (!inserted) {
+      return;
+    }
+    insertion_order_.push_back(entry->first);
+    while (entries_.size() > capacity_) {
+      entries_.erase(insertion_order_.front());
+      insertion_order_.pop_front();
+    }
+  }
+
+  std::size_t capacity_;
+  std::chrono::nanoseconds racy_window_;
+  mutable std::mutex mutex_;
+  std::map<platform::FileIdentity, Sha256Digest> entries_;
+  std::deque<platform::FileIdentity> insertion_order_;
+};
+
+// Verified digests that outlive the process, kept next to the artifacts they
+// vouch for: one "<device> <inode> <size> <mtime_ns> <ctime_ns> <sha256>"
+// line per file. load() seeds a VerifiedDigestCache with them, so a restart
+// trusts an unchanged artifact without hashing it again; store() writes back
+// what the cache vouches for after a verification. The sidecar is only a
+// hint: entries answer for exactly the same file identity as in memory, a
+// malformed line is skipped, and a reader that sees a cached digest disagree
+// with the manifest hashes the file before it reports corruption.
+class VerifiedDigestSidecar {
+ public:
+  static constexpr std::size_t kMaximumBytes = 16U << 20U;
+
+  // A missing or unreadable sidecar seeds nothing.
+  static void load(const std::filesystem::path &path, VerifiedDigestCache &cache) noexcept {
+    try {
+      if (!std::filesystem::is_regular_file(path)) {
+        return;
+      }
+      std::istringstream lines(platform::read_regular_file_bounded(path, kMaximumBytes));
+      for (std::string line; std::getline(lines, line);) {
+        std::istringstream fields(line);
+        platform::FileIdentity identity;
+        std::string hex;
+        if (fields >> identity.device >> identity.inode >> identity.size >> identity.mtime_ns >>
+            identity.ctime_ns >> hex) {
+          try {
+            cache.remember_written(identity, Sha256Digest::from_hex(hex));
+          } catch (const std::invalid_argument &) {
+            continue;
+          }
+        }
+      }
+    } catch (...) {
+      return;
+    }
+  }
+
+  // Rewrites the sidecar with the digests `cache` holds for the current
+  // identity of `files`. Best effort: a failure leaves the old sidecar, or
+  // none, and the next open hashes again.
+  static void store(const std::filesystem::path &path,
+                    std::span<const std::filesystem::path> files,
+                    const VerifiedDigestCache &cache) noexcept {
+    try {
+      std::string body;
+      for (const auto &file : files) {
+        const auto identity = platform::file_identity(file);
+        const auto digest = identity.has_value() ? cache.find(*identity) : std::nullopt;
+        if (digest.has_value()) {
+          body += std::to_string(identity->device) + ' ' + std::to_string(identity->inode) + ' ' +
+                  std::to_string(identity->size) + ' ' + std::to_string(identity->mtime_ns) +
+                  ' ' + std::to_string(identity->ctime_ns) + ' ' + digest->hex() + '\n';
+        }
+      }
+      if (body.empty() || (std::filesystem::is_regular_file(path) &&
+                           platform::read_regular_file_bounded(path, kMaximumBytes) == body)) {
+        return;
+      }
+      std::error_code error;
+      std::filesystem::create_directories(path.parent_path(), error);
+      // Opens of one collection may store at once; each writes its own
+      // temporary and the last rename wins.
+      static std::atomic<std::uint64_t> sequence{};
+      auto temporary = path;
+      temporary += ".tmp." + std::to_string(platform::get_pid()) + "." +
+                   std::to_string(sequence.fetch_add(1, std::memory_order_relaxed));
+      platform::write_all_fsync(temporary, body.data(), body.size());
+      std::filesystem::rename(temporary, path, error);
+      if (error) {
+        std::filesystem::remove(temporary, error);
+      }
+    } catch (...) {
+      return;
+    }
+  }
+};
+
+// sha256_file, answered from `cache` when it holds the file's current
+// identity. A freshly computed digest is remembered only if the identity read
+// before hashing still holds afterwards, so a file that changed mid-hash is
+// never vouched for. A null `cache` always hashes.
+[[nodiscard]] inline auto sha256_file_cached(const std::filesystem::path &path,
+                                             VerifiedDigestCache *cache) -> Sha256Digest {
+  const auto hashed_at = std::chrono::duration_cast<std::chrono::nanoseconds>(
+                             std::chrono::system_clock::now().time_since_epoch())
+                             .count();
+  const auto before = cache == nullptr ? std::nullopt : platform::file_identity(path);
+  if (before.has_value()) {
+    if (auto known = cache->find(*before); known.has_value()) {
+      return *known;
+    }
+  }
+  auto digest = sha256_file(path);
+  if (before.has_value() && platform::file_identity(path) == before) {
+    cache->remember(*before, digest, hashed_at);
+  }
+  return digest;
+}
+
+}  // namespace alaya::internal::collection
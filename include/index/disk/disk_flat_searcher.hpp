@@ -5,16 +5,21 @@
 #pragma once
 
 #include <algorithm>
+#include <atomic>
 #include <bit>
 #include <cmath>
+#include <condition_variable>
 #include <cstddef>
 #include <cstdint>
 #include <cstring>
 #include <filesystem>
 #include <memory>
+#include <mutex>
+#include <span>
 #include <stdexcept>
 #include <string>
 #include <vector>
+#include "core/any_segment.hpp"
 #include "core/value_types.hpp"
 #include "index/disk/disk_flat_builder.hpp"  // bit-pattern helpers in alaya::disk::detail
 #include "index/disk/segment_manifest.hpp"
@@ -60,6 +65,16 @@ struct AlignedFreeDeleter {
 
 using AlignedFloatBuffer = std::unique_ptr<float, AlignedFreeDeleter>;
 
+// Tile budgets for DiskFlatSegmentSearcher::search_many, in bytes of vector
+// data. Both a row tile and a query tile stay resident in a typical 1-2 MiB
+// L2 while every query of the tile is scored against every row of the tile.
+constexpr size_t kBatchRowTileBytes = size_t{256} << 10U;
+constexpr size_t kBatchQueryTileBytes = size_t{256} << 10U;
+
+// Smallest row range worth handing to another worker under
+// DiskSearchOptions::scan_threads; below it, the hand-off outweighs the scan.
+constexpr uint64_t kMinRowsPerScanWorker = uint64_t{1} << 16U;
+
 inline auto allocate_aligned_floats(size_t count) -> AlignedFloatBuffer {
   constexpr size_t kAlign = 64;
   const size_t bytes = ((count * sizeof(float) + kAlign - 1) / kAlign) * kAlign;
@@ -105,6 +120,8 @@ class DiskFlatSegmentSearcher : public SegmentSearcher {
                                std::to_string(vectors_mmap_.size()) + " for " +
                                manifest_.vectors_file);
     }
+    // Every search reads the vectors file front to back.
+    vectors_mmap_.advise(alaya::storage::MMapAccess::sequential);
   }
 
   DiskFlatSegmentSearcher(const DiskFlatSegmentSearcher &) = delete;
@@ -123,83 +140,159 @@ class DiskFlatSegmentSearcher : public SegmentSearcher {
     }
     const uint32_t d = static_cast<uint32_t>(manifest_.dim);
 
-    for (uint32_t c = 0; c < d; ++c) {
-      const float v = query[c];
-      if (!detail::is_finite_f32(v)) {
-        if (detail::is_nan_f32(v)) {
-          throw std::invalid_argument("DiskFlatSegmentSearcher: NaN query component at position " +
-                                      std::to_string(c));
-        }
-        const std::string sign = detail::is_neg_f32(v) ? "-Inf" : "+Inf";
-        throw std::invalid_argument("DiskFlatSegmentSearcher: Inf query component at position " +
-                                    std::to_string(c) + " (" + sign + ")");
-      }
+    detail::AlignedFloatBuffer normalized_query;
+    if (manifest_.metric == core::Metric::cosine) {
+      normalized_query = detail::allocate_aligned_floats(d);
     }
+    const float *effective_query = prepare_query(query, normalized_query.get());
+    const KernelFn kernel = select_kernel();
 
-    const float *effective_query = query;
-    detail::AlignedFloatBuffer normalized_query;
+    const auto *vectors = static_cast<const float *>(vectors_mmap_.data());
+    const auto *ids = static_cast<const uint64_t *>(ids_mmap_.data());
+    const uint64_t count = manifest_.count;
+    const uint64_t k = std::min<uint64_t>(opts.top_k, count);
 
-    if (manifest_.metric == core::Metric::cosine) {
-      double sum_sq = 0.0;
-      for (uint32_t c = 0; c < d; ++c) {
-        const double v = static_cast<double>(query[c]);
-        sum_sq += v * v;
-      }
-      if (sum_sq == 0.0) {
-        throw std::invalid_argument(
-            "DiskFlatSegmentSearcher: zero-magnitude query under COS metric");
+    const uint64_t workers = std::clamp<uint64_t>(count / detail::kMinRowsPerScanWorker,
+                                                  1,
+                                                  std::max<uint32_t>(opts.scan_threads, 1));
+    const uint64_t chunk = (count + workers - 1) / workers;
+    std::vector<std::vector<DiskSearchHit>> partial(workers);
+    for (auto &heap : partial) {
+      heap.reserve(k);
+    }
+    auto scan = [&](uint64_t worker) {
+      auto &heap = partial[worker];
+      const uint64_t end = std::min(count, (worker + 1) * chunk);
+      for (uint64_t i = worker * chunk; i < end; ++i) {
+        offer(heap, k, DiskSearchHit{ids[i], kernel(effective_query, vectors + i * d, d)});
       }
-      const double inv_norm = 1.0 / std::sqrt(sum_sq);
-      if (!detail::is_finite_f64(inv_norm)) {
-        throw std::runtime_error(
-            "DiskFlatSegmentSearcher: non-finite inverse norm of query (defence in depth)");
+    };
+
+    if (workers > 1) {
+      // Helpers on the shared sync-adapter workers and the caller claim row
+      // ranges from one cursor. The caller keeps claiming until none are
+      // left, so the scan never waits for a free worker (the caller may be
+      // one); it then waits only for ranges a helper has already started. A
+      // helper that starts late touches nothing but the shared cursor.
+      struct Round {
+        std::atomic<uint64_t> next{};
+        std::mutex mutex{};
+        std::condition_variable finished{};
+        uint64_t completed{};
+      };
+      auto round = std::make_shared<Round>();
+      const auto drain = [round, workers, &scan] {
+        for (;;) {
+          const auto worker = round->next.fetch_add(1, std::memory_order_acq_rel);
+          if (worker >= workers) {
+            return;
+          }
+          scan(worker);
+          {
+            std::lock_guard lock(round->mutex);
+            ++round->completed;
+          }
+          round->finished.notify_all();
+        }
+      };
+      for (uint64_t helper = 1; helper < workers; ++helper) {
+        try {
+          core::detail::SyncAdapterExecutor::instance().submit(drain);
+        } catch (...) {
+          break;  // The caller scans whatever no helper picks up.
+        }
       }
-      normalized_query = detail::allocate_aligned_floats(d);
-      for (uint32_t c = 0; c < d; ++c) {
-        normalized_query.get()[c] = static_cast<float>(static_cast<double>(query[c]) * inv_norm);
+      drain();
+      std::unique_lock lock(round->mutex);
+      round->finished.wait(lock, [&] {
+        return round->completed == workers;
+      });
+    } else {
+      scan(0);
+    }
+
+    auto heap = std::move(partial.front());
+    for (uint64_t worker = 1; worker < workers; ++worker) {
+      for (const auto &hit : partial[worker]) {
+        offer(heap, k, hit);
       }
-      effective_query = normalized_query.get();
     }
+    std::sort(heap.begin(), heap.end(), hit_less);
+    return heap;
+  }
+
+  auto batch_search(const float *queries, uint32_t num_queries, const DiskSearchOptions &opts) const
+      -> std::vector<std::vector<DiskSearchHit>> override {
+    if (num_queries != 0 && queries == nullptr) {
+      throw std::invalid_argument("DiskFlatSegmentSearcher: queries must not be null");
+    }
+    std::vector<const float *> rows(num_queries);
+    for (uint32_t q = 0; q < num_queries; ++q) {
+      rows[q] = queries + static_cast<size_t>(q) * manifest_.dim;
+    }
+    return search_many(rows, opts);
+  }
+
+  // Scores every query against the segment in one tiled pass: a tile of rows
+  // is scored against every query of a query tile before the scan moves on,
+  // so the vectors mmap is streamed once per query tile instead of once per
+  // query. Each query keeps its own top-k heap and sees rows in the same
+  // order as search(), so the results are identical to one search() call per
+  // query. Any invalid query throws before scanning starts. A batch is one
+  // lane, so `opts.scan_threads` does not apply here.
+  auto search_many(std::span<const float *const> queries, const DiskSearchOptions &opts) const
+      -> std::vector<std::vector<DiskSearchHit>> {
+    if (opts.top_k == 0) {
+      throw std::invalid_argument("DiskFlatSegmentSearcher: top_k must be > 0");
+    }
+    const uint32_t d = static_cast<uint32_t>(manifest_.dim);
+    const size_t num_queries = queries.size();
 
-    // Hoist SIMD dispatch out of the per-row loop (D12: no virtual / dispatch
-    // call inside the hot loop). The simd::l2_sqr<float,float> wrapper resolves
-    // a function pointer via get_l2_sqr_func() on every call; lifting the
-    // pointer out of the loop removes one indirection per row.
-    using KernelFn = float (*)(const float *__restrict, const float *__restrict, size_t);
-    const KernelFn kernel = (manifest_.metric == core::Metric::l2)
-                                ? static_cast<KernelFn>(simd::get_l2_sqr_func())
-                                : static_cast<KernelFn>(simd::get_ip_sqr_func());
+    detail::AlignedFloatBuffer normalized_queries;
+    if (manifest_.metric == core::Metric::cosine && num_queries != 0) {
+      normalized_queries = detail::allocate_aligned_floats(num_queries * d);
+    }
+    std::vector<const float *> effective(num_queries);
+    for (size_t q = 0; q < num_queries; ++q) {
+      if (queries[q] == nullptr) {
+        throw std::invalid_argument("DiskFlatSegmentSearcher: query must not be null");
+      }
+      float *scratch = normalized_queries ? normalized_queries.get() + q * d : nullptr;
+      effective[q] = prepare_query(queries[q], scratch);
+    }
+    const KernelFn kernel = select_kernel();
 
     const auto *vectors = static_cast<const float *>(vectors_mmap_.data());
     const auto *ids = static_cast<const uint64_t *>(ids_mmap_.data());
     const uint64_t count = manifest_.count;
     const uint64_t k = std::min<uint64_t>(opts.top_k, count);
 
-    auto cmp = [](const DiskSearchHit &a, const DiskSearchHit &b) {
-      if (a.distance != b.distance) {
-        return a.distance < b.distance;
-      }
-      return a.label < b.label;
-    };
+    std::vector<std::vector<DiskSearchHit>> heaps(num_queries);
+    for (auto &heap : heaps) {
+      heap.reserve(k);
+    }
 
-    std::vector<DiskSearchHit> heap;
-    heap.reserve(k);
-
-    for (uint64_t i = 0; i < count; ++i) {
-      const float dist = kernel(effective_query, vectors + i * d, d);
-      const DiskSearchHit hit{ids[i], dist};
-      if (heap.size() < k) {
-        heap.push_back(hit);
-        std::push_heap(heap.begin(), heap.end(), cmp);
-      } else if (cmp(hit, heap.front())) {
-        std::pop_heap(heap.begin(), heap.end(), cmp);
-        heap.back() = hit;
-        std::push_heap(heap.begin(), heap.end(), cmp);
+    const size_t row_bytes = static_cast<size_t>(d) * sizeof(float);
+    const uint64_t row_tile = std::max<size_t>(detail::kBatchRowTileBytes / row_bytes, 1);
+    const size_t query_tile = std::max<size_t>(detail::kBatchQueryTileBytes / row_bytes, 1);
+    for (size_t query_begin = 0; query_begin < num_queries; query_begin += query_tile) {
+      const size_t query_end = std::min(num_queries, query_begin + query_tile);
+      for (uint64_t row_begin = 0; row_begin < count; row_begin += row_tile) {
+        const uint64_t row_end = std::min(count, row_begin + row_tile);
+        for (size_t q = query_begin; q < query_end; ++q) {
+          auto &heap = heaps[q];
+          const float *query = effective[q];
+          for (uint64_t i = row_begin; i < row_end; ++i) {
+            offer(heap, k, DiskSearchHit{ids[i], kernel(query, vectors + i * d, d)});
+          }
+        }
       }
     }
 
-    std::sort(heap.begin(), heap.end(), cmp);
-    return heap;
+    for (auto &heap : heaps) {
+      std::sort(heap.begin(), heap.end(), hit_less);
+    }
+    return heaps;
   }
 
   auto size() const -> uint64_t override { return manifest_.count; }
@@ -223,6 +316,75 @@ class DiskFlatSegmentSearcher : public SegmentSearcher {
  private:
   static constexpr uint64_t kMaxDim = static_cast<uint64_t>(UINT32_MAX);
 
+  using KernelFn = float (*)(const float *__restrict, const float *__restrict, size_t);
+
+  static auto hit_less(const DiskSearchHit &a, const DiskSearchHit &b) -> bool {
+    if (a.distance != b.distance) {
+      return a.distance < b.distance;
+    }
+    return a.label < b.label;
+  }
+
+  // Keeps the k best hits seen so far as a max-heap under hit_less.
+  static void offer(std::vector<DiskSearchHit> &heap, uint64_t k, const DiskSearchHit &hit) {
+    if (heap.size() < k) {
+      heap.push_back(hit);
+      std::push_heap(heap.begin(), heap.end(), hit_less);
+    } else if (hit_less(hit, heap.front())) {
+      std::pop_heap(heap.begin(), heap.end(), hit_less);
+      heap.back() = hit;
+      std::push_heap(heap.begin(), heap.end(), hit_less);
+    }
+  }
+
+  // Hoist SIMD dispatch out of the per-row loop (D12: no virtual / dispatch
+  // call inside the hot loop). The simd::l2_sqr<float,float> wrapper resolves
+  // a function pointer via get_l2_sqr_func() on every call; lifting the
+  // pointer out of the loop removes one indirection per row.
+  auto select_kernel() const -> KernelFn {
+    return (manifest_.metric == core::Metric::l2)
+               ? static_cast<KernelFn>(simd::get_l2_sqr_func())
+               : static_cast<KernelFn>(simd::get_ip_sqr_func());
+  }
+
+  // Rejects non-finite components and, under COS, writes the L2-normalized
+  // query to `normalized` (dim() floats). Returns the vector to score with.
+  auto prepare_query(const float *query, float *normalized) const -> const float * {
+    const uint32_t d = static_cast<uint32_t>(manifest_.dim);
+    for (uint32_t c = 0; c < d; ++c) {
+      const float v = query[c];
+      if (!detail::is_finite_f32(v)) {
+        if (detail::is_nan_f32(v)) {
+          throw std::invalid_argument("DiskFlatSegmentSearcher: NaN query component at position " +
+                                      std::to_string(c));
+        }
+        const std::string sign = detail::is_neg_f32(v) ? "-Inf" : "+Inf";
+        throw std::invalid_argument("DiskFlatSegmentSearcher: Inf query component at position " +
+                                    std::to_string(c) + " (" + sign + ")");
+      }
+    }
+    if (manifest_.metric != core::Metric::cosine) {
+      return query;
+    }
+    double sum_sq = 0.0;
+    for (uint32_t c = 0; c < d; ++c) {
+      const double v = static_cast<double>(query[c]);
+      sum_sq += v * v;
+    }
+    if (sum_sq == 0.0) {
+      throw std::invalid_argument("DiskFlatSegmentSearcher: zero-magnitude query under COS metric");
+    }
+    const double inv_norm = 1.0 / std::sqrt(sum_sq);
+    if (!detail::is_finite_f64(inv_norm)) {
+      throw std::runtime_error(
+          "DiskFlatSegmentSearcher: non-finite inverse norm of query (defence in depth)");
+    }
+    for (uint32_t c = 0; c < d; ++c) {
+      normalized[c] = static_cast<float>(static_cast<double>(query[c]) * inv_norm);
+    }
+    return normalized;
+  }
+
   SegmentManifest manifest_;
   alaya::storage::MMapFile ids_mmap_;
   alaya::storage::MMapFile vectors_mmap_;
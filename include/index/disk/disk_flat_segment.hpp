@@ -63,6 +63,29 @@ struct DiskFlatPublicationOptions {
   std::optional<internal::collection::ArtifactManifestV2> base_manifest{};
 };
 
+// Optional flat search extension. `scan_threads` maps to
+// DiskSearchOptions::scan_threads: a single query's rows are split into up
+// to that many ranges scanned in parallel. Multi-query requests keep the tiled
+// single-lane scan unless it is above 1.
+struct DiskFlatSegmentSearchExtension {
+  core::VersionedStructHeader header{};
+  std::uint32_t scan_threads{1};
+  std::uint8_t reserved_bytes[4]{};
+  std::uint64_t reserved[3]{};
+
+  DiskFlatSegmentSearchExtension()
+      : header(core::current_struct_header<DiskFlatSegmentSearchExtension>()) {}
+};
+
+[[nodiscard]] inline auto make_disk_flat_segment_search_extension(
+    const DiskFlatSegmentSearchExtension &options) -> core::AlgorithmSearchExtension {
+  core::AlgorithmSearchExtension extension;
+  extension.algorithm_id = core::algorithm::flat;
+  extension.payload = std::addressof(options);
+  extension.payload_size = sizeof(options);
+  return extension;
+}
+
 struct DiskFlatExportBatch {
   std::uint64_t row_offset{};
   std::span<const std::uint64_t> logical_ids{};
@@ -330,6 +353,12 @@ class DiskFlatSegment {
     if (!opened.ok()) {
       return opened.status();
     }
+    // A lone segment has nowhere to keep a background verdict, so it waits
+    // for it. Collection verifies once itself and opens with verify_artifacts
+    // off.
+    if (auto verified = opened.value().wait_for_verification(); !verified.ok()) {
+      return verified;
+    }
     const auto &segments = opened.value().manifest.segments;
     const auto found = std::find_if(segments.begin(), segments.end(), [&](const auto &entry) {
       return entry.segment_id == segment_id;
@@ -363,6 +392,11 @@ class DiskFlatSegment {
     return open(core::ArtifactView(locations), open_options, context);
   }
 
+  [[nodiscard]] static auto make_search_extension(const DiskFlatSegmentSearchExtension &options)
+      -> core::AlgorithmSearchExtension {
+    return make_disk_flat_segment_search_extension(options);
+  }
+
   [[nodiscard]] auto descriptor() const noexcept -> core::Descriptor {
     core::Descriptor descriptor;
     descriptor.algorithm_id = core::algorithm::flat;
@@ -769,11 +803,28 @@ class DiskFlatSegment {
                                  "DiskFlat top_k exceeds uint32");
     }
     for (const auto &extension : request.options.extensions) {
-      if (extension.unknown_policy == core::UnknownExtensionPolicy::reject) {
+      if (extension.algorithm_id != core::algorithm::flat) {
+        if (extension.unknown_policy == core::UnknownExtensionPolicy::reject) {
+          return core::Status::error(core::StatusCode::invalid_argument,
+                                     core::OperationStage::validation,
+                                     core::StatusDetail::unknown_extension,
+                                     "DiskFlat received an extension for another algorithm");
+        }
+        continue;
+      }
+      if (extension.payload == nullptr ||
+          extension.payload_size < sizeof(DiskFlatSegmentSearchExtension)) {
         return core::Status::error(core::StatusCode::invalid_argument,
                                    core::OperationStage::validation,
-                                   core::StatusDetail::unknown_extension,
-                                   "DiskFlat defines no algorithm-specific search extension");
+                                   core::StatusDetail::malformed_struct,
+                                   "DiskFlat search extension payload is truncated");
+      }
+      const auto &typed = *static_cast<const DiskFlatSegmentSearchExtension *>(extension.payload);
+      if (!core::is_current_struct(typed) || typed.scan_threads == 0) {
+        return core::Status::error(core::StatusCode::invalid_argument,
+                                   core::OperationStage::validation,
+                                   core::StatusDetail::malformed_struct,
+                                   "DiskFlat search extension values are invalid");
       }
     }
     status = core::validate_runtime_control(request.context->deadline,
@@ -844,8 +895,19 @@ class DiskFlatSegment {
     DiskSearchOptions options;
     options.top_k = static_cast<std::uint32_t>(request.options.top_k);
     options.exact_rerank = true;
+    for (const auto &extension : request.options.extensions) {
+      if (extension.algorithm_id == core::algorithm::flat) {
+        options.scan_threads =
+            static_cast<const DiskFlatSegmentSearchExtension *>(extension.payload)->scan_threads;
+      }
+    }
     response.query_count = request.queries.rows;
     response.offsets[0] = 0;
+    if (request.queries.rows > 1 && options.scan_threads <= 1 &&
+        search_tiled_batch(request, options)) {
+      record_scan_stats(request);
+      return core::Status::success();
+    }
     core::RowCount cursor{};
     for (core::RowCount row = 0; row < request.queries.rows; ++row) {
       const auto control = core::validate_runtime_control(request.context->deadline,
@@ -861,23 +923,10 @@ class DiskFlatSegment {
         return request.queries.rows == 1 ? control : core::Status::success();
       }
       try {
-        const auto hits = searcher_->search(request.queries.row<float>(row), options);
-        for (std::size_t index = 0; index < hits.size(); ++index) {
-          response.hits[static_cast<std::size_t>(cursor + index)] =
-              core::SearchHit(core::SegmentRowId(hits[index].label),
-                              hits[index].distance,
-                              core::ScoreKind::distance,
-                              response.comparable_metric,
-                              core::ResultFlag::none);
-        }
-        const auto written = static_cast<core::RowCount>(hits.size());
-        cursor += written;
-        response.offsets[row + 1] = cursor;
-        response.valid_counts[row] = written;
-        response.statuses[row] = core::Status::success();
-        response.completeness[row] = written == request.options.top_k
-                                         ? core::SearchCompleteness::complete_k
-                                         : core::SearchCompleteness::eligible_exhausted;
+        write_row_hits(request,
+                       row,
+                       searcher_->search(request.queries.row<float>(row), options),
+                       cursor);
       } catch (...) {
         const auto failure = core::status_from_exception(core::OperationStage::search);
         response.offsets[row + 1] = cursor;
@@ -889,13 +938,70 @@ class DiskFlatSegment {
         }
       }
     }
+    record_scan_stats(request);
+    return core::Status::success();
+  }
+
+  // Multi-query fast path: one tiled scan serves every query (see
+  // DiskFlatSegmentSearcher::search_many). Deadline and cancellation are
+  // checked once up front because the scan is not interruptible. Returns
+  // false without touching the response when any query is invalid, so the
+  // per-row loop can report the failure against that row alone.
+  [[nodiscard]] auto search_tiled_batch(const core::SearchRequest &request,
+                                        const DiskSearchOptions &options) const -> bool {
+    const auto control = core::validate_runtime_control(request.context->deadline,
+                                                        request.context->cancellation,
+                                                        core::OperationStage::search);
+    if (!control.ok()) {
+      return false;
+    }
+    std::vector<std::vector<DiskSearchHit>> hits;
+    try {
+      std::vector<const float *> queries(static_cast<std::size_t>(request.queries.rows));
+      for (core::RowCount row = 0; row < request.queries.rows; ++row) {
+        queries[static_cast<std::size_t>(row)] = request.queries.row<float>(row);
+      }
+      hits = searcher_->search_many(queries, options);
+    } catch (...) {
+      return false;
+    }
+    core::RowCount cursor{};
+    for (core::RowCount row = 0; row < request.queries.rows; ++row) {
+      write_row_hits(request, row, hits[static_cast<std::size_t>(row)], cursor);
+    }
+    return true;
+  }
+
+  void write_row_hits(const core::SearchRequest &request,
+                      core::RowCount row,
+                      const std::vector<DiskSearchHit> &hits,
+                      core::RowCount &cursor) const {
+    auto &response = *request.response;
+    for (std::size_t index = 0; index < hits.size(); ++index) {
+      response.hits[static_cast<std::size_t>(cursor + index)] =
+          core::SearchHit(core::SegmentRowId(hits[index].label),
+                          hits[index].distance,
+                          core::ScoreKind::distance,
+                          response.comparable_metric,
+                          core::ResultFlag::none);
+    }
+    const auto written = static_cast<core::RowCount>(hits.size());
+    cursor += written;
+    response.offsets[row + 1] = cursor;
+    response.valid_counts[row] = written;
+    response.statuses[row] = core::Status::success();
+    response.completeness[row] = written == request.options.top_k
+                                     ? core::SearchCompleteness::complete_k
+                                     : core::SearchCompleteness::eligible_exhausted;
+  }
+
+  void record_scan_stats(const core::SearchRequest &request) const {
     if (request.context->stats != nullptr) {
       request.context->stats->visited += searcher_->size() * request.queries.rows;
       request.context->stats->io_requests += request.queries.rows;
       request.context->stats->io_bytes +=
           searcher_->size() * searcher_->dim() * sizeof(float) * request.queries.rows;
     }
-    return core::Status::success();
   }
 
   std::shared_ptr<DiskFlatSegmentSearcher> searcher_{};
@@ -49,7 +49,7 @@ namespace detail {
 // is now the actual production decision point: LaserSegment::open() below
 // consults it to pick which searcher to construct. Explicit request only,
 // so the default load path stays byte-identical to the legacy searcher:
-//   segment manifest x_laser_residency = paged_pool | resident_arena
+//   segment manifest x_laser_residency = paged_pool | resident_arena | mapped_arena
 //   env ALAYA_LASER_RESIDENCY overrides the manifest (same values)
 // Neither present -> nullopt -> legacy LaserSegmentSearcher.
 inline auto laser_residency_request(const SegmentManifest &sm)
@@ -246,7 +246,7 @@ class LaserSegment {
         return status;
       }
       const auto residency = detail::laser_residency_request(native);
-      if (residency.has_value() && *residency == ::alaya::laser::ResidencyMode::kResidentArena) {
+      if (residency.has_value() && *residency != ::alaya::laser::ResidencyMode::kPagedPool) {
         auto unified_searcher =
             std::make_shared<UnifiedLaserSegmentSearcher>(directory, *residency);
         return std::unique_ptr<LaserSegment>(new LaserSegment(nullptr,
@@ -320,6 +320,12 @@ class LaserSegment {
     if (!opened.ok()) {
       return opened.status();
     }
+    // A lone segment has nowhere to keep a background verdict, so it waits
+    // for it. Collection verifies once itself and opens with verify_artifacts
+    // off.
+    if (auto verified = opened.value().wait_for_verification(); !verified.ok()) {
+      return verified;
+    }
     const auto &segments = opened.value().manifest.segments;
     const auto found = std::find_if(segments.begin(), segments.end(), [&](const auto &entry) {
       return entry.segment_id == segment_id;
@@ -893,6 +899,9 @@ class LaserSegment {
     }
     response.query_count = request.queries.rows;
     response.offsets[0] = 0;
+#if ALAYA_DISK_LASER_SEGMENT_SUPPORTED && !defined(_WIN32)
+    ::alaya::laser::PageReadTally page_reads;
+#endif
     core::RowCount cursor{};
     for (core::RowCount row = 0; row < request.queries.rows; ++row) {
       const auto control = core::validate_runtime_control(request.context->deadline,
@@ -950,6 +959,10 @@ class LaserSegment {
       request.context->stats->visited += visited * request.queries.rows;
       request.context->stats->io_requests += request.queries.rows;
       request.context->stats->io_bytes += artifact_bytes_ * request.queries.rows;
+#if ALAYA_DISK_LASER_SEGMENT_SUPPORTED && !defined(_WIN32)
+      request.context->stats->device_reads += page_reads.stats().device_reads;
+      request.context->stats->coalesced_reads += page_reads.stats().coalesced_reads;
+#endif
     }
     return core::Status::success();
   }
@@ -1121,7 +1134,7 @@ class LaserSegment {
   // default/paged-pool path (byte-identical to pre-residency-wiring
   // behavior when no residency is configured); unified_searcher_ is
   // populated only when a manifest/env residency request resolves to
-  // kResidentArena.
+  // kResidentArena or kMappedArena.
   std::shared_ptr<LaserSegmentSearcher> legacy_searcher_{};
   std::shared_ptr<UnifiedLaserSegmentSearcher> unified_searcher_{};
   SegmentManifest native_{};
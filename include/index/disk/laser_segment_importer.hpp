@@ -11,22 +11,30 @@
   #include <cstdio>
   #include <cstring>
   #include <limits>
+  #include <optional>
+  #include <span>
   #include <sstream>
   #include <stdexcept>
   #include <string>
   #include <utility>
   #include <vector>
 
+  #include "index/collection/verified_digest_cache.hpp"
   #include "index/disk/disk_flat_builder.hpp"
   #include "index/graph/laser/qg/qg.hpp"
   #include "index/graph/laser/qg/residency.hpp"
   #include "platform/fs.hpp"
+  #include "storage/io/file_transfer.hpp"
 #endif
 
+#include <cstddef>
 #include <cstdint>
 #include <filesystem>
+#include <map>
+#include <string>
 #include <string_view>
 
+#include "index/collection/sha256.hpp"
 #include "index/disk/segment_manifest.hpp"
 #include "index/disk/types.hpp"
 
@@ -68,13 +76,27 @@ struct LaserSegmentImportParams {
   uint32_t default_ef = 200;
   uint32_t default_beam_width = 4;
   float search_dram_budget_gb = 0.5F;
+  // true: each artifact lands as its own inode (rename if move_files, else
+  // reflink, copy_file_range or a parallel chunked copy). false: hard links.
   bool copy_files = true;
+  // With copy_files, rename artifacts out of src_dir when it shares the
+  // segment's filesystem. The caller gives the source files up.
+  bool move_files = false;
+  // Worker threads for the chunked-copy fallback; 0 = hardware_concurrency().
+  std::size_t copy_threads = 0;
   // Optional residency request recorded as manifest extra x_laser_residency
-  // ("paged_pool" | "resident_arena"). Empty = no extra; the segment loads
+  // ("paged_pool" | "resident_arena" | "mapped_arena"). Empty = no extra; the segment loads
   // through the legacy searcher exactly as before. See
   // laser_segment.hpp::detail::laser_residency_request for the load-side
   // contract (moved there from segment_factory.hpp; see the U2-c manifest).
   std::string residency{};
+  // Further x_ manifest extras recorded verbatim (e.g. carried over from a
+  // segment being rewritten). Keys the importer writes itself take precedence.
+  std::map<std::string, std::string> extras{};
+  // SHA-256 of source artifacts the caller hashed while writing them, keyed
+  // by file name. A renamed or linked artifact reuses its digest instead of
+  // being read back when the manifest is published.
+  std::map<std::string, ::alaya::internal::collection::Sha256Digest> source_digests{};
 };
 
 class LaserSegmentImporter {
@@ -192,18 +214,57 @@ inline auto read_index_count(const std::filesystem::path &index_path) -> uint64_
   return count;
 }
 
-inline auto copy_or_link_artifact(const std::filesystem::path &src,
-                                  const std::filesystem::path &dst,
-                                  bool copy_files) -> void {
-  std::error_code ec;
-  if (copy_files) {
-    std::filesystem::copy_file(src, dst, std::filesystem::copy_options::none, ec);
-  } else {
+// Returns the artifact's SHA-256 when it is known: given by the caller in
+// params.source_digests, or hashed on the way through this process (the
+// chunked-copy fallback). Otherwise the manifest writer hashes it.
+inline auto place_artifact(const std::filesystem::path &src,
+                           const std::filesystem::path &dst,
+                           const LaserSegmentImportParams &params)
+    -> std::optional<::alaya::internal::collection::Sha256Digest> {
+  std::optional<::alaya::internal::collection::Sha256Digest> known;
+  if (const auto it = params.source_digests.find(src.filename().string());
+      it != params.source_digests.end()) {
+    known = it->second;
+  }
+  if (!params.copy_files) {
+    std::error_code ec;
     std::filesystem::create_hard_link(src, dst, ec);
+    if (ec) {
+      throw std::runtime_error("LaserSegmentImporter: artifact publish failed: " + src.string() +
+                               " -> " + dst.string() + ": " + ec.message());
+    }
+    return known;
   }
-  if (ec) {
+  ::alaya::internal::collection::Sha256 hasher;
+  ::alaya::storage::io::TransferOptions options;
+  options.allow_rename = params.move_files;
+  options.threads = params.copy_threads;
+  if (!known.has_value()) {
+    options.on_bytes = [&hasher](std::span<const std::byte> bytes) { hasher.update(bytes); };
+  }
+  ::alaya::storage::io::TransferMethod method{};
+  try {
+    method = ::alaya::storage::io::transfer_file(src, dst, options);
+  } catch (const std::exception &e) {
     throw std::runtime_error("LaserSegmentImporter: artifact publish failed: " + src.string() +
-                             " -> " + dst.string() + ": " + ec.message());
+                             " -> " + dst.string() + ": " + e.what());
+  }
+  if (known.has_value() || method != ::alaya::storage::io::TransferMethod::chunk_copied) {
+    return known;
+  }
+  return hasher.finalize();
+}
+
+// Seeds the process-wide digest cache so publishing the segment's manifest-v2
+// entry does not read these files back.
+inline auto remember_digests(
+    const std::vector<std::pair<std::filesystem::path, ::alaya::internal::collection::Sha256Digest>>
+        &digests) -> void {
+  auto &cache = ::alaya::internal::collection::VerifiedDigestCache::instance();
+  for (const auto &[path, digest] : digests) {
+    if (const auto identity = ::alaya::platform::file_identity(path); identity.has_value()) {
+      cache.remember_written(*identity, digest);
+    }
   }
 }
 
@@ -332,23 +393,29 @@ inline auto LaserSegmentImporter::import_from(const std::filesystem::path &src_d
   const auto tmp_dir = laser_importer_detail::make_tmp_dir(parent, seg_basename);
   detail::TmpDirGuard guard(tmp_dir);
 
+  std::vector<std::pair<std::filesystem::path, ::alaya::internal::collection::Sha256Digest>>
+      digests;
+  auto place = [&](const laser_importer_detail::Artifact &artifact) {
+    const auto dst = tmp_dir / artifact.src.filename();
+    if (auto digest = laser_importer_detail::place_artifact(artifact.src, dst, params_)) {
+      digests.emplace_back(dst, *digest);
+    }
+  };
   for (const auto &artifact : required) {
-    laser_importer_detail::copy_or_link_artifact(artifact.src,
-                                                 tmp_dir / artifact.src.filename(),
-                                                 params_.copy_files);
+    place(artifact);
   }
   for (const auto &artifact : optional) {
-    if (!artifact.present) {
-      continue;
+    if (artifact.present) {
+      place(artifact);
     }
-    laser_importer_detail::copy_or_link_artifact(artifact.src,
-                                                 tmp_dir / artifact.src.filename(),
-                                                 params_.copy_files);
   }
 
-  detail::write_all_fsync(tmp_dir / "ids.u64.bin",
-                          labels,
-                          static_cast<size_t>(n) * sizeof(uint64_t));
+  const auto ids_bytes = static_cast<size_t>(n) * sizeof(uint64_t);
+  detail::write_all_fsync(tmp_dir / "ids.u64.bin", labels, ids_bytes);
+  digests.emplace_back(
+      tmp_dir / "ids.u64.bin",
+      ::alaya::internal::collection::sha256(
+          std::span(reinterpret_cast<const std::byte *>(labels), ids_bytes)));
 
   SegmentManifest manifest{};
   manifest.version = kManifestVersion;
@@ -387,9 +454,18 @@ inline auto LaserSegmentImporter::import_from(const std::filesystem::path &src_d
   manifest.x_extras["x_laser_search_dram_budget_gb"] =
       laser_importer_detail::format_float(params_.search_dram_budget_gb);
   manifest.x_extras["x_laser_distance_field_supported"] = "true";
+  for (const auto &[key, value] : params_.extras) {
+    if (key.rfind("x_", 0) != 0) {
+      throw std::invalid_argument("LaserSegmentImporter: extra manifest key '" + key +
+                                  "' must start with x_");
+    }
+    manifest.x_extras.emplace(key, value);
+  }
   manifest.save(tmp_dir / "manifest.txt");
 
   detail::fsync_dir(tmp_dir);
+  // Renaming the directory leaves the files' own identities unchanged.
+  laser_importer_detail::remember_digests(digests);
   detail::rename_no_replace(tmp_dir, seg_dir);
   guard.disarm();
 
@@ -411,13 +487,27 @@ struct LaserSegmentImportParams {
   uint32_t default_ef = 200;
   uint32_t default_beam_width = 4;
   float search_dram_budget_gb = 0.5F;
+  // true: each artifact lands as its own inode (rename if move_files, else
+  // reflink, copy_file_range or a parallel chunked copy). false: hard links.
   bool copy_files = true;
+  // With copy_files, rename artifacts out of src_dir when it shares the
+  // segment's filesystem. The caller gives the source files up.
+  bool move_files = false;
+  // Worker threads for the chunked-copy fallback; 0 = hardware_concurrency().
+  std::size_t copy_threads = 0;
   // Optional residency request recorded as manifest extra x_laser_residency
-  // ("paged_pool" | "resident_arena"). Empty = no extra; the segment loads
+  // ("paged_pool" | "resident_arena" | "mapped_arena"). Empty = no extra; the segment loads
   // through the legacy searcher exactly as before. See
   // laser_segment.hpp::detail::laser_residency_request for the load-side
   // contract (moved there from segment_factory.hpp; see the U2-c manifest).
   std::string residency{};
+  // Further x_ manifest extras recorded verbatim (e.g. carried over from a
+  // segment being rewritten). Keys the importer writes itself take precedence.
+  std::map<std::string, std::string> extras{};
+  // SHA-256 of source artifacts the caller hashed while writing them, keyed
+  // by file name. A renamed or linked artifact reuses its digest instead of
+  // being read back when the manifest is published.
+  std::map<std::string, ::alaya::internal::collection::Sha256Digest> source_digests{};
 };
 
 class LaserSegmentImporter {
@@ -0,0 +1,137 @@
+// SPDX-FileCopyrightText: 2026 AlayaDB.AI
+//
+// SPDX-License-Identifier: AGPL-3.0-only
+
+#pragma once
+
+#include <chrono>
+#include <cstdint>
+#include <filesystem>
+#include <stdexcept>
+#include <string>
+#include <vector>
+
+#include "index/disk/laser_segment_importer.hpp"
+#include "index/disk/laser_segment_searcher.hpp"
+#include "index/disk/segment_manifest.hpp"
+#include "index/graph/laser/utils/visit_sketch.hpp"
+
+#if defined(ALAYA_ENABLE_LASER) && ALAYA_ENABLE_LASER != 0
+  #include "index/disk/disk_flat_builder.hpp"
+  #include "index/graph/laser/qg/qg_relayout.hpp"
+  #include "platform/fs.hpp"
+  #include "storage/mmap_file.hpp"
+#endif
+
+namespace alaya::disk {
+
+#if defined(ALAYA_ENABLE_LASER) && ALAYA_ENABLE_LASER != 0
+
+struct LaserSegmentRelayoutResult {
+  SegmentManifest manifest;
+  ::alaya::laser::QGRelayoutPlan plan;
+};
+
+// Writes a relaid-out copy of the sealed LASER segment `src_seg_dir` as the
+// new segment `dst_seg_dir` (which must not exist). Rows are reordered by
+// relayout_qg_index from `sketch`; the ids file is permuted with them, so
+// every row keeps its label and the copy answers queries exactly like the
+// source. The rewritten files are staged in a scratch directory beside
+// `dst_seg_dir`, and the layout-independent artifacts are hard-linked, before
+// LaserSegmentImporter publishes the segment with the source's parameters.
+inline auto relayout_laser_segment(const std::filesystem::path &src_seg_dir,
+                                   const ::alaya::laser::VisitSketch &sketch,
+                                   const std::filesystem::path &dst_seg_dir)
+    -> LaserSegmentRelayoutResult {
+  const auto source = SegmentManifest::load(src_seg_dir / "manifest.txt");
+  if (source.index_type != DiskIndexType::Laser) {
+    throw std::invalid_argument("relayout_laser_segment: " + src_seg_dir.string() +
+                                " is not a disk_laser segment");
+  }
+  const auto &prefix = detail::laser_required_extra(source, "x_laser_filename_prefix", src_seg_dir);
+  const uint32_t r = detail::laser_parse_u32_extra(source, "x_R", src_seg_dir);
+  const uint32_t main_dim = detail::laser_parse_u32_extra(source, "x_main_dim", src_seg_dir);
+  if (sketch.num_rows() != source.count) {
+    throw std::invalid_argument("relayout_laser_segment: sketch rows (" +
+                                std::to_string(sketch.num_rows()) +
+                                ") differ from segment count (" + std::to_string(source.count) +
+                                ") for " + src_seg_dir.string());
+  }
+
+  const auto dst_dir = dst_seg_dir.lexically_normal();
+  const auto parent = dst_dir.parent_path();
+  const auto dst_name = dst_dir.filename().string();
+  const auto scratch =
+      parent / (".relayout_" + dst_name + "_" + std::to_string(::alaya::platform::get_pid()) + "_" +
+                std::to_string(std::chrono::steady_clock::now().time_since_epoch().count()));
+  if (!std::filesystem::create_directory(scratch)) {
+    throw std::runtime_error("relayout_laser_segment: scratch directory already exists: " +
+                             scratch.string());
+  }
+  detail::TmpDirGuard guard(scratch);
+
+  const std::string dst_prefix = "dsqg_" + dst_name;
+  LaserSegmentRelayoutResult result;
+  result.plan = ::alaya::laser::relayout_qg_index((src_seg_dir / prefix).string(),
+                                                  (scratch / dst_prefix).string(),
+                                                  r,
+                                                  main_dim,
+                                                  sketch);
+
+  const std::string suffix =
+      "_R" + std::to_string(r) + "_MD" + std::to_string(main_dim) + ".index";
+  auto link = [&](const std::filesystem::path &from, const std::filesystem::path &to) {
+    std::error_code ec;
+    std::filesystem::create_hard_link(from, to, ec);
+    if (ec) {
+      std::filesystem::copy_file(from, to, std::filesystem::copy_options::none, ec);
+    }
+    if (ec) {
+      throw std::runtime_error("relayout_laser_segment: cannot stage " + from.string() + ": " +
+                               ec.message());
+    }
+  };
+  link(src_seg_dir / (prefix + suffix + "_rotator"), scratch / (dst_prefix + suffix + "_rotator"));
+  for (const auto *tail : {"_medoids", "_pca.bin"}) {
+    const auto from = src_seg_dir / (prefix + tail);
+    if (std::filesystem::exists(from)) {
+      link(from, scratch / (dst_prefix + tail));
+    }
+  }
+
+  storage::MMapFile ids(src_seg_dir / source.ids_file);
+  if (ids.size() != source.count * sizeof(uint64_t)) {
+    throw std::runtime_error("relayout_laser_segment: ids file size mismatch in " +
+                             src_seg_dir.string());
+  }
+  const auto *old_labels = static_cast<const uint64_t *>(ids.data());
+  std::vector<uint64_t> labels(source.count);
+  for (size_t p = 0; p < labels.size(); ++p) {
+    labels[p] = old_labels[result.plan.new_to_old[p]];
+  }
+
+  LaserSegmentImportParams params;
+  params.R = r;
+  params.main_dim = main_dim;
+  params.default_ef = detail::laser_parse_u32_extra(source, "x_default_ef", src_seg_dir);
+  params.default_beam_width =
+      detail::laser_parse_u32_extra(source, "x_default_beam_width", src_seg_dir);
+  params.search_dram_budget_gb = detail::laser_parse_float_extra_default(
+      source, "x_laser_search_dram_budget_gb", 0.5F, src_seg_dir);
+  params.copy_files = false;
+  if (const auto it = source.x_extras.find("x_laser_residency"); it != source.x_extras.end()) {
+    params.residency = it->second;
+  }
+  for (const auto *key : {"x_laser_row_cache_budget_gb", "x_laser_visit_sample_every"}) {
+    if (const auto it = source.x_extras.find(key); it != source.x_extras.end()) {
+      params.extras.emplace(key, it->second);
+    }
+  }
+  result.manifest = LaserSegmentImporter(static_cast<uint32_t>(source.dim), source.metric, params)
+                        .import_from(scratch, labels.data(), labels.size(), dst_dir);
+  return result;
+}
+
+#endif
+
+}  // namespace alaya::disk
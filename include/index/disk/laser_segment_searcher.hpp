@@ -8,6 +8,7 @@
 #include <bit>
 #include <cerrno>
 #include <cstdint>
+#include <cstdlib>
 #include <cstring>
 #include <filesystem>
 #include <limits>
@@ -182,6 +183,30 @@ inline auto laser_validate_manifest_artifact(const SegmentManifest &manifest,
   }
 }
 
+// Query sampling for the page relayout (VisitSketch): one query in N is
+// traced. Off by default:
+//   segment manifest x_laser_visit_sample_every = N
+//   env ALAYA_LASER_VISIT_SAMPLE overrides the manifest (0 turns it off)
+inline auto laser_visit_sample_every(const SegmentManifest &manifest,
+                                     const std::filesystem::path &seg_dir) -> uint32_t {
+  const char *env = std::getenv("ALAYA_LASER_VISIT_SAMPLE");
+  std::string value;
+  if (env != nullptr && *env != '\0') {
+    value = env;
+  } else if (const auto it = manifest.x_extras.find("x_laser_visit_sample_every");
+             it != manifest.x_extras.end() && !it->second.empty()) {
+    value = it->second;
+  } else {
+    return 0;
+  }
+  const auto parsed = parse_uint64(value, "x_laser_visit_sample_every");
+  if (parsed > static_cast<uint64_t>(std::numeric_limits<uint32_t>::max())) {
+    throw std::runtime_error("LaserSegmentSearcher: visit sample rate exceeds uint32 for segment " +
+                             seg_dir.string() + " (got " + value + ")");
+  }
+  return static_cast<uint32_t>(parsed);
+}
+
 }  // namespace detail
 
 static_assert(std::endian::native == std::endian::little,
@@ -282,8 +307,27 @@ class LaserSegmentSearcher : public SegmentSearcher {
                                                 "x_laser_search_dram_budget_gb",
                                                 0.5F,
                                                 seg_dir);
+    // Adaptive row cache (QuantizedGraph::set_row_cache_budget); off unless
+    // the manifest asks for it.
+    const float row_cache_budget_gb =
+        detail::laser_parse_float_extra_default(manifest_,
+                                                "x_laser_row_cache_budget_gb",
+                                                0.0F,
+                                                seg_dir);
+    const uint32_t visit_sample_every = detail::laser_visit_sample_every(manifest_, seg_dir);
     try {
       quantized_graph_->load_disk_index(index_prefix.c_str(), dram_budget_gb);
+      if (row_cache_budget_gb > 0.0F) {
+        quantized_graph_->set_row_cache_budget(
+            static_cast<size_t>(static_cast<double>(row_cache_budget_gb) * 1e9));
+      }
+      if (visit_sample_every != 0) {
+        auto sketch = std::make_shared<alaya::laser::VisitSketch>(
+            static_cast<size_t>(manifest_.count), visit_sample_every);
+        quantized_graph_->set_visit_sketch(sketch);
+        alaya::laser::VisitSketchRegistry::instance().publish(
+            alaya::laser::VisitSketchRegistry::key_for(seg_dir), sketch);
+      }
     } catch (const std::exception &e) {
       throw std::runtime_error("LaserSegmentSearcher: QuantizedGraph load failed for " +
                                seg_dir.string() + ": " + e.what());
@@ -367,6 +411,11 @@ class LaserSegmentSearcher : public SegmentSearcher {
   // manifest/artifact validation this constructor performs.
   auto graph() noexcept -> alaya::laser::QuantizedGraph & { return *quantized_graph_; }
   [[nodiscard]] auto labels() const noexcept -> const uint64_t * { return ids_view_; }
+  // Null unless query sampling is on (laser_visit_sample_every).
+  [[nodiscard]] auto visit_sketch() const noexcept
+      -> const std::shared_ptr<alaya::laser::VisitSketch> & {
+    return quantized_graph_->visit_sketch();
+  }
 
  private:
   // Declaration order matters: quantized_graph_ is destroyed before ids_mmap_.
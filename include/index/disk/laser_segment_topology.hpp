@@ -0,0 +1,118 @@
+// SPDX-FileCopyrightText: 2026 AlayaDB.AI
+//
+// SPDX-License-Identifier: AGPL-3.0-only
+
+#pragma once
+
+#include <algorithm>
+#include <array>
+#include <cstdint>
+#include <cstring>
+#include <filesystem>
+#include <limits>
+#include <stdexcept>
+#include <string>
+#include <vector>
+
+#include "index/disk/laser_segment_searcher.hpp"
+#include "index/disk/segment_manifest.hpp"
+#include "index/graph/frozen_graph_snapshot.hpp"
+
+#if defined(ALAYA_ENABLE_LASER) && ALAYA_ENABLE_LASER != 0
+  #include "index/graph/laser/qg/qg.hpp"
+  #include "storage/mmap_file.hpp"
+#endif
+
+namespace alaya::disk {
+
+#if defined(ALAYA_ENABLE_LASER) && ALAYA_ENABLE_LASER != 0
+
+// Reads the graph of the sealed LASER segment `seg_dir` back out of its v1
+// index file as a FrozenGraphSnapshot whose nodes are the segment's row ids
+// (each PID's label in the ids file), so a relaid-out segment reads back in
+// row order too. v1 rows pad unused neighbor slots with PID 0, so a trailing
+// run of zeros is dropped; a genuine last edge to PID 0 goes with it, which
+// costs a later build one edge it can relink.
+[[nodiscard]] inline auto load_laser_segment_topology(const std::filesystem::path &seg_dir)
+    -> FrozenGraphSnapshot {
+  const auto manifest = SegmentManifest::load(seg_dir / "manifest.txt");
+  if (manifest.index_type != DiskIndexType::Laser) {
+    throw std::invalid_argument("load_laser_segment_topology: " + seg_dir.string() +
+                                " is not a disk_laser segment");
+  }
+  const auto &prefix = detail::laser_required_extra(manifest, "x_laser_filename_prefix", seg_dir);
+  const uint32_t r = detail::laser_parse_u32_extra(manifest, "x_R", seg_dir);
+  const uint32_t main_dim = detail::laser_parse_u32_extra(manifest, "x_main_dim", seg_dir);
+  const auto index_path =
+      seg_dir / (prefix + "_R" + std::to_string(r) + "_MD" + std::to_string(main_dim) + ".index");
+
+  storage::MMapFile index(index_path);
+  const auto *bytes = static_cast<const char *>(index.data());
+  if (index.size() < ::alaya::laser::kSectorLen ||
+      ::alaya::laser::qg_header_has_v2_magic(bytes)) {
+    throw std::runtime_error("load_laser_segment_topology: not a sealed v1 index: " +
+                             index_path.string());
+  }
+  std::array<uint64_t, ::alaya::laser::kSectorLen / sizeof(uint64_t)> metas{};
+  std::memcpy(metas.data(), bytes, ::alaya::laser::kSectorLen);
+  const auto num_rows = static_cast<size_t>(metas[0]);
+  const auto node_len = static_cast<size_t>(metas[3]);
+  const auto npp = static_cast<size_t>(metas[4]);
+  if (num_rows != manifest.count || num_rows == 0 || npp == 0 || metas[8] != index.size() ||
+      node_len < size_t{r} * sizeof(::alaya::laser::PID) || metas[2] >= num_rows ||
+      num_rows > std::numeric_limits<uint32_t>::max()) {
+    throw std::runtime_error("load_laser_segment_topology: invalid v1 metadata in " +
+                             index_path.string());
+  }
+  const size_t page_count = (num_rows + npp - 1) / npp;
+  const size_t page_size = (index.size() - ::alaya::laser::kSectorLen) / page_count;
+  if ((index.size() - ::alaya::laser::kSectorLen) % page_count != 0 || npp * node_len > page_size) {
+    throw std::runtime_error("load_laser_segment_topology: invalid v1 geometry in " +
+                             index_path.string());
+  }
+
+  storage::MMapFile ids(seg_dir / manifest.ids_file);
+  if (ids.size() != num_rows * sizeof(uint64_t)) {
+    throw std::runtime_error("load_laser_segment_topology: ids file size mismatch in " +
+                             seg_dir.string());
+  }
+  const auto *labels = static_cast<const uint64_t *>(ids.data());
+  std::vector<bool> seen(num_rows, false);
+  for (size_t pid = 0; pid < num_rows; ++pid) {
+    if (labels[pid] >= num_rows || seen[labels[pid]]) {
+      throw std::runtime_error("load_laser_segment_topology: labels are not dense row ids in " +
+                               seg_dir.string());
+    }
+    seen[labels[pid]] = true;
+  }
+
+  index.advise(storage::MMapAccess::sequential);
+  const size_t neighbor_offset = node_len - size_t{r} * sizeof(::alaya::laser::PID);
+  FrozenGraphSnapshot::Adjacency adjacency(num_rows);
+  std::vector<::alaya::laser::PID> slots(r);
+  for (size_t pid = 0; pid < num_rows; ++pid) {
+    const char *row = bytes + ::alaya::laser::kSectorLen + page_size * (pid / npp) +
+                      (pid % npp) * node_len + neighbor_offset;
+    std::memcpy(slots.data(), row, slots.size() * sizeof(::alaya::laser::PID));
+    size_t used = slots.size();
+    while (used != 0 && slots[used - 1] == 0) {
+      --used;
+    }
+    auto &neighbors = adjacency[labels[pid]];
+    neighbors.reserve(used);
+    for (size_t slot = 0; slot < used; ++slot) {
+      const auto neighbor = slots[slot];
+      if (neighbor < num_rows && neighbor != pid &&
+          std::find(neighbors.begin(), neighbors.end(), labels[neighbor]) == neighbors.end()) {
+        neighbors.push_back(static_cast<uint32_t>(labels[neighbor]));
+      }
+    }
+  }
+  FrozenGraphSnapshot snapshot(std::move(adjacency), static_cast<uint32_t>(labels[metas[2]]), r);
+  snapshot.validate();
+  return snapshot;
+}
+
+#endif
+
+}  // namespace alaya::disk
@@ -28,6 +28,12 @@ struct DiskSearchOptions {
   // rank-only/NaN output; true asks LASER to forward the exact distances its
   // QG result pool already used to order the returned PIDs.
   bool return_distances = false;
+  // Intra-query parallelism for engines that scan every row (disk_flat). 0 or
+  // 1 scans on the calling thread; N > 1 splits the rows into up to N ranges
+  // that the caller and the shared sync-adapter workers scan, each keeping a
+  // local top-k that is merged at the end. Results are identical to the
+  // serial scan. LASER ignores it.
+  uint32_t scan_threads = 1;
   // Segment admission contract (docs/design/segment-admission-contract.md):
   // a value-copied view, not an owner. `filter.payload` (when kind !=
   // none) must stay valid for the duration of the search/batch_search
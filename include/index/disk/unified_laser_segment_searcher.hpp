@@ -33,6 +33,8 @@ namespace alaya::disk {
 //                     LaserSegmentSearcher::search)
 //   kResidentArena -> the resident-arena kernel, materialized from the same
 //                     on-disk segment at prepare() time
+//   kMappedArena   -> the same kernel over a read-only mapping of the index
+//                     file, prefaulted in the background
 class UnifiedLaserSegmentSearcher : public SegmentSearcher {
  public:
   explicit UnifiedLaserSegmentSearcher(const std::filesystem::path &seg_dir,
@@ -8,6 +8,9 @@
 #include <cstdint>
 #include <filesystem>
 #include <fstream>
+#include <limits>
+#include <optional>
+#include <span>
 #include <stdexcept>
 #include <string>
 #include <utility>
@@ -190,4 +193,100 @@ class FrozenGraphSnapshot {
   std::uint64_t frozen_pts_ = 0;
 };
 
+// Marks a row with no counterpart in the predecessor graph.
+inline constexpr std::uint32_t kNoPredecessorRow = std::numeric_limits<std::uint32_t>::max();
+
+// Builds the L2 Vamana topology over `data` (row-major, predecessor_row.size()
+// rows of `dim` floats) starting from `predecessor` rather than from
+// scratch. predecessor_row[i] names row i's node in `predecessor`, or is
+// kNoPredecessorRow for a new row. Carried rows keep their edges to other
+// carried rows. A row that pointed at a dropped node takes that node's
+// carried neighbors as candidates and is pruned again (DiskANN's delete
+// consolidation). New rows are inserted with search plus RobustPrune. The
+// predecessor must be an L2 graph with degree bound params.R. Returns nullopt
+// when no row is carried, which leaves nothing to start from.
+[[nodiscard]] inline auto extend_vamana_snapshot(const FrozenGraphSnapshot &predecessor,
+                                                 std::span<const std::uint32_t> predecessor_row,
+                                                 const float *data,
+                                                 std::uint32_t dim,
+                                                 const vamana::VamanaBuildParams &params)
+    -> std::optional<FrozenGraphSnapshot> {
+  if (predecessor.max_degree() != params.R) {
+    throw std::invalid_argument("extend_vamana_snapshot: predecessor degree bound differs");
+  }
+  const auto &old_graph = predecessor.adjacency();
+  std::vector<std::uint32_t> carried(old_graph.size(), kNoPredecessorRow);
+  for (std::size_t row = 0; row < predecessor_row.size(); ++row) {
+    const auto old_row = predecessor_row[row];
+    if (old_row == kNoPredecessorRow) {
+      continue;
+    }
+    if (old_row >= old_graph.size() || carried[old_row] != kNoPredecessorRow) {
+      throw std::invalid_argument("extend_vamana_snapshot: invalid predecessor row " +
+                                  std::to_string(old_row));
+    }
+    carried[old_row] = static_cast<std::uint32_t>(row);
+  }
+
+  FrozenGraphSnapshot::Adjacency seed(predecessor_row.size());
+  std::vector<std::uint32_t> repair;
+  std::vector<std::uint32_t> insert;
+  for (std::size_t row = 0; row < predecessor_row.size(); ++row) {
+    const auto old_row = predecessor_row[row];
+    const auto node = static_cast<std::uint32_t>(row);
+    if (old_row == kNoPredecessorRow) {
+      insert.push_back(node);
+      continue;
+    }
+    auto &neighbors = seed[row];
+    bool lost = false;
+    for (const auto neighbor : old_graph[old_row]) {
+      if (carried[neighbor] != kNoPredecessorRow) {
+        neighbors.push_back(carried[neighbor]);
+        continue;
+      }
+      lost = true;
+      for (const auto second : old_graph[neighbor]) {
+        if (second != old_row && carried[second] != kNoPredecessorRow) {
+          neighbors.push_back(carried[second]);
+        }
+      }
+    }
+    if (neighbors.empty()) {
+      insert.push_back(node);
+    } else if (lost) {
+      repair.push_back(node);
+    }
+  }
+
+  // Search starts from the old entry point, or failing that from the first
+  // of its carried neighbors, or from any carried row with edges.
+  auto entry = kNoPredecessorRow;
+  const auto old_entry = predecessor.entry_point();
+  if (old_entry < carried.size() && carried[old_entry] != kNoPredecessorRow &&
+      !seed[carried[old_entry]].empty()) {
+    entry = carried[old_entry];
+  }
+  for (std::size_t index = 0; entry == kNoPredecessorRow && old_entry < old_graph.size() &&
+                              index < old_graph[old_entry].size();
+       ++index) {
+    const auto candidate = carried[old_graph[old_entry][index]];
+    if (candidate != kNoPredecessorRow && !seed[candidate].empty()) {
+      entry = candidate;
+    }
+  }
+  for (std::size_t row = 0; entry == kNoPredecessorRow && row < seed.size(); ++row) {
+    if (!seed[row].empty()) {
+      entry = static_cast<std::uint32_t>(row);
+    }
+  }
+  if (entry == kNoPredecessorRow) {
+    return std::nullopt;
+  }
+
+  vamana::VamanaBuilder builder(data, predecessor_row.size(), dim, params);
+  builder.build_incremental(std::move(seed), repair, insert, entry);
+  return FrozenGraphSnapshot(std::move(builder));
+}
+
 }  // namespace alaya
@@ -17,6 +17,7 @@
 #include <cstdlib>
 #include <cstring>
 #include <deque>
+#include <exception>
 #include <filesystem>
 #include <fstream>
 #include <iomanip>
@@ -26,10 +27,12 @@
 #include <memory>
 #include <mutex>
 #include <numeric>
+#include <optional>
 #include <random>
 #include <set>
 #include <stdexcept>
 #include <string>
+#include <thread>
 #include <type_traits>
 #include <unordered_map>
 #include <unordered_set>
@@ -38,6 +41,7 @@
 
 #include "concurrentqueue.h"  // NOLINT
 #include "core/value_types.hpp"
+#include "index/graph/detail/thread_config.hpp"
 #include "index/graph/laser/common.hpp"
 #include "index/graph/laser/qg/qg_query.hpp"
 #include "index/graph/laser/qg/qg_scanner.hpp"
@@ -50,16 +54,20 @@
   #include "index/graph/laser/utils/aligned_file_reader_factory.hpp"
 #else
   #include "index/graph/laser/utils/page_reader_adapter.hpp"
+  #include "storage/io/page_awaitable.hpp"
 #endif
 #include "index/graph/laser/utils/array.hpp"
 #include "index/graph/laser/utils/buffer.hpp"
 #include "index/graph/laser/utils/concurrent_queue.hpp"
 #include "index/graph/laser/utils/io.hpp"
 #include "index/graph/laser/utils/memory.hpp"
+#include "index/graph/laser/utils/node_row_cache.hpp"
 #include "index/graph/laser/utils/pca_transform.hpp"
 #include "index/graph/laser/utils/rotator.hpp"
 #include "index/graph/laser/utils/tools.hpp"
+#include "index/graph/laser/utils/visit_sketch.hpp"
 #include "platform/detect.hpp"
+#include "storage/mmap_file.hpp"
 #include "third_party/ngt/hashset.hpp"
 #include "utils/kernel_section_profile.hpp"
 #include "utils/memory.hpp"
@@ -88,6 +96,8 @@ struct ArenaScratch {
   HashBasedBooleanSet visited_;
   buffer::SearchBuffer search_pool_;
   std::vector<float> pca_query_scratch_;
+  // Expansion order of a query sampled by the graph's VisitSketch.
+  std::vector<PID> trace_;
 
   void ensure(size_t num_points, size_t ef_search, size_t query_dimension) {
     search_pool_.resize(ef_search);
@@ -619,9 +629,12 @@ inline bool qg_header_has_v2_magic(const char *header) {
   return magic_a == kQGSuperblockMagic || magic_b == kQGSuperblockMagic;
 }
 
+class QuantizedGraphTestAccess;
+
 class QuantizedGraph {
   friend class QGBuilder;
   friend class QGUpdater;  // research prototype: streaming updates (qg_updater.hpp)
+  friend class QuantizedGraphTestAccess;
 
  private:
   size_t num_points_ = 0;    // num points
@@ -645,6 +658,8 @@ class QuantizedGraph {
 #if defined(_WIN32)
   std::unique_ptr<AlignedFileReader> aligned_file_reader_;
 #else
+  // Declared before page_reader_ so it outlives the reader's last callback.
+  SharedPageReads shared_page_reads_;
   std::unique_ptr<storage::io::PageReader> page_reader_;
 #endif
 
@@ -655,7 +670,7 @@ class QuantizedGraph {
   enum class PagedLeaseState : uint8_t { kClosed, kAccepting, kDraining };
   static constexpr uint64_t kPagedLeaseDrainBit = uint64_t{1} << 63U;
   static constexpr uint64_t kPagedLeaseCountMask = ~kPagedLeaseDrainBit;
-  // make_laser_page_reader() configures both Linux backends at depth 128.
+  // make_laser_page_reader() configures every Linux backend at depth 128.
   // Bounding graph-bound leases by the same limit also bounds Windows
   // register_thread() calls if that unsupported port is enabled later.
   static constexpr size_t kPagedLeaseLimit = 128;
@@ -733,11 +748,26 @@ class QuantizedGraph {
   // spans 2-3 4K pages; without hugepages every pop pays TLB walks and the HW
   // streamer stops at each page boundary (memqg's StaticStorage already gets
   // this via the same allocator — parity is required for the arena kernel).
-  std::vector<char, ::alaya::AlignedAlloc<char>> cache_nodes_;
+  // The uninitialized variant lets ensure_resident_arena() first-touch each
+  // slice on the thread that fills it.
+  std::vector<char, ::alaya::UninitAlignedAlloc<char>> cache_nodes_;
+  // Partial caches only; an identity arena is addressed directly (cached_row).
   std::unordered_map<PID, char *> caches_;
   // Full-cache probe: true when the loaded cache covers every node in identity
   // order, so cache_nodes_ can be addressed as a resident arena (pid * node_len_).
   bool arena_identity_ = false;
+  // Mapped arena (map_resident_arena): the index file mapped read-only and
+  // searched in place, so processes opening the same file share its page
+  // cache. A background thread faults pages in hot-first order.
+  storage::MMapFile index_map_;
+  std::thread prefault_thread_;
+  std::atomic<bool> prefault_stop_{false};
+  std::atomic<size_t> prefault_pages_done_{0};
+  size_t prefault_pages_total_ = 0;
+  // Adaptive row cache of the paged path (set_row_cache_budget); null when off.
+  std::unique_ptr<NodeRowCache> row_cache_;
+  // Sampled visit recorder (set_visit_sketch); null when off.
+  std::shared_ptr<VisitSketch> visit_sketch_;
 
   int query_time_ = 0;
   float total_io_time_ = 0;
@@ -794,6 +824,119 @@ class QuantizedGraph {
                       const RowAdmission *admission,
                       float *ALAYA_RESTRICT distances);
 
+  // Upper bound on paged queries one batch_search call keeps in flight.
+  static constexpr size_t kPagedInterleaveWidth = 16;
+
+  // Cached row of `id`, or nullptr when the paged path must read it.
+  [[nodiscard]] auto cached_row(PID id) -> char * {
+    if (arena_identity_) {
+      return id < cache_ids_.size() ? cache_nodes_.data() + static_cast<size_t>(id) * node_len_
+                                    : nullptr;
+    }
+    const auto found = caches_.find(id);
+    return found == caches_.end() ? nullptr : found->second;
+  }
+
+  // Row addressing for the arena kernel. The heap arena packs rows densely; a
+  // mapped index file keeps its page layout, which is dense as well unless
+  // each page carries slack after its last row.
+  struct ArenaRows {
+    const char *base = nullptr;
+    size_t stride = 0;         // distance between consecutive dense rows
+    size_t node_len = 0;
+    size_t node_per_page = 0;  // 0 = dense
+    size_t page_size = 0;
+
+    [[nodiscard]] auto row(size_t pid) const noexcept -> const char * {
+      if (node_per_page == 0) {
+        return base + pid * stride;
+      }
+      return base + pid / node_per_page * page_size + pid % node_per_page * node_len;
+    }
+  };
+  [[nodiscard]] auto arena_rows() const -> ArenaRows;
+
+  // Body of prefault_thread_.
+  void prefault_mapped_arena() noexcept;
+
+  // Big enough that each O_DIRECT read streams at device bandwidth, small
+  // enough that every core gets several chunks.
+  static constexpr size_t kArenaChunkBytes = size_t{8} << 20U;
+
+  // Reads page-aligned chunks of the index file through a PageReader on every
+  // core and de-pages their rows into `arena` (num_points_ * node_len_ bytes).
+  void load_arena_pages(char *arena, size_t chunk_bytes = kArenaChunkBytes);
+
+  // One disk_search_qg query as a resumable state machine. resume() runs the
+  // beam search until the query finishes (true) or its oldest issued page has
+  // not arrived yet (false), so one thread can keep several queries' reads in
+  // flight and scan one query's rows while another's pages load.
+  class PagedSearchTask {
+   public:
+    PagedSearchTask(QuantizedGraph &graph,
+                    PagedThreadDataLease lease,
+                    const float *ALAYA_RESTRICT query,
+                    uint32_t knn,
+                    size_t ef_search,
+                    size_t beam_width,
+                    const RowAdmission *admission);
+    PagedSearchTask(const PagedSearchTask &) = delete;
+    auto operator=(const PagedSearchTask &) -> PagedSearchTask & = delete;
+
+    [[nodiscard]] auto resume() -> bool;
+    // Copies the top-k out and returns the lease to the pool as reusable.
+    void finish(uint32_t *ALAYA_RESTRICT results, float *ALAYA_RESTRICT distances);
+
+   private:
+    enum class Phase : uint8_t { kExpand, kProcess, kDrain, kDone };
+
+    void expand_frontier();
+    void process_node(PID cur_node, float *cur_data);
+    void collect_completions();
+    [[nodiscard]] auto process_next_issued() -> bool;
+
+    QuantizedGraph &graph_;
+    PagedThreadDataLease lease_;
+    ThreadData &data_;
+    const RowAdmission *admission_;
+    size_t beam_width_;
+    QGQuery q_obj_;
+    const float *residual_query_ = nullptr;
+    // Result pool maintains the top-k nearest neighbors found during search
+    buffer::ResultBuffer res_pool_;
+    // RaBitQ computes distances to all neighbors of a node in a single SIMD-optimized pass.
+    std::vector<float> appro_dist_;
+#if defined(_WIN32)
+    std::vector<AlignedRead> frontier_read_reqs_;
+    std::vector<AlignedReadEvent> evts_;
+#else
+    std::vector<storage::io::ReadRequest> frontier_read_reqs_;
+    std::vector<storage::io::ReadResult> evts_;
+#endif
+    struct IssuedNode {
+      PID id;
+      char *slot;
+      bool from_row_cache;
+      // Row-cache epoch taken before the read was issued.
+      uint64_t row_cache_epoch;
+    };
+    // issued_nodes preserves the logical frontier order across asynchronous I/O.
+    // Completions only flip read_ready; processing always consumes this FIFO.
+    std::deque<IssuedNode> issued_nodes_;
+    std::unordered_map<PID, bool> read_ready_;
+    std::deque<char *> free_slots_;
+    std::vector<PID> cache_nhoods_;
+    // Adaptive beam width: starts at 1 and grows exponentially
+    size_t cur_beam_size_ = 1;
+    size_t need_process_num_ = 0;
+    // Nodes from the previous round left for pipelined processing
+    size_t previous_remain_num_ = 0;
+    Phase phase_ = Phase::kExpand;
+    // Sampled by the graph's VisitSketch; trace_ then collects process order.
+    bool tracing_ = false;
+    std::vector<PID> trace_;
+  };
+
   void copy_vectors(const float *);
 
   // for beam search
@@ -815,7 +958,19 @@ class QuantizedGraph {
                                AlignedFileReader &,
                                ThreadData);
 
-  // pf_base/pf_lines: resident-arena candidate prefetch — after each pool
+  // Same node payload as update_qg_out_of_memory, read from row-major
+  // `vectors` ((dimension_ + residual_dimension_) floats per row) instead of
+  // the aligned vector file. `node_buf` holds node_len_ bytes and must be
+  // zeroed by the caller.
+  void update_qg_in_memory(PID,
+                           const std::vector<Candidate<float>> &,
+                           const float *vectors,
+                           char *node_buf);
+
+  template <typename NeighborRow>
+  void encode_node(const std::vector<Candidate<float>> &, char *node_buf, NeighborRow row);
+
+  // pf_rows/pf_lines: resident-arena candidate prefetch — after each pool
   // insert, prefetch the head of the current-best candidate's row (memqg
   // kernel parity). nullptr/0 (the disk path) keeps behavior unchanged.
   float scan_neighbors(const QGQuery &q_obj,
@@ -824,7 +979,7 @@ class QuantizedGraph {
                        buffer::SearchBuffer &search_pool,
                        uint32_t cur_degree,
                        const HashBasedBooleanSet &visited,
-                       const char *pf_base = nullptr,
+                       const ArenaRows *pf_rows = nullptr,
                        size_t pf_lines = 0) const;
 
   [[nodiscard]] auto exact_distance(const float *lhs, const float *rhs, size_t dim) const -> float {
@@ -871,6 +1026,33 @@ class QuantizedGraph {
 
   void set_params(size_t ef_search, size_t num_threads, int beam_width);
 
+  // Adaptive row cache for the paged path: `bytes` of DRAM beside the static
+  // sidecar cache, filled from completed page reads of the rows the live
+  // queries actually visit (NodeRowCache). 0 turns it off. Hits replace a
+  // read without moving the row in the frontier, so results do not depend on
+  // what is cached. Not thread-safe against concurrent searches.
+  void set_row_cache_budget(size_t bytes) {
+    row_cache_ = bytes == 0 ? nullptr : std::make_unique<NodeRowCache>(bytes, node_len_);
+  }
+  [[nodiscard]] auto row_cache_stats() const noexcept -> NodeRowCacheStats {
+    return row_cache_ == nullptr ? NodeRowCacheStats{} : row_cache_->stats();
+  }
+
+  // Traces one query in sketch->sample_every() on either search path into
+  // `sketch` (sized for this graph's rows); the page relayout reads it back.
+  // Null turns tracing off. Not thread-safe against concurrent searches.
+  void set_visit_sketch(std::shared_ptr<VisitSketch> sketch) { visit_sketch_ = std::move(sketch); }
+  [[nodiscard]] auto visit_sketch() const noexcept -> const std::shared_ptr<VisitSketch> & {
+    return visit_sketch_;
+  }
+#if !defined(_WIN32)
+  // Paged-path page reads sent to the device, and reads saved because a
+  // request joined another search's in-flight read of the same page.
+  [[nodiscard]] auto paged_read_stats() const noexcept -> SharedPageReadStats {
+    return shared_page_reads_.stats();
+  }
+#endif
+
   // Lifecycle observers used by concurrency/teardown tests. They expose only
   // atomic counters, never a graph-bound ThreadData pointer.
   [[nodiscard]] auto paged_leases_in_flight() const noexcept -> size_t {
@@ -912,7 +1094,8 @@ class QuantizedGraph {
               float *ALAYA_RESTRICT distances = nullptr);
 
   // Full-cache probe: same scan_neighbors kernel on a resident arena — direct
-  // pid*node_len addressing over cache_nodes_, no beam/AIO orchestration.
+  // row addressing over cache_nodes_ (or the mapped index file when no heap
+  // arena exists), no beam/AIO orchestration.
   // The source-compatible overload reads the set_params() ef/beam defaults.
   void arena_search_qg(const float *ALAYA_RESTRICT query,
                        uint32_t knn,
@@ -952,13 +1135,45 @@ class QuantizedGraph {
   //    capacity for appendable PIDs up front, then reflect committed page
   //    writes into the arena so resident searches observe updates
   //    (pass-through mirror; no seqlock, research-grade like the updater).
+  //    The same writes drop the touched rows from the adaptive row cache.
   [[nodiscard]] bool arena_resident() const noexcept { return arena_identity_; }
   void ensure_resident_arena();
+
+  // Mapped-arena seams (MappedArenaProvider):
+  //  - map_resident_arena(): map the index file read-only and serve the arena
+  //    kernel from it in place, with no private copy. Searches may start at
+  //    once; pages not yet resident fault in on demand while a background
+  //    thread prefaults the file hot-first (entry point, medoids, the cache
+  //    sidecar's high in-degree rows, then every page in id order).
+  //    Idempotent; not thread-safe against concurrent searches. A heap arena,
+  //    when present, still takes precedence in arena_search_qg.
+  //  - mapped_arena_readiness(): how many index pages the prefault has made
+  //    resident so far.
+  //  - stop_arena_prefault(): abandon the prefault; the mapping stays usable.
+  struct MappedArenaReadiness {
+    size_t pages_ready = 0;
+    size_t pages_total = 0;
+
+    [[nodiscard]] auto complete() const noexcept -> bool { return pages_ready >= pages_total; }
+    [[nodiscard]] auto fraction() const noexcept -> double {
+      return pages_total == 0 ? 1.0
+                              : static_cast<double>(pages_ready) /
+                                    static_cast<double>(pages_total);
+    }
+  };
+  [[nodiscard]] bool arena_mapped() const noexcept { return index_map_.data() != nullptr; }
+  void map_resident_arena();
+  [[nodiscard]] auto mapped_arena_readiness() const noexcept -> MappedArenaReadiness {
+    return {prefault_pages_done_.load(std::memory_order_acquire), prefault_pages_total_};
+  }
+  void stop_arena_prefault() noexcept;
   void arena_reserve_rows(size_t rows);
   void arena_mirror_write(uint64_t file_off, const char *buf, size_t len);
 
-  // Batch is semantic sugar over reentrant per-query calls. These entries do
-  // not create threads; callers that want concurrency supply external lanes.
+  // Batch entries do not create threads; callers that want concurrency supply
+  // external lanes. The paged batch interleaves up to kPagedInterleaveWidth
+  // queries on the calling thread so their page reads overlap; each query's
+  // result is identical to a lone disk_search_qg call.
   void batch_search(const float *ALAYA_RESTRICT query,
                     uint32_t knn,
                     uint32_t *ALAYA_RESTRICT results,
@@ -1232,7 +1447,10 @@ inline void QuantizedGraph::destroy_thread_data() {
   paged_lease_state_.store(PagedLeaseState::kClosed, std::memory_order_release);
 }
 
-inline QuantizedGraph::~QuantizedGraph() { destroy_thread_data(); }
+inline QuantizedGraph::~QuantizedGraph() {
+  stop_arena_prefault();
+  destroy_thread_data();
+}
 
 inline void QuantizedGraph::set_params(size_t ef_search, size_t num_threads, int beam_width) {
   // Compatibility shell and paged-pool provisioning hook. Production search
@@ -1290,14 +1508,48 @@ inline void QuantizedGraph::batch_search(const float *ALAYA_RESTRICT query,
                                          size_t beam_width,
                                          const RowAdmission *admission,
                                          float *ALAYA_RESTRICT distances) {
-  for (size_t i = 0; i < num_queries; ++i) {
-    disk_search_qg(query + i * (dimension_ + residual_dimension_),
-                   knn,
-                   results + i * knn,
-                   ef_search,
-                   beam_width,
-                   admission,
-                   distances == nullptr ? nullptr : distances + i * knn);
+  const size_t stride = dimension_ + residual_dimension_;
+  std::vector<std::optional<PagedSearchTask>> lanes(std::min(num_queries, kPagedInterleaveWidth));
+  std::vector<size_t> lane_query(lanes.size());
+  size_t next = 0;
+  size_t active = 0;
+  // Leases are shared with every other searcher of this graph. A lane that
+  // cannot get one stays idle and retries once a running query frees its own;
+  // only a batch with nothing in flight surfaces the failure.
+  auto start = [&](size_t lane) -> bool {
+    std::optional<PagedThreadDataLease> lease;
+    try {
+      lease.emplace(acquire_thread_data(beam_width));
+    } catch (const std::runtime_error &) {
+      if (active == 0) throw;
+      return false;
+    }
+    lanes[lane].emplace(*this,
+                        std::move(*lease),
+                        query + next * stride,
+                        knn,
+                        ef_search,
+                        beam_width,
+                        admission);
+    lane_query[lane] = next++;
+    ++active;
+    return true;
+  };
+
+  while (next < num_queries || active > 0) {
+    for (size_t lane = 0; lane < lanes.size(); ++lane) {
+      if (!lanes[lane].has_value() && (next == num_queries || !start(lane))) {
+        continue;
+      }
+      if (!lanes[lane]->resume()) {
+        continue;
+      }
+      const size_t row = lane_query[lane];
+      lanes[lane]->finish(results + row * knn,
+                          distances == nullptr ? nullptr : distances + row * knn);
+      lanes[lane].reset();
+      --active;
+    }
   }
 }
 
@@ -1333,11 +1585,10 @@ inline void QuantizedGraph::arena_search_with(ArenaScratch &scratch,
                                               size_t ef_search,
                                               const RowAdmission *admission,
                                               float *ALAYA_RESTRICT distances) {
-  if (!arena_identity_) {
-    throw std::runtime_error(
-        "arena_search_qg: requires a 100% identity-ordered node cache sidecar");
-  }
+  const ArenaRows rows = arena_rows();
   scratch.ensure(num_points_, ef_search, dimension_ + residual_dimension_);
+  const bool tracing = visit_sketch_ != nullptr && visit_sketch_->sample();
+  scratch.trace_.clear();
 
   ALAYA_KSP_COUNT(queries);
   ALAYA_KSP_BEGIN(prep);
@@ -1376,11 +1627,10 @@ inline void QuantizedGraph::arena_search_with(ArenaScratch &scratch,
 
   buffer::ResultBuffer res_pool(knn);
   std::vector<float> appro_dist(degree_bound_);
-  const char *arena = cache_nodes_.data();
   const size_t pf_lines = arena_prefetch_lines((node_len_ + 63) / 64);
-  const char *pf_base = pf_lines > 0 ? arena : nullptr;
-  if (pf_base != nullptr) {
-    prefetch_row_l1(arena + static_cast<size_t>(entry_point_) * node_len_, pf_lines);
+  const ArenaRows *pf_rows = pf_lines > 0 ? &rows : nullptr;
+  if (pf_rows != nullptr) {
+    prefetch_row_l1(rows.row(entry_point_), pf_lines);
   }
 
   while (scratch.search_pool_.has_next()) {
@@ -1389,15 +1639,17 @@ inline void QuantizedGraph::arena_search_with(ArenaScratch &scratch,
       continue;
     }
     scratch.visited_.set(cur_node);
-    const auto *cur_data =
-        reinterpret_cast<const float *>(arena + static_cast<size_t>(cur_node) * node_len_);
+    if (tracing) {
+      scratch.trace_.push_back(cur_node);
+    }
+    const auto *cur_data = reinterpret_cast<const float *>(rows.row(cur_node));
     float sqr_y = scan_neighbors(q_obj,
                                  cur_data,
                                  appro_dist.data(),
                                  scratch.search_pool_,
                                  this->degree_bound_,
                                  scratch.visited_,
-                                 pf_base,
+                                 pf_rows,
                                  pf_lines);
     if (residual_dimension_ > 0) {
       sqr_y += exact_distance(cur_data + dimension_, residual_query, residual_dimension_);
@@ -1411,6 +1663,9 @@ inline void QuantizedGraph::arena_search_with(ArenaScratch &scratch,
     }
   }
 
+  if (tracing) {
+    visit_sketch_->record(scratch.trace_);
+  }
   res_pool.copy_results(results, distances);
 }
 
@@ -1475,319 +1730,334 @@ inline void QuantizedGraph::disk_search_qg(const float *ALAYA_RESTRICT query,
                                            size_t beam_width,
                                            const RowAdmission *admission,
                                            float *ALAYA_RESTRICT distances) {
-  auto lease = acquire_thread_data(beam_width);
-  ThreadData &data = lease.data();
-  data.search_scratch_.ensure(num_points_, ef_search, dimension_ + residual_dimension_);
+  PagedSearchTask task(*this,
+                       acquire_thread_data(beam_width),
+                       query,
+                       knn,
+                       ef_search,
+                       beam_width,
+                       admission);
+  // The lone query has nothing to overlap with, so an unready page is polled
+  // for in place.
+  while (!task.resume()) {
+  }
+  task.finish(results, distances);
+}
+
+inline QuantizedGraph::PagedSearchTask::PagedSearchTask(QuantizedGraph &graph,
+                                                        PagedThreadDataLease lease,
+                                                        const float *ALAYA_RESTRICT query,
+                                                        uint32_t knn,
+                                                        size_t ef_search,
+                                                        size_t beam_width,
+                                                        const RowAdmission *admission)
+    : graph_(graph),
+      lease_(std::move(lease)),
+      data_(lease_.data()),
+      admission_(admission),
+      beam_width_(beam_width),
+      q_obj_(query, graph.padded_dim_),
+      res_pool_(knn),
+      appro_dist_(graph.degree_bound_) {
+  data_.search_scratch_.ensure(graph_.num_points_,
+                               ef_search,
+                               graph_.dimension_ + graph_.residual_dimension_);
+  tracing_ = graph_.visit_sketch_ != nullptr && graph_.visit_sketch_->sample();
 
   // ==================== PCA Transform ====================
   // Transform the original query using PCA for dimension reordering.
   // After transformation, high-variance dimensions are placed first.
   const float *transformed_query = query;
-  if (pca_transform_.is_loaded()) {
-    pca_transform_.transform(query, data.search_scratch_.pca_query_scratch_.data());
-    transformed_query = data.search_scratch_.pca_query_scratch_.data();
+  if (graph_.pca_transform_.is_loaded()) {
+    graph_.pca_transform_.transform(query, data_.search_scratch_.pca_query_scratch_.data());
+    transformed_query = data_.search_scratch_.pca_query_scratch_.data();
   }
 
-  // Performance timing variables (for profiling purposes)
-  auto query_start = std::chrono::high_resolution_clock::now();
-  int64_t submit_time = 0;
-  int64_t wait_time = 0;
-  int64_t process_time = 0;
-  float n_hops = 0;  // Number of I/O rounds (disk access iterations)
-
   // ==================== Query Preparation ====================
-  // Create query object and apply Fast Hadamard Transform rotation.
+  // Apply Fast Hadamard Transform rotation.
   // This rotation aligns the query with the quantized representation used in RaBitQ.
-  QGQuery q_obj(transformed_query, padded_dim_);
-  q_obj.query_prepare(rotator_, scanner_);
+  q_obj_.rebind(transformed_query);
+  q_obj_.query_prepare(graph_.rotator_, graph_.scanner_);
 
   // Pointer to residual query components (used for datasets like GIST with extended dimensions)
-  const float *residual_query = transformed_query + dimension_;
+  residual_query_ = transformed_query + graph_.dimension_;
 
   // Compute ||q_r||^2 for residual dimensions to improve approximate distance precision
   float sqr_qr = 0;
-  for (size_t i = 0; i < residual_dimension_; ++i) {
-    sqr_qr += residual_query[i] * residual_query[i];
+  for (size_t i = 0; i < graph_.residual_dimension_; ++i) {
+    sqr_qr += residual_query_[i] * residual_query_[i];
   }
-  q_obj.set_sqr_qr(sqr_qr);
+  q_obj_.set_sqr_qr(sqr_qr);
 
   // ==================== Search Pool Initialization ====================
   // Initialize the search frontier with starting points.
   // If medoids (cluster centers) are available, find the closest one to the query
   // and use it as an additional entry point for better search quality.
-  if (!medoids_.empty()) {
+  if (!graph_.medoids_.empty()) {
     PID best_medoid = 0;
     float best_dist = FLT_MAX;
-    size_t best_medoid_idx = 0;
     // Linear scan through medoids to find the closest one
-    for (size_t cur_m = 0; cur_m < medoids_.size(); cur_m++) {
-      float cur_expanded_dist =
-          exact_distance(transformed_query,
-                         medoids_vector_.data() + (dimension_ + residual_dimension_) * cur_m,
-                         dimension_);
+    for (size_t cur_m = 0; cur_m < graph_.medoids_.size(); cur_m++) {
+      float cur_expanded_dist = graph_.exact_distance(
+          transformed_query,
+          graph_.medoids_vector_.data() + (graph_.dimension_ + graph_.residual_dimension_) * cur_m,
+          graph_.dimension_);
       if (cur_expanded_dist < best_dist) {
-        best_medoid = medoids_[cur_m];
+        best_medoid = graph_.medoids_[cur_m];
         best_dist = cur_expanded_dist;
-        best_medoid_idx = cur_m;
       }
     }
     // Insert best medoid with max distance (distance will be computed when visited)
-    data.search_scratch_.search_pool_.insert(best_medoid, FLT_MAX);
+    data_.search_scratch_.search_pool_.insert(best_medoid, FLT_MAX);
   }
   // Always include the global entry point as a starting position
-  data.search_scratch_.search_pool_.insert(entry_point_, FLT_MAX);
-
-  // ==================== Result and Distance Buffers ====================
-  // Result pool maintains the top-k nearest neighbors found during search
-  buffer::ResultBuffer res_pool(knn);
-
-  // Buffer for storing approximate distances computed via RaBitQ fast scan.
-  // RaBitQ computes distances to all neighbors of a node in a single SIMD-optimized pass.
-  std::vector<float> appro_dist(degree_bound_);
+  data_.search_scratch_.search_pool_.insert(graph_.entry_point_, FLT_MAX);
 
   // ==================== Asynchronous I/O Data Structures ====================
-  // frontier_read_reqs: Batch of aligned read requests to submit to AIO
-#if defined(_WIN32)
-  std::vector<AlignedRead> frontier_read_reqs;
-#else
-  std::vector<storage::io::ReadRequest> frontier_read_reqs;
-#endif
-  frontier_read_reqs.reserve(2 * beam_width);
-
-  // issued_nodes preserves the logical frontier order across asynchronous I/O.
-  // Completions only flip read_ready; processing always consumes this FIFO.
-  std::deque<std::pair<PID, char *>> issued_nodes;
-  std::unordered_map<PID, bool> read_ready;
-
+  frontier_read_reqs_.reserve(2 * beam_width_);
   // free_slots: Pool of available memory buffers for disk reads (double-buffering scheme)
-  std::deque<char *> free_slots;
-  for (size_t i = 0; i < 2 * beam_width; i++) {
-    free_slots.push_back(data.sector_scratch_ + i * page_size_);
+  for (size_t i = 0; i < 2 * beam_width_; i++) {
+    free_slots_.push_back(data_.sector_scratch_ + i * graph_.page_size_);
   }
+}
 
-  // Backend-independent event buffer for collecting completed I/O operations.
-#if defined(_WIN32)
-  std::vector<AlignedReadEvent> evts;
-#else
-  std::vector<storage::io::ReadResult> evts;
-#endif
-
-  // cache_nhoods: Nodes found in memory cache (no disk I/O needed)
-  std::vector<PID> cache_nhoods;
-
-  // Adaptive beam width: starts at 1 and grows exponentially
-  size_t cur_beam_size = 1;
-
-  // ==================== Node Processing Lambda ====================
-  // This lambda processes a single node: computes exact distance to query,
-  // scans neighbors using RaBitQ approximation, and updates search/result pools.
-  auto process_node = [&](PID cur_node, float *cur_data) {
-    // Scan neighbors and compute approximate distances using RaBitQ.
-    // Also computes exact L2 distance from query to current node.
-    float sqr_y = scan_neighbors(q_obj,
-                                 cur_data,
-                                 appro_dist.data(),
-                                 data.search_scratch_.search_pool_,
-                                 this->degree_bound_,
-                                 data.search_scratch_.visited_);
-    // Add residual dimension distance if applicable (e.g., for GIST dataset)
-    if (residual_dimension_ > 0) {
-      float *residual_data = cur_data + dimension_;
-      sqr_y += exact_distance(reinterpret_cast<const float *>(residual_data),
-                              residual_query,
-                              residual_dimension_);
-    }
-    // Insert current node with exact distance into result pool (unless the
-    // node is filtered out: tombstoned, or excluded by a per-call admission
-    // predicate. Routing still passes through it either way.)
-    const bool admit = admission != nullptr
-                           ? admission->test(cur_node)
-                           : (result_filter_ == nullptr ||
-                              result_filter_->find(cur_node) == result_filter_->end());
-    if (admit) {
-      res_pool.insert(cur_node, sqr_y);
+inline auto QuantizedGraph::PagedSearchTask::resume() -> bool {
+  for (;;) {
+    switch (phase_) {
+      case Phase::kExpand:
+        if (!data_.search_scratch_.search_pool_.has_next()) {
+          phase_ = Phase::kDrain;
+          break;
+        }
+        expand_frontier();
+        phase_ = Phase::kProcess;
+        break;
+      case Phase::kProcess:
+        // Process issued nodes (from previous or current iteration) in frontier order.
+        while (need_process_num_ > 0) {
+          if (!process_next_issued()) return false;
+          need_process_num_--;
+        }
+        phase_ = Phase::kExpand;
+        break;
+      case Phase::kDrain:
+        // After the main loop exits, there may still be nodes in the pipeline
+        // that haven't been processed yet. Drain the remaining nodes.
+        while (previous_remain_num_ > 0) {
+          if (!process_next_issued()) return false;
+          previous_remain_num_--;
+        }
+        assert(issued_nodes_.empty());
+        assert(read_ready_.empty());
+        phase_ = Phase::kDone;
+        return true;
+      case Phase::kDone:
+        return true;
     }
-  };
-
-  // ==================== I/O Completion Handler Lambda ====================
-  // Collects completed I/O events and marks their issued nodes ready.
-  // Uses non-blocking reader polling to check for completed I/O without waiting.
-  auto wait_for_nodes = [&]() {
-#if defined(_WIN32)
-    const auto ret = static_cast<std::size_t>(
-        aligned_file_reader_->poll_events(data.ctx_, static_cast<int>(cur_beam_size), evts));
-#else
-    const auto ret = poll_page_reads(*data.completions_, cur_beam_size, evts);
-#endif
+  }
+}
 
-    // Process each completed I/O event
-    for (std::size_t i = 0; i < ret; i++) {
-      const auto id = static_cast<PID>(evts[i].id);
-      const auto state = read_ready.find(id);
-      if (state == read_ready.end() || state->second) {
-        throw std::runtime_error(
-            "disk_search_qg: I/O completion id is unknown or duplicated "
-            "(page reader returned an unexpected id)");
-      }
-      state->second = true;
-    }
-  };
+inline void QuantizedGraph::PagedSearchTask::finish(uint32_t *ALAYA_RESTRICT results,
+                                                    float *ALAYA_RESTRICT distances) {
+  assert(phase_ == Phase::kDone);
+  // Copy the k nearest neighbor IDs from result pool to output array
+  res_pool_.copy_results(results, distances);
+  if (tracing_) {
+    graph_.visit_sketch_->record(trace_);
+  }
+  lease_.mark_reusable();
+}
 
-  // Completion timing is deliberately not a search input. A later request may
-  // finish first, but its row stays buffered until every earlier issued row has
-  // been processed. This retains batched asynchronous reads and the existing
-  // half-batch pipeline while making frontier mutation deterministic.
-  auto process_next_issued = [&]() -> bool {
-    if (issued_nodes.empty()) {
-      throw std::runtime_error("disk_search_qg: issued-node accounting underflow");
-    }
-    const auto state = read_ready.find(issued_nodes.front().first);
-    if (state == read_ready.end()) {
-      throw std::runtime_error("disk_search_qg: issued node has no read state");
+// One round of the beam search: pop up to the current beam of unvisited
+// candidates, submit reads for the uncached ones, process the cached ones,
+// and decide how many issued rows this round must consume before the next.
+inline void QuantizedGraph::PagedSearchTask::expand_frontier() {
+  auto &search_pool = data_.search_scratch_.search_pool_;
+  auto &visited = data_.search_scratch_.visited_;
+  frontier_read_reqs_.clear();
+  cache_nhoods_.clear();
+  size_t n_ops = 0;
+  size_t row_cache_hits = 0;
+
+  // Adaptive beam width: double the beam size each iteration (up to max)
+  // This helps balance between exploration breadth and I/O efficiency.
+  cur_beam_size_ =
+      std::min(beam_width_, static_cast<size_t>(std::ceil(2 * static_cast<float>(cur_beam_size_))));
+
+  // -------------------- Build I/O Request Batch --------------------
+  // Pop candidates from search pool and prepare I/O requests for non-cached nodes.
+  while (search_pool.has_next() && frontier_read_reqs_.size() + row_cache_hits < cur_beam_size_) {
+    PID cur_node = search_pool.pop();
+
+    // Skip already visited nodes to avoid redundant processing
+    if (visited.get(cur_node)) {
+      continue;
     }
-    if (!state->second) return false;
-
-    const auto node = issued_nodes.front();
-    issued_nodes.pop_front();
-    read_ready.erase(state);
-    process_node(node.first, reinterpret_cast<float *>(node.second + offset_to_node(node.first)));
-    free_slots.push_back(node.second);
-    return true;
-  };
+    visited.set(cur_node);
 
-  // Track remaining nodes from previous iteration for pipelined processing
-  size_t previous_remain_num = 0;
-
-  // Total I/O operations counter (for profiling)
-  int64_t io_num = 0;
-
-  // ==================== Main Search Loop ====================
-  // Iteratively expand search frontier until no more candidates remain.
-  // Uses beam search with adaptive width and pipelined I/O processing.
-  while (data.search_scratch_.search_pool_.has_next()) {
-    frontier_read_reqs.clear();
-    cache_nhoods.clear();
-    size_t n_ops = 0;
-    size_t need_process_num = 0;
-    size_t remain_num = 0;
-
-    // Adaptive beam width: double the beam size each iteration (up to max)
-    // This helps balance between exploration breadth and I/O efficiency.
-    cur_beam_size =
-        std::min(beam_width, static_cast<size_t>(std::ceil(2 * static_cast<float>(cur_beam_size))));
-
-    auto wait_start = std::chrono::high_resolution_clock::now();
-
-    // -------------------- Build I/O Request Batch --------------------
-    // Pop candidates from search pool and prepare I/O requests for non-cached nodes.
-    while (data.search_scratch_.search_pool_.has_next() &&
-           frontier_read_reqs.size() < cur_beam_size) {
-      PID cur_node = data.search_scratch_.search_pool_.pop();
-
-      // Skip already visited nodes to avoid redundant processing
-      if (data.search_scratch_.visited_.get(cur_node)) {
+    // Check if node is in memory cache
+    if (graph_.cached_row(cur_node) != nullptr) {
+      // Cache hit: add to cache_nhoods for immediate processing
+      cache_nhoods_.push_back(cur_node);
+    } else {
+      // Cache miss: need to read from disk
+      if (free_slots_.empty()) {
+        throw std::runtime_error("QuantizedGraph::search: free_buffer pool exhausted");
+      }
+      // Allocate a buffer slot for this read
+      char *slot = free_slots_.front();
+      assert(slot != nullptr);
+      free_slots_.pop_front();
+      // An adaptive-cache hit keeps the frontier slot of the read it replaces
+      // and is merely ready at once, so the cache never changes a result.
+      const uint64_t row_cache_epoch =
+          graph_.row_cache_ != nullptr ? graph_.row_cache_->epoch(cur_node) : 0;
+      const bool from_row_cache =
+          graph_.row_cache_ != nullptr &&
+          graph_.row_cache_->lookup(cur_node, slot + graph_.offset_to_node(cur_node));
+      const bool inserted = read_ready_.emplace(cur_node, from_row_cache).second;
+      if (!inserted) {
+        throw std::runtime_error("disk_search_qg: duplicate issued node");
+      }
+      issued_nodes_.push_back({cur_node, slot, from_row_cache, row_cache_epoch});
+      if (from_row_cache) {
+        ++row_cache_hits;
+        graph_.total_read_num_.fetch_add(1, std::memory_order_relaxed);
         continue;
       }
-      data.search_scratch_.visited_.set(cur_node);
-
-      // Check if node is in memory cache
-      if (caches_.find(cur_node) != caches_.end()) {
-        // Cache hit: add to cache_nhoods for immediate processing
-        cache_nhoods.push_back(cur_node);
-      } else {
-        // Cache miss: need to read from disk
-        if (free_slots.empty()) {
-          throw std::runtime_error("QuantizedGraph::search: free_buffer pool exhausted");
-        }
-        // Allocate a buffer slot for this read
-        char *slot = free_slots.front();
-        assert(slot != nullptr);
-        free_slots.pop_front();
-        const bool inserted = read_ready.emplace(cur_node, false).second;
-        if (!inserted) {
-          throw std::runtime_error("disk_search_qg: duplicate issued node");
-        }
-        issued_nodes.emplace_back(cur_node, slot);
-        // Create aligned read request (page-aligned for direct I/O)
+      // Create aligned read request (page-aligned for direct I/O)
 #if defined(_WIN32)
-        frontier_read_reqs.emplace_back(get_page_offset(cur_node), page_size_, cur_node, slot);
+      frontier_read_reqs_.emplace_back(graph_.get_page_offset(cur_node),
+                                       graph_.page_size_,
+                                       cur_node,
+                                       slot);
 #else
-        frontier_read_reqs.push_back(
-            {.id = cur_node,
-             .offset = get_page_offset(cur_node),
-             .buffer = std::span(reinterpret_cast<std::byte *>(slot), page_size_)});
+      frontier_read_reqs_.push_back(
+          {.id = cur_node,
+           .offset = graph_.get_page_offset(cur_node),
+           .buffer = std::span(reinterpret_cast<std::byte *>(slot), graph_.page_size_)});
 #endif
-      }
-      total_read_num_.fetch_add(1, std::memory_order_relaxed);
     }
+    graph_.total_read_num_.fetch_add(1, std::memory_order_relaxed);
+  }
 
-    // -------------------- Submit Async I/O Requests --------------------
-    // Submit batch of read requests to the AIO subsystem
-    if (!frontier_read_reqs.empty()) {
-      n_hops++;  // Count as one I/O round
-      auto submit_start = std::chrono::high_resolution_clock::now();
+  // -------------------- Submit Async I/O Requests --------------------
+  // Submit batch of read requests to the AIO subsystem
+  if (!frontier_read_reqs_.empty()) {
 #if defined(_WIN32)
-      n_ops = aligned_file_reader_->submit_reqs(frontier_read_reqs, data.ctx_);
+    n_ops = graph_.aligned_file_reader_->submit_reqs(frontier_read_reqs_, data_.ctx_);
 #else
-      n_ops = submit_page_reads(*page_reader_, frontier_read_reqs, *data.completions_);
+    // Pages another search is already fetching are joined, not re-read.
+    n_ops = graph_.shared_page_reads_.submit(*graph_.page_reader_,
+                                             frontier_read_reqs_,
+                                             data_.completions_);
 #endif
-      io_num += n_ops;
-      auto submit_end = std::chrono::high_resolution_clock::now();
-      submit_time +=
-          std::chrono::duration_cast<std::chrono::microseconds>(submit_end - submit_start).count();
-    }
-
-    // -------------------- Process Cached Nodes --------------------
-    // Process cached nodes (these are stored in memory and don't require disk I/O)
-    for (auto &cache_id : cache_nhoods) {
-      auto *cur_data = caches_.at(cache_id);
-      process_node(cache_id, reinterpret_cast<float *>(cur_data));
-    }
+  }
+  n_ops += row_cache_hits;
 
-    // -------------------- Pipelined Processing --------------------
-    // Calculate how many nodes to process in this iteration.
-    // We process half of new I/O ops plus leftovers from previous iteration,
-    // allowing I/O and computation to overlap (pipelining).
-    remain_num = 0.5 * n_ops;
-    need_process_num = n_ops + previous_remain_num - remain_num;
-    previous_remain_num = remain_num;
-
-    // Process issued nodes (from previous or current iteration) in frontier order.
-    while (need_process_num > 0) {
-      if (process_next_issued()) {
-        need_process_num--;
-      } else {
-        // The oldest issued node is not ready; collect more completions.
-        wait_for_nodes();
-      }
-    }
+  // -------------------- Process Cached Nodes --------------------
+  // Process cached nodes (these are stored in memory and don't require disk I/O)
+  for (auto &cache_id : cache_nhoods_) {
+    auto *cur_data = graph_.cached_row(cache_id);
+    process_node(cache_id, reinterpret_cast<float *>(cur_data));
   }
 
-  // ==================== Process Remaining Nodes ====================
-  // After the main loop exits, there may still be nodes in the pipeline
-  // that haven't been processed yet. Drain the remaining nodes.
-  while (previous_remain_num > 0) {
-    if (process_next_issued()) {
-      previous_remain_num--;
-    } else {
-      // Wait for the oldest remaining issued node to complete.
-      wait_for_nodes();
-    }
+  // -------------------- Pipelined Processing --------------------
+  // Calculate how many nodes to process in this iteration.
+  // We process half of new I/O ops plus leftovers from previous iteration,
+  // allowing I/O and computation to overlap (pipelining).
+  const size_t remain_num = 0.5 * n_ops;
+  need_process_num_ = n_ops + previous_remain_num_ - remain_num;
+  previous_remain_num_ = remain_num;
+}
+
+// Processes a single node: computes exact distance to query, scans neighbors
+// using RaBitQ approximation, and updates search/result pools.
+inline void QuantizedGraph::PagedSearchTask::process_node(PID cur_node, float *cur_data) {
+  if (tracing_) {
+    trace_.push_back(cur_node);
+  }
+  // Scan neighbors and compute approximate distances using RaBitQ.
+  // Also computes exact L2 distance from query to current node.
+  float sqr_y = graph_.scan_neighbors(q_obj_,
+                                      cur_data,
+                                      appro_dist_.data(),
+                                      data_.search_scratch_.search_pool_,
+                                      graph_.degree_bound_,
+                                      data_.search_scratch_.visited_);
+  // Add residual dimension distance if applicable (e.g., for GIST dataset)
+  if (graph_.residual_dimension_ > 0) {
+    float *residual_data = cur_data + graph_.dimension_;
+    sqr_y += graph_.exact_distance(reinterpret_cast<const float *>(residual_data),
+                                   residual_query_,
+                                   graph_.residual_dimension_);
+  }
+  // Insert current node with exact distance into result pool (unless the
+  // node is filtered out: tombstoned, or excluded by a per-call admission
+  // predicate. Routing still passes through it either way.)
+  const bool admit = admission_ != nullptr
+                         ? admission_->test(cur_node)
+                         : (graph_.result_filter_ == nullptr ||
+                            graph_.result_filter_->find(cur_node) == graph_.result_filter_->end());
+  if (admit) {
+    res_pool_.insert(cur_node, sqr_y);
   }
-  assert(issued_nodes.empty());
-  assert(read_ready.empty());
+}
 
-  // Record query end time for latency measurement
-  auto query_end = std::chrono::high_resolution_clock::now();
+// Collects completed I/O events and marks their issued nodes ready.
+// Uses non-blocking reader polling to check for completed I/O without waiting.
+inline void QuantizedGraph::PagedSearchTask::collect_completions() {
+#if defined(_WIN32)
+  const auto ret = static_cast<std::size_t>(graph_.aligned_file_reader_->poll_events(
+      data_.ctx_, static_cast<int>(cur_beam_size_), evts_));
+#else
+  const auto ret = poll_page_reads(*data_.completions_, cur_beam_size_, evts_);
+#endif
 
-  auto latency =
-      std::chrono::duration_cast<std::chrono::microseconds>(query_end - query_start).count();
+  // Process each completed I/O event
+  for (std::size_t i = 0; i < ret; i++) {
+    const auto id = static_cast<PID>(evts_[i].id);
+    const auto state = read_ready_.find(id);
+    if (state == read_ready_.end() || state->second) {
+      throw std::runtime_error(
+          "disk_search_qg: I/O completion id is unknown or duplicated "
+          "(page reader returned an unexpected id)");
+    }
+    state->second = true;
+  }
+}
 
-  // ==================== Copy Results and Cleanup ====================
-  // Copy the k nearest neighbor IDs from result pool to output array
-  res_pool.copy_results(results, distances);
+// Completion timing is deliberately not a search input. A later request may
+// finish first, but its row stays buffered until every earlier issued row has
+// been processed. This retains batched asynchronous reads and the existing
+// half-batch pipeline while making frontier mutation deterministic, and it is
+// what lets batch_search interleave queries without changing any result.
+// Returns false when the oldest issued row has still not arrived after one
+// poll of the completion queue.
+inline auto QuantizedGraph::PagedSearchTask::process_next_issued() -> bool {
+  if (issued_nodes_.empty()) {
+    throw std::runtime_error("disk_search_qg: issued-node accounting underflow");
+  }
+  auto state = read_ready_.find(issued_nodes_.front().id);
+  if (state == read_ready_.end()) {
+    throw std::runtime_error("disk_search_qg: issued node has no read state");
+  }
+  if (!state->second) {
+    collect_completions();
+    state = read_ready_.find(issued_nodes_.front().id);
+    if (!state->second) return false;
+  }
 
-  lease.mark_reusable();
+  const auto node = issued_nodes_.front();
+  issued_nodes_.pop_front();
+  read_ready_.erase(state);
+  char *row = node.slot + graph_.offset_to_node(node.id);
+  process_node(node.id, reinterpret_cast<float *>(row));
+  if (!node.from_row_cache && graph_.row_cache_ != nullptr) {
+    graph_.row_cache_->admit(node.id, row, node.row_cache_epoch);
+  }
+  free_slots_.push_back(node.slot);
+  return true;
 }
 
 // scan a data row (including data vec and quantization codes for its neighbors)
@@ -1798,7 +2068,7 @@ inline float QuantizedGraph::scan_neighbors(const QGQuery &q_obj,
                                             buffer::SearchBuffer &search_pool,
                                             uint32_t cur_degree,
                                             const HashBasedBooleanSet &visited,
-                                            const char *pf_base,
+                                            const ArenaRows *pf_rows,
                                             size_t pf_lines) const {
   ALAYA_KSP_COUNT(pops);
   ALAYA_KSP_BEGIN(exact);
@@ -1829,8 +2099,8 @@ inline float QuantizedGraph::scan_neighbors(const QGQuery &q_obj,
       continue;
     }
     search_pool.insert(cur_neighbor, tmp_dist);
-    if (pf_base != nullptr) {
-      prefetch_row_l2(pf_base + static_cast<size_t>(search_pool.next_id()) * node_len_, pf_lines);
+    if (pf_rows != nullptr) {
+      prefetch_row_l2(pf_rows->row(search_pool.next_id()), pf_lines);
     }
   }
   ALAYA_KSP_END(pool);
@@ -1873,12 +2143,6 @@ inline void QuantizedGraph::update_qg_out_of_memory(
 
   size_t full_page_size = ((dimension_ + residual_dimension_) * sizeof(float) + kSectorLen - 1) /
                           kSectorLen * kSectorLen;
-  size_t main_page_size = (dimension_ * sizeof(float) + kSectorLen - 1) / kSectorLen * kSectorLen;
-
-  kernels::linalg::RowMajorMatrix<float> x_pad(cur_degree, padded_dim_);  // padded neighbors mat
-  kernels::linalg::RowMajorMatrix<float> c_pad(1, padded_dim_);  // padded duplicate centroid mat
-  x_pad.setZero();
-  c_pad.setZero();
 
   std::vector<AlignedRead> frontier_read_reqs;
   frontier_read_reqs.reserve(cur_degree + 1);
@@ -1910,14 +2174,47 @@ inline void QuantizedGraph::update_qg_out_of_memory(
     neighbor_ptr[i] = new_neighbors[i].id;
   }
 
+  encode_node(new_neighbors, page_buf, [&](size_t i) {
+    return reinterpret_cast<const float *>(vector_buf + i * full_page_size);
+  });
+}
+
+inline void QuantizedGraph::update_qg_in_memory(PID cur_id,
+                                                const std::vector<Candidate<float>> &new_neighbors,
+                                                const float *vectors,
+                                                char *node_buf) {
+  if (new_neighbors.empty()) {
+    return;
+  }
+  const size_t stride = dimension_ + residual_dimension_;
+  std::copy_n(vectors + cur_id * stride, stride, reinterpret_cast<float *>(node_buf));
+  auto *neighbor_ptr = reinterpret_cast<PID *>(node_buf + neighbor_offset_ * 4);
+  for (size_t i = 0; i < new_neighbors.size(); ++i) {
+    neighbor_ptr[i] = new_neighbors[i].id;
+  }
+  encode_node(new_neighbors, node_buf, [&](size_t i) {
+    return vectors + static_cast<size_t>(new_neighbors[i].id) * stride;
+  });
+}
+
+// Fills the RaBitQ codes and factors of a node whose own vector and neighbor
+// ids are already in `page_buf`; `row(i)` yields neighbor i's full vector.
+template <typename NeighborRow>
+inline void QuantizedGraph::encode_node(const std::vector<Candidate<float>> &new_neighbors,
+                                        char *page_buf,
+                                        NeighborRow row) {
+  const size_t cur_degree = new_neighbors.size();
+  kernels::linalg::RowMajorMatrix<float> x_pad(cur_degree, padded_dim_);  // padded neighbors mat
+  kernels::linalg::RowMajorMatrix<float> c_pad(1, padded_dim_);  // padded duplicate centroid mat
+  x_pad.setZero();
+  c_pad.setZero();
+
   /* Copy data */
   for (size_t i = 0; i < cur_degree; ++i) {
-    auto neighbor_id = new_neighbors[i].id;
-    const auto *cur_data =
-        reinterpret_cast<const float *>(reinterpret_cast<char *>(vector_buf) + i * full_page_size);
+    const float *cur_data = row(i);
     std::copy(cur_data, cur_data + dimension_, &x_pad(static_cast<int64_t>(i), 0));
   }
-  const auto *cur_cent = reinterpret_cast<const float *>(reinterpret_cast<char *>(page_buf));
+  const auto *cur_cent = reinterpret_cast<const float *>(page_buf);
   std::copy(cur_cent, cur_cent + dimension_, &c_pad(0, 0));
 
   /* rotate Matrix */
@@ -1939,9 +2236,7 @@ inline void QuantizedGraph::update_qg_out_of_memory(
   // Add ||x_r||^2 (residual dimensions) directly to triple_x for improved precision
   // This avoids storing a separate sqr_xr array and saves computation during search
   for (size_t i = 0; i < cur_degree; ++i) {
-    const auto *neighbor_data =
-        reinterpret_cast<const float *>(reinterpret_cast<char *>(vector_buf) + i * full_page_size);
-    const float *residual_data = neighbor_data + dimension_;
+    const float *residual_data = row(i) + dimension_;
     float sqr_xr_val = 0;
     for (size_t j = 0; j < residual_dimension_; ++j) {
       sqr_xr_val += residual_data[j] * residual_data[j];
@@ -2117,10 +2412,6 @@ inline void QuantizedGraph::load_cache(std::string &cache_ids_file,
   cache_vectors_input.read(reinterpret_cast<char *>(cache_nodes_.data()),
                            static_cast<std::streamsize>(sizeof(char) * online_cache_num *
                                                         node_len_));
-  for (unsigned i = 0; i < cache_ids_.size(); i++) {
-    PID cur_id = cache_ids_[i];
-    caches_[cur_id] = cache_nodes_.data() + i * node_len_;
-  }
   arena_identity_ = cache_ids_.size() == num_points_;
   if (arena_identity_) {
     for (size_t i = 0; i < cache_ids_.size(); ++i) {
@@ -2130,6 +2421,13 @@ inline void QuantizedGraph::load_cache(std::string &cache_ids_file,
       }
     }
   }
+  if (arena_identity_) {
+    return;
+  }
+  for (unsigned i = 0; i < cache_ids_.size(); i++) {
+    PID cur_id = cache_ids_[i];
+    caches_[cur_id] = cache_nodes_.data() + i * node_len_;
+  }
 }
 
 inline void QuantizedGraph::ensure_resident_arena() {
@@ -2139,14 +2437,24 @@ inline void QuantizedGraph::ensure_resident_arena() {
   if (index_file_name_.empty()) {
     throw std::logic_error("QuantizedGraph::ensure_resident_arena: call load_disk_index() first");
   }
+  std::vector<char, ::alaya::UninitAlignedAlloc<char>> arena(num_points_ * node_len_);
+  load_arena_pages(arena.data());
+  cache_nodes_ = std::move(arena);
+  cache_ids_.resize(num_points_);
+  std::iota(cache_ids_.begin(), cache_ids_.end(), PID{0});
+  // The identity arena is addressed as pid * node_len_, so the per-node
+  // pointer map (one hash entry per row) is not built at all.
+  caches_.clear();
+  arena_identity_ = true;
+}
+
+#if defined(_WIN32)
+inline void QuantizedGraph::load_arena_pages(char *arena, size_t /*chunk_bytes*/) {
   std::ifstream in(index_file_name_, std::ios::binary);
   if (!in.is_open()) {
     throw std::runtime_error("QuantizedGraph::ensure_resident_arena: cannot open " +
                              index_file_name_);
   }
-  // Zero-fill on the calling thread = NUMA first-touch placement (the
-  // NumaPolicy::kFirstTouch default needs no further action here).
-  std::vector<char, ::alaya::AlignedAlloc<char>> arena(num_points_ * node_len_, 0);
   std::vector<char> page(page_size_);
   const size_t num_pages = (num_points_ + node_per_page_ - 1) / node_per_page_;
   for (size_t p = 0; p < num_pages; ++p) {
@@ -2160,18 +2468,231 @@ inline void QuantizedGraph::ensure_resident_arena() {
       throw std::runtime_error("QuantizedGraph::ensure_resident_arena: short read at page " +
                                std::to_string(p) + " of " + index_file_name_);
     }
-    for (size_t s = 0; s < rows_in_page; ++s) {
-      std::memcpy(arena.data() + (base + s) * node_len_, page.data() + s * node_len_, node_len_);
+    std::memcpy(arena + base * node_len_, page.data(), rows_in_page * node_len_);
+  }
+}
+#else
+inline void QuantizedGraph::load_arena_pages(char *arena, size_t chunk_bytes) {
+  const size_t num_pages = (num_points_ + node_per_page_ - 1) / node_per_page_;
+  if (num_pages == 0) {
+    return;
+  }
+  const size_t chunk_pages = std::max<size_t>(1, chunk_bytes / page_size_);
+  const size_t num_chunks = (num_pages + chunk_pages - 1) / chunk_pages;
+  const size_t workers = std::min<size_t>(num_chunks, ::alaya::configured_thread_limit());
+  // One read in flight per worker keeps the device queue `workers` deep.
+  auto reader = make_laser_page_reader(index_file_name_, static_cast<uint32_t>(workers));
+  std::vector<void *> buffers(workers, nullptr);
+
+  // Each worker owns a contiguous run of chunks, hence a contiguous slice of
+  // the arena that only it writes: its first touch places those pages on the
+  // worker's NUMA node.
+  std::mutex error_mutex;
+  std::exception_ptr first_error;
+  auto run = [&](size_t worker) {
+    try {
+      void *&buffer = buffers[worker];
+      buffer = allocate_page_read_buffer(*reader, chunk_pages * page_size_);
+      const size_t chunk_begin = worker * num_chunks / workers;
+      const size_t chunk_end = (worker + 1) * num_chunks / workers;
+      for (size_t chunk = chunk_begin; chunk < chunk_end; ++chunk) {
+        const size_t first_page = chunk * chunk_pages;
+        const size_t pages = std::min(chunk_pages, num_pages - first_page);
+        // The last chunk may run past EOF; the reader reports it as a short
+        // read, which is fine as long as every row it must supply arrived.
+        const storage::io::ReadRequest request{
+            .id = chunk,
+            .offset = kSectorLen + first_page * page_size_,
+            .buffer = std::span(static_cast<std::byte *>(buffer), pages * page_size_)};
+        const auto results = storage::io::read_pages_blocking(*reader, {&request, 1});
+        const size_t last_rows =
+            std::min(node_per_page_, num_points_ - (first_page + pages - 1) * node_per_page_);
+        const size_t needed = (pages - 1) * page_size_ + last_rows * node_len_;
+        if (results.size() != 1 ||
+            (results[0].status != storage::io::ReadStatus::ok &&
+             results[0].status != storage::io::ReadStatus::short_read) ||
+            results[0].bytes < needed) {
+          throw std::runtime_error("QuantizedGraph::ensure_resident_arena: short read at page " +
+                                   std::to_string(first_page) + " of " + index_file_name_);
+        }
+        const auto *pages_data = static_cast<const char *>(buffer);
+        for (size_t p = 0; p < pages; ++p) {
+          const size_t base = (first_page + p) * node_per_page_;
+          const size_t rows_in_page = std::min(node_per_page_, num_points_ - base);
+          std::memcpy(arena + base * node_len_,
+                      pages_data + p * page_size_,
+                      rows_in_page * node_len_);
+        }
+      }
+    } catch (...) {
+      std::lock_guard lock(error_mutex);
+      if (!first_error) {
+        first_error = std::current_exception();
+      }
+    }
+  };
+
+  std::vector<std::thread> helpers;
+  helpers.reserve(workers - 1);
+  try {
+    for (size_t worker = 1; worker < workers; ++worker) {
+      helpers.emplace_back(run, worker);
+    }
+  } catch (...) {
+    std::lock_guard lock(error_mutex);
+    if (!first_error) {
+      first_error = std::current_exception();
     }
   }
-  cache_nodes_ = std::move(arena);
-  cache_ids_.resize(num_points_);
-  std::iota(cache_ids_.begin(), cache_ids_.end(), PID{0});
-  caches_.clear();
-  for (size_t i = 0; i < cache_ids_.size(); ++i) {
-    caches_[cache_ids_[i]] = cache_nodes_.data() + i * node_len_;
+  run(0);
+  for (auto &helper : helpers) {
+    helper.join();
+  }
+  // Registered buffers must outlive the reader.
+  reader->shutdown();
+  for (void *buffer : buffers) {
+    std::free(buffer);
+  }
+  if (first_error) {
+    std::rethrow_exception(first_error);
+  }
+}
+#endif
+
+inline auto QuantizedGraph::arena_rows() const -> ArenaRows {
+  if (arena_identity_) {
+    return {.base = cache_nodes_.data(), .stride = node_len_, .node_len = node_len_};
+  }
+  if (!arena_mapped()) {
+    throw std::runtime_error(
+        "arena_search_qg: requires a 100% identity-ordered node cache sidecar or a mapped "
+        "index file");
+  }
+  const char *base = static_cast<const char *>(index_map_.data()) + kSectorLen;
+  if (node_per_page_ == 1) {
+    return {.base = base, .stride = page_size_, .node_len = node_len_};
+  }
+  if (node_per_page_ * node_len_ == page_size_) {
+    return {.base = base, .stride = node_len_, .node_len = node_len_};
+  }
+  return {.base = base,
+          .node_len = node_len_,
+          .node_per_page = node_per_page_,
+          .page_size = page_size_};
+}
+
+inline void QuantizedGraph::map_resident_arena() {
+  if (arena_mapped()) {
+    return;
+  }
+  if (index_file_name_.empty()) {
+    throw std::logic_error("QuantizedGraph::map_resident_arena: call load_disk_index() first");
+  }
+  storage::MMapFile map(index_file_name_);
+  const size_t num_pages = (num_points_ + node_per_page_ - 1) / node_per_page_;
+  size_t needed = kSectorLen;
+  if (num_pages > 0) {
+    const size_t last_rows = num_points_ - (num_pages - 1) * node_per_page_;
+    needed += (num_pages - 1) * page_size_ + last_rows * node_len_;
+  }
+  if (map.size() < needed) {
+    throw std::runtime_error("QuantizedGraph::map_resident_arena: " + index_file_name_ +
+                             " is shorter than its " + std::to_string(num_points_) + " rows");
+  }
+  // Graph hops land anywhere in the file, so fault-time readahead would only
+  // pull in neighbours nobody asked for; the prefault thread asks for its
+  // ranges explicitly instead.
+  map.advise(storage::MMapAccess::random);
+  map.advise(storage::MMapAccess::huge_pages);
+  index_map_ = std::move(map);
+  prefault_pages_total_ = num_pages;
+  prefault_pages_done_.store(0, std::memory_order_relaxed);
+  prefault_stop_.store(false, std::memory_order_relaxed);
+  try {
+    prefault_thread_ = std::thread([this] {
+      prefault_mapped_arena();
+    });
+  } catch (...) {
+    index_map_ = storage::MMapFile();
+    prefault_pages_total_ = 0;
+    throw;
+  }
+}
+
+inline void QuantizedGraph::stop_arena_prefault() noexcept {
+  prefault_stop_.store(true, std::memory_order_relaxed);
+  if (prefault_thread_.joinable()) {
+    prefault_thread_.join();
+  }
+}
+
+inline void QuantizedGraph::prefault_mapped_arena() noexcept {
+  // Readahead window of the sequential sweep.
+  constexpr size_t kWindowBytes = size_t{8} << 20U;
+  const size_t num_pages = prefault_pages_total_;
+  const auto *file = static_cast<const char *>(index_map_.data());
+  const size_t file_size = index_map_.size();
+  try {
+    std::vector<uint8_t> faulted(num_pages, 0);
+    volatile char sink = 0;
+    auto fault = [&](size_t page) {
+      if (faulted[page] != 0) {
+        return;
+      }
+      faulted[page] = 1;
+      const size_t begin = kSectorLen + page * page_size_;
+      const size_t end = std::min(file_size, begin + page_size_);
+      for (size_t offset = begin; offset < end; offset += kSectorLen) {
+        sink = file[offset];
+      }
+      prefault_pages_done_.fetch_add(1, std::memory_order_release);
+    };
+
+    // Hot pages first: readahead for all of them goes out before the first
+    // touch blocks, so their reads overlap.
+    std::vector<size_t> hot;
+    hot.reserve(cache_ids_.size() + medoids_.size() + 1);
+    auto add_hot = [&](PID pid) {
+      if (pid < num_points_) {
+        hot.push_back(pid / node_per_page_);
+      }
+    };
+    add_hot(entry_point_);
+    for (PID medoid : medoids_) {
+      add_hot(medoid);
+    }
+    for (PID pid : cache_ids_) {
+      add_hot(pid);
+    }
+    for (size_t page : hot) {
+      index_map_.advise(storage::MMapAccess::will_need, kSectorLen + page * page_size_, page_size_);
+    }
+    for (size_t page : hot) {
+      if (prefault_stop_.load(std::memory_order_relaxed)) {
+        return;
+      }
+      fault(page);
+    }
+
+    // Then everything else in id order, which the builder already sorted by
+    // in-degree.
+    const size_t window_pages = std::max<size_t>(1, kWindowBytes / page_size_);
+    for (size_t first = 0; first < num_pages; first += window_pages) {
+      const size_t last = std::min(num_pages, first + window_pages);
+      index_map_.advise(storage::MMapAccess::will_need,
+                        kSectorLen + first * page_size_,
+                        (last - first) * page_size_);
+      for (size_t page = first; page < last; ++page) {
+        if (prefault_stop_.load(std::memory_order_relaxed)) {
+          return;
+        }
+        fault(page);
+      }
+    }
+  } catch (...) {
+    // Out of memory for the bookkeeping: searches still fault pages in on
+    // demand; readiness simply stops advancing.
   }
-  arena_identity_ = true;
 }
 
 inline void QuantizedGraph::arena_reserve_rows(size_t rows) {
@@ -2184,16 +2705,32 @@ inline void QuantizedGraph::arena_reserve_rows(size_t rows) {
   if (cache_nodes_.size() >= want_bytes) {
     return;
   }
-  // Reallocation moves the arena, so the paged-path pointer map must be
-  // rebuilt. Callers run this before serving searches (updater ctor time);
-  // growth never runs concurrently with readers.
+  // Reallocation moves the arena; the paged path addresses it through
+  // cached_row(), so nothing else needs rebuilding. Callers run this before
+  // serving searches (updater ctor time); growth never runs concurrently with
+  // readers.
   cache_nodes_.resize(want_bytes, 0);
-  for (size_t i = 0; i < cache_ids_.size(); ++i) {
-    caches_[cache_ids_[i]] = cache_nodes_.data() + i * node_len_;
-  }
 }
 
 inline void QuantizedGraph::arena_mirror_write(uint64_t file_off, const char *buf, size_t len) {
+#if !defined(_WIN32)
+  // The bytes are on the file now; a search must not join a read of these
+  // pages that may have fetched them from before.
+  if (len != 0 && file_off >= kSectorLen) {
+    const uint64_t rel = file_off - kSectorLen;
+    for (uint64_t page = rel / page_size_; page * page_size_ < rel + len; ++page) {
+      shared_page_reads_.page_written(kSectorLen + page * page_size_);
+    }
+  }
+#endif
+  if (row_cache_ != nullptr && len != 0 && file_off >= kSectorLen) {
+    const uint64_t rel = file_off - kSectorLen;
+    for (uint64_t page = rel / page_size_; page * page_size_ < rel + len; ++page) {
+      for (size_t slot = 0; slot < node_per_page_; ++slot) {
+        row_cache_->invalidate(static_cast<PID>(page * node_per_page_ + slot));
+      }
+    }
+  }
   if (!arena_identity_ || len == 0 || file_off < kSectorLen) {
     return;  // metadata-sector writes (superblock A/B copies) carry no row bytes
   }
@@ -13,12 +13,16 @@
 #include <cstdlib>
 #include <cstring>
 #include <filesystem>
+#include <fstream>
 #include <functional>
 #include <iomanip>
 #include <iostream>
+#include <limits>
 #include <mutex>
 #include <numeric>
 #include <random>
+#include <stdexcept>
+#include <string>
 #include <unordered_set>
 #include <utility>
 #include <vector>
@@ -30,10 +34,13 @@
 #include "index/graph/laser/utils/aligned_file_reader_factory.hpp"
 #include "index/graph/laser/utils/tools.hpp"
 #include "platform/fs.hpp"
+#include "storage/io/direct_file_writer.hpp"
 #include "third_party/ngt/hashset.hpp"
 
 namespace alaya::laser {
 constexpr size_t kMaxBsIter = 5;
+// Pages encoded per DirectFileWriter call by QGBuilder::build_in_memory().
+constexpr size_t kInMemoryWriteBatchBytes = size_t{8} << 20U;
 using CandidateList = std::vector<Candidate<float>>;
 
 class PageAssembler {
@@ -93,8 +100,17 @@ class QGBuilder {
   std::vector<HashBasedBooleanSet> visited_list_;
   std::vector<uint32_t> degrees_;
   std::function<void(PID, const char *, size_t)> node_payload_observer_;
+  std::function<void(const std::string &, const char *, size_t)> file_bytes_observer_;
+  void observe_file_bytes(const std::string &path, const char *bytes, size_t len) const {
+    if (file_bytes_observer_) {
+      file_bytes_observer_(path, bytes, len);
+    }
+  }
   void random_init();
   void init_from_vamana(const std::string &filename);
+  void init_from_snapshot(const FrozenGraphSnapshot &snapshot);
+  void check_snapshot(const FrozenGraphSnapshot &snapshot, const char *caller) const;
+  void rank_cache_ids(const std::vector<uint32_t> &in_degrees);
   void search_new_neighbors(bool refine);
   void heuristic_prune(PID, CandidateList &, CandidateList &, bool);
   void add_reverse_edges(PID data_id, std::vector<std::mutex> &, bool);
@@ -121,6 +137,13 @@ class QGBuilder {
     node_payload_observer_ = std::move(observer);
   }
 
+  // Receives every byte build_in_memory() writes, file by file and in file
+  // order, so a caller can hash the artifacts without reading them back.
+  void set_file_bytes_observer(
+      std::function<void(const std::string &, const char *, size_t)> observer) {
+    file_bytes_observer_ = std::move(observer);
+  }
+
   /**
    * @brief Build through the existing Vamana-file entry point from an in-memory snapshot.
    *
@@ -129,19 +152,7 @@ class QGBuilder {
    * both success and exception paths.
    */
   void build_from_graph(const FrozenGraphSnapshot &snapshot, const char *filename) {
-    snapshot.validate();
-    if (snapshot.num_points() != num_nodes_) {
-      throw std::invalid_argument(
-          "QGBuilder::build_from_graph: snapshot size does not match QuantizedGraph");
-    }
-    if (snapshot.max_degree() != degree_bound_) {
-      throw std::invalid_argument(
-          "QGBuilder::build_from_graph: snapshot max_degree does not match QuantizedGraph");
-    }
-    if (snapshot.frozen_pts() != 0) {
-      throw std::invalid_argument(
-          "QGBuilder::build_from_graph: frozen points are not supported by the LASER packer");
-    }
+    check_snapshot(snapshot, "QGBuilder::build_from_graph");
 
     static std::atomic<std::uint64_t> sequence{0};
     const auto serial = sequence.fetch_add(1, std::memory_order_relaxed);
@@ -163,6 +174,127 @@ class QGBuilder {
     build(path_string.c_str(), filename);
   }
 
+  /**
+   * @brief Build straight from an in-memory graph and row-major vectors.
+   *
+   * Writes the same four files as build() -- byte-identical for the same
+   * graph, vectors and rotator seed -- without the {filename}_pca_base.fbin
+   * input, the sector-aligned temporary copy or a Vamana file. Nodes are
+   * encoded from `vectors` ((dim + residual_dim) floats per row) a batch of
+   * pages at a time and each batch is written once, at its final offset,
+   * through a DirectFileWriter. Cache node payloads are captured while
+   * encoding rather than read back from the finished index. Every file is
+   * synced before this returns, and its bytes go to the file-bytes observer.
+   */
+  void build_in_memory(const FrozenGraphSnapshot &snapshot,
+                       const float *vectors,
+                       const char *filename) {
+    check_snapshot(snapshot, "QGBuilder::build_in_memory");
+    init_from_snapshot(snapshot);
+
+    const std::string index_path = qg_.gen_index_path(filename);
+    const size_t page_size = qg_.page_size_;
+    const size_t node_per_page = qg_.node_per_page_;
+    const size_t node_len = qg_.node_len_;
+    const size_t page_num = (qg_.num_points_ + node_per_page - 1) / node_per_page;
+
+    const auto cache_num =
+        static_cast<size_t>(static_cast<double>(qg_.num_vertices()) * kCacheRatio);
+    qg_.cache_ids_.resize(cache_num);
+    std::vector<size_t> cache_slot(num_nodes_, cache_num);
+    for (size_t slot = 0; slot < cache_num; ++slot) {
+      cache_slot[qg_.cache_ids_[slot]] = slot;
+    }
+    const size_t cache_header = 2 * sizeof(size_t);
+    std::vector<char> cache_nodes(cache_header + cache_num * node_len);
+    std::memcpy(cache_nodes.data(), &cache_num, sizeof(size_t));
+    std::memcpy(cache_nodes.data() + sizeof(size_t), &node_len, sizeof(size_t));
+
+    const size_t batch_pages = std::max<size_t>(1, kInMemoryWriteBatchBytes / page_size);
+    struct AlignedBuffer {
+      char *data;
+      ~AlignedBuffer() { memory::align_free(data); }
+    } batch{reinterpret_cast<char *>(memory::align_allocate<kSectorLen>(
+        std::max(batch_pages * page_size, kSectorLen)))};
+
+    storage::io::DirectFileWriter output(index_path);
+    std::memset(batch.data, 0, kSectorLen);
+    auto *metas = reinterpret_cast<uint64_t *>(batch.data);
+    metas[0] = qg_.num_points_;
+    metas[1] = qg_.dimension_;
+    metas[2] = qg_.entry_point_;
+    metas[3] = node_len;
+    metas[4] = node_per_page;
+    qg_write_native_semantics(metas, kSectorLen, qg_.metric(), qg_.preprocessing());
+    metas[8] = page_size * page_num + kSectorLen;
+    output.write_at(0, batch.data, kSectorLen);
+    observe_file_bytes(index_path, batch.data, kSectorLen);
+
+    const int num_threads_signed = static_cast<int>(num_threads_);
+    for (size_t first_page = 0; first_page < page_num; first_page += batch_pages) {
+      const size_t pages = std::min(batch_pages, page_num - first_page);
+      const size_t first_row = first_page * node_per_page;
+      const size_t end_row = std::min(qg_.num_points_, (first_page + pages) * node_per_page);
+      std::memset(batch.data, 0, pages * page_size);
+      auto node_at = [&](size_t row) {
+        return batch.data + (row / node_per_page - first_page) * page_size +
+               (row % node_per_page) * node_len;
+      };
+#pragma omp parallel for schedule(dynamic) num_threads(num_threads_signed)
+      for (int64_t ii = static_cast<int64_t>(first_row); ii < static_cast<int64_t>(end_row);
+           ++ii) {
+        const auto row = static_cast<size_t>(ii);
+        char *node = node_at(row);
+        qg_.update_qg_in_memory(static_cast<PID>(row), new_neighbors_[row], vectors, node);
+        if (cache_slot[row] != cache_num) {
+          std::memcpy(cache_nodes.data() + cache_header + cache_slot[row] * node_len,
+                      node,
+                      node_len);
+        }
+      }
+      if (node_payload_observer_) {
+        for (size_t row = first_row; row < end_row; ++row) {
+          node_payload_observer_(static_cast<PID>(row), node_at(row), node_len);
+        }
+      }
+      output.write_at(kSectorLen + first_page * page_size, batch.data, pages * page_size);
+      observe_file_bytes(index_path, batch.data, pages * page_size);
+    }
+    output.finish();
+
+    const std::string rotator_path = index_path + "_rotator";
+    {
+      std::ofstream rotator_output(rotator_path, std::ios::binary | std::ios::trunc);
+      qg_.rotator_.save(rotator_output);
+      if (!rotator_output.flush()) {
+        throw std::runtime_error("QGBuilder::build_in_memory: cannot write " + rotator_path);
+      }
+    }
+    ::alaya::platform::sync_file_or_throw(rotator_path);
+    if (file_bytes_observer_) {
+      // The rotator saves itself through an ofstream; it is padded_dim floats,
+      // so it is the one artifact read back, straight from the page cache.
+      const auto rotator_bytes =
+          ::alaya::platform::read_regular_file_bounded(rotator_path,
+                                                       std::numeric_limits<std::size_t>::max());
+      observe_file_bytes(rotator_path, rotator_bytes.data(), rotator_bytes.size());
+    }
+
+    std::vector<char> cache_ids(sizeof(size_t) + cache_num * sizeof(PID));
+    std::memcpy(cache_ids.data(), &cache_num, sizeof(size_t));
+    std::memcpy(cache_ids.data() + sizeof(size_t),
+                qg_.cache_ids_.data(),
+                cache_num * sizeof(PID));
+    ::alaya::platform::write_all_fsync(index_path + "_cache_ids",
+                                       cache_ids.data(),
+                                       cache_ids.size());
+    observe_file_bytes(index_path + "_cache_ids", cache_ids.data(), cache_ids.size());
+    ::alaya::platform::write_all_fsync(index_path + "_cache_nodes",
+                                       cache_nodes.data(),
+                                       cache_nodes.size());
+    observe_file_bytes(index_path + "_cache_nodes", cache_nodes.data(), cache_nodes.size());
+  }
+
   /**
    * @brief Builds a disk-based quantized graph index from a Vamana graph and vector data.
    *
@@ -605,17 +737,52 @@ inline void QGBuilder::init_from_vamana(const std::string &filename) {
               << " (max observed in file: " << max_range_of_graph << ")" << std::endl;
   }
 
+  rank_cache_ids(in_degrees);
+
+  std::cout << "done. Index has " << nodes_read << " nodes and " << cc
+            << " out-edges, _start is set to " << start << std::endl;
+  assert(nodes_read == num_nodes_);
+}
+
+inline void QGBuilder::init_from_snapshot(const FrozenGraphSnapshot &snapshot) {
+  qg_.set_ep(snapshot.entry_point());
+  std::vector<uint32_t> in_degrees(num_nodes_, 0);
+  for (size_t node = 0; node < num_nodes_; ++node) {
+    auto &neighbors = new_neighbors_[node];
+    neighbors.clear();
+    for (const auto neighbor : snapshot.adjacency()[node]) {
+      ++in_degrees[neighbor];
+      neighbors.emplace_back(neighbor, 0.0);
+    }
+  }
+  rank_cache_ids(in_degrees);
+}
+
+inline void QGBuilder::check_snapshot(const FrozenGraphSnapshot &snapshot,
+                                      const char *caller) const {
+  snapshot.validate();
+  if (snapshot.num_points() != num_nodes_) {
+    throw std::invalid_argument(std::string(caller) +
+                                ": snapshot size does not match QuantizedGraph");
+  }
+  if (snapshot.max_degree() != degree_bound_) {
+    throw std::invalid_argument(std::string(caller) +
+                                ": snapshot max_degree does not match QuantizedGraph");
+  }
+  if (snapshot.frozen_pts() != 0) {
+    throw std::invalid_argument(std::string(caller) +
+                                ": frozen points are not supported by the LASER packer");
+  }
+}
+
+// Sorts node IDs by in-degree in descending order: high in-degree nodes are
+// cached first for better search performance.
+inline void QGBuilder::rank_cache_ids(const std::vector<uint32_t> &in_degrees) {
   qg_.cache_ids_.resize(num_nodes_);
   std::iota(qg_.cache_ids_.begin(), qg_.cache_ids_.end(), 0);
-  // Sort node IDs by in-degree in descending order (high in-degree nodes are cached first for
-  // better search performance)
   std::sort(qg_.cache_ids_.begin(), qg_.cache_ids_.end(), [&](PID a, PID b) {
     return in_degrees[a] > in_degrees[b];
   });
-
-  std::cout << "done. Index has " << nodes_read << " nodes and " << cc
-            << " out-edges, _start is set to " << start << std::endl;
-  assert(nodes_read == num_nodes_);
 }
 
 }  // namespace alaya::laser
@@ -0,0 +1,355 @@
+// SPDX-FileCopyrightText: 2026 AlayaDB.AI
+//
+// SPDX-License-Identifier: AGPL-3.0-only
+
+#pragma once
+
+#include <algorithm>
+#include <array>
+#include <cstddef>
+#include <cstdint>
+#include <cstring>
+#include <filesystem>
+#include <fstream>
+#include <limits>
+#include <numeric>
+#include <optional>
+#include <stdexcept>
+#include <string>
+#include <unordered_map>
+#include <utility>
+#include <vector>
+
+#include "index/graph/laser/common.hpp"
+#include "index/graph/laser/qg/qg.hpp"
+#include "index/graph/laser/utils/visit_sketch.hpp"
+#include "platform/fs.hpp"
+#include "storage/mmap_file.hpp"
+
+namespace alaya::laser {
+
+// PID permutation chosen by plan_qg_relayout; new_to_old[p] is the source
+// row stored at new PID p.
+struct QGRelayoutPlan {
+  std::vector<PID> new_to_old;
+  std::vector<PID> old_to_new;
+  // Leading new PIDs that carry sampled visits; the rest keep source order.
+  size_t hot_rows = 0;
+};
+
+// Packs rows so that rows often expanded by the same query share a page.
+// Pages are filled greedily: a page opens on the hottest unplaced row, then
+// takes the unplaced row with the most co-visits to the rows already on it,
+// falling back to the next hottest row when none is linked. Rows the sketch
+// never saw keep their relative order behind the hot ones.
+//
+// Searches may keep bumping the sketch while this runs, so the visit counts
+// are copied once up front and every ordering decision uses that copy; a
+// sort comparator over live counters would not be a strict weak ordering.
+[[nodiscard]] inline auto plan_qg_relayout(size_t num_rows,
+                                           size_t node_per_page,
+                                           const VisitSketch &sketch) -> QGRelayoutPlan {
+  if (sketch.num_rows() != num_rows) {
+    throw std::invalid_argument("plan_qg_relayout: sketch row count differs from the index");
+  }
+  QGRelayoutPlan plan;
+  plan.new_to_old.reserve(num_rows);
+
+  std::vector<uint32_t> visits(num_rows);
+  std::vector<PID> hot;
+  for (size_t id = 0; id < num_rows; ++id) {
+    visits[id] = sketch.visits(static_cast<PID>(id));
+    if (visits[id] != 0) {
+      hot.push_back(static_cast<PID>(id));
+    }
+  }
+  std::stable_sort(hot.begin(), hot.end(), [&](PID a, PID b) { return visits[a] > visits[b]; });
+
+  // Co-visit adjacency in CSR form.
+  const auto pairs = sketch.co_visits();
+  std::vector<size_t> offsets(num_rows + 1, 0);
+  for (const auto &pair : pairs) {
+    ++offsets[pair.first + 1];
+    ++offsets[pair.second + 1];
+  }
+  std::partial_sum(offsets.begin(), offsets.end(), offsets.begin());
+  std::vector<std::pair<PID, uint32_t>> edges(offsets.back());
+  std::vector<size_t> fill(offsets.begin(), offsets.end() - 1);
+  for (const auto &pair : pairs) {
+    edges[fill[pair.first]++] = {pair.second, pair.count};
+    edges[fill[pair.second]++] = {pair.first, pair.count};
+  }
+
+  std::vector<bool> placed(num_rows, false);
+  size_t cursor = 0;
+  auto next_hot = [&]() -> std::optional<PID> {
+    while (cursor < hot.size() && placed[hot[cursor]]) {
+      ++cursor;
+    }
+    return cursor < hot.size() ? std::optional<PID>(hot[cursor]) : std::nullopt;
+  };
+
+  const size_t per_page = std::max<size_t>(node_per_page, 1);
+  std::unordered_map<PID, uint64_t> gain;
+  for (auto seed = next_hot(); seed.has_value(); seed = next_hot()) {
+    gain.clear();
+    auto place = [&](PID id) {
+      placed[id] = true;
+      plan.new_to_old.push_back(id);
+      gain.erase(id);
+      for (size_t e = offsets[id]; e < offsets[id + 1]; ++e) {
+        if (!placed[edges[e].first]) {
+          gain[edges[e].first] += edges[e].second;
+        }
+      }
+    };
+    place(*seed);
+    for (size_t slot = 1; slot < per_page; ++slot) {
+      PID best = 0;
+      uint64_t best_gain = 0;
+      for (const auto &[id, weight] : gain) {
+        if (weight > best_gain ||
+            (weight == best_gain && best_gain != 0 &&
+             (visits[id] > visits[best] || (visits[id] == visits[best] && id < best)))) {
+          best = id;
+          best_gain = weight;
+        }
+      }
+      if (best_gain != 0) {
+        place(best);
+      } else if (auto fallback = next_hot(); fallback.has_value()) {
+        place(*fallback);
+      } else {
+        break;
+      }
+    }
+  }
+  plan.hot_rows = plan.new_to_old.size();
+  for (size_t id = 0; id < num_rows; ++id) {
+    if (!placed[id]) {
+      plan.new_to_old.push_back(static_cast<PID>(id));
+    }
+  }
+
+  plan.old_to_new.resize(num_rows);
+  for (size_t p = 0; p < num_rows; ++p) {
+    plan.old_to_new[plan.new_to_old[p]] = static_cast<PID>(p);
+  }
+  return plan;
+}
+
+namespace detail {
+
+inline void qg_relayout_write_or_throw(std::ofstream &out,
+                                       const void *data,
+                                       size_t bytes,
+                                       const std::filesystem::path &path) {
+  out.write(static_cast<const char *>(data), static_cast<std::streamsize>(bytes));
+  if (!out) {
+    throw std::runtime_error("relayout_qg_index: write failed for " + path.string());
+  }
+}
+
+inline void qg_relayout_close_and_sync(std::ofstream &out, const std::filesystem::path &path) {
+  out.close();
+  if (!out) {
+    throw std::runtime_error("relayout_qg_index: close failed for " + path.string());
+  }
+  ::alaya::platform::sync_file_or_throw(path);
+}
+
+}  // namespace detail
+
+// Rewrites the v1 index `<src_prefix>_R<degree>_MD<main_dim>.index` in the
+// order of `plan_qg_relayout` as the same name under `dst_prefix`. Rows move
+// with their page trailers, neighbor lists and the entry point are renamed
+// through old_to_new, and the metadata sector is otherwise kept. The static
+// cache sidecars are regenerated from the sketch: the same number of rows,
+// hottest first, topped up from the old selection (an all-rows cache stays
+// the identity, which the resident arena relies on). `_medoids_indices` is
+// renamed when present; `_rotator`, `_medoids` and `_pca.bin` do not depend
+// on the layout and are left to the caller. Mutable (v2/v3) files are
+// refused. All written files are fsynced.
+inline auto relayout_qg_index(const std::string &src_prefix,
+                              const std::string &dst_prefix,
+                              size_t degree_bound,
+                              size_t main_dim,
+                              const VisitSketch &sketch) -> QGRelayoutPlan {
+  const std::string suffix =
+      "_R" + std::to_string(degree_bound) + "_MD" + std::to_string(main_dim) + ".index";
+  const std::filesystem::path src_index = src_prefix + suffix;
+  const std::filesystem::path dst_index = dst_prefix + suffix;
+
+  storage::MMapFile source(src_index);
+  const auto *bytes = static_cast<const char *>(source.data());
+  if (source.size() < kSectorLen) {
+    throw std::runtime_error("relayout_qg_index: short metadata sector in " + src_index.string());
+  }
+  if (qg_header_has_v2_magic(bytes)) {
+    throw std::runtime_error("relayout_qg_index: " + src_index.string() +
+                             " is a mutable (v2) index; only sealed v1 files are relaid out");
+  }
+  std::array<uint64_t, kSectorLen / sizeof(uint64_t)> metas{};
+  std::memcpy(metas.data(), bytes, kSectorLen);
+  const auto num_rows = static_cast<size_t>(metas[0]);
+  const auto node_len = static_cast<size_t>(metas[3]);
+  const auto npp = static_cast<size_t>(metas[4]);
+  if (num_rows == 0 || npp == 0 || metas[8] != source.size() ||
+      node_len < degree_bound * sizeof(PID) ||
+      num_rows > static_cast<size_t>(std::numeric_limits<PID>::max())) {
+    throw std::runtime_error("relayout_qg_index: invalid v1 metadata in " + src_index.string());
+  }
+  const size_t page_count = (num_rows + npp - 1) / npp;
+  if ((source.size() - kSectorLen) % page_count != 0) {
+    throw std::runtime_error("relayout_qg_index: invalid v1 geometry in " + src_index.string());
+  }
+  const size_t page_size = (source.size() - kSectorLen) / page_count;
+  if (npp * node_len > page_size) {
+    throw std::runtime_error("relayout_qg_index: invalid v1 geometry in " + src_index.string());
+  }
+  source.advise(storage::MMapAccess::will_need);
+
+  QGRelayoutPlan plan = plan_qg_relayout(num_rows, npp, sketch);
+  const auto &old_to_new = plan.old_to_new;
+  auto source_row = [&](PID old_id) {
+    return bytes + kSectorLen + page_size * (old_id / npp) + (old_id % npp) * node_len;
+  };
+  // The trailer region only exists when the page leaves room for it.
+  const bool has_trailers = page_size - npp * node_len >= npp * kQGRowTrailerSize;
+  const size_t neighbor_offset = node_len - degree_bound * sizeof(PID);
+
+  metas[2] = old_to_new.at(static_cast<size_t>(metas[2]));
+  std::array<char, kSectorLen> header{};
+  std::memcpy(header.data(), bytes, kSectorLen);
+  std::memcpy(header.data(), metas.data(), sizeof(uint64_t) * 3);
+
+  {
+    std::ofstream out(dst_index, std::ios::binary | std::ios::trunc);
+    if (!out) {
+      throw std::runtime_error("relayout_qg_index: cannot create " + dst_index.string());
+    }
+    detail::qg_relayout_write_or_throw(out, header.data(), header.size(), dst_index);
+    std::vector<char> page(page_size);
+    for (size_t first = 0; first < num_rows; first += npp) {
+      std::fill(page.begin(), page.end(), 0);
+      for (size_t slot = 0; slot < npp && first + slot < num_rows; ++slot) {
+        const PID old_id = plan.new_to_old[first + slot];
+        char *row = page.data() + slot * node_len;
+        std::memcpy(row, source_row(old_id), node_len);
+        auto *neighbors = reinterpret_cast<PID *>(row + neighbor_offset);
+        for (size_t e = 0; e < degree_bound; ++e) {
+          // Unused slots hold 0, and row 0's new id is as valid a filler.
+          if (neighbors[e] < num_rows) {
+            neighbors[e] = old_to_new[neighbors[e]];
+          }
+        }
+        if (has_trailers) {
+          const size_t trailer_base = page_size - npp * kQGRowTrailerSize;
+          std::memcpy(page.data() + trailer_base + slot * kQGRowTrailerSize,
+                      bytes + kSectorLen + page_size * (old_id / npp) + trailer_base +
+                          (old_id % npp) * kQGRowTrailerSize,
+                      kQGRowTrailerSize);
+        }
+      }
+      detail::qg_relayout_write_or_throw(out, page.data(), page.size(), dst_index);
+    }
+    detail::qg_relayout_close_and_sync(out, dst_index);
+  }
+
+  // Cache sidecars: keep the old row count, fill hottest first.
+  const std::filesystem::path src_cache_ids = src_index.string() + "_cache_ids";
+  const std::string cache_ids_prefix = ::alaya::platform::read_file_prefix(src_cache_ids,
+                                                                           sizeof(size_t));
+  size_t cache_num = 0;
+  std::memcpy(&cache_num, cache_ids_prefix.data(), sizeof(cache_num));
+  cache_num = std::min(cache_num, num_rows);
+  std::vector<PID> old_cache(cache_num);
+  {
+    std::ifstream in(src_cache_ids, std::ios::binary);
+    in.seekg(static_cast<std::streamoff>(sizeof(size_t)));
+    in.read(reinterpret_cast<char *>(old_cache.data()),
+            static_cast<std::streamsize>(sizeof(PID) * cache_num));
+    if (!in) {
+      throw std::runtime_error("relayout_qg_index: short cache ids file " +
+                               src_cache_ids.string());
+    }
+  }
+  std::vector<PID> cache_ids;
+  cache_ids.reserve(cache_num);
+  if (cache_num == num_rows) {
+    cache_ids.resize(num_rows);
+    std::iota(cache_ids.begin(), cache_ids.end(), PID{0});
+  } else {
+    std::vector<bool> chosen(num_rows, false);
+    for (size_t p = 0; p < plan.hot_rows && cache_ids.size() < cache_num; ++p) {
+      cache_ids.push_back(static_cast<PID>(p));
+      chosen[p] = true;
+    }
+    for (size_t i = 0; i < old_cache.size() && cache_ids.size() < cache_num; ++i) {
+      if (old_cache[i] < num_rows && !chosen[old_to_new[old_cache[i]]]) {
+        cache_ids.push_back(old_to_new[old_cache[i]]);
+        chosen[cache_ids.back()] = true;
+      }
+    }
+  }
+  {
+    const std::filesystem::path path = dst_index.string() + "_cache_ids";
+    std::ofstream out(path, std::ios::binary | std::ios::trunc);
+    const size_t count = cache_ids.size();
+    detail::qg_relayout_write_or_throw(out, &count, sizeof(count), path);
+    detail::qg_relayout_write_or_throw(out, cache_ids.data(), sizeof(PID) * count, path);
+    detail::qg_relayout_close_and_sync(out, path);
+  }
+  {
+    const std::filesystem::path path = dst_index.string() + "_cache_nodes";
+    std::ofstream out(path, std::ios::binary | std::ios::trunc);
+    const size_t count = cache_ids.size();
+    detail::qg_relayout_write_or_throw(out, &count, sizeof(count), path);
+    detail::qg_relayout_write_or_throw(out, &node_len, sizeof(node_len), path);
+    std::vector<char> row(node_len);
+    for (const PID id : cache_ids) {
+      std::memcpy(row.data(), source_row(plan.new_to_old[id]), node_len);
+      auto *neighbors = reinterpret_cast<PID *>(row.data() + neighbor_offset);
+      for (size_t e = 0; e < degree_bound; ++e) {
+        if (neighbors[e] < num_rows) {
+          neighbors[e] = old_to_new[neighbors[e]];
+        }
+      }
+      detail::qg_relayout_write_or_throw(out, row.data(), node_len, path);
+    }
+    detail::qg_relayout_close_and_sync(out, path);
+  }
+
+  const std::filesystem::path src_medoids = src_prefix + "_medoids_indices";
+  if (std::filesystem::exists(src_medoids)) {
+    std::ifstream in(src_medoids, std::ios::binary);
+    std::array<int, 2> shape{};
+    in.read(reinterpret_cast<char *>(shape.data()), sizeof(shape));
+    if (!in || shape[0] < 0 || shape[1] < 0) {
+      throw std::runtime_error("relayout_qg_index: invalid medoid indices in " +
+                               src_medoids.string());
+    }
+    std::vector<int> medoids(static_cast<size_t>(shape[0]) * static_cast<size_t>(shape[1]));
+    in.read(reinterpret_cast<char *>(medoids.data()),
+            static_cast<std::streamsize>(sizeof(int) * medoids.size()));
+    if (!in) {
+      throw std::runtime_error("relayout_qg_index: short medoid indices in " +
+                               src_medoids.string());
+    }
+    for (int &medoid : medoids) {
+      if (medoid < 0 || static_cast<size_t>(medoid) >= num_rows) {
+        throw std::runtime_error("relayout_qg_index: medoid out of range in " +
+                                 src_medoids.string());
+      }
+      medoid = static_cast<int>(old_to_new[static_cast<size_t>(medoid)]);
+    }
+    const std::filesystem::path path = dst_prefix + "_medoids_indices";
+    std::ofstream out(path, std::ios::binary | std::ios::trunc);
+    detail::qg_relayout_write_or_throw(out, shape.data(), sizeof(shape), path);
+    detail::qg_relayout_write_or_throw(out, medoids.data(), sizeof(int) * medoids.size(), path);
+    detail::qg_relayout_close_and_sync(out, path);
+  }
+  return plan;
+}
+
+}  // namespace alaya::laser
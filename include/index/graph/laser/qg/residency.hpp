@@ -21,6 +21,7 @@ namespace alaya::laser {
 enum class ResidencyMode : uint8_t {
   kPagedPool,      // beam search over the buffer-pool/AIO path (disk_search_qg)
   kResidentArena,  // direct pid*node_len addressing over a resident arena
+  kMappedArena,    // the arena kernel over a read-only mapping of the index file
 };
 
 // NUMA placement hook for resident allocations. v1 implements first-touch only:
@@ -65,8 +66,9 @@ class ResidencyProvider {
                       const RowAdmission *admission = nullptr,
                       float *distances = nullptr) = 0;
 
-  // Batch is a sequential lowering to the same per-query kernel. Scheduling
-  // and concurrency belong to the caller's external lanes.
+  // Batch returns exactly the per-query kernel's results and creates no
+  // threads; cross-thread concurrency belongs to the caller's external lanes.
+  // The paged provider interleaves queries' I/O on the calling thread.
   virtual void batch_search(QuantizedGraph &qg,
                             const float *queries,
                             uint32_t knn,
@@ -169,6 +171,55 @@ class ResidentArenaProvider final : public ResidencyProvider {
   NumaPolicy numa_;
 };
 
+// Zero-copy variant of the resident arena: prepare() maps the index file
+// instead of copying it, so a reopened process serves immediately (cold rows
+// fault in on first touch) and processes that open the same segment share one
+// page-cache copy. A background prefault makes the file resident hot-first;
+// readiness() reports its progress.
+class MappedArenaProvider final : public ResidencyProvider {
+ public:
+  [[nodiscard]] auto mode() const noexcept -> ResidencyMode override {
+    return ResidencyMode::kMappedArena;
+  }
+
+  void prepare(QuantizedGraph &qg) override { qg.map_resident_arena(); }
+
+  [[nodiscard]] static auto readiness(const QuantizedGraph &qg) noexcept
+      -> QuantizedGraph::MappedArenaReadiness {
+    return qg.mapped_arena_readiness();
+  }
+
+  void search(QuantizedGraph &qg,
+              const float *query,
+              uint32_t knn,
+              uint32_t *results,
+              size_t ef_search,
+              size_t beam_width,
+              const RowAdmission *admission,
+              float *distances) override {
+    qg.arena_search_qg(query, knn, results, ef_search, beam_width, admission, distances);
+  }
+
+  void batch_search(QuantizedGraph &qg,
+                    const float *queries,
+                    uint32_t knn,
+                    uint32_t *results,
+                    size_t num_queries,
+                    size_t ef_search,
+                    size_t beam_width,
+                    const RowAdmission *admission,
+                    float *distances) override {
+    qg.arena_batch_search(queries,
+                          knn,
+                          results,
+                          num_queries,
+                          ef_search,
+                          beam_width,
+                          admission,
+                          distances);
+  }
+};
+
 inline auto make_residency_provider(ResidencyMode mode, NumaPolicy numa = {})
     -> std::unique_ptr<ResidencyProvider> {
   switch (mode) {
@@ -176,12 +227,15 @@ inline auto make_residency_provider(ResidencyMode mode, NumaPolicy numa = {})
       return std::make_unique<PagedPoolProvider>();
     case ResidencyMode::kResidentArena:
       return std::make_unique<ResidentArenaProvider>(numa);
+    case ResidencyMode::kMappedArena:
+      return std::make_unique<MappedArenaProvider>();
   }
   throw std::invalid_argument("make_residency_provider: unknown ResidencyMode");
 }
 
 inline constexpr std::string_view kResidencyPagedPoolName = "paged_pool";
 inline constexpr std::string_view kResidencyResidentArenaName = "resident_arena";
+inline constexpr std::string_view kResidencyMappedArenaName = "mapped_arena";
 
 inline auto residency_mode_to_string(ResidencyMode mode) -> std::string_view {
   switch (mode) {
@@ -189,6 +243,8 @@ inline auto residency_mode_to_string(ResidencyMode mode) -> std::string_view {
       return kResidencyPagedPoolName;
     case ResidencyMode::kResidentArena:
       return kResidencyResidentArenaName;
+    case ResidencyMode::kMappedArena:
+      return kResidencyMappedArenaName;
   }
   return {};
 }
@@ -200,8 +256,11 @@ inline auto residency_mode_from_string(std::string_view s) -> ResidencyMode {
   if (s == kResidencyResidentArenaName) {
     return ResidencyMode::kResidentArena;
   }
+  if (s == kResidencyMappedArenaName) {
+    return ResidencyMode::kMappedArena;
+  }
   throw std::invalid_argument("unknown residency mode string: '" + std::string(s) +
-                              "' (expected 'paged_pool' or 'resident_arena')");
+                              "' (expected 'paged_pool', 'resident_arena' or 'mapped_arena')");
 }
 
 }  // namespace alaya::laser
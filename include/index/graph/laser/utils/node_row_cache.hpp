@@ -0,0 +1,261 @@
+// SPDX-FileCopyrightText: 2026 AlayaDB.AI
+//
+// SPDX-License-Identifier: AGPL-3.0-only
+
+#pragma once
+
+#include <atomic>
+#include <cstddef>
+#include <cstdint>
+#include <cstring>
+#include <memory>
+#include <vector>
+
+#include "index/graph/laser/common.hpp"
+#include "utils/memory.hpp"
+
+namespace alaya::laser {
+
+struct NodeRowCacheStats {
+  uint64_t hits = 0;
+  uint64_t misses = 0;
+  uint64_t admitted = 0;
+  // Misses turned away by the doorkeeper because the row was not seen before.
+  uint64_t rejected = 0;
+  uint64_t evicted = 0;
+
+  [[nodiscard]] auto hit_rate() const noexcept -> double {
+    const uint64_t lookups = hits + misses;
+    return lookups == 0 ? 0.0 : static_cast<double>(hits) / static_cast<double>(lookups);
+  }
+};
+
+// Online row cache for the paged search path, filled from completed page
+// reads. The static cache sidecar is chosen once at build time by in-degree;
+// this one follows the live query distribution within a fixed DRAM budget.
+//
+// Layout: fixed row slots grouped into sets of kWays. A row may only live in
+// the set its PID hashes to, so lookup probes at most kWays keys and never
+// takes a lock. Eviction runs CLOCK within the set (a hit sets the slot's
+// referenced bit; the hand clears it and passes over once). Admission is a
+// TinyLFU-style doorkeeper: a row is cached on its second miss within the
+// current window, so one-off scans do not flush the working set.
+//
+// Every slot carries a pin count with a writer bit. Readers copy a row out
+// while pinned; a writer claims only an unpinned slot, so a row is never
+// read while it is being replaced.
+//
+// Each set also carries an epoch that invalidate() bumps. A caller takes
+// epoch(id) before it issues the page read and hands it back to admit(), so
+// a read that raced a write to its page is never cached: the bytes it
+// carries may predate the write.
+class NodeRowCache {
+ public:
+  static constexpr size_t kWays = 8;
+
+  // `budget_bytes` / `row_len` slots, rounded down to whole sets. A budget
+  // below one set leaves the cache empty (every lookup misses).
+  NodeRowCache(size_t budget_bytes, size_t row_len)
+      : row_len_(row_len),
+        num_sets_(row_len == 0 ? 0 : budget_bytes / row_len / kWays),
+        slots_(std::make_unique<Slot[]>(num_sets_ * kWays)),
+        hands_(std::make_unique<std::atomic<uint8_t>[]>(num_sets_)),
+        epochs_(std::make_unique<std::atomic<uint64_t>[]>(num_sets_)),
+        rows_(num_sets_ * kWays * row_len_) {
+    // About four doorkeeper bits per slot keeps false admissions rare.
+    size_t bits = 64;
+    while (bits < num_sets_ * kWays * 4) {
+      bits <<= 1U;
+    }
+    doorkeeper_ = std::vector<std::atomic<uint64_t>>(bits / 64);
+    doorkeeper_mask_ = bits - 1;
+  }
+
+  NodeRowCache(const NodeRowCache &) = delete;
+  auto operator=(const NodeRowCache &) -> NodeRowCache & = delete;
+
+  [[nodiscard]] auto capacity_rows() const noexcept -> size_t { return num_sets_ * kWays; }
+  [[nodiscard]] auto row_len() const noexcept -> size_t { return row_len_; }
+
+  // Copies the cached row of `id` into `out` (row_len() bytes) and returns
+  // true, or returns false on a miss.
+  auto lookup(PID id, char *out) noexcept -> bool {
+    if (num_sets_ != 0) {
+      const size_t first = set_of(id) * kWays;
+      for (size_t way = 0; way < kWays; ++way) {
+        Slot &slot = slots_[first + way];
+        if (slot.key.load(std::memory_order_relaxed) != id || !pin(slot)) {
+          continue;
+        }
+        // The slot may have been refilled between the key check and the pin.
+        if (slot.key.load(std::memory_order_relaxed) == id) {
+          std::memcpy(out, row(first + way), row_len_);
+          slot.state.fetch_sub(1, std::memory_order_release);
+          slot.referenced.store(1, std::memory_order_relaxed);
+          hits_.fetch_add(1, std::memory_order_relaxed);
+          return true;
+        }
+        slot.state.fetch_sub(1, std::memory_order_release);
+      }
+    }
+    misses_.fetch_add(1, std::memory_order_relaxed);
+    return false;
+  }
+
+  // Invalidation epoch of `id`'s set; take it before reading the row.
+  [[nodiscard]] auto epoch(PID id) const noexcept -> uint64_t {
+    return num_sets_ == 0 ? 0 : epochs_[set_of(id)].load(std::memory_order_seq_cst);
+  }
+
+  // Offers a freshly read row after a miss, with the epoch(id) taken before
+  // the read was issued. The first offer of a row only marks the doorkeeper;
+  // a repeat offer claims a slot in its set. Gives up rather than waits when
+  // every candidate slot is pinned, and drops the row if its set was
+  // invalidated since `epoch`.
+  void admit(PID id, const char *data, uint64_t epoch) noexcept {
+    if (num_sets_ == 0 || epochs_[set_of(id)].load(std::memory_order_seq_cst) != epoch) {
+      return;
+    }
+    if (!doorkeeper_test_and_set(id)) {
+      rejected_.fetch_add(1, std::memory_order_relaxed);
+      return;
+    }
+    const size_t first = set_of(id) * kWays;
+    for (size_t way = 0; way < kWays; ++way) {
+      if (slots_[first + way].key.load(std::memory_order_relaxed) == id) {
+        return;  // another query admitted it first
+      }
+    }
+    auto &hand = hands_[set_of(id)];
+    for (size_t step = 0; step < 2 * kWays; ++step) {
+      const size_t way = hand.fetch_add(1, std::memory_order_relaxed) % kWays;
+      Slot &slot = slots_[first + way];
+      if (slot.referenced.exchange(0, std::memory_order_relaxed) != 0) {
+        continue;  // second chance
+      }
+      uint32_t idle = 0;
+      if (!slot.state.compare_exchange_strong(idle, kWriter, std::memory_order_acquire)) {
+        continue;
+      }
+      if (slot.key.load(std::memory_order_relaxed) != kEmpty) {
+        evicted_.fetch_add(1, std::memory_order_relaxed);
+      }
+      std::memcpy(row(first + way), data, row_len_);
+      // Publish the key before re-reading the epoch: an invalidate() that
+      // bumped it after this check then finds the key and drops the row.
+      slot.key.store(id, std::memory_order_seq_cst);
+      if (epochs_[set_of(id)].load(std::memory_order_seq_cst) != epoch) {
+        slot.key.store(kEmpty, std::memory_order_relaxed);
+        slot.state.store(0, std::memory_order_release);
+        return;
+      }
+      slot.state.store(0, std::memory_order_release);
+      admitted_.fetch_add(1, std::memory_order_relaxed);
+      return;
+    }
+  }
+
+  // Drops `id` if cached and turns away reads of it already in flight;
+  // waits out readers that hold it pinned. Used when the row's bytes on disk
+  // change.
+  void invalidate(PID id) noexcept {
+    if (num_sets_ == 0) {
+      return;
+    }
+    epochs_[set_of(id)].fetch_add(1, std::memory_order_seq_cst);
+    const size_t first = set_of(id) * kWays;
+    for (size_t way = 0; way < kWays; ++way) {
+      Slot &slot = slots_[first + way];
+      if (slot.key.load(std::memory_order_seq_cst) != id) {
+        continue;
+      }
+      uint32_t idle = 0;
+      while (!slot.state.compare_exchange_weak(idle, kWriter, std::memory_order_acquire)) {
+        idle = 0;
+      }
+      if (slot.key.load(std::memory_order_relaxed) == id) {
+        slot.key.store(kEmpty, std::memory_order_relaxed);
+        slot.referenced.store(0, std::memory_order_relaxed);
+      }
+      slot.state.store(0, std::memory_order_release);
+    }
+  }
+
+  [[nodiscard]] auto stats() const noexcept -> NodeRowCacheStats {
+    return {hits_.load(std::memory_order_relaxed),
+            misses_.load(std::memory_order_relaxed),
+            admitted_.load(std::memory_order_relaxed),
+            rejected_.load(std::memory_order_relaxed),
+            evicted_.load(std::memory_order_relaxed)};
+  }
+
+ private:
+  static constexpr PID kEmpty = ~PID{0};
+  // state: reader pin count, or kWriter while a writer owns the slot.
+  static constexpr uint32_t kWriter = 1U << 31U;
+
+  struct Slot {
+    std::atomic<PID> key{kEmpty};
+    std::atomic<uint32_t> state{0};
+    std::atomic<uint8_t> referenced{0};
+  };
+
+  static auto mix(uint64_t x) noexcept -> uint64_t {
+    x ^= x >> 33U;
+    x *= 0xff51afd7ed558ccdULL;
+    x ^= x >> 33U;
+    x *= 0xc4ceb9fe1a85ec53ULL;
+    x ^= x >> 33U;
+    return x;
+  }
+
+  [[nodiscard]] auto set_of(PID id) const noexcept -> size_t {
+    return static_cast<size_t>(mix(id) % num_sets_);
+  }
+
+  [[nodiscard]] auto row(size_t slot) noexcept -> char * { return rows_.data() + slot * row_len_; }
+
+  static auto pin(Slot &slot) noexcept -> bool {
+    uint32_t state = slot.state.load(std::memory_order_relaxed);
+    do {
+      if ((state & kWriter) != 0) {
+        return false;
+      }
+    } while (!slot.state.compare_exchange_weak(state, state + 1, std::memory_order_acquire));
+    return true;
+  }
+
+  // Returns whether `id` was already marked in this window. The window ends,
+  // and the doorkeeper is cleared, after as many marks as it has bits / 4.
+  auto doorkeeper_test_and_set(PID id) noexcept -> bool {
+    const uint64_t bit = (mix(id) >> 7U) & doorkeeper_mask_;
+    const uint64_t mask = uint64_t{1} << (bit % 64);
+    const bool seen =
+        (doorkeeper_[bit / 64].fetch_or(mask, std::memory_order_relaxed) & mask) != 0;
+    if (!seen &&
+        marks_.fetch_add(1, std::memory_order_relaxed) + 1 >= (doorkeeper_mask_ + 1) / 4) {
+      marks_.store(0, std::memory_order_relaxed);
+      for (auto &word : doorkeeper_) {
+        word.store(0, std::memory_order_relaxed);
+      }
+    }
+    return seen;
+  }
+
+  size_t row_len_;
+  size_t num_sets_;
+  std::unique_ptr<Slot[]> slots_;
+  std::unique_ptr<std::atomic<uint8_t>[]> hands_;
+  std::unique_ptr<std::atomic<uint64_t>[]> epochs_;
+  std::vector<char, ::alaya::AlignedAlloc<char>> rows_;
+  std::vector<std::atomic<uint64_t>> doorkeeper_;
+  uint64_t doorkeeper_mask_ = 0;
+  std::atomic<uint64_t> marks_{0};
+  std::atomic<uint64_t> hits_{0};
+  std::atomic<uint64_t> misses_{0};
+  std::atomic<uint64_t> admitted_{0};
+  std::atomic<uint64_t> rejected_{0};
+  std::atomic<uint64_t> evicted_{0};
+};
+
+}  // namespace alaya::laser
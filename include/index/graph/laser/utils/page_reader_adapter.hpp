@@ -3,14 +3,17 @@
 
 #pragma once
 
+#include <atomic>
 #include <cstddef>
 #include <cstdint>
 #include <cstdlib>
 #include <cstring>
 #include <deque>
+#include <memory>
 #include <mutex>
 #include <span>
 #include <stdexcept>
+#include <unordered_map>
 #include <vector>
 
 #include "storage/io/page_reader_factory.hpp"
@@ -30,14 +33,16 @@ struct PageReadCompletions {
   // The backend must follow the build's compiled PageReader, not the host OS: a
   // Linux tree configured with ALAYA_LASER_USE_THREADPOOL compiles no libaio
   // implementation, so requesting it would throw on every QG open.
-#if defined(__linux__) && defined(ALAYA_LASER_USE_LIBAIO) && ALAYA_LASER_USE_LIBAIO
+#if defined(__linux__) && defined(ALAYA_LASER_USE_IO_URING) && ALAYA_LASER_USE_IO_URING
+  return storage::io::open_page_reader(path, options, storage::io::PageReaderBackend::io_uring);
+#elif defined(__linux__) && defined(ALAYA_LASER_USE_LIBAIO) && ALAYA_LASER_USE_LIBAIO
   return storage::io::open_page_reader(path, options, storage::io::PageReaderBackend::libaio);
 #else
   return storage::io::open_page_reader(path, options, storage::io::PageReaderBackend::threadpool);
 #endif
 }
 
-[[nodiscard]] inline auto allocate_page_read_buffer(const storage::io::PageReader &reader,
+[[nodiscard]] inline auto allocate_page_read_buffer(storage::io::PageReader &reader,
                                                     std::size_t bytes) -> void * {
   const auto constraints = reader.constraints();
   if (constraints.buffer_alignment == 0 || constraints.size_alignment == 0 ||
@@ -48,6 +53,8 @@ struct PageReadCompletions {
   void *buffer = nullptr;
   if (::posix_memalign(&buffer, alignment, bytes) != 0) throw std::bad_alloc();
   std::memset(buffer, 0, bytes);
+  // Best effort: a reader that cannot pre-map the buffer still reads into it.
+  (void)reader.register_buffer({static_cast<std::byte *>(buffer), bytes});
   return buffer;
 }
 
@@ -68,6 +75,190 @@ inline void collect_page_read(void *context, storage::io::ReadResult result) noe
   return requests.size();
 }
 
+struct SharedPageReadStats {
+  // Reads that went to the device.
+  uint64_t device_reads = 0;
+  // Requests served by attaching to a read another request already had in
+  // flight for the same page.
+  uint64_t coalesced_reads = 0;
+};
+
+// Counts the reads SharedPageReads issues or joins on this thread while the
+// tally is in scope. A search submits its page reads from its calling thread,
+// so a tally opened around one search call counts that search alone. Tallies
+// nest; only the innermost one counts.
+class PageReadTally {
+ public:
+  PageReadTally() noexcept : previous_(current_) { current_ = &stats_; }
+  PageReadTally(const PageReadTally &) = delete;
+  auto operator=(const PageReadTally &) -> PageReadTally & = delete;
+  ~PageReadTally() { current_ = previous_; }
+
+  [[nodiscard]] auto stats() const noexcept -> const SharedPageReadStats & { return stats_; }
+
+  static void record(std::uint64_t device_reads, std::uint64_t coalesced_reads) noexcept {
+    if (current_ != nullptr) {
+      current_->device_reads += device_reads;
+      current_->coalesced_reads += coalesced_reads;
+    }
+  }
+
+ private:
+  inline static thread_local SharedPageReadStats *current_ = nullptr;
+  SharedPageReadStats *previous_;
+  SharedPageReadStats stats_{};
+};
+
+// In-flight page reads shared by every search of one graph, keyed by file
+// offset. A request for a page that is already being fetched attaches to
+// that read instead of submitting a duplicate. When the read completes, its
+// bytes are copied into every attached buffer, and each party receives its
+// own ReadResult (carrying its own id) through its own PageReadCompletions,
+// so callers cannot tell a shared read from a private one.
+//
+// A read stops accepting new parties once page_written() reports a write to
+// its page: it may have fetched the bytes from before that write, so a later
+// request for the page goes to the device on its own.
+//
+// An attached buffer must stay valid until its result is delivered, just like
+// the buffer of a private read. The table must outlive the reader's last
+// callback.
+class SharedPageReads {
+ public:
+  // Submits `requests` and returns how many results `completions` will
+  // receive (all of them). Request ids need not be unique across callers.
+  auto submit(storage::io::PageReader &reader,
+              std::span<const storage::io::ReadRequest> requests,
+              const std::shared_ptr<PageReadCompletions> &completions) -> std::size_t {
+    std::vector<storage::io::ReadRequest> leads;
+    std::vector<storage::io::ReadRequest> direct;
+    std::uint64_t coalesced = 0;
+    leads.reserve(requests.size());
+    {
+      std::lock_guard lock(mutex_);
+      for (const auto &request : requests) {
+        const auto found = in_flight_.find(request.offset);
+        if (found == in_flight_.end()) {
+          Party leader{completions, request.id, request.buffer};
+          in_flight_.emplace(request.offset, InFlight{std::move(leader), {}, true});
+          // The device read is tagged with its offset, the table key.
+          auto lead = request;
+          lead.id = request.offset;
+          leads.push_back(lead);
+        } else if (found->second.joinable &&
+                   found->second.leader.buffer.size() == request.buffer.size()) {
+          found->second.waiters.push_back({completions, request.id, request.buffer});
+          ++coalesced;
+        } else {
+          direct.push_back(request);
+        }
+      }
+    }
+    coalesced_reads_.fetch_add(coalesced, std::memory_order_relaxed);
+    PageReadTally::record(0, coalesced);
+    try {
+      if (!leads.empty()) {
+        [[maybe_unused]] auto handle = reader.submit(
+            leads, storage::io::Completion{.fn = complete_shared_read, .context = this});
+      }
+    } catch (...) {
+      fail_unsubmitted(leads);
+      throw;
+    }
+    device_reads_.fetch_add(leads.size(), std::memory_order_relaxed);
+    PageReadTally::record(leads.size(), 0);
+    if (!direct.empty()) {
+      [[maybe_unused]] auto handle = reader.submit(
+          direct, storage::io::Completion{.fn = collect_page_read, .context = completions.get()});
+      device_reads_.fetch_add(direct.size(), std::memory_order_relaxed);
+      PageReadTally::record(direct.size(), 0);
+    }
+    return requests.size();
+  }
+
+  // Reports that the page read at `offset` was rewritten. A read of it
+  // already in flight keeps its parties but takes no new ones.
+  void page_written(std::uint64_t offset) {
+    std::lock_guard lock(mutex_);
+    const auto found = in_flight_.find(offset);
+    if (found != in_flight_.end()) {
+      found->second.joinable = false;
+    }
+  }
+
+  [[nodiscard]] auto stats() const noexcept -> SharedPageReadStats {
+    return {device_reads_.load(std::memory_order_relaxed),
+            coalesced_reads_.load(std::memory_order_relaxed)};
+  }
+
+ private:
+  struct Party {
+    std::shared_ptr<PageReadCompletions> completions;
+    std::uint64_t id = 0;
+    std::span<std::byte> buffer;
+  };
+  struct InFlight {
+    Party leader;
+    std::vector<Party> waiters;
+    bool joinable = true;
+  };
+
+  static void deliver(const Party &party, storage::io::ReadResult result) noexcept {
+    result.id = party.id;
+    collect_page_read(party.completions.get(), result);
+  }
+
+  static void complete_shared_read(void *context, storage::io::ReadResult result) noexcept {
+    auto &self = *static_cast<SharedPageReads *>(context);
+    InFlight read;
+    {
+      std::lock_guard lock(self.mutex_);
+      const auto found = self.in_flight_.find(result.id);
+      if (found == self.in_flight_.end()) {
+        return;
+      }
+      read = std::move(found->second);
+      self.in_flight_.erase(found);
+    }
+    // Waiters first: once the leader hears back it may reuse its buffer.
+    const auto bytes = std::min(result.bytes, read.leader.buffer.size());
+    for (const auto &waiter : read.waiters) {
+      std::memcpy(waiter.buffer.data(), read.leader.buffer.data(), bytes);
+      deliver(waiter, result);
+    }
+    deliver(read.leader, result);
+  }
+
+  // The reader refused the batch: its callers see the exception, and requests
+  // that attached to those reads in the meantime get an error result.
+  void fail_unsubmitted(std::span<const storage::io::ReadRequest> leads) noexcept {
+    std::vector<Party> orphans;
+    {
+      std::lock_guard lock(mutex_);
+      for (const auto &lead : leads) {
+        const auto found = in_flight_.find(lead.offset);
+        if (found == in_flight_.end()) {
+          continue;
+        }
+        for (auto &waiter : found->second.waiters) {
+          orphans.push_back(std::move(waiter));
+        }
+        in_flight_.erase(found);
+      }
+    }
+    for (const auto &orphan : orphans) {
+      deliver(orphan,
+              {.status = storage::io::ReadStatus::io_error,
+               .error = std::make_error_code(std::errc::io_error)});
+    }
+  }
+
+  std::mutex mutex_;
+  std::unordered_map<std::uint64_t, InFlight> in_flight_;
+  std::atomic<std::uint64_t> device_reads_{0};
+  std::atomic<std::uint64_t> coalesced_reads_{0};
+};
+
 inline void validate_page_read(const storage::io::ReadResult &result) {
   if (result.status != storage::io::ReadStatus::ok) {
     throw std::system_error(result.error,
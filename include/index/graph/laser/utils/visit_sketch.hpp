@@ -0,0 +1,203 @@
+// SPDX-FileCopyrightText: 2026 AlayaDB.AI
+//
+// SPDX-License-Identifier: AGPL-3.0-only
+
+#pragma once
+
+#include <algorithm>
+#include <atomic>
+#include <cstddef>
+#include <cstdint>
+#include <filesystem>
+#include <map>
+#include <memory>
+#include <mutex>
+#include <span>
+#include <string>
+#include <vector>
+
+#include "index/graph/laser/common.hpp"
+
+namespace alaya::laser {
+
+struct CoVisit {
+  PID first = 0;
+  PID second = 0;
+  uint32_t count = 0;
+};
+
+// Sampled record of the rows LASER search expands, read back by the page
+// relayout in qg_relayout.hpp. One query in `sample_every` is traced. Its
+// trace is the order in which search expanded rows: each traced row bumps a
+// per-row visit counter, and every two rows expanded within kWindow steps of
+// each other bump a co-visit counter for the pair.
+//
+// Memory is fixed at construction: four bytes per row plus `pair_capacity`
+// pair slots. The pair table is lossy. A pair that finds neither its own slot
+// nor a free one in its probe window decays the weakest slot there by one and
+// takes it over once that count is down to one, so heavy pairs stay while
+// one-off pairs churn. Counters are relaxed atomics; two racing recorders may
+// misattribute a count but never corrupt the table.
+class VisitSketch {
+ public:
+  static constexpr size_t kWindow = 4;
+  static constexpr size_t kProbe = 8;
+
+  // `pair_capacity` 0 picks four slots per row.
+  VisitSketch(size_t num_rows, uint32_t sample_every, size_t pair_capacity = 0)
+      : sample_every_(std::max<uint32_t>(sample_every, 1)),
+        visits_(num_rows),
+        pairs_(round_capacity(pair_capacity == 0 ? num_rows * 4 : pair_capacity)) {
+    pair_mask_ = pairs_.size() - 1;
+  }
+
+  VisitSketch(const VisitSketch &) = delete;
+  auto operator=(const VisitSketch &) -> VisitSketch & = delete;
+
+  [[nodiscard]] auto num_rows() const noexcept -> size_t { return visits_.size(); }
+  [[nodiscard]] auto sample_every() const noexcept -> uint32_t { return sample_every_; }
+  [[nodiscard]] auto pair_capacity() const noexcept -> size_t { return pairs_.size(); }
+  [[nodiscard]] auto sampled_queries() const noexcept -> uint64_t {
+    return sampled_.load(std::memory_order_relaxed);
+  }
+
+  // Called once per query; true when that query should be traced.
+  [[nodiscard]] auto sample() noexcept -> bool {
+    return ticket_.fetch_add(1, std::memory_order_relaxed) % sample_every_ == 0;
+  }
+
+  void record(std::span<const PID> trace) noexcept {
+    sampled_.fetch_add(1, std::memory_order_relaxed);
+    for (size_t i = 0; i < trace.size(); ++i) {
+      if (trace[i] >= visits_.size()) {
+        continue;
+      }
+      visits_[trace[i]].fetch_add(1, std::memory_order_relaxed);
+      const size_t end = std::min(trace.size(), i + 1 + kWindow);
+      for (size_t j = i + 1; j < end; ++j) {
+        if (trace[j] != trace[i] && trace[j] < visits_.size()) {
+          add_pair(trace[i], trace[j]);
+        }
+      }
+    }
+  }
+
+  [[nodiscard]] auto visits(PID id) const noexcept -> uint32_t {
+    return id < visits_.size() ? visits_[id].load(std::memory_order_relaxed) : 0;
+  }
+
+  // Snapshot of every pair currently held, in no particular order.
+  [[nodiscard]] auto co_visits() const -> std::vector<CoVisit> {
+    std::vector<CoVisit> out;
+    for (const auto &slot : pairs_) {
+      const uint64_t key = slot.key.load(std::memory_order_relaxed);
+      const uint32_t count = slot.count.load(std::memory_order_relaxed);
+      if (key != kEmpty && count != 0) {
+        out.push_back({static_cast<PID>(key >> 32U), static_cast<PID>(key), count});
+      }
+    }
+    return out;
+  }
+
+ private:
+  static constexpr uint64_t kEmpty = ~uint64_t{0};
+
+  struct PairSlot {
+    std::atomic<uint64_t> key{kEmpty};
+    std::atomic<uint32_t> count{0};
+  };
+
+  static auto round_capacity(size_t wanted) -> size_t {
+    size_t capacity = 1024;
+    while (capacity < wanted) {
+      capacity <<= 1U;
+    }
+    return capacity;
+  }
+
+  static auto mix(uint64_t x) noexcept -> uint64_t {
+    x ^= x >> 33U;
+    x *= 0xff51afd7ed558ccdULL;
+    x ^= x >> 33U;
+    x *= 0xc4ceb9fe1a85ec53ULL;
+    x ^= x >> 33U;
+    return x;
+  }
+
+  void add_pair(PID a, PID b) noexcept {
+    const uint64_t key = (uint64_t{std::min(a, b)} << 32U) | std::max(a, b);
+    const size_t home = static_cast<size_t>(mix(key)) & pair_mask_;
+    PairSlot *weakest = nullptr;
+    uint32_t weakest_count = ~uint32_t{0};
+    for (size_t step = 0; step < kProbe; ++step) {
+      PairSlot &slot = pairs_[(home + step) & pair_mask_];
+      uint64_t seen = slot.key.load(std::memory_order_relaxed);
+      if (seen == kEmpty &&
+          slot.key.compare_exchange_strong(seen, key, std::memory_order_relaxed)) {
+        seen = key;
+      }
+      if (seen == key) {
+        slot.count.fetch_add(1, std::memory_order_relaxed);
+        return;
+      }
+      const uint32_t count = slot.count.load(std::memory_order_relaxed);
+      if (count < weakest_count) {
+        weakest = &slot;
+        weakest_count = count;
+      }
+    }
+    if (weakest == nullptr) {
+      return;
+    }
+    if (weakest_count <= 1) {
+      weakest->key.store(key, std::memory_order_relaxed);
+      weakest->count.store(1, std::memory_order_relaxed);
+    } else {
+      weakest->count.fetch_sub(1, std::memory_order_relaxed);
+    }
+  }
+
+  uint32_t sample_every_;
+  std::atomic<uint64_t> ticket_{0};
+  std::atomic<uint64_t> sampled_{0};
+  std::vector<std::atomic<uint32_t>> visits_;
+  std::vector<PairSlot> pairs_;
+  size_t pair_mask_ = 0;
+};
+
+// Process-wide directory of the sketches open segments are recording, keyed
+// by segment directory (key_for). Searchers register on open; maintenance
+// looks a segment up by the same key. Entries are weak, so a closed segment's
+// sketch goes with it.
+class VisitSketchRegistry {
+ public:
+  // Never destroyed: a searcher may still publish while statics are torn down.
+  [[nodiscard]] static auto instance() -> VisitSketchRegistry & {
+    static auto *registry = new VisitSketchRegistry();
+    return *registry;
+  }
+
+  [[nodiscard]] static auto key_for(const std::filesystem::path &seg_dir) -> std::string {
+    std::error_code ec;
+    auto canonical = std::filesystem::weakly_canonical(seg_dir, ec);
+    return (ec ? seg_dir : canonical).lexically_normal().string();
+  }
+
+  void publish(const std::string &key, const std::shared_ptr<VisitSketch> &sketch) {
+    std::lock_guard lock(mutex_);
+    std::erase_if(entries_, [](const auto &entry) { return entry.second.expired(); });
+    entries_[key] = sketch;
+  }
+
+  [[nodiscard]] auto find(const std::string &key) const -> std::shared_ptr<VisitSketch> {
+    std::lock_guard lock(mutex_);
+    const auto found = entries_.find(key);
+    return found == entries_.end() ? nullptr : found->second.lock();
+  }
+
+ private:
+  mutable std::mutex mutex_;
+  std::map<std::string, std::weak_ptr<VisitSketch>> entries_;
+};
+
+}  // namespace alaya::laser
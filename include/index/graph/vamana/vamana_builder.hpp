@@ -12,6 +12,7 @@
 #include <cstdint>
 #include <mutex>
 #include <random>
+#include <stdexcept>
 #include <string>
 #include <utility>
 #include <vector>
@@ -112,6 +113,65 @@ class VamanaBuilder {
     link(params_.alpha);
   }
 
+  // Incremental link over a carried-over topology. `seed` holds one list per
+  // row in this builder's ids. Rows in `repair` lost neighbors that are no
+  // longer part of the graph; their lists hold the unpruned candidates and
+  // are pruned again. Rows in `insert` start empty and are linked exactly as
+  // build() links every row, searching from `entry`, which must be a seeded
+  // row. Only the final over-degree scan visits every row, so the pruning
+  // and search work scales with |repair| + |insert|.
+  void build_incremental(std::vector<std::vector<uint32_t>> seed,
+                         const std::vector<uint32_t> &repair,
+                         const std::vector<uint32_t> &insert,
+                         uint32_t entry) {
+    if (seed.size() != num_points_ || entry >= num_points_) {
+      throw std::invalid_argument("VamanaBuilder::build_incremental: seed does not match data");
+    }
+    omp_set_num_threads(static_cast<int>(params_.num_threads));
+    graph_ = std::move(seed);
+    medoid_ = entry;
+    LOG_INFO("Vamana incremental build: N={}, repair={}, insert={}, entry={}",
+             num_points_,
+             repair.size(),
+             insert.size(),
+             medoid_);
+    init_scratches();
+    const float alpha = params_.alpha;
+
+#pragma omp parallel for schedule(dynamic, 256) num_threads(static_cast<int>(params_.num_threads))
+    for (int64_t index = 0; index < static_cast<int64_t>(repair.size()); ++index) {
+      const uint32_t node = repair[static_cast<size_t>(index)];
+      std::vector<uint32_t> candidates;
+      {
+        std::lock_guard<std::mutex> guard(locks_[node]);
+        candidates = graph_[node];
+      }
+      reprune(node, candidates, scratches_[static_cast<size_t>(omp_get_thread_num())], alpha);
+    }
+
+#pragma omp parallel for schedule(dynamic, 256) num_threads(static_cast<int>(params_.num_threads))
+    for (int64_t index = 0; index < static_cast<int64_t>(insert.size()); ++index) {
+      const uint32_t node = insert[static_cast<size_t>(index)];
+      Scratch &s = scratches_[static_cast<size_t>(omp_get_thread_num())];
+      std::vector<uint32_t> pruned_list;
+      search_for_point_and_prune(node, params_.L, pruned_list, s, alpha);
+      {
+        std::lock_guard<std::mutex> guard(locks_[node]);
+        graph_[node] = pruned_list;
+      }
+      inter_insert(node, pruned_list, s, alpha);
+    }
+
+#pragma omp parallel for schedule(dynamic, 2048) num_threads(static_cast<int>(params_.num_threads))
+    for (int64_t node_ctr = 0; node_ctr < static_cast<int64_t>(num_points_); ++node_ctr) {
+      const auto node = static_cast<uint32_t>(node_ctr);
+      if (graph_[node].size() > params_.R) {
+        const std::vector<uint32_t> snapshot = graph_[node];
+        reprune(node, snapshot, scratches_[static_cast<size_t>(omp_get_thread_num())], alpha);
+      }
+    }
+  }
+
   const std::vector<std::vector<uint32_t>> &graph() const { return graph_; }
   uint32_t medoid() const { return medoid_; }
   uint32_t max_degree() const { return params_.R; }
@@ -298,6 +358,45 @@ class VamanaBuilder {
                     });
   }
 
+  // Replaces `node`'s adjacency with the RobustPrune of `candidates`
+  // (deduplicated, self removed). Shared by the over-degree cleanup and the
+  // incremental repair pass.
+  void reprune(uint32_t node, const std::vector<uint32_t> &candidates, Scratch &s, float alpha) {
+    s.pool.clear();
+    s.occlude_factor.clear();
+    s.pool.reserve(candidates.size());
+    for (uint32_t cur_nbr : candidates) {
+      if (cur_nbr == node) {
+        continue;
+      }
+      bool already_seen = false;
+      for (const auto &prev : s.pool) {
+        if (prev.id == cur_nbr) {
+          already_seen = true;
+          break;
+        }
+      }
+      if (!already_seen) {
+        s.pool.emplace_back(cur_nbr, l2_dist(node, cur_nbr));
+      }
+    }
+    std::vector<uint32_t> new_neighbors;
+    prune_neighbors(node,
+                    s.pool,
+                    alpha,
+                    params_.R,
+                    params_.maxc,
+                    new_neighbors,
+                    s.occlude_factor,
+                    [this](uint32_t a, uint32_t b) {
+                      return l2_dist(a, b);
+                    });
+    {
+      std::lock_guard<std::mutex> guard(locks_[node]);
+      graph_[node] = std::move(new_neighbors);
+    }
+  }
+
   // For each newly minted forward edge n → des, attempt the reverse edge
   // des → n. Fast path (|des_pool| < 1.3R): append without pruning. Slow
   // path: copy des_pool + {n} under lock, prune outside lock, then
@@ -514,40 +613,7 @@ class VamanaBuilder {
         }
       }
       if (prune_needed) {
-        Scratch &s = scratches_[static_cast<size_t>(omp_get_thread_num())];
-        s.pool.clear();
-        s.occlude_factor.clear();
-        s.pool.reserve(snapshot.size());
-        for (uint32_t cur_nbr : snapshot) {
-          if (cur_nbr == node) {
-            continue;
-          }
-          bool already_seen = false;
-          for (const auto &prev : s.pool) {
-            if (prev.id == cur_nbr) {
-              already_seen = true;
-              break;
-            }
-          }
-          if (!already_seen) {
-            s.pool.emplace_back(cur_nbr, l2_dist(node, cur_nbr));
-          }
-        }
-        std::vector<uint32_t> new_neighbors;
-        prune_neighbors(node,
-                        s.pool,
-                        alpha,
-                        params_.R,
-                        params_.maxc,
-                        new_neighbors,
-                        s.occlude_factor,
-                        [this](uint32_t a, uint32_t b) {
-                          return l2_dist(a, b);
-                        });
-        {
-          std::lock_guard<std::mutex> guard(locks_[node]);
-          graph_[node] = std::move(new_neighbors);
-        }
+        reprune(node, snapshot, scratches_[static_cast<size_t>(omp_get_thread_num())], alpha);
       }
       log_progress_tick(cleanup_done,
                         cleanup_last_pct,
@@ -46,6 +46,8 @@
     #define ALAYA_TARGET_AVX512_BW __attribute__((target("avx512f,avx512bw")))
     #define ALAYA_TARGET_AVX2 __attribute__((target("avx2,fma")))
     #define ALAYA_TARGET_SSE4 __attribute__((target("sse4.1")))
+    #define ALAYA_TARGET_PCLMUL __attribute__((target("pclmul,sse4.1")))
+    #define ALAYA_TARGET_SHA __attribute__((target("sha,sse4.1")))
     #define ALAYA_TARGET_SSE2 __attribute__((target("sse2")))  // Baseline for x86-64
   #else
     // On non-x86 architectures, these are no-ops
@@ -54,6 +56,8 @@
     #define ALAYA_TARGET_AVX512_BW
     #define ALAYA_TARGET_AVX2
     #define ALAYA_TARGET_SSE4
+    #define ALAYA_TARGET_PCLMUL
+    #define ALAYA_TARGET_SHA
     #define ALAYA_TARGET_SSE2
   #endif
 
@@ -75,6 +79,8 @@
   #define ALAYA_TARGET_AVX512_BW
   #define ALAYA_TARGET_AVX2
   #define ALAYA_TARGET_SSE4
+  #define ALAYA_TARGET_PCLMUL
+  #define ALAYA_TARGET_SHA
   #define ALAYA_TARGET_SSE2
   #define ALAYA_NOINLINE __declspec(noinline)
   #define ALAYA_ALWAYS_INLINE __forceinline
@@ -90,6 +96,8 @@
   #define ALAYA_TARGET_AVX512_BW
   #define ALAYA_TARGET_AVX2
   #define ALAYA_TARGET_SSE4
+  #define ALAYA_TARGET_PCLMUL
+  #define ALAYA_TARGET_SHA
   #define ALAYA_TARGET_SSE2
   #define ALAYA_NOINLINE
   #define ALAYA_ALWAYS_INLINE inline
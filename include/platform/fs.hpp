@@ -5,10 +5,12 @@
 #pragma once
 
 #include <cerrno>
+#include <compare>
 #include <cstdint>
 #include <cstdio>
 #include <cstring>
 #include <filesystem>
+#include <optional>
 #include <stdexcept>
 #include <string>
 #include <system_error>
@@ -163,6 +165,31 @@ inline auto sync_file_or_throw(const fs::path &path) -> void {
 #endif
 }
 
+// sync_file_or_throw for append-only logs whose size is made durable by the
+// same call: Linux issues fdatasync, which skips the timestamp-only inode
+// update. Other platforms fall back to the full sync.
+inline auto sync_file_data_or_throw(const fs::path &path) -> void {
+#ifdef __linux__
+  int fd = ::open(path.c_str(), O_RDONLY | O_CLOEXEC | O_NOFOLLOW);
+  if (fd < 0) {
+    throw std::runtime_error("sync_file_data_or_throw: open failed: " + path.string() + ": " +
+                             std::strerror(errno));
+  }
+  if (::fdatasync(fd) != 0) {
+    int saved = errno;
+    ::close(fd);
+    throw std::runtime_error("sync_file_data_or_throw: fdatasync failed: " + path.string() +
+                             ": " + std::strerror(saved));
+  }
+  if (::close(fd) != 0) {
+    throw std::runtime_error("sync_file_data_or_throw: close failed: " + path.string() + ": " +
+                             std::strerror(errno));
+  }
+#else
+  sync_file_or_throw(path);
+#endif
+}
+
 inline auto sync_directory(const fs::path &path) -> void {
   if (path.empty() || !fs::exists(path)) {
     return;
@@ -364,6 +391,49 @@ inline auto read_file_prefix(const fs::path &path, std::size_t prefix_bytes) ->
 #endif
 }
 
+// What the kernel says about a file's current contents: device, inode, size,
+// and the modification and status-change times in nanoseconds. Any write,
+// truncate, or rename-over moves ctime, and user space cannot set ctime back,
+// so an unchanged identity means the bytes have not been rewritten through the
+// filesystem. POSIX only: Windows returns nullopt, as does any stat failure or
+// a path that is not a regular file (symlinks are not followed).
+struct FileIdentity {
+  std::uint64_t device{};
+  std::uint64_t inode{};
+  std::uint64_t size{};
+  std::int64_t mtime_ns{};
+  std::int64_t ctime_ns{};
+
+  auto operator<=>(const FileIdentity &) const = default;
+};
+
+inline auto file_identity(const fs::path &path) noexcept -> std::optional<FileIdentity> {
+#ifdef _WIN32
+  (void)path;
+  return std::nullopt;
+#else
+  struct stat info {};
+  if (::lstat(path.c_str(), &info) != 0 || !S_ISREG(info.st_mode)) {
+    return std::nullopt;
+  }
+  #if defined(__APPLE__)
+  const auto &modified = info.st_mtimespec;
+  const auto &changed = info.st_ctimespec;
+  #else
+  const auto &modified = info.st_mtim;
+  const auto &changed = info.st_ctim;
+  #endif
+  constexpr std::int64_t kNanosPerSecond = 1000000000;
+  return FileIdentity{static_cast<std::uint64_t>(info.st_dev),
+                      static_cast<std::uint64_t>(info.st_ino),
+                      static_cast<std::uint64_t>(info.st_size),
+                      static_cast<std::int64_t>(modified.tv_sec) * kNanosPerSecond +
+                          static_cast<std::int64_t>(modified.tv_nsec),
+                      static_cast<std::int64_t>(changed.tv_sec) * kNanosPerSecond +
+                          static_cast<std::int64_t>(changed.tv_nsec)};
+#endif
+}
+
 // Read a regular file into a std::string with a size cap. Refuses symlinks
 // and non-regular files. Returns the file contents (no trailing data).
 // Portable replacement for the POSIX-only O_NOFOLLOW + fstat + read pattern
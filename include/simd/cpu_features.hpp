@@ -23,6 +23,8 @@ struct CpuFeatures {
   bool avx2_ = false;
   bool fma_ = false;
   bool sse4_1_ = false;
+  bool pclmul_ = false;
+  bool sha_ = false;
 
   static auto detect() -> CpuFeatures {
     CpuFeatures features;
@@ -54,6 +56,12 @@ struct CpuFeatures {
     if (__builtin_cpu_supports("sse4.1")) {
       features.sse4_1_ = true;
     }
+    if (__builtin_cpu_supports("pclmul")) {
+      features.pclmul_ = true;
+    }
+    if (__builtin_cpu_supports("sha")) {
+      features.sha_ = true;
+    }
   #elif defined(_MSC_VER)
     int cpu_info[4];
     __cpuid(cpu_info, 0);
@@ -63,6 +71,7 @@ struct CpuFeatures {
       __cpuid(cpu_info, 1);
       features.sse4_1_ = (cpu_info[2] & (1 << 19)) != 0;
       features.fma_ = (cpu_info[2] & (1 << 12)) != 0;
+      features.pclmul_ = (cpu_info[2] & (1 << 1)) != 0;
       const bool osxsave = (cpu_info[2] & (1 << 27)) != 0;
       if (osxsave) {
         const auto xcr0 = _xgetbv(0);
@@ -76,6 +85,7 @@ struct CpuFeatures {
       features.avx512dq_ = (cpu_info[1] & (1 << 17)) != 0;
       features.avx512vl_ = (cpu_info[1] & (1U << 31)) != 0;
       features.avx2_ = (cpu_info[1] & (1 << 5)) != 0;
+      features.sha_ = (cpu_info[1] & (1 << 29)) != 0;
     }
   #endif
 #endif
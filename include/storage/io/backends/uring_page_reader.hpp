@@ -0,0 +1,454 @@
+// SPDX-FileCopyrightText: 2026 AlayaDB.AI
+// SPDX-License-Identifier: AGPL-3.0-only
+
+#pragma once
+
+#if !defined(__linux__)
+  #error "UringPageReader is available only on Linux"
+#endif
+
+#include <liburing.h>
+
+#include <algorithm>
+#include <condition_variable>
+#include <filesystem>
+#include <map>
+#include <mutex>
+#include <optional>
+#include <stdexcept>
+#include <system_error>
+#include <thread>
+#include <vector>
+
+#include <fcntl.h>
+#include <sys/stat.h>
+#include <sys/uio.h>
+#include <unistd.h>
+#include <cerrno>
+
+#include "storage/io/alignment.hpp"
+
+namespace alaya::storage::io {
+
+struct UringOptions {
+  // Let a kernel thread poll the submission queue, so submit() usually costs
+  // no syscall. The thread spins on a CPU while busy and sleeps after
+  // `sqpoll_idle_ms` without work.
+  bool sqpoll = false;
+  std::uint32_t sqpoll_idle_ms = 50;
+  // Slots in the sparse registered-buffer table; 0 disables register_buffer().
+  std::uint32_t registered_buffer_slots = 256;
+};
+
+// PageReader over one io_uring. The file is opened O_DIRECT and registered as
+// a fixed file, reads into buffers handed to register_buffer() go out as
+// READ_FIXED (no per-I/O page pinning), and a finite request deadline rides
+// along as a linked timeout so the kernel cancels a late read instead of the
+// reaper merely labelling it. BatchHandle::cancel() issues ASYNC_CANCEL for
+// every read of the batch still in flight.
+//
+// The submission queue is guarded by `mutex_`; the completion queue belongs
+// to the reaper thread alone. Requires Linux 5.11 (IORING_FEAT_EXT_ARG), so
+// the reaper's timed wait never has to borrow a submission entry.
+class UringPageReader final : public PageReader {
+ private:
+  struct RequestState;
+  struct BatchState {
+    std::mutex mutex;
+    std::size_t remaining = 0;
+    bool cancel_requested = false;
+    UringPageReader *owner = nullptr;
+    // Pointers stay valid only while the matching `done` entry is false.
+    std::vector<RequestState *> requests;
+    std::vector<bool> done;
+  };
+  struct RequestState {
+    ReadRequest request;
+    Completion completion;
+    std::shared_ptr<BatchState> batch;
+    std::size_t index = 0;
+    __kernel_timespec timeout{};
+    bool linked_timeout = false;
+    bool suppress_completion = false;
+  };
+  struct RegisteredBuffer {
+    std::size_t size = 0;
+    std::uint32_t slot = 0;
+  };
+
+  // user_data of linked-timeout and cancel entries; their CQEs are dropped.
+  static constexpr std::uint64_t kControlUserData = 0;
+
+ public:
+  explicit UringPageReader(const std::filesystem::path &path,
+                           ReaderOptions options = {},
+                           UringOptions uring = {})
+      : constraints_(direct_constraints(path, std::max<std::uint32_t>(1, options.queue_depth))) {
+    fd_ = ::open(path.c_str(), O_RDONLY | O_DIRECT);
+    if (fd_ < 0) throw std::system_error(errno, std::generic_category(), "open O_DIRECT");
+    io_uring_params params{};
+    if (uring.sqpoll) {
+      params.flags |= IORING_SETUP_SQPOLL;
+      params.sq_thread_idle = uring.sqpoll_idle_ms;
+      sqpoll_ = true;
+    }
+    // A read plus its linked timeout take two entries; cancels take more.
+    const int setup = ::io_uring_queue_init_params(4 * constraints_.max_batch, &ring_, &params);
+    if (setup < 0) {
+      ::close(fd_);
+      fd_ = -1;
+      throw std::system_error(-setup, std::generic_category(), "io_uring_queue_init_params");
+    }
+    if ((params.features & IORING_FEAT_EXT_ARG) == 0) {
+      ::io_uring_queue_exit(&ring_);
+      ::close(fd_);
+      fd_ = -1;
+      throw std::system_error(ENOSYS,
+                              std::generic_category(),
+                              "io_uring lacks IORING_FEAT_EXT_ARG");
+    }
+    fixed_file_ = ::io_uring_register_files(&ring_, &fd_, 1) == 0;
+    if (uring.registered_buffer_slots != 0 &&
+        ::io_uring_register_buffers_sparse(&ring_, uring.registered_buffer_slots) == 0) {
+      buffer_slots_ = uring.registered_buffer_slots;
+    }
+    try {
+      reaper_ = std::thread([this] {
+        reap_loop();
+      });
+    } catch (...) {
+      ::io_uring_queue_exit(&ring_);
+      ::close(fd_);
+      throw;
+    }
+  }
+
+  ~UringPageReader() override { shutdown(); }
+
+  // Whether this kernel (and its seccomp policy) can host the reader.
+  [[nodiscard]] static auto is_available() noexcept -> bool {
+    io_uring ring{};
+    io_uring_params params{};
+    if (::io_uring_queue_init_params(2, &ring, &params) < 0) return false;
+    ::io_uring_queue_exit(&ring);
+    return (params.features & IORING_FEAT_EXT_ARG) != 0;
+  }
+
+  [[nodiscard]] auto constraints() const noexcept -> ReadConstraints override {
+    return constraints_;
+  }
+
+  // Registers `buffer` for READ_FIXED. It must stay allocated until
+  // shutdown(). Returns false when the table is full or the kernel refuses;
+  // reads into the buffer then still work, just without the fixed fast path.
+  auto register_buffer(std::span<std::byte> buffer) noexcept -> bool override {
+    std::lock_guard lock(mutex_);
+    if (stopping_ || buffer.empty() || registered_.size() >= buffer_slots_) return false;
+    iovec region{.iov_base = buffer.data(), .iov_len = buffer.size()};
+    const auto slot = static_cast<std::uint32_t>(registered_.size());
+    if (::io_uring_register_buffers_update_tag(&ring_, slot, &region, nullptr, 1) != 1) {
+      return false;
+    }
+    registered_.insert_or_assign(buffer.data(), RegisteredBuffer{buffer.size(), slot});
+    return true;
+  }
+
+  [[nodiscard]] auto submit(std::span<const ReadRequest> requests, Completion completion)
+      -> BatchHandle override {
+    if ((completion.fn == nullptr && !requests.empty()) || requests.size() > constraints_.max_batch)
+      throw std::invalid_argument("invalid PageReader batch");
+    for (const auto &request : requests) {
+      if (!validate_read_request(request, constraints_))
+        throw std::invalid_argument("read request violates alignment constraints");
+    }
+
+    auto batch = std::make_shared<BatchState>();
+    batch->remaining = requests.size();
+    batch->owner = this;
+    auto handle = make_batch_handle([weak = std::weak_ptr(batch)]() noexcept {
+      const auto state = weak.lock();
+      if (!state) return CancelResult::already_complete;
+      // While any read is outstanding, shutdown() cannot finish, so `owner`
+      // stays valid for as long as this lock is held.
+      std::lock_guard lock(state->mutex);
+      if (state->remaining == 0) return CancelResult::already_complete;
+      state->cancel_requested = true;
+      state->owner->cancel_in_flight(*state);
+      return CancelResult::requested;
+    });
+    if (requests.empty()) {
+      std::lock_guard lock(mutex_);
+      if (stopping_) throw std::runtime_error("PageReader is shut down");
+      return handle;
+    }
+
+    const auto now = Clock::now();
+    std::vector<std::unique_ptr<RequestState>> states;
+    states.reserve(requests.size());
+    batch->requests.reserve(requests.size());
+    batch->done.assign(requests.size(), false);
+    for (const auto &request : requests) {
+      auto state = std::make_unique<RequestState>();
+      state->request = request;
+      state->completion = completion;
+      state->batch = batch;
+      state->index = batch->requests.size();
+      // A deadline already past gets no timeout: the read still runs and is
+      // reported timed_out, so the buffer is never left half-written.
+      if (request.deadline != Clock::time_point::max() && request.deadline > now) {
+        const auto left = request.deadline - now;
+        const auto nanos = std::chrono::duration_cast<std::chrono::nanoseconds>(left).count();
+        state->timeout.tv_sec = nanos / 1'000'000'000;
+        state->timeout.tv_nsec = nanos % 1'000'000'000;
+        state->linked_timeout = true;
+      }
+      batch->requests.push_back(state.get());
+      states.push_back(std::move(state));
+    }
+
+    std::unique_lock lock(mutex_);
+    capacity_cv_.wait(lock, [&] {
+      return stopping_ || outstanding_ + requests.size() <= constraints_.max_batch;
+    });
+    if (stopping_) throw std::runtime_error("PageReader is shut down");
+    if (failed_errno_ != 0) {
+      throw std::system_error(failed_errno_, std::generic_category(), "io_uring_submit");
+    }
+    unsigned entries = 0;
+    for (const auto &state : states) entries += state->linked_timeout ? 2U : 1U;
+    if (const int reserved = reserve_sqes_locked(entries); reserved < 0) {
+      // Nothing of this batch is in the ring yet; its states die with `states`.
+      throw std::system_error(-reserved, std::generic_category(), "io_uring submission queue");
+    }
+    for (auto &state : states) prepare_read(*state);
+    const int submitted = submit_locked();
+    outstanding_ += requests.size();
+    if (submitted < 0) {
+      // The entries stay queued in the ring and go out with the next
+      // io_uring_submit that succeeds; their completions are swallowed, and
+      // this caller waits for them so its buffers are not written after it
+      // returns. Each completion of another read retries the submit. Once
+      // only stranded reads are outstanding nothing would wake the wait, so
+      // the batch fails with the errno and the reader refuses later batches
+      // and cancels, which keeps the stranded entries from ever going out.
+      for (auto &state : states) {
+        state->suppress_completion = true;
+        state.release();
+      }
+      stranded_reads_ += requests.size();
+      drain_cv_.wait(lock, [&] {
+        if (stranded_reads_ != 0 && submit_locked() >= 0) stranded_reads_ = 0;
+        return outstanding_ == stranded_reads_;
+      });
+      if (stranded_reads_ != 0) failed_errno_ = -submitted;
+      throw std::system_error(-submitted, std::generic_category(), "io_uring_submit");
+    }
+    // A successful submit hands every queued entry to the kernel, including
+    // any an earlier failed submit left behind.
+    stranded_reads_ = 0;
+    for (auto &state : states) state.release();
+    lock.unlock();
+    return handle;
+  }
+
+  void shutdown() noexcept override {
+    {
+      std::unique_lock lock(mutex_);
+      if (stopping_) return;
+      stopping_ = true;
+      capacity_cv_.notify_all();
+      drain_cv_.wait(lock, [&] {
+        return outstanding_ == stranded_reads_;
+      });
+      reaper_stop_ = true;
+    }
+    if (reaper_.joinable()) reaper_.join();
+    if (fd_ >= 0) {
+      ::io_uring_queue_exit(&ring_);
+      ::close(fd_);
+      fd_ = -1;
+    }
+  }
+
+ private:
+  static auto direct_constraints(const std::filesystem::path &path, std::uint32_t depth)
+      -> ReadConstraints {
+    std::size_t memory = 4096;
+    std::size_t offset = 4096;
+#if defined(STATX_DIOALIGN) && defined(AT_STATX_DONT_SYNC)
+    struct statx info{};
+    if (::statx(AT_FDCWD, path.c_str(), AT_STATX_DONT_SYNC, STATX_DIOALIGN, &info) == 0 &&
+        (info.stx_mask & STATX_DIOALIGN) != 0) {
+      if (info.stx_dio_mem_align != 0) memory = info.stx_dio_mem_align;
+      if (info.stx_dio_offset_align != 0) offset = info.stx_dio_offset_align;
+    }
+#endif
+    return {memory, offset, offset, depth, true};
+  }
+
+  // Makes room for `entries` submission entries before any of a batch is
+  // prepared, so a batch never goes out half-built. Pending cancels, or an
+  // SQPOLL thread that has not caught up, can fill the ring: submitting hands
+  // the entries to the kernel, and under SQPOLL io_uring_sqring_wait() waits
+  // for its thread to consume them. Returns the negative errno of a hard
+  // failure, or -EBUSY when the kernel takes nothing.
+  auto reserve_sqes_locked(unsigned entries) -> int {
+    while (::io_uring_sq_space_left(&ring_) < entries) {
+      const int submitted = submit_locked();
+      if (submitted < 0) return submitted;
+      if (::io_uring_sq_space_left(&ring_) >= entries) break;
+      if (sqpoll_) {
+        const int waited = ::io_uring_sqring_wait(&ring_);
+        if (waited < 0 && waited != -EINTR) return waited;
+      } else if (submitted == 0) {
+        return -EBUSY;
+      }
+    }
+    return 0;
+  }
+
+  // Callers hold `mutex_` and have reserved the entry with
+  // reserve_sqes_locked().
+  auto next_sqe_locked() -> io_uring_sqe * {
+    auto *sqe = ::io_uring_get_sqe(&ring_);
+    if (sqe == nullptr) {
+      throw std::system_error(EBUSY, std::generic_category(), "io_uring submission queue");
+    }
+    return sqe;
+  }
+
+  void prepare_read(RequestState &state) {
+    auto *sqe = next_sqe_locked();
+    auto *buffer = state.request.buffer.data();
+    const auto size = static_cast<unsigned>(state.request.buffer.size());
+    const int file = fixed_file_ ? 0 : fd_;
+    if (const auto slot = registered_slot(state.request.buffer); slot.has_value()) {
+      ::io_uring_prep_read_fixed(sqe, file, buffer, size, state.request.offset, *slot);
+    } else {
+      ::io_uring_prep_read(sqe, file, buffer, size, state.request.offset);
+    }
+    if (fixed_file_) sqe->flags |= IOSQE_FIXED_FILE;
+    ::io_uring_sqe_set_data(sqe, &state);
+    if (!state.linked_timeout) return;
+    sqe->flags |= IOSQE_IO_LINK;
+    auto *timeout = next_sqe_locked();
+    ::io_uring_prep_link_timeout(timeout, &state.timeout, 0);
+    ::io_uring_sqe_set_data64(timeout, kControlUserData);
+  }
+
+  [[nodiscard]] auto registered_slot(std::span<std::byte> buffer) const
+      -> std::optional<int> {
+    auto found = registered_.upper_bound(buffer.data());
+    if (found == registered_.begin()) return std::nullopt;
+    --found;
+    const auto offset = static_cast<std::size_t>(buffer.data() - found->first);
+    if (offset + buffer.size() > found->second.size) return std::nullopt;
+    return static_cast<int>(found->second.slot);
+  }
+
+  // io_uring_submit, retried across transient refusals. Returns the negative
+  // errno of a hard failure.
+  auto submit_locked() -> int {
+    for (;;) {
+      const int submitted = ::io_uring_submit(&ring_);
+      if (submitted >= 0) return submitted;
+      if (submitted != -EINTR && submitted != -EAGAIN && submitted != -EBUSY) return submitted;
+      std::this_thread::yield();
+    }
+  }
+
+  // Called with `batch.mutex` held; completions mark requests done under it.
+  void cancel_in_flight(BatchState &batch) noexcept {
+    std::lock_guard lock(mutex_);
+    if (failed_errno_ != 0) return;
+    bool queued = false;
+    for (std::size_t index = 0; index < batch.requests.size(); ++index) {
+      if (batch.done[index]) continue;
+      if (reserve_sqes_locked(1) < 0) break;
+      auto *sqe = ::io_uring_get_sqe(&ring_);
+      if (sqe == nullptr) break;
+      ::io_uring_prep_cancel(sqe, batch.requests[index], 0);
+      ::io_uring_sqe_set_data64(sqe, kControlUserData);
+      queued = true;
+    }
+    if (queued) (void)submit_locked();
+  }
+
+  void reap_loop() noexcept {
+    for (;;) {
+      __kernel_timespec timeout{.tv_sec = 0, .tv_nsec = 10'000'000};
+      io_uring_cqe *cqe = nullptr;
+      if (::io_uring_wait_cqe_timeout(&ring_, &cqe, &timeout) == 0) {
+        unsigned head = 0;
+        unsigned seen = 0;
+        io_uring_for_each_cqe(&ring_, head, cqe) {
+          ++seen;
+          if (cqe->user_data != kControlUserData) complete(*cqe);
+        }
+        ::io_uring_cq_advance(&ring_, seen);
+      }
+      std::lock_guard lock(mutex_);
+      if (reaper_stop_ && outstanding_ == stranded_reads_) return;
+    }
+  }
+
+  void complete(const io_uring_cqe &cqe) noexcept {
+    // Pair with submit()'s mutex-held ownership hand-off before adopting the
+    // RequestState, exactly as the libaio reaper does.
+    std::unique_lock lock(mutex_);
+    std::unique_ptr<RequestState> state(
+        reinterpret_cast<RequestState *>(static_cast<std::uintptr_t>(cqe.user_data)));
+    lock.unlock();
+    ReadResult result{.id = state->request.id};
+    auto &batch = *state->batch;
+    {
+      std::lock_guard batch_lock(batch.mutex);
+      batch.done[state->index] = true;
+      --batch.remaining;
+      if (batch.cancel_requested) {
+        result.status = ReadStatus::cancelled;
+      } else if ((cqe.res == -ECANCELED || cqe.res == -EINTR) && state->linked_timeout) {
+        result.status = ReadStatus::timed_out;
+      } else if (cqe.res < 0) {
+        result.status = ReadStatus::io_error;
+        result.error = {-cqe.res, std::generic_category()};
+      } else if (Clock::now() > state->request.deadline) {
+        result.status = ReadStatus::timed_out;
+      } else {
+        result.status =
+            static_cast<std::size_t>(cqe.res) == state->request.buffer.size()
+                ? ReadStatus::ok
+                : ReadStatus::short_read;
+      }
+      if (cqe.res > 0) result.bytes = static_cast<std::size_t>(cqe.res);
+    }
+    if (!state->suppress_completion) state->completion.fn(state->completion.context, result);
+    lock.lock();
+    --outstanding_;
+    lock.unlock();
+    capacity_cv_.notify_all();
+    drain_cv_.notify_all();
+  }
+
+  int fd_ = -1;
+  io_uring ring_{};
+  bool sqpoll_ = false;
+  bool fixed_file_ = false;
+  std::uint32_t buffer_slots_ = 0;
+  std::map<const std::byte *, RegisteredBuffer> registered_;
+  ReadConstraints constraints_{};
+  std::thread reaper_;
+  std::mutex mutex_;
+  std::condition_variable capacity_cv_;
+  std::condition_variable drain_cv_;
+  std::size_t outstanding_ = 0;
+  // Reads queued in the ring by a failed io_uring_submit and not yet taken
+  // by the kernel. Included in `outstanding_`.
+  std::size_t stranded_reads_ = 0;
+  // Set when a batch gave up on stranded reads; later batches fail with it.
+  int failed_errno_ = 0;
+  bool stopping_ = false;
+  bool reaper_stop_ = false;
+};
+
+}  // namespace alaya::storage::io
@@ -0,0 +1,114 @@
+// SPDX-FileCopyrightText: 2026 AlayaDB.AI
+//
+// SPDX-License-Identifier: AGPL-3.0-only
+
+#pragma once
+
+#include <cerrno>
+#include <cstddef>
+#include <cstdint>
+#include <filesystem>
+#include <stdexcept>
+#include <string>
+#include <system_error>
+#include <utility>
+
+#include <fcntl.h>
+#include <unistd.h>
+
+#include "storage/io/alignment.hpp"
+
+namespace alaya::storage::io {
+
+// Creates a file and writes it at explicit offsets, bypassing the page cache
+// where the filesystem allows it. Bulk artifacts that are written once and
+// read back through O_DIRECT readers gain nothing from being cached twice.
+// The file is created buffered and O_DIRECT is added with fcntl: opening with
+// O_CREAT | O_EXCL | O_DIRECT creates the file on tmpfs (before Linux 6.6)
+// and FUSE and then fails with EINVAL, so a buffered retry would hit EEXIST.
+// A filesystem that refuses O_DIRECT there or at the first write (some
+// overlays) leaves a buffered descriptor, so the caller keeps one code path. Every write must be aligned to kAlignment in
+// buffer address, offset and length whether or not the descriptor is direct.
+// finish() fdatasyncs and closes; a writer destroyed without finish() closes
+// without syncing.
+class DirectFileWriter {
+ public:
+  static constexpr std::size_t kAlignment = 4096;
+
+  explicit DirectFileWriter(std::filesystem::path path) : path_(std::move(path)) {
+    fd_ = ::open(path_.c_str(), O_WRONLY | O_CREAT | O_EXCL | O_CLOEXEC, 0644);
+    if (fd_ < 0) {
+      throw std::system_error(errno, std::generic_category(), "open " + path_.string());
+    }
+#ifdef O_DIRECT
+    const int flags = ::fcntl(fd_, F_GETFL);
+    direct_ = flags >= 0 && ::fcntl(fd_, F_SETFL, flags | O_DIRECT) == 0;
+#endif
+  }
+
+  DirectFileWriter(const DirectFileWriter &) = delete;
+  auto operator=(const DirectFileWriter &) -> DirectFileWriter & = delete;
+
+  ~DirectFileWriter() {
+    if (fd_ >= 0) {
+      ::close(fd_);
+    }
+  }
+
+  [[nodiscard]] auto direct() const noexcept -> bool { return direct_; }
+
+  void write_at(std::uint64_t offset, const void *data, std::size_t bytes) {
+    if (!is_aligned(reinterpret_cast<std::uintptr_t>(data), kAlignment) ||
+        !is_aligned(offset, kAlignment) || !is_aligned(bytes, kAlignment)) {
+      throw std::invalid_argument("DirectFileWriter: unaligned write to " + path_.string());
+    }
+    const auto *cursor = static_cast<const char *>(data);
+    while (bytes != 0) {
+      const auto written = ::pwrite(fd_, cursor, bytes, static_cast<off_t>(offset));
+      if (written < 0 && errno == EINTR) {
+        continue;
+      }
+#ifdef O_DIRECT
+      if (written < 0 && errno == EINVAL && direct_) {
+        fall_back_to_buffered();
+        continue;
+      }
+#endif
+      if (written <= 0) {
+        throw std::system_error(written < 0 ? errno : EIO,
+                                std::generic_category(),
+                                "pwrite " + path_.string());
+      }
+      cursor += written;
+      offset += static_cast<std::uint64_t>(written);
+      bytes -= static_cast<std::size_t>(written);
+    }
+  }
+
+  void finish() {
+    if (::fdatasync(fd_) != 0) {
+      throw std::system_error(errno, std::generic_category(), "fdatasync " + path_.string());
+    }
+    const int fd = std::exchange(fd_, -1);
+    if (::close(fd) != 0) {
+      throw std::system_error(errno, std::generic_category(), "close " + path_.string());
+    }
+  }
+
+ private:
+#ifdef O_DIRECT
+  void fall_back_to_buffered() {
+    const int flags = ::fcntl(fd_, F_GETFL);
+    if (flags < 0 || ::fcntl(fd_, F_SETFL, flags & ~O_DIRECT) != 0) {
+      throw std::system_error(errno, std::generic_category(), "fcntl " + path_.string());
+    }
+    direct_ = false;
+  }
+#endif
+
+  std::filesystem::path path_;
+  int fd_{-1};
+  bool direct_{};
+};
+
+}  // namespace alaya::storage::io
@@ -0,0 +1,367 @@
+// SPDX-FileCopyrightText: 2026 AlayaDB.AI
+//
+// SPDX-License-Identifier: AGPL-3.0-only
+
+#pragma once
+
+#include <algorithm>
+#include <cerrno>
+#include <condition_variable>
+#include <cstddef>
+#include <cstdint>
+#include <cstdlib>
+#include <exception>
+#include <filesystem>
+#include <functional>
+#include <mutex>
+#include <span>
+#include <stdexcept>
+#include <string>
+#include <system_error>
+#include <thread>
+#include <vector>
+
+#ifndef _WIN32
+  #include <fcntl.h>
+  #include <sys/stat.h>
+  #include <unistd.h>
+#endif
+#ifdef _WIN32
+  #ifndef NOMINMAX
+    #define NOMINMAX
+  #endif
+  #include <windows.h>
+#endif
+#ifdef __linux__
+  #include <linux/fs.h>
+  #include <sys/ioctl.h>
+  #include <sys/syscall.h>
+#endif
+
+namespace alaya::storage::io {
+
+// How transfer_file() placed the destination.
+enum class TransferMethod : std::uint8_t {
+  renamed,        // rename(2): the source is gone
+  cloned,         // FICLONE reflink: extents shared, no data copied
+  kernel_copied,  // copy_file_range(2): copied without a user-space pass
+  chunk_copied,   // pread/pwrite by worker threads; the only method that
+                  // hands the bytes to TransferOptions::on_bytes
+};
+
+struct TransferOptions {
+  // Rename the source into place when both sides share a filesystem. The
+  // caller gives the source up; across filesystems the source is copied and
+  // left where it was.
+  bool allow_rename = false;
+  // Skip rename and the in-kernel methods and always copy through user
+  // space. Tests reach the fallback through it.
+  bool force_chunked = false;
+  // Worker threads for the chunked copy; 0 picks hardware_concurrency().
+  std::size_t threads = 0;
+  std::size_t chunk_bytes = std::size_t{8} << 20U;
+  // Called with the file's bytes in order, one chunk per call, when the
+  // chunked copy runs. Calls never overlap but may come from any worker.
+  std::function<void(std::span<const std::byte>)> on_bytes;
+};
+
+namespace transfer_detail {
+
+#ifndef _WIN32
+class Fd {
+ public:
+  explicit Fd(int fd) noexcept : fd_(fd) {}
+  Fd(const Fd &) = delete;
+  auto operator=(const Fd &) -> Fd & = delete;
+  ~Fd() {
+    if (fd_ >= 0) {
+      ::close(fd_);
+    }
+  }
+  [[nodiscard]] auto get() const noexcept -> int { return fd_; }
+  void close_or_throw(const std::filesystem::path &path) {
+    const int fd = fd_;
+    fd_ = -1;
+    if (::close(fd) != 0) {
+      throw std::system_error(errno, std::generic_category(), "close " + path.string());
+    }
+  }
+
+ private:
+  int fd_;
+};
+
+[[nodiscard]] inline auto io_error(const char *call, const std::filesystem::path &path)
+    -> std::system_error {
+  return {errno, std::generic_category(), std::string(call) + " " + path.string()};
+}
+
+// Errors that mean "this method does not apply here", not "the copy failed".
+[[nodiscard]] inline auto unsupported(int error) noexcept -> bool {
+  return error == EXDEV || error == EINVAL || error == EOPNOTSUPP || error == ENOTTY ||
+         error == ENOSYS || error == EBADF || error == EPERM;
+}
+
+// Moves `src` to `dst` unless `dst` exists, which throws EEXIST like the copy
+// paths do. renameat2(RENAME_NOREPLACE) where the kernel and filesystem have
+// it, else link + unlink. Returns false when neither applies (different
+// filesystems, no hard links), so the caller copies instead.
+[[nodiscard]] inline auto rename_no_replace(const std::filesystem::path &src,
+                                            const std::filesystem::path &dst) -> bool {
+  #if defined(__linux__) && defined(SYS_renameat2) && defined(RENAME_NOREPLACE)
+  if (::syscall(SYS_renameat2,
+                AT_FDCWD,
+                src.c_str(),
+                AT_FDCWD,
+                dst.c_str(),
+                static_cast<unsigned int>(RENAME_NOREPLACE)) == 0) {
+    return true;
+  }
+  if (errno == EXDEV) {
+    return false;
+  }
+  if (errno != EINVAL && errno != ENOSYS) {
+    throw io_error("renameat2", dst);
+  }
+  #endif
+  if (::link(src.c_str(), dst.c_str()) != 0) {
+    if (errno != EEXIST && unsupported(errno)) {
+      return false;
+    }
+    throw io_error("link", dst);
+  }
+  if (::unlink(src.c_str()) != 0) {
+    throw io_error("unlink", src);
+  }
+  return true;
+}
+
+  #ifdef __linux__
+[[nodiscard]] inline auto try_clone(int src, int dst) noexcept -> bool {
+  return ::ioctl(dst, FICLONE, src) == 0;
+}
+
+// Copies `bytes` in the kernel. Returns false, with nothing to undo beyond
+// truncation, if the filesystem pair refuses on the first call.
+[[nodiscard]] inline auto try_copy_file_range(int src,
+                                              int dst,
+                                              std::uint64_t bytes,
+                                              const std::filesystem::path &path) -> bool {
+  std::uint64_t done = 0;
+  while (done < bytes) {
+    const auto copied = ::copy_file_range(src, nullptr, dst, nullptr, bytes - done, 0);
+    if (copied < 0 && errno == EINTR) {
+      continue;
+    }
+    if (copied < 0 && done == 0 && unsupported(errno)) {
+      return false;
+    }
+    if (copied < 0) {
+      throw io_error("copy_file_range", path);
+    }
+    if (copied == 0) {
+      throw std::runtime_error("copy_file_range: source shrank while copying to " +
+                               path.string());
+    }
+    done += static_cast<std::uint64_t>(copied);
+  }
+  return true;
+}
+  #endif
+
+inline void pread_all(int fd,
+                      char *data,
+                      std::size_t bytes,
+                      off_t offset,
+                      const std::filesystem::path &path) {
+  while (bytes != 0) {
+    const auto got = ::pread(fd, data, bytes, offset);
+    if (got < 0 && errno == EINTR) {
+      continue;
+    }
+    if (got <= 0) {
+      if (got == 0) {
+        errno = EIO;
+      }
+      throw io_error("pread", path);
+    }
+    data += got;
+    offset += got;
+    bytes -= static_cast<std::size_t>(got);
+  }
+}
+
+inline void pwrite_all(int fd,
+                       const char *data,
+                       std::size_t bytes,
+                       off_t offset,
+                       const std::filesystem::path &path) {
+  while (bytes != 0) {
+    const auto put = ::pwrite(fd, data, bytes, offset);
+    if (put < 0 && errno == EINTR) {
+      continue;
+    }
+    if (put <= 0) {
+      if (put == 0) {
+        errno = EIO;
+      }
+      throw io_error("pwrite", path);
+    }
+    data += put;
+    offset += put;
+    bytes -= static_cast<std::size_t>(put);
+  }
+}
+
+// Each worker copies chunks worker, worker + W, ... . When on_bytes is set a
+// worker hands its chunk over only once every earlier chunk has been handed
+// over, so I/O on later chunks overlaps the consumer of earlier ones.
+inline void chunked_copy(int src,
+                         int dst,
+                         std::uint64_t bytes,
+                         const TransferOptions &options,
+                         const std::filesystem::path &path) {
+  const std::size_t chunk_bytes = std::max<std::size_t>(options.chunk_bytes, 4096);
+  const auto num_chunks = static_cast<std::size_t>((bytes + chunk_bytes - 1) / chunk_bytes);
+  if (num_chunks == 0) {
+    return;
+  }
+  const std::size_t requested =
+      options.threads != 0 ? options.threads
+                           : std::max<std::size_t>(1, std::thread::hardware_concurrency());
+  const std::size_t workers = std::min(num_chunks, requested);
+
+  std::mutex mutex;
+  std::condition_variable turn;
+  std::size_t next_chunk = 0;
+  bool failed = false;
+  std::exception_ptr first_error;
+  auto run = [&](std::size_t worker) {
+    try {
+      std::vector<char> buffer(chunk_bytes);
+      for (std::size_t chunk = worker; chunk < num_chunks; chunk += workers) {
+        const auto offset = static_cast<std::uint64_t>(chunk) * chunk_bytes;
+        const auto length = static_cast<std::size_t>(std::min<std::uint64_t>(chunk_bytes,
+                                                                             bytes - offset));
+        pread_all(src, buffer.data(), length, static_cast<off_t>(offset), path);
+        pwrite_all(dst, buffer.data(), length, static_cast<off_t>(offset), path);
+        if (!options.on_bytes) {
+          continue;
+        }
+        std::unique_lock lock(mutex);
+        turn.wait(lock, [&] { return failed || next_chunk == chunk; });
+        if (failed) {
+          return;
+        }
+        options.on_bytes(std::as_bytes(std::span(buffer.data(), length)));
+        ++next_chunk;
+        turn.notify_all();
+      }
+    } catch (...) {
+      std::lock_guard lock(mutex);
+      if (!first_error) {
+        first_error = std::current_exception();
+      }
+      failed = true;
+      turn.notify_all();
+    }
+  };
+
+  std::vector<std::thread> helpers;
+  helpers.reserve(workers - 1);
+  try {
+    for (std::size_t worker = 1; worker < workers; ++worker) {
+      helpers.emplace_back(run, worker);
+    }
+  } catch (...) {
+    std::lock_guard lock(mutex);
+    if (!first_error) {
+      first_error = std::current_exception();
+    }
+    failed = true;
+    turn.notify_all();
+  }
+  run(0);
+  for (auto &helper : helpers) {
+    helper.join();
+  }
+  if (first_error) {
+    std::rethrow_exception(first_error);
+  }
+}
+#endif
+
+}  // namespace transfer_detail
+
+// Places a copy of regular file `src` at `dst`, which must not exist, using
+// the cheapest method the filesystems allow: a rename that never replaces
+// `dst` (if allowed), FICLONE,
+// copy_file_range, then a parallel chunked copy. A copied `dst` is fsynced
+// before this returns; a renamed one keeps whatever durability `src` had.
+// The destination's parent directory is not synced.
+[[nodiscard]] inline auto transfer_file(const std::filesystem::path &src,
+                                        const std::filesystem::path &dst,
+                                        const TransferOptions &options) -> TransferMethod {
+#ifdef _WIN32
+  // Without MOVEFILE_REPLACE_EXISTING the move fails on an existing `dst`,
+  // and so does the copy below.
+  if (options.allow_rename && !options.force_chunked &&
+      ::MoveFileExW(src.c_str(), dst.c_str(), MOVEFILE_WRITE_THROUGH) != 0) {
+    return TransferMethod::renamed;
+  }
+  std::filesystem::copy_file(src, dst, std::filesystem::copy_options::none);
+  return TransferMethod::kernel_copied;
+#else
+  using transfer_detail::io_error;
+  if (options.allow_rename && !options.force_chunked &&
+      transfer_detail::rename_no_replace(src, dst)) {
+    return TransferMethod::renamed;
+  }
+
+  transfer_detail::Fd in(::open(src.c_str(), O_RDONLY | O_CLOEXEC));
+  if (in.get() < 0) {
+    throw io_error("open", src);
+  }
+  struct stat info {};
+  if (::fstat(in.get(), &info) != 0) {
+    throw io_error("fstat", src);
+  }
+  if (!S_ISREG(info.st_mode)) {
+    throw std::runtime_error("transfer_file: not a regular file: " + src.string());
+  }
+  const auto bytes = static_cast<std::uint64_t>(info.st_size);
+  transfer_detail::Fd out(::open(dst.c_str(), O_WRONLY | O_CREAT | O_EXCL | O_CLOEXEC, 0644));
+  if (out.get() < 0) {
+    throw io_error("open", dst);
+  }
+
+  try {
+    auto method = TransferMethod::chunk_copied;
+  #ifdef __linux__
+    if (!options.force_chunked && transfer_detail::try_clone(in.get(), out.get())) {
+      method = TransferMethod::cloned;
+    } else if (!options.force_chunked &&
+               transfer_detail::try_copy_file_range(in.get(), out.get(), bytes, dst)) {
+      method = TransferMethod::kernel_copied;
+    }
+  #endif
+    if (method == TransferMethod::chunk_copied) {
+      if (::ftruncate(out.get(), static_cast<off_t>(bytes)) != 0) {
+        throw io_error("ftruncate", dst);
+      }
+      transfer_detail::chunked_copy(in.get(), out.get(), bytes, options, dst);
+    }
+    if (::fsync(out.get()) != 0) {
+      throw io_error("fsync", dst);
+    }
+    out.close_or_throw(dst);
+    return method;
+  } catch (...) {
+    std::error_code ignored;
+    std::filesystem::remove(dst, ignored);
+    throw;
+  }
+#endif
+}
+
+}  // namespace alaya::storage::io
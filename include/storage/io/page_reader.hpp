@@ -104,6 +104,13 @@ class PageReader {
   [[nodiscard]] virtual auto submit(std::span<const ReadRequest> requests, Completion completion)
       -> BatchHandle = 0;
   virtual void shutdown() noexcept = 0;
+  // Hint that reads will keep landing in `buffer`, which must stay allocated
+  // until shutdown(). Backends that can pre-map it (io_uring READ_FIXED) return
+  // true; the default ignores it.
+  virtual auto register_buffer(std::span<std::byte> buffer) noexcept -> bool {
+    (void)buffer;
+    return false;
+  }
 
  protected:
   template <class CancelFn>
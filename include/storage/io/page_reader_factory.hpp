@@ -9,6 +9,9 @@
 #if defined(__linux__) && defined(ALAYA_LASER_USE_LIBAIO) && ALAYA_LASER_USE_LIBAIO
   #include "storage/io/backends/libaio_page_reader.hpp"
 #endif
+#if defined(__linux__) && defined(ALAYA_LASER_USE_IO_URING) && ALAYA_LASER_USE_IO_URING
+  #include "storage/io/backends/uring_page_reader.hpp"
+#endif
 #include "storage/io/backends/threadpool_page_reader.hpp"
 #include "storage/io/sync_page_reader.hpp"
 
@@ -32,7 +35,11 @@ enum class PageReaderBackend : std::uint8_t { sync, libaio, threadpool, io_uring
       throw std::runtime_error("libaio PageReader is unavailable on this platform");
 #endif
     case PageReaderBackend::io_uring:
-      throw std::runtime_error("io_uring PageReader is not implemented");
+#if defined(__linux__) && defined(ALAYA_LASER_USE_IO_URING) && ALAYA_LASER_USE_IO_URING
+      return std::make_unique<UringPageReader>(path, options);
+#else
+      throw std::runtime_error("io_uring PageReader is unavailable in this build");
+#endif
     case PageReaderBackend::iocp:
       throw std::runtime_error("IOCP PageReader is not implemented");
   }
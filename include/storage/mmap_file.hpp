@@ -4,6 +4,7 @@
 
 #pragma once
 
+#include <algorithm>
 #include <cerrno>
 #include <cstddef>
 #include <cstdint>
@@ -62,6 +63,22 @@ inline auto errno_to_string(int err) -> std::string {
 
 }  // namespace detail
 
+// Kernel paging hints for a mapping. Advisory only: hosts without madvise
+// (Windows) ignore them, and a rejected hint never fails the caller.
+enum class MMapAccess : std::uint8_t {
+  normal = 0,
+  // Read front to back: aggressive readahead, and pages behind the scan are
+  // cheap to reclaim.
+  sequential = 1,
+  random = 2,
+  // Start asynchronous readahead of the range now.
+  will_need = 3,
+  // Back the range with transparent huge pages where the kernel and
+  // filesystem support it (Linux only; read-only file THP needs
+  // CONFIG_READ_ONLY_THP_FOR_FS).
+  huge_pages = 4,
+};
+
 class MMapFile {
  public:
   MMapFile() = default;
@@ -94,6 +111,40 @@ class MMapFile {
   auto data() const -> const void * { return data_; }
   auto size() const -> size_t { return size_; }
 
+  void advise(MMapAccess access) const noexcept { advise(access, 0, size_); }
+
+  // Hint for [offset, offset + length) only; the range is widened to whole
+  // pages and clipped to the mapping.
+  void advise(MMapAccess access, size_t offset, size_t length) const noexcept {
+#ifndef _WIN32
+    if (data_ == nullptr || offset >= size_ || length == 0) {
+      return;
+    }
+    int advice = MADV_NORMAL;
+    if (access == MMapAccess::sequential) {
+      advice = MADV_SEQUENTIAL;
+    } else if (access == MMapAccess::random) {
+      advice = MADV_RANDOM;
+    } else if (access == MMapAccess::will_need) {
+      advice = MADV_WILLNEED;
+    } else if (access == MMapAccess::huge_pages) {
+  #ifdef MADV_HUGEPAGE
+      advice = MADV_HUGEPAGE;
+  #else
+      return;
+  #endif
+    }
+    const auto page = static_cast<size_t>(::sysconf(_SC_PAGESIZE));
+    const size_t begin = offset / page * page;
+    const size_t end = std::min(size_, offset + std::min(length, size_ - offset));
+    (void)::madvise(static_cast<char *>(data_) + begin, end - begin, advice);
+#else
+    (void)access;
+    (void)offset;
+    (void)length;
+#endif
+  }
+
   template <typename T>
   auto as() const -> const T * {
     if (size_ % sizeof(T) != 0) {
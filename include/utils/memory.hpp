@@ -8,6 +8,7 @@
 #include <limits>
 #include <new>
 #include <type_traits>
+#include <utility>
 #include "platform/detect.hpp"
 #include "utils/math.hpp"
 
@@ -96,6 +97,37 @@ auto operator!=(const AlignedAlloc<T> & /*unused*/, const AlignedAlloc<U> & /*un
   return false;
 }
 
+/**
+ * @brief AlignedAlloc whose value-initialization is a no-op.
+ *
+ * `resize(n)` leaves the new elements untouched until their first writer
+ * faults the pages in, so a parallel loader places each page on the NUMA node
+ * of the thread that fills it. Explicit values (`resize(n, 0)`) still apply.
+ */
+template <typename T>
+class UninitAlignedAlloc : public AlignedAlloc<T> {
+ public:
+  template <class U>
+  struct rebind {  // NOLINT
+    using other = UninitAlignedAlloc<U>;
+  };
+
+  constexpr UninitAlignedAlloc() noexcept = default;
+  constexpr UninitAlignedAlloc(const UninitAlignedAlloc &) noexcept = default;
+
+  template <typename U>
+  constexpr explicit UninitAlignedAlloc(const UninitAlignedAlloc<U> & /*unused*/) noexcept {}
+
+  template <class U>
+  void construct(U *ptr) noexcept(std::is_nothrow_default_constructible_v<U>) {
+    ::new (static_cast<void *>(ptr)) U;
+  }
+  template <class U, class... Args>
+  void construct(U *ptr, Args &&...args) {
+    ::new (static_cast<void *>(ptr)) U(std::forward<Args>(args)...);
+  }
+};
+
 inline auto alloc_2m(size_t nbytes) -> void * {
   auto len = math::round_up_pow2(nbytes, 1 << 21);
   auto p = alaya_aligned_alloc_impl(len, 1 << 21);
@@ -0,0 +1,206 @@
+// SPDX-FileCopyrightText: 2026 AlayaDB.AI
+//
+// SPDX-License-Identifier: AGPL-3.0-only
+
+#pragma once
+
+// Append-only log file behind one descriptor that stays open.
+//
+// Writing through an ofstream and syncing by path costs an open/close pair
+// and a full fsync per durable append. AppendFile keeps the descriptor,
+// writes with pwrite at its own cursor, and syncs with fdatasync. On Linux it
+// also reserves disk blocks past the end of the file in fixed-size extents
+// (fallocate with FALLOC_FL_KEEP_SIZE), so an append lands in blocks that
+// are already allocated and the commit path never allocates. The file size
+// still ends at the last byte written, so readers and torn-tail repair see
+// exactly what they would see without the reservation.
+//
+// Like frame.hpp, this layer depends only on the standard library and
+// `platform/`.
+
+#include <algorithm>
+#include <cerrno>
+#include <cstddef>
+#include <cstdint>
+#include <cstring>
+#include <filesystem>
+#include <span>
+#include <stdexcept>
+#include <string>
+#include <system_error>
+#include <utility>
+
+#ifdef _WIN32
+  #include <fstream>
+#else
+  #include <fcntl.h>
+  #include <unistd.h>
+#endif
+
+#include "platform/fs.hpp"
+
+namespace alaya::wal {
+
+class AppendFile {
+ public:
+  inline static constexpr std::uint64_t kDefaultReserveBytes = std::uint64_t{64} << 20U;
+
+  // Opens `path` (created if missing) for appends at `offset`, which must be
+  // the file's size. `reserve_bytes` == 0 disables the block reservation.
+  AppendFile(std::filesystem::path path,
+             std::uint64_t offset,
+             std::uint64_t reserve_bytes = kDefaultReserveBytes)
+      : path_(std::move(path)), end_(offset), reserved_(offset), reserve_bytes_(reserve_bytes) {
+#ifdef _WIN32
+    if (!std::filesystem::exists(path_)) {
+      std::ofstream create(path_, std::ios::binary);
+    }
+    stream_.open(path_, std::ios::binary | std::ios::in | std::ios::out);
+    if (!stream_) {
+      throw std::runtime_error("AppendFile: cannot open " + path_.string());
+    }
+#else
+    fd_ = ::open(path_.c_str(), O_WRONLY | O_CREAT | O_CLOEXEC, 0644);
+    if (fd_ < 0) {
+      throw error("open");
+    }
+#endif
+  }
+
+  AppendFile(const AppendFile &) = delete;
+  auto operator=(const AppendFile &) -> AppendFile & = delete;
+  AppendFile(AppendFile &&) = delete;
+  auto operator=(AppendFile &&) -> AppendFile & = delete;
+
+  ~AppendFile() {
+#ifndef _WIN32
+    if (fd_ >= 0) {
+      ::close(fd_);
+    }
+#endif
+  }
+
+  [[nodiscard]] auto path() const noexcept -> const std::filesystem::path & { return path_; }
+  // Bytes written so far; the next write() lands here.
+  [[nodiscard]] auto end() const noexcept -> std::uint64_t { return end_; }
+
+  // Hands `bytes` to the OS at end(). Not durable until sync_data(). A
+  // failed write leaves the file ending at end(), as if it was never tried.
+  void write(std::span<const std::byte> bytes) {
+    if (bytes.empty()) {
+      return;
+    }
+    reserve(end_ + bytes.size());
+#ifdef _WIN32
+    stream_.seekp(static_cast<std::streamoff>(end_));
+    stream_.write(reinterpret_cast<const char *>(bytes.data()),
+                  static_cast<std::streamsize>(bytes.size()));
+    stream_.flush();
+    if (!stream_) {
+      stream_.clear();
+      std::error_code ignored;
+      std::filesystem::resize_file(path_, end_, ignored);
+      throw std::runtime_error("AppendFile: cannot write " + path_.string());
+    }
+#else
+    auto offset = static_cast<off_t>(end_);
+    const auto *data = reinterpret_cast<const char *>(bytes.data());
+    auto remaining = bytes.size();
+    while (remaining != 0) {
+      const auto put = ::pwrite(fd_, data, remaining, offset);
+      if (put < 0 && errno == EINTR) {
+        continue;
+      }
+      if (put <= 0) {
+        if (put == 0) {
+          errno = EIO;
+        }
+        auto failure = error("pwrite");
+        // Drop any prefix that did land: a later, shorter write would leave
+        // part of it behind the new end of the log.
+        (void)::ftruncate(fd_, static_cast<off_t>(end_));
+        reserved_ = end_;
+        throw failure;
+      }
+      data += put;
+      offset += put;
+      remaining -= static_cast<std::size_t>(put);
+    }
+#endif
+    end_ += bytes.size();
+  }
+
+  // Asks the kernel to start writing back [offset, end()) without waiting,
+  // so a later sync_data() finds less to flush. A no-op off Linux.
+  void start_writeback(std::uint64_t offset) const noexcept {
+#ifdef __linux__
+    if (offset < end_) {
+      (void)::sync_file_range(fd_,
+                              static_cast<off_t>(offset),
+                              static_cast<off_t>(end_ - offset),
+                              SYNC_FILE_RANGE_WRITE);
+    }
+#else
+    (void)offset;
+#endif
+  }
+
+  // Makes everything written durable, file size included, without flushing
+  // timestamp-only inode updates.
+  void sync_data() {
+#ifdef _WIN32
+    platform::sync_file_or_throw(path_);
+#else
+  #ifdef __APPLE__
+    const int result = ::fsync(fd_);
+  #else
+    const int result = ::fdatasync(fd_);
+  #endif
+    if (result != 0) {
+      throw error("fdatasync");
+    }
+#endif
+  }
+
+ private:
+  [[nodiscard]] auto error(const char *call) const -> std::system_error {
+    return {errno,
+            std::generic_category(),
+            std::string("AppendFile: ") + call + " " + path_.string()};
+  }
+
+  // Keeps at least one reservation extent allocated past `needed`. The
+  // reservation is only an optimization: a filesystem that cannot reserve
+  // stops being asked, and a failed attempt (say, ENOSPC for a whole extent)
+  // leaves the write to allocate as usual.
+  void reserve(std::uint64_t needed) noexcept {
+#ifdef __linux__
+    if (reserve_bytes_ == 0 || needed <= reserved_) {
+      return;
+    }
+    const auto length = std::max(reserve_bytes_, needed - reserved_);
+    if (::fallocate(fd_,
+                    FALLOC_FL_KEEP_SIZE,
+                    static_cast<off_t>(reserved_),
+                    static_cast<off_t>(length)) == 0) {
+      reserved_ += length;
+    } else if (errno == EOPNOTSUPP || errno == ENOSYS || errno == EINVAL) {
+      reserve_bytes_ = 0;
+    }
+#else
+    (void)needed;
+#endif
+  }
+
+  std::filesystem::path path_{};
+  std::uint64_t end_{};
+  std::uint64_t reserved_{};
+  std::uint64_t reserve_bytes_{};
+#ifdef _WIN32
+  std::fstream stream_{};
+#else
+  int fd_{-1};
+#endif
+};
+
+}  // namespace alaya::wal
@@ -0,0 +1,219 @@
+// SPDX-FileCopyrightText: 2026 AlayaDB.AI
+//
+// SPDX-License-Identifier: AGPL-3.0-only
+
+#pragma once
+
+// CRC-32 (IEEE 802.3, reflected polynomial 0xedb88320) kernels for WAL frames.
+//
+// Every kernel updates a pre-inverted register: callers start from 0xffffffff
+// and invert the final value, which is what `crc32()` in frame.hpp does. The
+// kernels differ only in speed, never in output, so frames written by any of
+// them validate under any other:
+//   * bitwise  - the original one-bit-at-a-time loop, kept as the oracle
+//   * slice8   - eight table lookups per 8 bytes
+//   * slice16  - sixteen table lookups per 16 bytes; the portable default
+//   * pclmul   - carry-less multiply folding over 64-byte blocks (x86 only)
+//
+// Table loads assemble words byte by byte, so the slicing kernels produce the
+// same result on big-endian hosts; compilers fold them to one load on x86.
+
+#include <array>
+#include <cstddef>
+#include <cstdint>
+
+#include "platform/detect.hpp"
+#include "simd/cpu_features.hpp"
+
+#ifdef ALAYA_ARCH_X86
+  #include <immintrin.h>
+#endif
+
+namespace alaya::wal {
+
+using Crc32UpdateFn = std::uint32_t (*)(std::uint32_t crc,
+                                        const std::byte *data,
+                                        std::size_t size) noexcept;
+
+namespace crc32_detail {
+
+inline constexpr std::uint32_t kPolynomial = 0xedb88320U;
+inline constexpr std::size_t kSliceTables = 16;
+
+// Table k maps a byte to its CRC contribution k bytes further down the stream.
+constexpr auto make_tables() -> std::array<std::array<std::uint32_t, 256>, kSliceTables> {
+  std::array<std::array<std::uint32_t, 256>, kSliceTables> tables{};
+  for (std::uint32_t value = 0; value < 256; ++value) {
+    std::uint32_t crc = value;
+    for (unsigned bit = 0; bit < 8; ++bit) {
+      crc = (crc >> 1U) ^ ((crc & 1U) != 0 ? kPolynomial : 0U);
+    }
+    tables[0][value] = crc;
+  }
+  for (std::size_t table = 1; table < kSliceTables; ++table) {
+    for (std::size_t value = 0; value < 256; ++value) {
+      const auto previous = tables[table - 1][value];
+      tables[table][value] = (previous >> 8U) ^ tables[0][previous & 0xffU];
+    }
+  }
+  return tables;
+}
+
+inline constexpr auto kTables = make_tables();
+
+[[nodiscard]] inline auto load_u32(const std::byte *data) noexcept -> std::uint32_t {
+  return static_cast<std::uint32_t>(data[0]) | (static_cast<std::uint32_t>(data[1]) << 8U) |
+         (static_cast<std::uint32_t>(data[2]) << 16U) |
+         (static_cast<std::uint32_t>(data[3]) << 24U);
+}
+
+// Looks up the four bytes of `word` in tables first, first-1, ..., first-3.
+[[nodiscard]] inline auto fold_word(std::uint32_t word, std::size_t first) noexcept
+    -> std::uint32_t {
+  return kTables[first][word & 0xffU] ^ kTables[first - 1][(word >> 8U) & 0xffU] ^
+         kTables[first - 2][(word >> 16U) & 0xffU] ^ kTables[first - 3][word >> 24U];
+}
+
+[[nodiscard]] inline auto update_bytes(std::uint32_t crc,
+                                       const std::byte *data,
+                                       std::size_t size) noexcept -> std::uint32_t {
+  for (std::size_t index = 0; index < size; ++index) {
+    crc = (crc >> 8U) ^ kTables[0][(crc ^ static_cast<std::uint32_t>(data[index])) & 0xffU];
+  }
+  return crc;
+}
+
+#ifdef ALAYA_ARCH_X86
+
+ALAYA_TARGET_PCLMUL inline auto load(const std::byte *data) noexcept -> __m128i {
+  return _mm_loadu_si128(reinterpret_cast<const __m128i *>(data));
+}
+
+// Carries a 128-bit lane across the distance encoded by `keys` and adds `next`.
+ALAYA_TARGET_PCLMUL inline auto fold(__m128i lane, __m128i keys, __m128i next) noexcept
+    -> __m128i {
+  const auto low = _mm_clmulepi64_si128(lane, keys, 0x00);
+  const auto high = _mm_clmulepi64_si128(lane, keys, 0x11);
+  return _mm_xor_si128(_mm_xor_si128(high, low), next);
+}
+
+#endif
+
+}  // namespace crc32_detail
+
+[[nodiscard]] inline auto crc32_update_bitwise(std::uint32_t crc,
+                                               const std::byte *data,
+                                               std::size_t size) noexcept -> std::uint32_t {
+  for (std::size_t index = 0; index < size; ++index) {
+    crc ^= static_cast<std::uint32_t>(data[index]);
+    for (unsigned bit = 0; bit < 8; ++bit) {
+      const auto mask = static_cast<std::uint32_t>(-(static_cast<std::int32_t>(crc & 1U)));
+      crc = (crc >> 1U) ^ (crc32_detail::kPolynomial & mask);
+    }
+  }
+  return crc;
+}
+
+[[nodiscard]] inline auto crc32_update_slice8(std::uint32_t crc,
+                                              const std::byte *data,
+                                              std::size_t size) noexcept -> std::uint32_t {
+  using crc32_detail::fold_word;
+  using crc32_detail::load_u32;
+  for (; size >= 8; data += 8, size -= 8) {
+    crc = fold_word(load_u32(data) ^ crc, 7) ^ fold_word(load_u32(data + 4), 3);
+  }
+  return crc32_detail::update_bytes(crc, data, size);
+}
+
+[[nodiscard]] inline auto crc32_update_slice16(std::uint32_t crc,
+                                               const std::byte *data,
+                                               std::size_t size) noexcept -> std::uint32_t {
+  using crc32_detail::fold_word;
+  using crc32_detail::load_u32;
+  for (; size >= 16; data += 16, size -= 16) {
+    crc = fold_word(load_u32(data) ^ crc, 15) ^ fold_word(load_u32(data + 4), 11) ^
+          fold_word(load_u32(data + 8), 7) ^ fold_word(load_u32(data + 12), 3);
+  }
+  return crc32_detail::update_bytes(crc, data, size);
+}
+
+#ifdef ALAYA_ARCH_X86
+
+// Folds four 128-bit lanes across 64-byte blocks with PCLMULQDQ, reduces them
+// to 128 then 32 bits (Barrett), and finishes the sub-16-byte tail with
+// slice16. The constants are x^(k) mod P for the reflected IEEE polynomial, as
+// in Gopal et al., "Fast CRC Computation for Generic Polynomials Using
+// PCLMULQDQ Instruction" (Intel, 2009). Inputs shorter than one block go
+// straight to slice16.
+ALAYA_TARGET_PCLMUL inline auto crc32_update_pclmul(std::uint32_t crc,
+                                                    const std::byte *data,
+                                                    std::size_t size) noexcept
+    -> std::uint32_t {
+  if (size < 64) {
+    return crc32_update_slice16(crc, data, size);
+  }
+  using crc32_detail::fold;
+  using crc32_detail::load;
+  auto x1 = _mm_xor_si128(load(data), _mm_cvtsi32_si128(static_cast<int>(crc)));
+  auto x2 = load(data + 16);
+  auto x3 = load(data + 32);
+  auto x4 = load(data + 48);
+  data += 64;
+  size -= 64;
+
+  const auto k1k2 = _mm_set_epi64x(0x01c6e41596LL, 0x0154442bd4LL);
+  for (; size >= 64; data += 64, size -= 64) {
+    x1 = fold(x1, k1k2, load(data));
+    x2 = fold(x2, k1k2, load(data + 16));
+    x3 = fold(x3, k1k2, load(data + 32));
+    x4 = fold(x4, k1k2, load(data + 48));
+  }
+
+  const auto k3k4 = _mm_set_epi64x(0x00ccaa009eLL, 0x01751997d0LL);
+  x1 = fold(x1, k3k4, x2);
+  x1 = fold(x1, k3k4, x3);
+  x1 = fold(x1, k3k4, x4);
+  for (; size >= 16; data += 16, size -= 16) {
+    x1 = fold(x1, k3k4, load(data));
+  }
+
+  // 128 -> 64 bits.
+  const auto low_mask = _mm_setr_epi32(~0, 0, ~0, 0);
+  x1 = _mm_xor_si128(_mm_srli_si128(x1, 8), _mm_clmulepi64_si128(x1, k3k4, 0x10));
+  const auto k5k0 = _mm_set_epi64x(0, 0x0163cd6124LL);
+  const auto carry = _mm_srli_si128(x1, 4);
+  x1 = _mm_clmulepi64_si128(_mm_and_si128(x1, low_mask), k5k0, 0x00);
+  x1 = _mm_xor_si128(x1, carry);
+
+  // Barrett reduction to 32 bits.
+  const auto poly = _mm_set_epi64x(0x01f7011641LL, 0x01db710641LL);
+  auto reduced = _mm_clmulepi64_si128(_mm_and_si128(x1, low_mask), poly, 0x10);
+  reduced = _mm_clmulepi64_si128(_mm_and_si128(reduced, low_mask), poly, 0x00);
+  x1 = _mm_xor_si128(x1, reduced);
+  crc = static_cast<std::uint32_t>(_mm_extract_epi32(x1, 1));
+
+  return crc32_update_slice16(crc, data, size);
+}
+
+#endif
+
+// Picks the fastest kernel `features` admits.
+[[nodiscard]] inline auto select_crc32_update_func(const simd::CpuFeatures &features) noexcept
+    -> Crc32UpdateFn {
+#ifdef ALAYA_ARCH_X86
+  if (features.pclmul_ && features.sse4_1_) {
+    return crc32_update_pclmul;
+  }
+#else
+  (void)features;
+#endif
+  return crc32_update_slice16;
+}
+
+// The kernel for the running CPU, resolved once per process.
+[[nodiscard]] inline auto get_crc32_update_func() noexcept -> Crc32UpdateFn {
+  static const Crc32UpdateFn kUpdate = select_crc32_update_func(simd::get_cpu_features());
+  return kUpdate;
+}
+
+}  // namespace alaya::wal
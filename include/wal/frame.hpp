@@ -15,9 +15,10 @@
 //
 // Layering: `wal/` sits at the bottom of the stack. It depends only on the
 // standard library plus `platform/` (the filesystem primitives WalFile needs
-// for crash-safe fsync/rename). It must never include `core/`, `space/`,
-// `index/`, or `storage/`. The frame primitives, `Decoder`, and `scan()` are
-// pure `std`; only `WalFile` touches `platform/`.
+// for crash-safe fsync/rename) and the leaf `simd/cpu_features.hpp` that picks
+// the CRC-32 kernel. It must never include `core/`, `space/`, `index/`, or
+// `storage/`. The frame primitives, `Decoder`, and `scan()` are pure `std`
+// apart from the checksum; only `WalFile` touches `platform/fs.hpp`.
 
 #include <algorithm>
 #include <array>
@@ -33,6 +34,7 @@
 #include <vector>
 
 #include "platform/fs.hpp"
+#include "wal/crc32.hpp"
 
 namespace alaya::wal {
 
@@ -90,16 +92,10 @@ inline void put_u64(std::vector<std::byte> &output, std::uint64_t value) {
   return value;
 }
 
+// Standard CRC-32 of `bytes`, computed by the fastest kernel in crc32.hpp that
+// the running CPU supports. Every kernel yields the same value.
 [[nodiscard]] inline auto crc32(std::span<const std::byte> bytes) noexcept -> std::uint32_t {
-  std::uint32_t crc = 0xffffffffU;
-  for (const auto byte : bytes) {
-    crc ^= std::to_integer<std::uint8_t>(byte);
-    for (unsigned bit = 0; bit < 8; ++bit) {
-      const auto mask = static_cast<std::uint32_t>(-(static_cast<std::int32_t>(crc & 1U)));
-      crc = (crc >> 1U) ^ (0xedb88320U & mask);
-    }
-  }
-  return ~crc;
+  return ~get_crc32_update_func()(0xffffffffU, bytes.data(), bytes.size());
 }
 
 // Serialize one frame. `type` is an opaque non-zero record type; the framing
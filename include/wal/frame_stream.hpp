@@ -0,0 +1,349 @@
+// SPDX-FileCopyrightText: 2026 AlayaDB.AI
+//
+// SPDX-License-Identifier: AGPL-3.0-only
+
+#pragma once
+
+// Pipelined, bounded-memory reader over a WAL7 frame file.
+//
+// scan_path() reads the whole file and keeps every payload; visit_frames()
+// holds one frame but reads, checks and hands it over on a single thread.
+// FrameStream keeps a few large blocks in flight instead: a reader thread
+// fills blocks with sequential reads and splits them at frame boundaries,
+// worker threads check the CRC of each block's frames, and next() hands the
+// verified frames out in file order on the caller's thread. Memory is bounded
+// by FrameStreamOptions, never by the file length.
+//
+// The acceptance rules are exactly those of scan(): the first frame whose
+// magic, version, type, lengths, trailer or CRC is wrong (or which is cut off
+// by the end of the file) ends the stream and marks a torn/corrupt tail.
+// Nothing past the damage is ever handed out.
+
+#include <algorithm>
+#include <array>
+#include <condition_variable>
+#include <cstddef>
+#include <cstdint>
+#include <deque>
+#include <exception>
+#include <filesystem>
+#include <fstream>
+#include <memory>
+#include <mutex>
+#include <optional>
+#include <span>
+#include <stdexcept>
+#include <thread>
+#include <utility>
+#include <vector>
+
+#include "wal/frame.hpp"
+
+namespace alaya::wal {
+
+// One verified frame handed out by FrameStream. `payload` points into the
+// stream's read buffer and stays valid until the next call to next().
+struct FrameView {
+  std::uint8_t type{};
+  std::uint8_t flags{};
+  std::uint64_t op_id{};
+  std::uint64_t batch_id{};
+  std::span<const std::byte> payload{};
+  std::uint64_t offset{};
+  std::uint64_t size{};
+};
+
+struct FrameStreamOptions {
+  // Bytes per sequential read. A frame longer than this gets a block of its
+  // own, so the bound below grows to kMaximumPayloadBytes at worst.
+  std::size_t block_bytes = std::size_t{8} << 20U;
+  // Blocks read ahead of the consumer. Peak memory is about
+  // (blocks_ahead + 1) * block_bytes.
+  std::size_t blocks_ahead = 4;
+  // CRC workers; 0 picks min(blocks_ahead, hardware_concurrency()).
+  std::size_t verify_threads = 0;
+};
+
+// CRC-32 of a complete frame as make_frame() computes it, with the checksum
+// field read as zero, without copying the frame.
+[[nodiscard]] inline auto frame_checksum(std::span<const std::byte> frame) noexcept
+    -> std::uint32_t {
+  static constexpr std::array<std::byte, 4> kZero{};
+  const auto update = get_crc32_update_func();
+  auto crc = update(0xffffffffU, frame.data(), kChecksumOffset);
+  crc = update(crc, kZero.data(), kZero.size());
+  const auto rest = kChecksumOffset + kZero.size();
+  return ~update(crc, frame.data() + rest, frame.size() - rest);
+}
+
+class FrameStream {
+ public:
+  explicit FrameStream(std::filesystem::path path, FrameStreamOptions options = {})
+      : path_(std::move(path)), options_(options) {
+    options_.block_bytes = std::max<std::size_t>(options_.block_bytes, kHeaderBytes);
+    options_.blocks_ahead = std::max<std::size_t>(options_.blocks_ahead, 1);
+    if (!std::filesystem::exists(path_)) {
+      finished_ = true;
+      return;
+    }
+    input_.open(path_, std::ios::binary);
+    if (!input_) {
+      throw std::runtime_error("FrameStream: cannot read " + path_.string());
+    }
+    const std::size_t workers =
+        options_.verify_threads != 0
+            ? options_.verify_threads
+            : std::min<std::size_t>(options_.blocks_ahead,
+                                    std::max(1U, std::thread::hardware_concurrency()));
+    try {
+      reader_ = std::thread([this] { read_blocks(); });
+      for (std::size_t worker = 0; worker < workers; ++worker) {
+        verifiers_.emplace_back([this] { verify_blocks(); });
+      }
+    } catch (...) {
+      stop_threads();
+      throw;
+    }
+  }
+
+  FrameStream(const FrameStream &) = delete;
+  auto operator=(const FrameStream &) -> FrameStream & = delete;
+  FrameStream(FrameStream &&) = delete;
+  auto operator=(FrameStream &&) -> FrameStream & = delete;
+
+  ~FrameStream() { stop_threads(); }
+
+  // The next verified frame in file order, or nullopt once the verified
+  // prefix is exhausted. Rethrows a read error from the reader thread.
+  [[nodiscard]] auto next() -> std::optional<FrameView> {
+    for (;;) {
+      if (current_ != nullptr && index_ < current_->verified) {
+        const auto start = current_->starts[index_];
+        const auto end =
+            index_ + 1 < current_->starts.size() ? current_->starts[index_ + 1] : current_->framed;
+        ++index_;
+        const auto frame = std::span<const std::byte>(current_->bytes).subspan(start, end - start);
+        FrameView view;
+        view.type = std::to_integer<std::uint8_t>(frame[6]);
+        view.flags = std::to_integer<std::uint8_t>(frame[7]);
+        view.op_id = get_u64(frame, 16);
+        view.batch_id = get_u64(frame, 24);
+        view.payload = frame.subspan(kHeaderBytes, frame.size() - kHeaderBytes - kTrailerBytes);
+        view.offset = current_->offset + start;
+        view.size = frame.size();
+        valid_bytes_ = view.offset + view.size;
+        return view;
+      }
+      if (finished_) {
+        return std::nullopt;
+      }
+      if (current_ != nullptr &&
+          (current_->verified < current_->starts.size() || current_->last)) {
+        torn_ = current_->verified < current_->starts.size() || current_->torn;
+        finish();
+        return std::nullopt;
+      }
+      std::unique_lock lock(mutex_);
+      current_.reset();
+      index_ = 0;
+      changed_.wait(lock, [&] {
+        return error_ != nullptr || (!ready_.empty() && ready_.front()->checked);
+      });
+      if (error_ != nullptr) {
+        lock.unlock();
+        finish();
+        std::rethrow_exception(error_);
+      }
+      current_ = std::move(ready_.front());
+      ready_.pop_front();
+      changed_.notify_all();
+    }
+  }
+
+  // Meaningful once next() has returned nullopt: the end of the last
+  // verified frame, and whether anything followed it.
+  [[nodiscard]] auto valid_bytes() const noexcept -> std::uint64_t { return valid_bytes_; }
+  [[nodiscard]] auto stopped_at_corrupt_or_torn_tail() const noexcept -> bool { return torn_; }
+
+ private:
+  struct Block {
+    std::vector<std::byte> bytes{};
+    std::vector<std::size_t> starts{};  // frame offsets within `bytes`
+    std::size_t framed{};               // end of the last frame
+    std::uint64_t offset{};             // file offset of bytes[0]
+    std::size_t verified{};             // leading frames whose CRC matched
+    bool checked{};
+    bool last{};  // the reader stopped after this block
+    bool torn{};  // ... because of damage or a partial trailing frame
+  };
+
+  // Splits `block.bytes` into complete, structurally valid frames and returns
+  // where the last of them ends. Sets `torn` on structural damage.
+  [[nodiscard]] static auto split(Block &block, bool &torn) -> std::size_t {
+    const auto bytes = std::span<const std::byte>(block.bytes);
+    std::size_t position{};
+    while (bytes.size() - position >= kHeaderBytes) {
+      const auto input = bytes.subspan(position);
+      const auto frame_bytes = get_u32(input, 8);
+      const auto payload_bytes = get_u32(input, 12);
+      if (get_u32(input, 0) != kFrameMagic || get_u16(input, 4) != kFormatVersion ||
+          std::to_integer<std::uint8_t>(input[6]) == 0 || payload_bytes > kMaximumPayloadBytes ||
+          frame_bytes != kHeaderBytes + payload_bytes + kTrailerBytes) {
+        torn = true;
+        break;
+      }
+      if (frame_bytes > input.size()) {
+        break;
+      }
+      if (get_u32(input, frame_bytes - 4) != kTrailerMagic) {
+        torn = true;
+        break;
+      }
+      block.starts.push_back(position);
+      position += frame_bytes;
+    }
+    block.framed = position;
+    return position;
+  }
+
+  void read_blocks() {
+    try {
+      std::vector<std::byte> carry;
+      std::uint64_t offset{};
+      for (;;) {
+        {
+          std::unique_lock lock(mutex_);
+          changed_.wait(lock, [&] { return stop_ || ready_.size() < options_.blocks_ahead; });
+          if (stop_) {
+            return;
+          }
+        }
+        auto block = std::make_shared<Block>();
+        block->offset = offset;
+        block->bytes = std::move(carry);
+        carry.clear();
+        auto want = options_.block_bytes;
+        if (block->bytes.size() >= kHeaderBytes) {
+          // A frame longer than one block is read whole in one go.
+          want = std::max<std::size_t>(want, get_u32(block->bytes, 8));
+        }
+        const auto have = block->bytes.size();
+        block->bytes.resize(std::max(want, have));
+        input_.read(reinterpret_cast<char *>(block->bytes.data() + have),
+                    static_cast<std::streamsize>(block->bytes.size() - have));
+        const auto got = static_cast<std::size_t>(input_.gcount());
+        if (input_.bad()) {
+          throw std::runtime_error("FrameStream: cannot read " + path_.string());
+        }
+        const bool end_of_file = have + got < block->bytes.size();
+        block->bytes.resize(have + got);
+
+        bool torn = false;
+        const auto framed = split(*block, torn);
+        if (!torn && end_of_file && framed != block->bytes.size()) {
+          torn = true;  // a partial frame at the end of the file
+        }
+        block->last = torn || end_of_file;
+        block->torn = torn;
+        if (!block->last) {
+          carry.assign(block->bytes.begin() + static_cast<std::ptrdiff_t>(framed),
+                       block->bytes.end());
+        }
+        block->bytes.resize(framed);
+        offset += framed;
+        if (block->starts.empty() && !block->last) {
+          continue;
+        }
+        {
+          std::lock_guard lock(mutex_);
+          ready_.push_back(block);
+          unchecked_.push_back(std::move(block));
+          changed_.notify_all();
+        }
+        if (torn || end_of_file) {
+          return;
+        }
+      }
+    } catch (...) {
+      std::lock_guard lock(mutex_);
+      error_ = std::current_exception();
+      changed_.notify_all();
+    }
+  }
+
+  void verify_blocks() {
+    for (;;) {
+      std::shared_ptr<Block> block;
+      {
+        std::unique_lock lock(mutex_);
+        changed_.wait(lock, [&] { return stop_ || !unchecked_.empty(); });
+        if (stop_) {
+          return;
+        }
+        block = std::move(unchecked_.front());
+        unchecked_.pop_front();
+      }
+      const auto bytes = std::span<const std::byte>(block->bytes);
+      std::size_t verified{};
+      for (; verified < block->starts.size(); ++verified) {
+        const auto start = block->starts[verified];
+        const auto end = verified + 1 < block->starts.size() ? block->starts[verified + 1]
+                                                             : block->framed;
+        const auto frame = bytes.subspan(start, end - start);
+        if (frame_checksum(frame) != get_u32(frame, kChecksumOffset)) {
+          break;
+        }
+      }
+      std::lock_guard lock(mutex_);
+      block->verified = verified;
+      block->checked = true;
+      changed_.notify_all();
+    }
+  }
+
+  // Ends the stream early: the reader and workers have nothing left to do.
+  void finish() {
+    finished_ = true;
+    current_.reset();
+    stop_threads();
+  }
+
+  void stop_threads() {
+    {
+      std::lock_guard lock(mutex_);
+      stop_ = true;
+      changed_.notify_all();
+    }
+    if (reader_.joinable()) {
+      reader_.join();
+    }
+    for (auto &verifier : verifiers_) {
+      if (verifier.joinable()) {
+        verifier.join();
+      }
+    }
+    verifiers_.clear();
+    ready_.clear();
+    unchecked_.clear();
+  }
+
+  std::filesystem::path path_{};
+  FrameStreamOptions options_{};
+  std::ifstream input_{};
+  std::thread reader_{};
+  std::vector<std::thread> verifiers_{};
+  std::mutex mutex_{};
+  std::condition_variable changed_{};
+  std::deque<std::shared_ptr<Block>> ready_{};      // in file order, for next()
+  std::deque<std::shared_ptr<Block>> unchecked_{};  // awaiting a CRC worker
+  std::exception_ptr error_{};
+  bool stop_{};
+  // Consumer-side state, touched only by next().
+  std::shared_ptr<Block> current_{};
+  std::size_t index_{};
+  std::uint64_t valid_bytes_{};
+  bool torn_{};
+  bool finished_{};
+};
+
+}  // namespace alaya::wal
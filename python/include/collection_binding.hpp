@@ -638,6 +638,16 @@ struct PyCompactResponse {
   std::uint64_t manifest_generation{};
 };
 
+struct PyRebuildResponse {
+  std::vector<std::uint64_t> source_segment_ids{};
+  std::uint64_t rebuilt_segment_id{};
+  std::uint64_t successor_segment_id{};
+  std::uint64_t wal_cut{};
+  core::RowCount rebuilt_rows{};
+  std::uint64_t rebuilt_bytes{};
+  std::uint64_t manifest_generation{};
+};
+
 struct PyGcResponse {
   core::RowCount pending{};
   core::RowCount reclaimed{};
@@ -944,6 +954,12 @@ class PyCollection {
   [[nodiscard]] auto checkpoint() -> PyCheckpointResponse;
   [[nodiscard]] auto seal() -> PySealResponse;
   [[nodiscard]] auto compact() -> PyCompactResponse;
+  [[nodiscard]] auto rebuild(const std::optional<std::string> &index_type,
+                             const std::optional<std::string> &quantization_type,
+                             std::optional<std::uint32_t> build_threads,
+                             std::optional<std::uint32_t> max_neighbors,
+                             std::optional<std::uint32_t> ef_construction)
+      -> PyRebuildResponse;
   [[nodiscard]] auto gc() -> PyGcResponse;
   [[nodiscard]] auto stats() const -> PyStatsResponse;
   [[nodiscard]] auto options() const -> PyOptionsResponse;
@@ -194,6 +194,23 @@ class _CompactResponse(metaclass=type):
     @property
     def manifest_generation(self) -> int: ...
 
+class _RebuildResponse(metaclass=type):
+    def __init__(self, *args: object, **kwargs: object) -> None: ...
+    @property
+    def source_segment_ids(self) -> list[int]: ...
+    @property
+    def rebuilt_segment_id(self) -> int: ...
+    @property
+    def successor_segment_id(self) -> int: ...
+    @property
+    def wal_cut(self) -> int: ...
+    @property
+    def rebuilt_rows(self) -> int: ...
+    @property
+    def rebuilt_bytes(self) -> int: ...
+    @property
+    def manifest_generation(self) -> int: ...
+
 class _GcResponse(metaclass=type):
     def __init__(self, *args: object, **kwargs: object) -> None: ...
     @property
@@ -368,6 +385,14 @@ class _Collection(metaclass=type):
     def checkpoint(self) -> _CheckpointResponse: ...
     def seal(self) -> _SealResponse: ...
     def compact(self) -> _CompactResponse: ...
+    def rebuild(
+        self,
+        index_type: str | None = None,
+        quantization_type: str | None = None,
+        build_threads: int | None = None,
+        max_neighbors: int | None = None,
+        ef_construction: int | None = None,
+    ) -> _RebuildResponse: ...
     def gc(self) -> _GcResponse: ...
     def stats(self) -> _StatsResponse: ...
     def options(self) -> _OptionsResponse: ...
@@ -8,10 +8,8 @@ from __future__ import annotations
 
 import math
 import os
-import shutil
 import sys
 import threading
-import uuid
 import warnings
 import weakref
 from collections.abc import Mapping, Sequence
@@ -60,7 +58,6 @@ from .exceptions import (
     CollectionClosedError,
     CollectionInternalError,
     CollectionInvalidArgumentError,
-    CollectionIoError,
     CollectionNotSupportedError,
     _status_error,
 )
@@ -658,7 +655,7 @@ class Collection:
         return _garbage_collection_receipt(self._require_writable().gc())
 
     def rebuild_index(self, *, index: IndexConfig | None = None) -> CheckpointReceipt:
-        """Rebuild all live rows into an atomically swapped index owner.
+        """Rebuild all live rows into one sealed segment of the target index.
 
         Parameters
         ----------
@@ -669,13 +666,15 @@ class Collection:
         Returns
         -------
         CheckpointReceipt
-            Durable checkpoint receipt from the replacement owner.
+            Durable checkpoint receipt taken after the rebuilt segment is
+            routed.
 
         Notes
         -----
-        The current binding has no native rebuild primitive. This method uses
-        a same-filesystem staging directory, closes the old native owner, and
-        atomically swaps directories before reopening the handle.
+        The native owner rebuilds from its pinned snapshot and swaps the
+        result in atomically. Reads and writes on other threads keep being
+        served throughout; replaced segments are left for
+        :meth:`collect_garbage`.
         """
         with self._lock:
             current = self._require_writable()
@@ -684,8 +683,7 @@ class Collection:
                 raise TypeError("index must be FlatIndexConfig, QGIndexConfig, or None")
             replacement_config = replace(self._config, index=target)
             validate_creation_config(replacement_config)
-            records = current.records()
-            if isinstance(target, QGIndexConfig) and len(records) <= 32:
+            if isinstance(target, QGIndexConfig) and current.stats().size <= 32:
                 raise _status_error(
                     CollectionInvalidArgumentError,
                     "QG rebuild requires more than 32 live rows; Flat fallback is disabled",
@@ -693,7 +691,20 @@ class Collection:
                     operation_stage=4,
                     status_detail=1,
                 )
-            return self._rebuild(current, records, replacement_config)
+            if isinstance(target, QGIndexConfig):
+                current.rebuild(
+                    index_type=target.kind,
+                    quantization_type="rabitq",
+                    build_threads=target.build_threads or 1,
+                    max_neighbors=target.max_neighbors,
+                    ef_construction=target.construction_effort,
+                )
+            else:
+                current.rebuild(index_type=target.kind, quantization_type="none")
+            write_collection_schema(self._path, replacement_config)
+            self._config = replacement_config
+            self._legacy_quantization = None
+            return _checkpoint_receipt(current.checkpoint())
 
     def stats(self) -> CollectionStats:
         """Return typed collection accounting and lifecycle statistics."""
@@ -824,90 +835,6 @@ class Collection:
             )
         return native
 
-    def _rebuild(
-        self,
-        current: _NativeCollection,
-        records: list[_RecordResponse],
-        config: CollectionConfig,
-    ) -> CheckpointReceipt:
-        """Stage, atomically swap, and reopen a replacement native owner."""
-        suffix = uuid.uuid4().hex
-        staging = self._path.parent / f".{self._path.name}.rebuild-{suffix}"
-        backup = self._path.parent / f".{self._path.name}.backup-{suffix}"
-        failed = self._path.parent / f".{self._path.name}.failed-{suffix}"
-        replacement: _NativeCollection | None = None
-        current_closed = False
-        try:
-            replacement = create_native_collection(staging, config)
-            if records:
-                ids, documents, vectors, metadata = _record_columns(records, config)
-                response = replacement.mutate(
-                    ids,
-                    documents,
-                    vectors,
-                    metadata,
-                    "add",
-                    mode="all_or_nothing",
-                    durability="wal_fsync",
-                    retry_token="",
-                )
-                if any(_row_status(row.row_status) is not RowStatus.INSERTED for row in response.rows):
-                    raise _status_error(
-                        CollectionInternalError,
-                        "replacement owner rejected exported live rows",
-                        status_code=11,
-                        operation_stage=4,
-                        status_detail=1,
-                    )
-                replacement.seal()
-            checkpoint = _checkpoint_receipt(replacement.checkpoint())
-            write_collection_schema(staging, config)
-            replacement.close()
-            replacement = None
-
-            current.close()
-            current_closed = True
-            self._native = None
-            os.replace(self._path, backup)
-            try:
-                os.replace(staging, self._path)
-            except OSError:
-                os.replace(backup, self._path)
-                self._native = _NativeCollection.open(os.fspath(self._path), False)
-                current_closed = False
-                raise
-            try:
-                reopened = _NativeCollection.open(os.fspath(self._path), False)
-            except Exception:
-                os.replace(self._path, failed)
-                os.replace(backup, self._path)
-                self._native = _NativeCollection.open(os.fspath(self._path), False)
-                current_closed = False
-                shutil.rmtree(failed, ignore_errors=True)
-                raise
-            self._native = reopened
-            self._config = config
-            self._legacy_quantization = None
-            current_closed = False
-            shutil.rmtree(backup)
-            return checkpoint
-        except OSError as error:
-            if current_closed and self._native is None and self._path.exists():
-                self._native = _NativeCollection.open(os.fspath(self._path), False)
-            raise _status_error(
-                CollectionIoError,
-                f"index rebuild filesystem operation failed: {error}",
-                status_code=8,
-                operation_stage=4,
-            ) from error
-        finally:
-            if replacement is not None:
-                try:
-                    replacement.close()
-                except RuntimeError:
-                    pass
-            shutil.rmtree(staging, ignore_errors=True)
-
 
 def _write_array(vectors: VectorInput, rows: int, config: CollectionConfig) -> npt.NDArray[np.generic]:
     """Normalize and validate a two-dimensional write matrix."""
@@ -1165,35 +1092,4 @@ def _collection_stats(response: _StatsResponse) -> CollectionStats:
     )
 
 
-def _record_columns(
-    records: list[_RecordResponse],
-    config: CollectionConfig,
-) -> tuple[
-    list[str],
-    list[str],
-    npt.NDArray[np.generic],
-    list[dict[str, MetadataScalar] | None],
-]:
-    """Convert exported native records into replacement mutation columns."""
-    ids: list[str] = []
-    documents: list[str] = []
-    metadata: list[dict[str, MetadataScalar] | None] = []
-    vectors: list[npt.NDArray[np.generic]] = []
-    for record in records:
-        if record.vector is None:
-            raise _status_error(
-                CollectionInternalError,
-                "native record export omitted a vector required for rebuild",
-                status_code=11,
-                operation_stage=12,
-                status_detail=1,
-            )
-        ids.append(str(record.id))
-        documents.append(record.document)
-        metadata.append(dict(record.metadata))
-        vectors.append(np.asarray(record.vector))
-    array = np.ascontiguousarray(np.stack(vectors), dtype=np.dtype(config.dtype))
-    return ids, documents, array, metadata
-
-
 __all__ = ["Collection"]
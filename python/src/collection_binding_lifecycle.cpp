@@ -27,6 +27,13 @@ void register_collection_management(PyCollectionClass &collection) {
   collection.def("checkpoint", &PyCollection::checkpoint)
       .def("seal", &PyCollection::seal)
       .def("compact", &PyCollection::compact)
+      .def("rebuild",
+           &PyCollection::rebuild,
+           py::arg("index_type") = py::none(),
+           py::arg("quantization_type") = py::none(),
+           py::arg("build_threads") = py::none(),
+           py::arg("max_neighbors") = py::none(),
+           py::arg("ef_construction") = py::none())
       .def("gc", &PyCollection::gc)
       .def("stats", &PyCollection::stats)
       .def("options", &PyCollection::options)
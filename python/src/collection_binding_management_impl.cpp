@@ -44,6 +44,35 @@ namespace alaya::python::collection_binding {
           receipt.manifest_generation};
 }
 
+[[nodiscard]] auto PyCollection::rebuild(const std::optional<std::string> &index_type,
+                                         const std::optional<std::string> &quantization_type,
+                                         std::optional<std::uint32_t> build_threads,
+                                         std::optional<std::uint32_t> max_neighbors,
+                                         std::optional<std::uint32_t> ef_construction)
+    -> PyRebuildResponse {
+  CollectionRebuildOptions options;
+  if (index_type.has_value()) {
+    options.target_algorithm = algorithm(*index_type);
+  }
+  if (quantization_type.has_value()) {
+    options.quantization = quantization(*quantization_type);
+  }
+  options.build_threads = build_threads;
+  options.max_neighbors = max_neighbors;
+  options.ef_construction = ef_construction;
+  const auto receipt = [&] {
+    py::gil_scoped_release release;
+    return unwrap(collection_->rebuild(options));
+  }();
+  return {receipt.source_segment_ids,
+          receipt.rebuilt_segment_id,
+          receipt.successor_segment_id,
+          receipt.wal_cut,
+          receipt.rebuilt_rows,
+          receipt.rebuilt_bytes,
+          receipt.manifest_generation};
+}
+
 [[nodiscard]] auto PyCollection::gc() -> PyGcResponse {
   const auto receipt = [&] {
     py::gil_scoped_release release;
@@ -84,6 +84,15 @@ void register_response_types(py::module_ &module) {
       .def_readonly("output_bytes", &PyCompactResponse::output_bytes)
       .def_readonly("manifest_generation", &PyCompactResponse::manifest_generation);
 
+  py::class_<PyRebuildResponse>(module, "_RebuildResponse")
+      .def_readonly("source_segment_ids", &PyRebuildResponse::source_segment_ids)
+      .def_readonly("rebuilt_segment_id", &PyRebuildResponse::rebuilt_segment_id)
+      .def_readonly("successor_segment_id", &PyRebuildResponse::successor_segment_id)
+      .def_readonly("wal_cut", &PyRebuildResponse::wal_cut)
+      .def_readonly("rebuilt_rows", &PyRebuildResponse::rebuilt_rows)
+      .def_readonly("rebuilt_bytes", &PyRebuildResponse::rebuilt_bytes)
+      .def_readonly("manifest_generation", &PyRebuildResponse::manifest_generation);
+
   py::class_<PyGcResponse>(module, "_GcResponse")
       .def_readonly("pending", &PyGcResponse::pending)
       .def_readonly("reclaimed", &PyGcResponse::reclaimed)
@@ -105,6 +105,8 @@ namespace alaya {
         }
         auto state = std::move(loaded_state).value();
         options.value().auto_seal_rows = state.auto_seal_rows;
+        options.value().maintenance = open_options.maintenance;
+        options.value().manifest_reader = open_options.manifest_reader;
         auto status = validate_options(options.value(), core::OperationStage::open);
         if (!status.ok()) {
           return status;
@@ -149,6 +151,8 @@ namespace alaya {
       }
       internal::collection::CollectionControlState state;
       state.auto_seal_rows = options.value().auto_seal_rows;
+      options.value().maintenance = open_options.maintenance;
+      options.value().manifest_reader = open_options.manifest_reader;
       auto opened = open_segmented(options.value(), state, false);
       if (!opened.ok()) {
         return opened.status();
@@ -244,6 +248,7 @@ namespace alaya {
   request.rows = native_rows;
   request.mode = mode;
   request.options = std::move(options);
+  await_admission();
   core::MutationContext context;
   auto receipt = implementation_->mutate_batch(request, context);
   if (receipt.ok()) {
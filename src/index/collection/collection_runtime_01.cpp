@@ -194,7 +194,7 @@ namespace alaya {
     return writable;
   }
   std::lock_guard lock(control_mutex_);
-  return prepare_successor_locked(context, options);
+  return prepare_successor_locked(context, options, SuccessorPlan{});
 }
 
 [[nodiscard]] auto Collection::rotate_to_successor(const CollectionRotationHandle &handle)
@@ -227,6 +227,46 @@ namespace alaya {
   return compact_locked(context);
 }
 
+[[nodiscard]] auto Collection::relayout(CollectionRelayoutOptions options)
+    -> core::Result<CollectionRelayoutReceipt> {
+  core::SealContext context;
+  return relayout(context, options);
+}
+
+[[nodiscard]] auto Collection::relayout(core::SealContext &context,
+                                        CollectionRelayoutOptions options)
+    -> core::Result<CollectionRelayoutReceipt> {
+  if (const auto writable = ensure_writable(core::OperationStage::build); !writable.ok()) {
+    return writable;
+  }
+  std::lock_guard lock(control_mutex_);
+  return relayout_locked(context, options);
+}
+
+[[nodiscard]] auto Collection::rebuild(CollectionRebuildOptions options)
+    -> core::Result<CollectionRebuildReceipt> {
+  core::SealContext context;
+  return rebuild(context, std::move(options));
+}
+
+[[nodiscard]] auto Collection::rebuild(core::SealContext &context,
+                                       CollectionRebuildOptions options)
+    -> core::Result<CollectionRebuildReceipt> {
+  if (const auto writable = ensure_writable(core::OperationStage::build); !writable.ok()) {
+    return writable;
+  }
+  std::lock_guard lock(control_mutex_);
+  return rebuild_locked(context, options);
+}
+
+[[nodiscard]] auto Collection::wait_for_maintenance() -> core::Status {
+  if (maintenance_ == nullptr) {
+    return core::Status::success();
+  }
+  maintenance_->wait_idle();
+  return maintenance_->take_failure();
+}
+
 [[nodiscard]] auto Collection::gc() -> core::Result<CollectionGcReceipt> {
   if (const auto writable = ensure_writable(core::OperationStage::save); !writable.ok()) {
     return writable;
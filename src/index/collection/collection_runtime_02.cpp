@@ -23,6 +23,9 @@ namespace alaya {
   result.durable_watermark = native.durable_watermark;
   result.metadata_epoch = native.metadata_epoch;
   result.lifecycle = native.lifecycle;
+  result.recovery_replayed_transactions = native.recovery_replayed_transactions;
+  result.recovery_replayed_rows = native.recovery_replayed_rows;
+  result.recovery_replay_nanoseconds = native.recovery_replay_nanoseconds;
   std::uint64_t row_bytes{};
   if (core::checked_multiply(options_.dim,
                              core::scalar_type_size(options_.scalar_type),
@@ -40,6 +43,15 @@ namespace alaya {
   result.searchable_bytes = result.searchable_vector_bytes;
   result.accepted_bytes = result.accepted_vector_bytes;
   result.active_segment_algorithm = core::algorithm::flat;
+  result.admission_waits = admission_waits_.load(std::memory_order_relaxed);
+  result.background_seals = background_seals_.load(std::memory_order_relaxed);
+  if (maintenance_ != nullptr) {
+    for (const auto task : {internal::collection::MaintenanceTask::seal,
+                            internal::collection::MaintenanceTask::compact,
+                            internal::collection::MaintenanceTask::gc}) {
+      result.background_failures += maintenance_->counters(task).failed;
+    }
+  }
   {
     std::lock_guard lock(control_mutex_);
     result.compacted_bytes = control_state_.compacted_bytes;
@@ -69,6 +81,10 @@ namespace alaya {
 }
 
 [[nodiscard]] auto Collection::close() -> core::Status {
+  // Outside control_mutex_: a running background seal holds it.
+  if (maintenance_ != nullptr) {
+    maintenance_->stop();
+  }
   std::lock_guard lock(control_mutex_);
   auto status = implementation_->close();
   if (!status.ok()) {
@@ -25,10 +25,33 @@ namespace alaya {
                                                 options.scalar_type,
                                                 options.max_logical_id_bytes};
   std::vector<internal::collection::SegmentRegistration> registrations;
+  auto reader_options = options.manifest_reader;
+  reader_options.persist_verified_digests = reader_options.persist_verified_digests && !read_only;
   auto manifest = internal::collection::load_manifest_v2_if_present(options.root);
   if (!manifest.ok()) {
     return manifest.status();
   }
+  // LASER-backed entries verify the manifest's artifacts when they open;
+  // flat entries read their native artifacts directly.
+  const auto verifies_artifacts = [](const internal::collection::SegmentEntryV2 &entry) {
+    return entry.lifecycle != internal::collection::SegmentLifecycleV2::retired &&
+           entry.lifecycle != internal::collection::SegmentLifecycleV2::gc_pending &&
+           entry.factory_key != "flat";
+  };
+  std::shared_ptr<internal::collection::ArtifactVerificationTask> verification;
+  if (manifest.value().has_value() && reader_options.verify_artifacts &&
+      std::ranges::any_of(manifest.value()->segments, verifies_artifacts)) {
+    // Hash every artifact once here instead of once per segment open below.
+    // A background verdict stays with the SegmentedCollection, whose searches
+    // wait for it.
+    auto verified = internal::collection::CollectionManifestDualReader::open(options.root,
+                                                                             reader_options);
+    if (!verified.ok()) {
+      return verified.status();
+    }
+    verification = std::move(verified).value().verification;
+    reader_options.verify_artifacts = false;
+  }
   if (manifest.value().has_value()) {
     for (const auto &entry : manifest.value()->segments) {
       if (entry.lifecycle == internal::collection::SegmentLifecycleV2::retired ||
@@ -36,10 +59,8 @@ namespace alaya {
         continue;
       }
       core::OpenContext context;
-      auto erased = internal::collection::detail::CollectionSegmentFactory::open_entry(options.root,
-                                                                                       entry,
-                                                                                       schema,
-                                                                                       context);
+      auto erased = internal::collection::detail::CollectionSegmentFactory::open_entry(
+          options.root, entry, schema, context, reader_options);
       if (!erased.ok()) {
         return erased.status();
       }
@@ -87,6 +108,7 @@ namespace alaya {
   config.features.manifest_v2_writer = true;
   config.wal.root = options.root;
   config.read_only = read_only;
+  config.artifact_verification = std::move(verification);
   registrations.push_back(std::move(active).value());
   return internal::collection::SegmentedCollection::open(schema,
                                                          std::move(registrations),
@@ -112,7 +134,8 @@ void Collection::fire_seal_failpoint(const CollectionSealOptions &options,
     const internal::collection::RoutingSnapshot &snapshot,
     std::span<const internal::collection::RowAddress> sources,
     std::uint64_t target_segment_id,
-    std::uint64_t target_generation) -> core::Result<ReplacementBuildData> {
+    std::uint64_t target_generation,
+    bool keep_row_ids) -> core::Result<ReplacementBuildData> {
   ReplacementBuildData result;
   std::uint64_t next_row{};
   for (const auto state :
@@ -121,9 +144,12 @@ void Collection::fire_seal_failpoint(const CollectionSealOptions &options,
       if (version.state != state || !address_is_source(version.address, sources)) {
         continue;
       }
-      internal::collection::RowAddress target{target_segment_id,
-                                              target_generation,
-                                              core::SegmentRowId(next_row++)};
+      // A relayout keeps each row at its source row id; other targets
+      // renumber densely.
+      internal::collection::RowAddress target{
+          target_segment_id,
+          target_generation,
+          keep_row_ids ? version.address.row_id : core::SegmentRowId(next_row++)};
       result.replacements.push_back({logical_id, version.address, target, version.upsert_sequence});
       result.rows.push_back(
           {logical_id, target.row_id, version.upsert_sequence, version.state, version.payload});
@@ -57,7 +57,9 @@ namespace alaya {
     }
     internal::collection::CollectionControlStore::remove_replacements(root, state.mapping_file);
     state.mapping_file.clear();
-    state.phase = state.operation == internal::collection::CollectionControlOperation::seal
+    state.phase = state.operation == internal::collection::CollectionControlOperation::seal ||
+                          state.operation ==
+                              internal::collection::CollectionControlOperation::rebuild
                       ? internal::collection::CollectionControlPhase::successor_active
                       : internal::collection::CollectionControlPhase::idle;
     if (state.phase == internal::collection::CollectionControlPhase::idle) {
@@ -91,12 +93,11 @@ namespace alaya {
     if (auto entry = pinned->find_segment(source.segment_id, source.generation)) {
       const auto source_name =
           internal::collection::detail::collection_segment_name(source.segment_id);
-      pending_gc_.push_back(
-          {source_name,
-           control_state_.operation == internal::collection::CollectionControlOperation::compact
-               ? options_.root / "segments" / source_name
-               : std::filesystem::path{},
-           entry});
+      pending_gc_.push_back({source_name,
+                             entry->role == internal::collection::SegmentRole::sealed
+                                 ? options_.root / "segments" / source_name
+                                 : std::filesystem::path{},
+                             entry});
     }
   }
   status = implementation_->resume_segment_replacement(control_state_.sources,
@@ -147,7 +148,7 @@ namespace alaya {
   if (auto gate = implementation_->recovery_gate(core::OperationStage::freeze); !gate.ok()) {
     return gate;
   }
-  auto handle = prepare_successor_locked(context, options);
+  auto handle = prepare_successor_locked(context, options, SuccessorPlan{});
   if (!handle.ok()) {
     return handle.status();
   }
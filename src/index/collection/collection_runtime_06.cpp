@@ -10,7 +10,8 @@
 namespace alaya {
 
 [[nodiscard]] auto Collection::prepare_successor_locked(core::SealContext &context,
-                                                        const CollectionSealOptions &options)
+                                                        const CollectionSealOptions &options,
+                                                        const SuccessorPlan &plan)
     -> core::Result<CollectionRotationHandle> {
   if (auto gate = implementation_->recovery_gate(core::OperationStage::freeze); !gate.ok()) {
     return gate;
@@ -44,15 +45,36 @@ namespace alaya {
                  core::StatusDetail::none,
                  "another Collection control-plane operation is in progress");
   }
+  // A successor left by an interrupted seal() or rebuild() is finished with
+  // its persisted sources; a seal() finishes a rebuild with the current
+  // options, but a rebuild() cannot widen a seal that is already cut.
+  const auto rebuild = internal::collection::CollectionControlOperation::rebuild;
+  if (plan.include_sealed &&
+      control_state_.phase == internal::collection::CollectionControlPhase::successor_active &&
+      control_state_.operation != rebuild) {
+    return error(core::StatusCode::conflict,
+                 core::OperationStage::freeze,
+                 core::StatusDetail::none,
+                 "an interrupted seal is pending; call seal() before rebuild()");
+  }
 
   if (control_state_.phase == internal::collection::CollectionControlPhase::idle) {
     const auto snapshot = implementation_->pin_routing_snapshot();
     const auto source = snapshot->find_active_mutable();
-    if (source == nullptr || snapshot->known_rows_for(*source) == 0) {
+    std::vector<internal::collection::RowAddress> sealed_sources;
+    if (plan.include_sealed) {
+      for (const auto &entry : snapshot->segments) {
+        if (entry->role == internal::collection::SegmentRole::sealed) {
+          sealed_sources.push_back({entry->segment_id, entry->generation, core::SegmentRowId{}});
+        }
+      }
+    }
+    if (source == nullptr || (snapshot->known_rows_for(*source) == 0 && sealed_sources.empty())) {
       return error(core::StatusCode::not_found,
                    core::OperationStage::freeze,
                    core::StatusDetail::none,
-                   "cannot seal an empty active segment");
+                   plan.include_sealed ? "cannot rebuild an empty Collection"
+                                       : "cannot seal an empty active segment");
     }
     if (control_state_.next_segment_id > 99'999'998) {
       return error(core::StatusCode::resource_exhausted,
@@ -60,11 +82,15 @@ namespace alaya {
                    core::StatusDetail::arithmetic_overflow,
                    "Collection segment namespace is exhausted");
     }
-    control_state_.operation = internal::collection::CollectionControlOperation::seal;
+    control_state_.operation =
+        plan.include_sealed ? rebuild : internal::collection::CollectionControlOperation::seal;
     control_state_.phase = internal::collection::CollectionControlPhase::cut_pending;
     control_state_.sources = {internal::collection::RowAddress{source->segment_id,
                                                                source->generation,
                                                                core::SegmentRowId{}}};
+    control_state_.sources.insert(control_state_.sources.end(),
+                                  sealed_sources.begin(),
+                                  sealed_sources.end());
     control_state_.successor_segment_id = control_state_.next_segment_id++;
     control_state_.successor_generation = 1;
     control_state_.target_segment_id = control_state_.next_segment_id++;
@@ -134,7 +160,8 @@ namespace alaya {
     return error(core::StatusCode::not_found,
                  core::OperationStage::build,
                  core::StatusDetail::none,
-                 "active seal snapshot contains no live rows");
+                 plan.include_sealed ? "rebuild snapshot contains no live rows"
+                                     : "active seal snapshot contains no live rows");
   }
   status = context.snapshot_reservation.ensure(build_data.value().snapshot_bytes,
                                                core::OperationStage::freeze,
@@ -142,7 +169,8 @@ namespace alaya {
   if (!status.ok()) {
     return status;
   }
-  control_state_.mapping_file = "seal_" + std::to_string(control_state_.target_segment_id) + ".map";
+  control_state_.mapping_file = (control_state_.operation == rebuild ? "rebuild_" : "seal_") +
+                                std::to_string(control_state_.target_segment_id) + ".map";
   status =
       internal::collection::CollectionControlStore::save_replacements(options_.root,
                                                                       control_state_.mapping_file,
@@ -194,12 +222,43 @@ namespace alaya {
                                                 options_.metric,
                                                 options_.scalar_type,
                                                 options_.max_logical_id_bytes};
+  const auto &build_options = plan.build_options != nullptr ? *plan.build_options : options_;
   internal::collection::detail::CollectionTargetBuildParams build_params;
-  build_params.quantization = options_.quantization;
-  build_params.max_neighbors = options_.max_neighbors;
-  build_params.ef_construction = options_.ef_construction;
-  build_params.thread_count = options_.build_threads;
-  const auto resolution = resolve_build_algorithm(options_.target_algorithm,
+  build_params.quantization = build_options.quantization;
+  build_params.max_neighbors = build_options.max_neighbors;
+  build_params.ef_construction = build_options.ef_construction;
+  build_params.thread_count = build_options.build_threads;
+  // A rebuild starts from the sealed source holding the most live rows;
+  // the target builder decides whether its graph is worth extending.
+  internal::collection::detail::CollectionTopologySeed topology_seed;
+  if (plan.include_sealed) {
+    std::map<std::uint64_t, core::RowCount> carried;
+    for (const auto &replacement : build_data.value().replacements) {
+      if (static_cast<std::uint64_t>(replacement.target.row_id) < build_data.value().live_rows &&
+          replacement.source.segment_id != control_state_.sources.front().segment_id) {
+        ++carried[replacement.source.segment_id];
+      }
+    }
+    const auto best = std::ranges::max_element(carried, {}, [](const auto &item) {
+      return item.second;
+    });
+    if (best != carried.end()) {
+      topology_seed.segment_dir =
+          options_.root / "segments" /
+          internal::collection::detail::collection_segment_name(best->first);
+      topology_seed.rows.assign(static_cast<std::size_t>(build_data.value().live_rows),
+                                ::alaya::kNoPredecessorRow);
+      for (const auto &replacement : build_data.value().replacements) {
+        const auto row = static_cast<std::uint64_t>(replacement.target.row_id);
+        if (row < topology_seed.rows.size() && replacement.source.segment_id == best->first) {
+          topology_seed.rows[row] =
+              static_cast<std::uint32_t>(static_cast<std::uint64_t>(replacement.source.row_id));
+        }
+      }
+      build_params.topology_seed = &topology_seed;
+    }
+  }
+  const auto resolution = resolve_build_algorithm(build_options.target_algorithm,
                                                   schema,
                                                   build_data.value().live_rows,
                                                   build_params);
@@ -217,7 +276,7 @@ namespace alaya {
     return built.status();
   }
   auto built_target = std::move(built).value();
-  built_target.requested_algorithm = options_.target_algorithm;
+  built_target.requested_algorithm = build_options.target_algorithm;
   built_target.flat_fallback = resolution.flat_fallback;
   built_target.fallback_reason = resolution.fallback_reason;
   if (resolution.flat_fallback) {
@@ -247,8 +306,13 @@ namespace alaya {
   // still correctly defers instead of reclaiming a live segment.
   for (const auto &source : control_state_.sources) {
     if (auto entry = pinned->find_segment(source.segment_id, source.generation)) {
-      pending_gc_.push_back(
-          {internal::collection::detail::collection_segment_name(source.segment_id), {}, entry});
+      const auto source_name =
+          internal::collection::detail::collection_segment_name(source.segment_id);
+      pending_gc_.push_back({source_name,
+                             entry->role == internal::collection::SegmentRole::sealed
+                                 ? options_.root / "segments" / source_name
+                                 : std::filesystem::path{},
+                             entry});
     }
   }
 
@@ -2,7 +2,7 @@
 //
 // SPDX-License-Identifier: AGPL-3.0-only
 
-// collection_runtime_07: successor rotation and flat-export verification.
+// collection_runtime_07: successor rotation, rebuild, and flat-export verification.
 // One compile-cost-balanced Collection runtime unit; see CMakeLists.txt.
 
 #include "index/collection/collection.hpp"
@@ -67,6 +67,7 @@ namespace alaya {
   receipt.manifest_generation = control_state_.manifest_generation;
   receipt.built_algorithm = prepared.built_target.built_algorithm;
   receipt.effective_ef_construction = prepared.built_target.effective_ef_construction;
+  receipt.reused_topology_rows = prepared.built_target.reused_topology_rows;
   receipt.flat_fallback = prepared.built_target.flat_fallback;
   receipt.fallback_reason = prepared.built_target.fallback_reason;
   const auto mapping_file = control_state_.mapping_file;
@@ -90,6 +91,87 @@ namespace alaya {
   return receipt;
 }
 
+[[nodiscard]] auto Collection::rebuild_locked(core::SealContext &context,
+                                              const CollectionRebuildOptions &options)
+    -> core::Result<CollectionRebuildReceipt> {
+  if (auto gate = implementation_->recovery_gate(core::OperationStage::build); !gate.ok()) {
+    return gate;
+  }
+  auto rebuilt_options = options_;
+  rebuilt_options.target_algorithm =
+      options.target_algorithm.value_or(rebuilt_options.target_algorithm);
+  rebuilt_options.quantization = options.quantization.value_or(rebuilt_options.quantization);
+  rebuilt_options.max_neighbors = options.max_neighbors.value_or(rebuilt_options.max_neighbors);
+  rebuilt_options.ef_construction =
+      options.ef_construction.value_or(rebuilt_options.ef_construction);
+  rebuilt_options.build_threads = options.build_threads.value_or(rebuilt_options.build_threads);
+  auto status = validate_options(rebuilt_options, core::OperationStage::build);
+  if (!status.ok()) {
+    return status;
+  }
+
+  CollectionRebuildReceipt receipt;
+  const auto empty = [&] {
+    const auto snapshot = implementation_->pin_routing_snapshot();
+    return snapshot->searchable_live_count == 0 && snapshot->tombstone_count == 0 &&
+           std::ranges::none_of(snapshot->segments, [&](const auto &entry) {
+             return entry->role == internal::collection::SegmentRole::sealed ||
+                    snapshot->known_rows_for(*entry) != 0;
+           });
+  }();
+  std::optional<CollectionSealReceipt> sealed;
+  // An empty Collection has nothing to rebuild; only its options change.
+  if (!empty || control_state_.phase != internal::collection::CollectionControlPhase::idle) {
+    auto handle = prepare_successor_locked(context, {}, SuccessorPlan{true, &rebuilt_options});
+    if (!handle.ok()) {
+      return handle.status();
+    }
+    auto rotated = rotate_to_successor_locked(handle.value(), context);
+    if (!rotated.ok()) {
+      return rotated.status();
+    }
+    receipt.source_segment_ids = handle.value().predecessor_segment_ids;
+    sealed = std::move(rotated).value();
+  }
+  // The rebuilt segment is routed; later seals and compactions build with
+  // the new options.
+  if (rebuilt_options.target_algorithm != options_.target_algorithm ||
+      rebuilt_options.quantization != options_.quantization ||
+      rebuilt_options.max_neighbors != options_.max_neighbors ||
+      rebuilt_options.ef_construction != options_.ef_construction ||
+      rebuilt_options.build_threads != options_.build_threads) {
+    status = write_facade_schema(rebuilt_options);
+    if (!status.ok()) {
+      return status;
+    }
+    // Field by field: writers and searches read root/dim/metric unlocked.
+    options_.target_algorithm = rebuilt_options.target_algorithm;
+    options_.quantization = rebuilt_options.quantization;
+    options_.max_neighbors = rebuilt_options.max_neighbors;
+    options_.ef_construction = rebuilt_options.ef_construction;
+    options_.build_threads = rebuilt_options.build_threads;
+  }
+
+  if (!sealed.has_value()) {
+    receipt.successor_segment_id = control_state_.active_segment_id;
+    receipt.manifest_generation = control_state_.manifest_generation;
+    receipt.built_algorithm = options_.target_algorithm;
+    return receipt;
+  }
+  receipt.rebuilt_segment_id = sealed->sealed_segment_id;
+  receipt.successor_segment_id = sealed->successor_segment_id;
+  receipt.wal_cut = sealed->wal_cut;
+  receipt.rebuilt_rows = sealed->sealed_rows;
+  receipt.rebuilt_bytes = sealed->sealed_bytes;
+  receipt.manifest_generation = sealed->manifest_generation;
+  receipt.built_algorithm = sealed->built_algorithm;
+  receipt.effective_ef_construction = sealed->effective_ef_construction;
+  receipt.reused_topology_rows = sealed->reused_topology_rows;
+  receipt.flat_fallback = sealed->flat_fallback;
+  receipt.fallback_reason = std::move(sealed->fallback_reason);
+  return receipt;
+}
+
 [[nodiscard]] auto Collection::verify_flat_exports(
     const internal::collection::RoutingSnapshot &snapshot,
     std::span<const internal::collection::RowAddress> sources) const -> core::Status {
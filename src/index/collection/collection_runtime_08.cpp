@@ -2,15 +2,15 @@
 //
 // SPDX-License-Identifier: AGPL-3.0-only
 
-// collection_runtime_08: compaction internals.
+// collection_runtime_08: compaction and relayout internals.
 // One compile-cost-balanced Collection runtime unit; see CMakeLists.txt.
 
 #include "index/collection/collection.hpp"
 
 namespace alaya {
 
-[[nodiscard]] auto Collection::compact_locked(core::SealContext &context)
-    -> core::Result<CollectionCompactReceipt> {
+[[nodiscard]] auto Collection::begin_replacement_locked(const core::SealContext &context)
+    -> core::Status {
   if (auto gate = implementation_->recovery_gate(core::OperationStage::build); !gate.ok()) {
     return gate;
   }
@@ -36,6 +36,134 @@ namespace alaya {
                  core::StatusDetail::none,
                  "another Collection control-plane operation is in progress");
   }
+  return core::Status::success();
+}
+
+[[nodiscard]] auto Collection::stage_replacement_locked(
+    internal::collection::CollectionControlOperation operation,
+    std::string_view mapping_prefix,
+    std::span<const internal::collection::RowAddress> sources,
+    std::uint64_t target_segment_id,
+    std::uint64_t target_generation,
+    std::uint64_t wal_cut,
+    const std::vector<internal::collection::SegmentReplacement> &replacements) -> core::Status {
+  control_state_.operation = operation;
+  control_state_.phase = internal::collection::CollectionControlPhase::building;
+  control_state_.sources.assign(sources.begin(), sources.end());
+  control_state_.target_segment_id = target_segment_id;
+  control_state_.target_generation = target_generation;
+  control_state_.wal_cut = wal_cut;
+  control_state_.mapping_file =
+      std::string(mapping_prefix) + std::to_string(target_segment_id) + ".map";
+  auto status =
+      internal::collection::CollectionControlStore::save_replacements(options_.root,
+                                                                      control_state_.mapping_file,
+                                                                      replacements);
+  if (!status.ok()) {
+    return status;
+  }
+  return internal::collection::CollectionControlStore::save(options_.root, control_state_);
+}
+
+[[nodiscard]] auto Collection::replacement_publication(
+    internal::collection::ArtifactManifestV2 base_manifest,
+    std::uint64_t target_segment_id,
+    std::uint64_t target_generation,
+    std::uint64_t metadata_epoch) const
+    -> internal::collection::detail::CollectionTargetPublication {
+  internal::collection::detail::CollectionTargetPublication publication;
+  publication.collection_root = options_.root;
+  publication.segment_id = internal::collection::detail::collection_segment_name(target_segment_id);
+  publication.segment_generation = target_generation;
+  publication.manifest_generation =
+      std::max(base_manifest.publication.generation + 1, control_state_.manifest_generation + 1);
+  publication.publication_parent = std::string(internal::collection::kCollectionManifestFilename);
+  publication.metadata_epoch = metadata_epoch;
+  publication.metadata_checkpoint = "checkpoint_" + std::to_string(control_state_.wal_cut) + ".bin";
+  publication.wal_cut = control_state_.wal_cut;
+  publication.row_versions = {control_state_.wal_cut == 0 ? std::uint64_t{0} : std::uint64_t{1},
+                              control_state_.wal_cut};
+  publication.id_map_checkpoint = publication.metadata_checkpoint;
+  publication.collection_features.manifest_v2_writer = true;
+  publication.abort_policy = internal::collection::ArtifactAbortPolicy::retain_for_restart_cleanup;
+  publication.base_manifest = std::move(base_manifest);
+  return publication;
+}
+
+[[nodiscard]] auto Collection::publish_replacement_segment_locked(
+    core::SealContext &context,
+    internal::collection::RoutingSnapshotPtr pinned,
+    std::span<const internal::collection::RowAddress> sources,
+    std::uint64_t target_segment_id,
+    std::uint64_t target_generation,
+    core::AnySegment segment,
+    const ReplacementBuildData &build_data) -> core::Status {
+  auto status = patch_published_target_manifest();
+  if (!status.ok()) {
+    return status;
+  }
+  control_state_.phase = internal::collection::CollectionControlPhase::manifest_published;
+  status = internal::collection::CollectionControlStore::save(options_.root, control_state_);
+  if (!status.ok()) {
+    return status;
+  }
+
+  for (const auto &source : sources) {
+    const auto source_name =
+        internal::collection::detail::collection_segment_name(source.segment_id);
+    if (auto entry = pinned->find_segment(source.segment_id, source.generation)) {
+      pending_gc_.push_back({source_name, options_.root / "segments" / source_name, entry});
+    }
+  }
+  internal::collection::SegmentRegistration target;
+  target.segment_id = target_segment_id;
+  target.generation = target_generation;
+  target.role = internal::collection::SegmentRole::sealed;
+  target.segment = std::move(segment);
+  target.rows = build_data.rows;
+  status = implementation_->install_segment_replacement(sources,
+                                                        std::move(target),
+                                                        build_data.replacements);
+  if (!status.ok()) {
+    return status;
+  }
+  pinned.reset();
+  core::CheckpointContext checkpoint_context;
+  checkpoint_context.deadline = context.deadline;
+  checkpoint_context.cancellation = context.cancellation;
+  checkpoint_context.lane = context.lane;
+  checkpoint_context.dirty_page_io_credits = context.io_credits;
+  checkpoint_context.wal_io_credits = context.io_credits;
+  checkpoint_context.durability_target = core::DurabilityTarget::full_checkpoint;
+  return checkpoint_locked(checkpoint_context).status();
+}
+
+[[nodiscard]] auto Collection::finish_replacement_locked(std::uint64_t target_segment_id,
+                                                         std::uint64_t target_generation)
+    -> core::Status {
+  const auto mapping_file = control_state_.mapping_file;
+  control_state_.operation = internal::collection::CollectionControlOperation::idle;
+  control_state_.phase = internal::collection::CollectionControlPhase::idle;
+  control_state_.last_sealed_segment_id = target_segment_id;
+  control_state_.last_sealed_generation = target_generation;
+  control_state_.sources.clear();
+  control_state_.target_segment_id = 0;
+  control_state_.target_generation = 0;
+  control_state_.wal_cut = 0;
+  control_state_.mapping_file.clear();
+  auto status = internal::collection::CollectionControlStore::save(options_.root, control_state_);
+  if (!status.ok()) {
+    return status;
+  }
+  internal::collection::CollectionControlStore::remove_replacements(options_.root, mapping_file);
+  return core::Status::success();
+}
+
+[[nodiscard]] auto Collection::compact_locked(core::SealContext &context)
+    -> core::Result<CollectionCompactReceipt> {
+  if (auto status = begin_replacement_locked(context); !status.ok()) {
+    return status;
+  }
   auto loaded = internal::collection::load_manifest_v2_if_present(options_.root);
   if (!loaded.ok()) {
     return loaded.status();
@@ -76,7 +204,7 @@ namespace alaya {
                  "Flat segment namespace is exhausted");
   }
   auto pinned = implementation_->pin_routing_snapshot();
-  status = verify_flat_exports(*pinned, sources);
+  auto status = verify_flat_exports(*pinned, sources);
   if (!status.ok()) {
     return status;
   }
@@ -99,43 +227,22 @@ namespace alaya {
   if (!status.ok()) {
     return status;
   }
-  control_state_.operation = internal::collection::CollectionControlOperation::compact;
-  control_state_.phase = internal::collection::CollectionControlPhase::building;
-  control_state_.sources = sources;
-  control_state_.target_segment_id = target_segment_id;
-  control_state_.target_generation = kTargetGeneration;
-  control_state_.wal_cut = pinned->visibility_watermark;
   control_state_.pending_compacted_bytes = input_bytes;
-  control_state_.mapping_file = "compact_" + std::to_string(target_segment_id) + ".map";
-  status =
-      internal::collection::CollectionControlStore::save_replacements(options_.root,
-                                                                      control_state_.mapping_file,
-                                                                      build_data.value()
-                                                                          .replacements);
-  if (!status.ok()) {
-    return status;
-  }
-  status = internal::collection::CollectionControlStore::save(options_.root, control_state_);
+  status = stage_replacement_locked(internal::collection::CollectionControlOperation::compact,
+                                    "compact_",
+                                    sources,
+                                    target_segment_id,
+                                    kTargetGeneration,
+                                    pinned->visibility_watermark,
+                                    build_data.value().replacements);
   if (!status.ok()) {
     return status;
   }
 
-  internal::collection::detail::CollectionTargetPublication publication;
-  publication.collection_root = options_.root;
-  publication.segment_id = internal::collection::detail::collection_segment_name(target_segment_id);
-  publication.segment_generation = kTargetGeneration;
-  publication.manifest_generation =
-      std::max(base_manifest.publication.generation + 1, control_state_.manifest_generation + 1);
-  publication.publication_parent = std::string(internal::collection::kCollectionManifestFilename);
-  publication.metadata_epoch = pinned->metadata_epoch;
-  publication.metadata_checkpoint = "checkpoint_" + std::to_string(control_state_.wal_cut) + ".bin";
-  publication.wal_cut = control_state_.wal_cut;
-  publication.row_versions = {control_state_.wal_cut == 0 ? std::uint64_t{0} : std::uint64_t{1},
-                              control_state_.wal_cut};
-  publication.id_map_checkpoint = publication.metadata_checkpoint;
-  publication.collection_features.manifest_v2_writer = true;
-  publication.abort_policy = internal::collection::ArtifactAbortPolicy::retain_for_restart_cleanup;
-  publication.base_manifest = std::move(base_manifest);
+  auto publication = replacement_publication(std::move(base_manifest),
+                                             target_segment_id,
+                                             kTargetGeneration,
+                                             pinned->metadata_epoch);
   core::BuildContext build_context;
   build_context.growing_reservation = context.build_reservation;
   build_context.io_credits = context.io_credits;
@@ -171,47 +278,16 @@ namespace alaya {
   if (resolution.flat_fallback) {
     built_target.built_algorithm = core::algorithm::flat;
   }
-  status = patch_published_target_manifest();
+  status = publish_replacement_segment_locked(context,
+                                              std::move(pinned),
+                                              sources,
+                                              target_segment_id,
+                                              kTargetGeneration,
+                                              std::move(built_target.segment),
+                                              build_data.value());
   if (!status.ok()) {
     return status;
   }
-  control_state_.phase = internal::collection::CollectionControlPhase::manifest_published;
-  status = internal::collection::CollectionControlStore::save(options_.root, control_state_);
-  if (!status.ok()) {
-    return status;
-  }
-
-  for (const auto &source : sources) {
-    const auto source_name =
-        internal::collection::detail::collection_segment_name(source.segment_id);
-    if (auto entry = pinned->find_segment(source.segment_id, source.generation)) {
-      pending_gc_.push_back({source_name, options_.root / "segments" / source_name, entry});
-    }
-  }
-  internal::collection::SegmentRegistration target;
-  target.segment_id = target_segment_id;
-  target.generation = kTargetGeneration;
-  target.role = internal::collection::SegmentRole::sealed;
-  target.segment = std::move(built_target.segment);
-  target.rows = build_data.value().rows;
-  status = implementation_->install_segment_replacement(sources,
-                                                        std::move(target),
-                                                        build_data.value().replacements);
-  if (!status.ok()) {
-    return status;
-  }
-  pinned.reset();
-  core::CheckpointContext checkpoint_context;
-  checkpoint_context.deadline = context.deadline;
-  checkpoint_context.cancellation = context.cancellation;
-  checkpoint_context.lane = context.lane;
-  checkpoint_context.dirty_page_io_credits = context.io_credits;
-  checkpoint_context.wal_io_credits = context.io_credits;
-  checkpoint_context.durability_target = core::DurabilityTarget::full_checkpoint;
-  auto checkpoint = checkpoint_locked(checkpoint_context);
-  if (!checkpoint.ok()) {
-    return checkpoint.status();
-  }
 
   CollectionCompactReceipt receipt;
   for (const auto &source : sources) {
@@ -226,27 +302,154 @@ namespace alaya {
   receipt.effective_ef_construction = built_target.effective_ef_construction;
   receipt.flat_fallback = built_target.flat_fallback;
   receipt.fallback_reason = built_target.fallback_reason;
-  const auto mapping_file = control_state_.mapping_file;
   if (!core::checked_add(control_state_.compacted_bytes,
                          input_bytes,
                          control_state_.compacted_bytes)) {
     control_state_.compacted_bytes = std::numeric_limits<std::uint64_t>::max();
   }
   control_state_.pending_compacted_bytes = 0;
-  control_state_.operation = internal::collection::CollectionControlOperation::idle;
-  control_state_.phase = internal::collection::CollectionControlPhase::idle;
-  control_state_.last_sealed_segment_id = target_segment_id;
-  control_state_.last_sealed_generation = kTargetGeneration;
-  control_state_.sources.clear();
-  control_state_.target_segment_id = 0;
-  control_state_.target_generation = 0;
-  control_state_.wal_cut = 0;
-  control_state_.mapping_file.clear();
-  status = internal::collection::CollectionControlStore::save(options_.root, control_state_);
+  status = finish_replacement_locked(target_segment_id, kTargetGeneration);
+  if (!status.ok()) {
+    return status;
+  }
+  return receipt;
+}
+
+[[nodiscard]] auto Collection::relayout_locked(core::SealContext &context,
+                                               const CollectionRelayoutOptions &options)
+    -> core::Result<CollectionRelayoutReceipt> {
+  if (auto status = begin_replacement_locked(context); !status.ok()) {
+    return status;
+  }
+  auto loaded = internal::collection::load_manifest_v2_if_present(options_.root);
+  if (!loaded.ok()) {
+    return loaded.status();
+  }
+  if (!loaded.value().has_value()) {
+    return error(core::StatusCode::not_found,
+                 core::OperationStage::build,
+                 core::StatusDetail::none,
+                 "LASER relayout requires a sealed manifest entry");
+  }
+  auto base_manifest = std::move(*loaded.value());
+
+  // The source is the sealed LASER-backed segment whose open searcher has
+  // sampled the most queries.
+  const internal::collection::SegmentEntryV2 *source_entry = nullptr;
+  std::shared_ptr<::alaya::laser::VisitSketch> sketch;
+  for (const auto &entry : base_manifest.segments) {
+    const bool laser_backed =
+        entry.algorithm_id == core::algorithm::laser ||
+        (entry.algorithm_id == core::algorithm::qg &&
+         std::ranges::find(entry.reader_compatibility.required_features,
+                           internal::collection::detail::kQgLaserImplementationKey) !=
+             entry.reader_compatibility.required_features.end());
+    if (entry.lifecycle != internal::collection::SegmentLifecycleV2::sealed || !laser_backed) {
+      continue;
+    }
+    auto candidate = ::alaya::laser::VisitSketchRegistry::instance().find(
+        ::alaya::laser::VisitSketchRegistry::key_for(options_.root / "segments" /
+                                                      entry.segment_id));
+    if (candidate != nullptr && candidate->sampled_queries() >= options.min_sampled_queries &&
+        (sketch == nullptr || candidate->sampled_queries() > sketch->sampled_queries())) {
+      source_entry = &entry;
+      sketch = std::move(candidate);
+    }
+  }
+  if (source_entry == nullptr) {
+    return error(core::StatusCode::not_found,
+                 core::OperationStage::build,
+                 core::StatusDetail::none,
+                 "no sealed LASER segment has enough sampled queries to relayout");
+  }
+  if (control_state_.next_segment_id > 99'999'999) {
+    return error(core::StatusCode::resource_exhausted,
+                 core::OperationStage::build,
+                 core::StatusDetail::arithmetic_overflow,
+                 "Collection segment namespace is exhausted");
+  }
+  const std::vector<internal::collection::RowAddress> sources{
+      {numeric_segment_id(source_entry->segment_id),
+       source_entry->generation,
+       core::SegmentRowId{}}};
+  const auto source_dir = options_.root / "segments" / source_entry->segment_id;
+  const auto exposed_algorithm = source_entry->algorithm_id;
+  const auto sampled_queries = sketch->sampled_queries();
+
+  auto pinned = implementation_->pin_routing_snapshot();
+  const auto target_segment_id = control_state_.next_segment_id++;
+  constexpr std::uint64_t kTargetGeneration = 1;
+  auto build_data = collect_replacement_rows(*pinned,
+                                             sources,
+                                             target_segment_id,
+                                             kTargetGeneration,
+                                             /*keep_row_ids=*/true);
+  if (!build_data.ok()) {
+    return build_data.status();
+  }
+  if (build_data.value().rows.empty()) {
+    return error(core::StatusCode::not_found,
+                 core::OperationStage::build,
+                 core::StatusDetail::none,
+                 "LASER relayout source has no current rows");
+  }
+  auto status = stage_replacement_locked(internal::collection::CollectionControlOperation::relayout,
+                                         "relayout_",
+                                         sources,
+                                         target_segment_id,
+                                         kTargetGeneration,
+                                         pinned->visibility_watermark,
+                                         build_data.value().replacements);
+  if (!status.ok()) {
+    return status;
+  }
+
+  auto publication = replacement_publication(std::move(base_manifest),
+                                             target_segment_id,
+                                             kTargetGeneration,
+                                             pinned->metadata_epoch);
+  core::BuildContext build_context;
+  build_context.growing_reservation = context.build_reservation;
+  build_context.io_credits = context.io_credits;
+  build_context.deadline = context.deadline;
+  build_context.cancellation = context.cancellation;
+  build_context.lane = context.lane;
+  internal::collection::CollectionSchema schema{options_.dim,
+                                                options_.metric,
+                                                options_.scalar_type,
+                                                options_.max_logical_id_bytes};
+  auto built = internal::collection::detail::relayout_laser_collection_target(exposed_algorithm,
+                                                                              schema,
+                                                                              source_dir,
+                                                                              *sketch,
+                                                                              publication,
+                                                                              build_context);
+  if (!built.ok()) {
+    return built.status();
+  }
+  auto built_target = std::move(built).value();
+  status = publish_replacement_segment_locked(context,
+                                              std::move(pinned),
+                                              sources,
+                                              target_segment_id,
+                                              kTargetGeneration,
+                                              std::move(built_target.segment),
+                                              build_data.value());
+  if (!status.ok()) {
+    return status;
+  }
+
+  CollectionRelayoutReceipt receipt;
+  receipt.source_segment_id = sources.front().segment_id;
+  receipt.relayout_segment_id = target_segment_id;
+  receipt.rows = static_cast<core::RowCount>(build_data.value().rows.size());
+  receipt.sampled_queries = sampled_queries;
+  receipt.output_bytes = built_target.artifact_bytes;
+  receipt.manifest_generation = control_state_.manifest_generation;
+  status = finish_replacement_locked(target_segment_id, kTargetGeneration);
   if (!status.ok()) {
     return status;
   }
-  internal::collection::CollectionControlStore::remove_replacements(options_.root, mapping_file);
   return receipt;
 }
 }  // namespace alaya
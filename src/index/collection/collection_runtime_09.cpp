@@ -134,6 +134,7 @@ namespace alaya {
   request.document = item.document;
   request.mode = mode;
   request.options = std::move(options);
+  await_admission();
   core::MutationContext context;
   auto receipt = implementation_->write(request, context);
   if (receipt.ok()) {
@@ -152,6 +153,10 @@ void Collection::maybe_auto_seal() noexcept {
     if (active == nullptr || snapshot->known_rows_for(*active) < options_.auto_seal_rows) {
       return;
     }
+    if (maintenance_ != nullptr) {
+      maintenance_->schedule(internal::collection::MaintenanceTask::seal);
+      return;
+    }
     (void)seal();
   } catch (...) {
     // The committed mutation remains authoritative. Auto-seal is a
@@ -159,6 +164,97 @@ void Collection::maybe_auto_seal() noexcept {
   }
 }
 
+void Collection::await_admission() noexcept {
+  if (maintenance_ == nullptr || options_.auto_seal_rows == 0) {
+    return;
+  }
+  // Never below the seal threshold: a seal below it would find nothing to do.
+  const auto hard_cap = std::max(options_.auto_seal_rows,
+                                 options_.maintenance.hard_cap_rows != 0
+                                     ? options_.maintenance.hard_cap_rows
+                                     : options_.auto_seal_rows * 4);
+  try {
+    const auto snapshot = implementation_->pin_routing_snapshot();
+    const auto active = snapshot->find_active_mutable();
+    if (active == nullptr || snapshot->known_rows_for(*active) < hard_cap) {
+      return;
+    }
+    admission_waits_.fetch_add(1, std::memory_order_relaxed);
+    maintenance_->schedule(internal::collection::MaintenanceTask::seal);
+    maintenance_->wait(internal::collection::MaintenanceTask::seal);
+  } catch (...) {
+    // Admission is back-pressure only; the write proceeds either way.
+  }
+}
+
+[[nodiscard]] auto Collection::run_maintenance(internal::collection::MaintenanceTask task)
+    -> core::Status {
+  using internal::collection::MaintenanceTask;
+  if (closed_.load(std::memory_order_acquire)) {
+    return core::Status::success();
+  }
+  core::SealContext context;
+  auto rotated = false;
+  {
+    std::lock_guard lock(control_mutex_);
+    switch (task) {
+      case MaintenanceTask::seal: {
+        const auto snapshot = implementation_->pin_routing_snapshot();
+        const auto active = snapshot->find_active_mutable();
+        // A seal that ran since this one was queued may have taken the rows.
+        if (active == nullptr || snapshot->known_rows_for(*active) < options_.auto_seal_rows) {
+          return core::Status::success();
+        }
+        auto build_options = options_;
+        if (options_.maintenance.build_threads != 0) {
+          build_options.build_threads =
+              std::min(build_options.build_threads, options_.maintenance.build_threads);
+        }
+        auto handle = prepare_successor_locked(context, {}, SuccessorPlan{false, &build_options});
+        if (!handle.ok()) {
+          return handle.status();
+        }
+        auto sealed = rotate_to_successor_locked(handle.value(), context);
+        if (!sealed.ok()) {
+          return sealed.status();
+        }
+        background_seals_.fetch_add(1, std::memory_order_relaxed);
+        rotated = true;
+        break;
+      }
+      case MaintenanceTask::compact: {
+        auto compacted = compact_locked(context);
+        // Too few compactable sources is not a failure.
+        if (!compacted.ok() && compacted.status().code() != core::StatusCode::not_found) {
+          return compacted.status();
+        }
+        rotated = compacted.ok();
+        break;
+      }
+      case MaintenanceTask::gc: {
+        auto collected = gc_locked();
+        if (!collected.ok()) {
+          return collected.status();
+        }
+        break;
+      }
+    }
+  }
+  if (rotated && task == MaintenanceTask::seal && options_.maintenance.compact_min_segments != 0) {
+    const auto snapshot = implementation_->pin_routing_snapshot();
+    const auto sealed = std::ranges::count_if(snapshot->segments, [](const auto &entry) {
+      return entry->role == internal::collection::SegmentRole::sealed;
+    });
+    if (static_cast<std::uint64_t>(sealed) >= options_.maintenance.compact_min_segments) {
+      maintenance_->schedule(MaintenanceTask::compact);
+    }
+  }
+  if (rotated && options_.maintenance.gc_after_rotation) {
+    maintenance_->schedule(MaintenanceTask::gc);
+  }
+  return core::Status::success();
+}
+
 [[nodiscard]] auto Collection::execute_search(const core::TypedTensorView &queries,
                                               const core::SearchOptions &options,
                                               core::SearchContext &context,
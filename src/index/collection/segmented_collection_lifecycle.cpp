@@ -75,29 +75,33 @@ namespace alaya::internal::collection {
   if (!admission.has_value()) {
     return closed_status(core::OperationStage::admission);
   }
-  std::lock_guard mutation_lock(mutation_mutex_);
+  // A retry returns its recorded receipt without copying the row again.
+  if (!request.options.retry_token.empty()) {
+    std::unique_lock mutation_lock(mutation_mutex_);
+    if (retry_receipts_.contains(request.options.retry_token)) {
+      return complete_group_commit(mutation_lock, write_locked(request, {}, context));
+    }
+  }
+  auto prepared =
+      prepare_payload(request.logical_id, request.vector, request.metadata, request.document);
+  std::unique_lock mutation_lock(mutation_mutex_);
+  return complete_group_commit(mutation_lock, write_locked(request, std::move(prepared), context));
+}
+
+[[nodiscard]] auto SegmentedCollection::write_locked(const WriteRequest &request,
+                                                     PreparedPayload prepared,
+                                                     core::MutationContext &context)
+    -> core::Result<MutationReceipt> {
   auto current = load_snapshot();
   if (!request.options.retry_token.empty()) {
     const auto retried = retry_receipts_.find(request.options.retry_token);
     if (retried != retry_receipts_.end()) {
+      await_group_sync_for(retried->second);
       return retried->second;
     }
   }
-  auto status = validate_logical_id(request.logical_id, core::OperationStage::validation);
-  if (!status.ok()) {
-    return status;
-  }
-  status = core::validate_tensor(request.vector, schema_.dim, core::OperationStage::validation);
-  if (!status.ok()) {
-    return status;
-  }
-  if (request.vector.rows != 1 || request.vector.scalar_type != schema_.scalar_type) {
-    return core::Status::error(core::StatusCode::invalid_argument,
-                               core::OperationStage::validation,
-                               request.vector.scalar_type == schema_.scalar_type
-                                   ? core::StatusDetail::malformed_struct
-                                   : core::StatusDetail::unsupported_scalar_type,
-                               "collection write requires one row with the schema scalar type");
+  if (!prepared.status.ok()) {
+    return prepared.status;
   }
 
   const auto existing = current->versions.find(request.logical_id);
@@ -112,24 +116,18 @@ namespace alaya::internal::collection {
   if (request.mode == WriteMode::replace && !live) {
     return not_found("replace logical ID is not live");
   }
-  auto owned = OwnedVector::copy_row(request.vector, 0);
-  if (!owned.ok()) {
-    return owned.status();
-  }
-  RecordPayload payload;
-  payload.vector = std::move(owned).value();
-  payload.metadata = request.metadata;
-  payload.document = request.document;
   const auto row_status = !live                                ? RowMutationStatus::inserted
                           : request.mode == WriteMode::replace ? RowMutationStatus::replaced
                                                                : RowMutationStatus::updated;
   return mutate_locked(std::move(current),
                        request.logical_id,
                        SegmentMutationAction::write,
-                       std::move(payload),
+                       std::move(prepared.payload),
                        row_status,
                        context,
-                       request.options);
+                       request.options,
+                       0,
+                       std::move(prepared.encoded));
 }
 
 [[nodiscard]] auto SegmentedCollection::erase(const core::LogicalId &logical_id,
@@ -143,11 +141,19 @@ namespace alaya::internal::collection {
   if (!admission.has_value()) {
     return closed_status(core::OperationStage::admission);
   }
-  std::lock_guard mutation_lock(mutation_mutex_);
+  std::unique_lock mutation_lock(mutation_mutex_);
+  return complete_group_commit(mutation_lock, erase_locked(logical_id, context, options));
+}
+
+[[nodiscard]] auto SegmentedCollection::erase_locked(const core::LogicalId &logical_id,
+                                                     core::MutationContext &context,
+                                                     const WriteOptions &options)
+    -> core::Result<MutationReceipt> {
   auto current = load_snapshot();
   if (!options.retry_token.empty()) {
     const auto retried = retry_receipts_.find(options.retry_token);
     if (retried != retry_receipts_.end()) {
+      await_group_sync_for(retried->second);
       return retried->second;
     }
   }
@@ -178,7 +184,13 @@ namespace alaya::internal::collection {
   if (!admission.has_value()) {
     return closed_status(core::OperationStage::admission);
   }
-  std::lock_guard mutation_lock(mutation_mutex_);
+  std::unique_lock mutation_lock(mutation_mutex_);
+  return complete_group_commit(mutation_lock, delete_by_filter_locked(filter, context));
+}
+
+[[nodiscard]] auto SegmentedCollection::delete_by_filter_locked(const LogicalFilter &filter,
+                                                                core::MutationContext &context)
+    -> core::Result<std::vector<MutationReceipt>> {
   const auto admitted = load_snapshot();
   std::vector<core::LogicalId> expanded;
   for (const auto &[logical_id, version] : admitted->versions) {
@@ -225,10 +237,35 @@ namespace alaya::internal::collection {
   if (!admission.has_value()) {
     return closed_status(core::OperationStage::admission);
   }
-  std::lock_guard mutation_lock(mutation_mutex_);
+  // A retried batch and one its reservations cannot hold both return before
+  // any row is copied or encoded. The locked path checks both again.
+  std::vector<PreparedPayload> prepared;
+  if (!request.options.retry_token.empty()) {
+    std::unique_lock mutation_lock(mutation_mutex_);
+    if (batch_retry_receipts_.contains(request.options.retry_token)) {
+      return complete_group_commit(mutation_lock, mutate_batch_locked(request, prepared, context));
+    }
+  }
+  if (!request.rows.empty() && request.rows.size() <= std::numeric_limits<std::uint32_t>::max()) {
+    auto batch_resources = preflight_batch_resources(request, context);
+    if (!batch_resources.ok()) {
+      return batch_resources;
+    }
+  }
+  prepared = prepare_batch_payloads(request);
+  std::unique_lock mutation_lock(mutation_mutex_);
+  return complete_group_commit(mutation_lock, mutate_batch_locked(request, prepared, context));
+}
+
+[[nodiscard]] auto SegmentedCollection::mutate_batch_locked(
+    const BatchMutationRequest &request,
+    std::vector<PreparedPayload> &prepared,
+    core::MutationContext &context)
+    -> core::Result<BatchMutationReceipt> {
   if (!request.options.retry_token.empty()) {
     const auto retried = batch_retry_receipts_.find(request.options.retry_token);
     if (retried != batch_retry_receipts_.end()) {
+      await_group_sync_for(retried->second);
       return retried->second;
     }
   }
@@ -263,7 +300,8 @@ namespace alaya::internal::collection {
   }
   const auto batch_op_id = next_op_id_.fetch_add(1, std::memory_order_acq_rel);
   if (request.mode == BatchMutationMode::all_or_nothing) {
-    return mutate_atomic_batch_locked(std::move(current), request, context, batch_op_id);
+    return mutate_atomic_batch_locked(
+        std::move(current), request, prepared, context, batch_op_id);
   }
 
   BatchMutationReceipt batch;
@@ -280,6 +318,7 @@ namespace alaya::internal::collection {
                              ? retry_receipts_.end()
                              : retry_receipts_.find(row_options.retry_token);
     if (retried != retry_receipts_.end()) {
+      await_group_sync_for(retried->second);
       auto receipt = retried->second;
       receipt.batch_op_id = batch_op_id;
       batch.rows.push_back(std::move(receipt));
@@ -287,6 +326,7 @@ namespace alaya::internal::collection {
     }
     auto receipt = mutate_batch_row_locked(load_snapshot(),
                                            request.rows[index],
+                                           prepared[index],
                                            context,
                                            row_options,
                                            batch_op_id);
@@ -359,6 +399,10 @@ namespace alaya::internal::collection {
     result.visibility_watermark = snapshot->visibility_watermark;
     result.durable_watermark = snapshot->durable_watermark;
     result.metadata_epoch = snapshot->metadata_epoch;
+    result.recovery_replayed_transactions = recovery_replay_.transactions_replayed;
+    result.recovery_replayed_rows = recovery_replay_.rows_replayed;
+    result.recovery_replay_nanoseconds =
+        static_cast<std::uint64_t>(recovery_replay_.elapsed.count());
     for (const auto &entry : snapshot->segments) {
       core::SegmentStats segment_stats;
       if (entry->segment.stats(segment_stats).ok()) {
@@ -403,6 +447,10 @@ namespace alaya::internal::collection {
     }
   }
 
+  if (checkpoints_ != nullptr) {
+    // A background checkpoint merge may still be rewriting CURRENT.
+    checkpoints_->wait_for_merge();
+  }
   const auto snapshot = load_snapshot();
   for (const auto &entry : snapshot->segments) {
     const auto capabilities = entry->segment.capabilities();
@@ -474,10 +522,7 @@ namespace alaya::internal::collection {
       return status;
     }
   }
-  auto stored = CollectionCheckpointStore::write(wal_->directory(),
-                                                 *snapshot,
-                                                 retry_receipts_,
-                                                 batch_retry_receipts_);
+  auto stored = checkpoints_->write(*snapshot, retry_receipts_, batch_retry_receipts_);
   if (!stored.ok()) {
     return stored.status();
   }
@@ -655,10 +700,7 @@ namespace alaya::internal::collection {
                                                           std::move(successor.maintenance)));
   next->generation = current->generation + 1;
 
-  auto stored = CollectionCheckpointStore::write(wal_->directory(),
-                                                 *next,
-                                                 retry_receipts_,
-                                                 batch_retry_receipts_);
+  auto stored = checkpoints_->write(*next, retry_receipts_, batch_retry_receipts_);
   if (!stored.ok()) {
     return stored.status();
   }
@@ -799,7 +841,9 @@ namespace alaya::internal::collection {
     const auto found = next->versions.find(replacement.logical_id);
     if (found != next->versions.end() && found->second.address == replacement.source &&
         found->second.upsert_sequence == replacement.upsert_sequence) {
-      found->second.address = replacement.target;
+      auto moved = found->second;
+      moved.address = replacement.target;
+      next->versions.insert_or_assign(replacement.logical_id, std::move(moved));
     }
     const auto row = static_cast<std::uint64_t>(replacement.target.row_id);
     if (row != std::numeric_limits<std::uint64_t>::max()) {
@@ -811,7 +855,7 @@ namespace alaya::internal::collection {
       }
     }
   }
-  std::erase_if(next->reverse, [&](const auto &item) {
+  erase_if(next->reverse, [&](const auto &item) {
     return is_source(item.first);
   });
   std::erase_if(next->segments, [&](const auto &entry) {
@@ -922,12 +966,6 @@ namespace alaya::internal::collection {
       std::max(maximum_sequence, config_.recovery.minimum_visibility_watermark);
   snapshot->durable_watermark = 0;
   if (config_.features.wal_coordinator) {
-    auto opened =
-        CollectionLogicalWal::open(config_.wal.root, config_.wal.namespace_name, config_.read_only);
-    if (!opened.ok()) {
-      return opened.status();
-    }
-    wal_ = std::move(opened).value();
     const auto recovered = recover_durable_state(snapshot);
     if (!recovered.ok()) {
       return recovered;
@@ -13,7 +13,8 @@ namespace alaya::internal::collection {
                                                       RowMutationStatus row_status,
                                                       core::MutationContext &context,
                                                       const WriteOptions &options,
-                                                      std::uint64_t batch_op_id)
+                                                      std::uint64_t batch_op_id,
+                                                      std::vector<std::byte> encoded_payload)
     -> core::Result<MutationReceipt> {
   auto control = core::validate_runtime_control(context.deadline,
                                                 context.cancellation,
@@ -56,6 +57,7 @@ namespace alaya::internal::collection {
     row.previous = previous->second.address;
   }
   row.payload = std::move(payload);
+  row.encoded_payload = std::move(encoded_payload);
   row.retry_token = options.retry_token;
   transaction.rows.push_back(std::move(row));
   auto executed =
@@ -165,8 +167,64 @@ namespace alaya::internal::collection {
   return core::Status::success();
 }
 
+[[nodiscard]] auto SegmentedCollection::prepare_payload(const core::LogicalId &logical_id,
+                                                        const core::TypedTensorView &vector,
+                                                        const Metadata &metadata,
+                                                        const std::string &document) const
+    -> PreparedPayload {
+  PreparedPayload prepared;
+  prepared.status = validate_logical_id(logical_id, core::OperationStage::validation);
+  if (!prepared.status.ok()) {
+    return prepared;
+  }
+  prepared.status = core::validate_tensor(vector, schema_.dim, core::OperationStage::validation);
+  if (!prepared.status.ok()) {
+    return prepared;
+  }
+  if (vector.rows != 1 || vector.scalar_type != schema_.scalar_type) {
+    prepared.status =
+        core::Status::error(core::StatusCode::invalid_argument,
+                            core::OperationStage::validation,
+                            vector.scalar_type == schema_.scalar_type
+                                ? core::StatusDetail::malformed_struct
+                                : core::StatusDetail::unsupported_scalar_type,
+                            "collection write requires one row with the schema scalar type");
+    return prepared;
+  }
+  auto owned = OwnedVector::copy_row(vector, 0);
+  if (!owned.ok()) {
+    prepared.status = owned.status();
+    return prepared;
+  }
+  prepared.payload.vector = std::move(owned).value();
+  prepared.payload.metadata = metadata;
+  prepared.payload.document = document;
+  if (wal_ != nullptr) {
+    try {
+      prepared.encoded = encode_wal_payload(prepared.payload);
+    } catch (...) {
+      // Left empty: the locked path encodes again and reports the failure.
+      prepared.encoded.clear();
+    }
+  }
+  return prepared;
+}
+
+[[nodiscard]] auto SegmentedCollection::prepare_batch_payloads(
+    const BatchMutationRequest &request) const -> std::vector<PreparedPayload> {
+  std::vector<PreparedPayload> prepared(request.rows.size());
+  for (std::size_t index = 0; index < request.rows.size(); ++index) {
+    const auto &row = request.rows[index];
+    if (row.action == RowMutationAction::write) {
+      prepared[index] = prepare_payload(row.logical_id, row.vector, row.metadata, row.document);
+    }
+  }
+  return prepared;
+}
+
 [[nodiscard]] auto SegmentedCollection::validate_batch_row(const RoutingSnapshotPtr &current,
-                                                           const BatchRowMutation &row) const
+                                                           const BatchRowMutation &row,
+                                                           PreparedPayload &prepared) const
     -> ValidatedBatchRow {
   ValidatedBatchRow result;
   if (!validate_logical_id(row.logical_id, core::OperationStage::validation).ok()) {
@@ -188,8 +246,7 @@ namespace alaya::internal::collection {
     result.valid = true;
     return result;
   }
-  auto tensor = core::validate_tensor(row.vector, schema_.dim, core::OperationStage::validation);
-  if (!tensor.ok() || row.vector.rows != 1 || row.vector.scalar_type != schema_.scalar_type) {
+  if (!prepared.status.ok()) {
     return result;
   }
   if (row.write_mode == WriteMode::insert_only && live) {
@@ -200,13 +257,8 @@ namespace alaya::internal::collection {
     result.status = RowMutationStatus::not_found;
     return result;
   }
-  auto owned = OwnedVector::copy_row(row.vector, 0);
-  if (!owned.ok()) {
-    return result;
-  }
-  result.payload.vector = std::move(owned).value();
-  result.payload.metadata = row.metadata;
-  result.payload.document = row.document;
+  result.payload = std::move(prepared.payload);
+  result.encoded_payload = std::move(prepared.encoded);
   result.status = !live                                  ? RowMutationStatus::inserted
                   : row.write_mode == WriteMode::replace ? RowMutationStatus::replaced
                                                          : RowMutationStatus::updated;
@@ -238,11 +290,12 @@ namespace alaya::internal::collection {
 
 [[nodiscard]] auto SegmentedCollection::mutate_batch_row_locked(RoutingSnapshotPtr current,
                                                                 const BatchRowMutation &row,
+                                                                PreparedPayload &prepared,
                                                                 core::MutationContext &context,
                                                                 const WriteOptions &options,
                                                                 std::uint64_t batch_op_id)
     -> core::Result<MutationReceipt> {
-  auto validated = validate_batch_row(current, row);
+  auto validated = validate_batch_row(current, row, prepared);
   if (!validated.valid) {
     return make_non_searchable_receipt(current, batch_op_id, validated.status, options.retry_token);
   }
@@ -253,12 +306,14 @@ namespace alaya::internal::collection {
                        validated.status,
                        context,
                        options,
-                       batch_op_id);
+                       batch_op_id,
+                       std::move(validated.encoded_payload));
 }
 
 [[nodiscard]] auto SegmentedCollection::mutate_atomic_batch_locked(
     RoutingSnapshotPtr current,
     const BatchMutationRequest &request,
+    std::vector<PreparedPayload> &prepared,
     core::MutationContext &context,
     std::uint64_t batch_op_id) -> core::Result<BatchMutationReceipt> {
   const auto target = current->find_active_mutable();
@@ -276,7 +331,7 @@ namespace alaya::internal::collection {
   for (std::size_t index = 0; index < request.rows.size(); ++index) {
     auto [unused, inserted] = first_occurrence.emplace(request.rows[index].logical_id, index);
     (void)unused;
-    auto row = validate_batch_row(current, request.rows[index]);
+    auto row = validate_batch_row(current, request.rows[index], prepared[index]);
     if (!inserted) {
       row.valid = false;
       row.status = RowMutationStatus::conflict;
@@ -337,6 +392,7 @@ namespace alaya::internal::collection {
     row.target = {target->segment_id, target->generation, core::SegmentRowId(row_value)};
     row.previous = validated[index].previous;
     row.payload = std::move(validated[index].payload);
+    row.encoded_payload = std::move(validated[index].encoded_payload);
     row.retry_token = request.rows[index].retry_token;
     if (row.retry_token.empty() && !request.options.retry_token.empty()) {
       row.retry_token = request.options.retry_token + "#" + std::to_string(index);
@@ -408,17 +464,72 @@ namespace alaya::internal::collection {
   try {
     const auto payload = encode_batch_receipt_marker(receipt);
     const auto durable = durability == WriteDurability::wal_fsync;
-    return wal_->append(LogicalWalRecordType::publish_marker,
-                        static_cast<std::uint8_t>(0x80U | (durable ? 1U : 0U)),
-                        receipt.batch_op_id,
-                        receipt.batch_op_id,
-                        payload,
-                        durable ? LogicalWalSync::fsync : LogicalWalSync::buffered);
+    auto status = wal_->append(LogicalWalRecordType::publish_marker,
+                               static_cast<std::uint8_t>(0x80U | (durable ? 1U : 0U)),
+                               receipt.batch_op_id,
+                               receipt.batch_op_id,
+                               payload,
+                               durable ? LogicalWalSync::flush : LogicalWalSync::buffered);
+    group_sync_pending_ = group_sync_pending_ || (status.ok() && durable);
+    return status;
   } catch (...) {
     return core::status_from_exception(core::OperationStage::completion);
   }
 }
 
+void SegmentedCollection::advance_durable_watermark(std::uint64_t watermark) {
+  const auto current = load_snapshot();
+  if (current->durable_watermark >= watermark) {
+    return;
+  }
+  // A new watermark is a new snapshot version, so readers and caches keyed
+  // on generation or metadata_epoch see it change.
+  auto durable = std::make_shared<RoutingSnapshot>(*current);
+  durable->generation = current->generation + 1;
+  durable->metadata_epoch = current->metadata_epoch + 1;
+  durable->durable_watermark = watermark;
+  publish_snapshot(std::move(durable));
+}
+
+void SegmentedCollection::stamp_durable_watermark(MutationReceipt &receipt,
+                                                  std::uint64_t watermark) {
+  if (receipt.durability != DurabilityState::wal_fsync || receipt.durable_watermark >= watermark) {
+    return;
+  }
+  receipt.durable_watermark = watermark;
+  if (receipt.retry_token.empty()) {
+    return;
+  }
+  const auto stored = retry_receipts_.find(receipt.retry_token);
+  if (stored != retry_receipts_.end() && stored->second.op_id == receipt.op_id) {
+    stored->second.durable_watermark = std::max(stored->second.durable_watermark, watermark);
+  }
+}
+
+void SegmentedCollection::stamp_durable_watermark(std::vector<MutationReceipt> &receipts,
+                                                  std::uint64_t watermark) {
+  for (auto &receipt : receipts) {
+    stamp_durable_watermark(receipt, watermark);
+  }
+}
+
+void SegmentedCollection::stamp_durable_watermark(BatchMutationReceipt &receipt,
+                                                  std::uint64_t watermark) {
+  stamp_durable_watermark(receipt.rows, watermark);
+  if (receipt.durability != DurabilityState::wal_fsync || receipt.durable_watermark >= watermark) {
+    return;
+  }
+  receipt.durable_watermark = watermark;
+  if (receipt.retry_token.empty()) {
+    return;
+  }
+  const auto stored = batch_retry_receipts_.find(receipt.retry_token);
+  if (stored != batch_retry_receipts_.end() && stored->second.batch_op_id == receipt.batch_op_id) {
+    stored->second.durable_watermark = std::max(stored->second.durable_watermark, watermark);
+    stamp_durable_watermark(stored->second.rows, watermark);
+  }
+}
+
 [[nodiscard]] auto SegmentedCollection::make_engine_payloads(
     const WalMutationTransaction &transaction) -> std::vector<SegmentMutationPayload> {
   std::vector<SegmentMutationPayload> payloads;
@@ -443,24 +554,20 @@ namespace alaya::internal::collection {
     const WalMutationTransaction &transaction,
     bool durable) -> core::Result<std::shared_ptr<RoutingSnapshot>> {
   try {
+    // The copy shares both maps with `current`; only the paths to the
+    // transaction's rows are copied below, and the counts are adjusted per row
+    // instead of being recounted over the whole collection.
     auto next = std::make_shared<RoutingSnapshot>(*current);
     next->generation = current->generation + 1;
     next->metadata_epoch = current->metadata_epoch + 1;
     for (const auto &row : transaction.rows) {
-      next->visibility_watermark = std::max(next->visibility_watermark, row.op_id);
-      next->reverse.insert_or_assign(row.target, ReverseEntry{row.logical_id, row.op_id});
-      next->versions.insert_or_assign(row.logical_id,
-                                      VersionEntry{row.target,
-                                                   row.op_id,
-                                                   row.action == SegmentMutationAction::write
-                                                       ? VersionState::live
-                                                       : VersionState::tombstone,
-                                                   row.payload});
-    }
-    if (durable) {
+      apply_row_to_snapshot(*next, row);
+    }
+    // With a WAL the durable watermark advances only after the group sync
+    // that covers this transaction returns; see complete_group_commit().
+    if (durable && wal_ == nullptr) {
       next->durable_watermark = next->visibility_watermark;
     }
-    recalculate_counts(*next);
     return next;
   } catch (...) {
     return core::status_from_exception(core::OperationStage::mutation_stage);
@@ -470,7 +577,7 @@ namespace alaya::internal::collection {
 [[nodiscard]] auto SegmentedCollection::execute_transaction_locked(
     RoutingSnapshotPtr current,
     const std::shared_ptr<SegmentEntry> &target,
-    const WalMutationTransaction &transaction,
+    WalMutationTransaction &transaction,
     core::MutationContext &context,
     std::uint64_t transaction_id) -> core::Result<std::vector<MutationReceipt>> {
   if (auto guard = ensure_not_recovery_required(core::OperationStage::mutation_prepare);
@@ -562,6 +669,12 @@ namespace alaya::internal::collection {
       return status;
     }
   }
+  // Nothing reads the encoded bytes once PREPARE is written; free them
+  // instead of holding a second copy of every row through staging.
+  wal_payload = {};
+  for (auto &row : transaction.rows) {
+    row.encoded_payload = {};
+  }
   if (failpoint(MutationFailPoint::after_prepare)) {
     return injected_failure(MutationFailPoint::after_prepare);
   }
@@ -618,16 +731,20 @@ namespace alaya::internal::collection {
     return injected_failure(MutationFailPoint::metadata_stage_failure);
   }
   if (wal_ != nullptr) {
+    // A durable COMMIT reaches the kernel here, so it survives a process kill;
+    // the fdatasync that covers power loss is shared with concurrent writers
+    // and awaited by complete_group_commit() after mutation_mutex_ is released.
     status = wal_->append(LogicalWalRecordType::commit,
                           durable ? 1U : 0U,
                           transaction_id,
                           transaction.batch_op_id,
                           {},
-                          durable ? LogicalWalSync::fsync : LogicalWalSync::buffered);
+                          durable ? LogicalWalSync::flush : LogicalWalSync::buffered);
     if (!status.ok()) {
       (void)target->segment.abort_mutation(token, engine_context);
       return status;
     }
+    group_sync_pending_ = group_sync_pending_ || durable;
   }
   // B-03: from here (L:COMMIT is durable) until publish_snapshot completes, any
   // non-termination exit must latch a Collection-level recovery-required state, or
@@ -694,36 +811,50 @@ namespace alaya::internal::collection {
   if (transaction.rows.empty()) {
     return core::Status::success();
   }
+  const WalMutationTransaction *const run[] = {&transaction};
+  return replay_engine_run(run);
+}
+
+[[nodiscard]] auto SegmentedCollection::replay_engine_run(
+    std::span<const WalMutationTransaction *const> run) -> core::Status {
+  if (run.empty()) {
+    return core::Status::success();
+  }
+  const auto &first = run.front()->rows.front().target;
   const auto target =
-      load_or_initializing_snapshot_->find_segment(transaction.rows.front().target.segment_id,
-                                                   transaction.rows.front().target.generation);
+      load_or_initializing_snapshot_->find_segment(first.segment_id, first.generation);
   if (target == nullptr) {
     return core::Status::error(core::StatusCode::corruption,
                                core::OperationStage::mutation_replay,
                                core::StatusDetail::readonly_instance,
                                "committed WAL targets an unavailable segment");
   }
-  for (const auto &row : transaction.rows) {
-    if (row.target.segment_id != target->segment_id ||
-        row.target.generation != target->generation) {
-      return core::Status::error(core::StatusCode::corruption,
-                                 core::OperationStage::mutation_replay,
-                                 core::StatusDetail::malformed_struct,
-                                 "one WAL transaction targets multiple segment instances");
-    }
-    const auto row_id = static_cast<std::uint64_t>(row.target.row_id);
-    if (row_id != std::numeric_limits<std::uint64_t>::max()) {
-      auto first_unused = target->next_row_id.load(std::memory_order_acquire);
-      while (first_unused <= row_id &&
-             !target->next_row_id.compare_exchange_weak(first_unused,
-                                                        row_id + 1,
-                                                        std::memory_order_acq_rel)) {
+  std::uint64_t first_unused_floor{};
+  std::uint64_t maximum_row{};
+  for (const auto *transaction : run) {
+    for (const auto &row : transaction->rows) {
+      if (row.target.segment_id != target->segment_id ||
+          row.target.generation != target->generation) {
+        return core::Status::error(core::StatusCode::corruption,
+                                   core::OperationStage::mutation_replay,
+                                   core::StatusDetail::malformed_struct,
+                                   "one WAL transaction targets multiple segment instances");
       }
+      const auto row_id = static_cast<std::uint64_t>(row.target.row_id);
+      if (row_id != std::numeric_limits<std::uint64_t>::max()) {
+        first_unused_floor = std::max(first_unused_floor, row_id + 1);
+      }
+      maximum_row = std::max(maximum_row, row.op_id);
     }
   }
+  auto first_unused = target->next_row_id.load(std::memory_order_acquire);
+  while (first_unused < first_unused_floor &&
+         !target->next_row_id.compare_exchange_weak(first_unused,
+                                                    first_unused_floor,
+                                                    std::memory_order_acq_rel)) {
+  }
   if (!target->segment.capabilities().supports(core::OperationCapability::mutation)) {
     core::SegmentStats stats;
-    const auto maximum_row = std::ranges::max(transaction.rows, {}, &WalMutationRow::op_id).op_id;
     if (target->segment.stats(stats).ok() && stats.snapshot_version >= maximum_row) {
       // A roll-forward reader may have consumed the physical WAL tail into
       // its private working generation before erasing mutation slots. The
@@ -736,24 +867,30 @@ namespace alaya::internal::collection {
                                core::StatusDetail::readonly_instance,
                                "committed WAL targets a reader below its applied watermark");
   }
-  auto payloads = make_engine_payloads(transaction);
-  SegmentMutationBundlePayload bundle;
-  bundle.batch_op_id = transaction.batch_op_id;
-  bundle.rows = payloads;
-  const auto bundled =
-      transaction.batch_mode == BatchMutationMode::all_or_nothing && transaction.rows.size() > 1;
-  core::OpaqueOperationRequest opaque;
-  opaque.payload =
-      bundled ? static_cast<const void *>(&bundle) : static_cast<const void *>(&payloads.front());
-  opaque.payload_size = bundled ? sizeof(bundle) : sizeof(SegmentMutationPayload);
-  core::MutationContext context;
-  context.transaction_token = &transaction;
-  // B-01 set-point #2 (replay): derive the physical txid from the transaction shape
-  // (atomic batch -> batch_op_id, else the single row's op_id), matching the live
-  // path so a replayed transaction hits the same idempotency decision.
-  context.transaction_id = physical_txid(transaction);
-  context.max_row_op_id = transaction_max_row_op(transaction);
-  return target->segment.replay_mutation(opaque, context);
+  for (const auto *transaction : run) {
+    auto payloads = make_engine_payloads(*transaction);
+    SegmentMutationBundlePayload bundle;
+    bundle.batch_op_id = transaction->batch_op_id;
+    bundle.rows = payloads;
+    const auto bundled = transaction->batch_mode == BatchMutationMode::all_or_nothing &&
+                         transaction->rows.size() > 1;
+    core::OpaqueOperationRequest opaque;
+    opaque.payload =
+        bundled ? static_cast<const void *>(&bundle) : static_cast<const void *>(&payloads.front());
+    opaque.payload_size = bundled ? sizeof(bundle) : sizeof(SegmentMutationPayload);
+    core::MutationContext context;
+    context.transaction_token = transaction;
+    // B-01 set-point #2 (replay): derive the physical txid from the transaction shape
+    // (atomic batch -> batch_op_id, else the single row's op_id), matching the live
+    // path so a replayed transaction hits the same idempotency decision.
+    context.transaction_id = physical_txid(*transaction);
+    context.max_row_op_id = transaction_max_row_op(*transaction);
+    auto status = target->segment.replay_mutation(opaque, context);
+    if (!status.ok()) {
+      return status;
+    }
+  }
+  return core::Status::success();
 }
 
 void SegmentedCollection::install_recovered_receipts(const WalMutationTransaction &transaction,
@@ -844,24 +981,35 @@ void SegmentedCollection::install_recovered_receipts(const WalMutationTransactio
   std::sort(active_rows.begin(), active_rows.end(), [&](std::size_t lhs, std::size_t rhs) {
     return image.state.rows[lhs].op_id < image.state.rows[rhs].op_id;
   });
-  for (const auto index : active_rows) {
-    WalMutationTransaction single;
-    single.batch_op_id = image.state.rows[index].op_id;
+  std::vector<WalMutationTransaction> singles(active_rows.size());
+  std::vector<const WalMutationTransaction *> run;
+  run.reserve(singles.size());
+  for (std::size_t i = 0; i < active_rows.size(); ++i) {
+    auto &single = singles[i];
+    single.batch_op_id = image.state.rows[active_rows[i]].op_id;
     single.batch_mode = BatchMutationMode::per_row_independent;
     single.durability = WriteDurability::wal_fsync;
-    single.rows.push_back(image.state.rows[index]);
-    const auto status = replay_engine_transaction(single);
-    if (!status.ok()) {
-      return status;
+    single.rows.push_back(image.state.rows[active_rows[i]]);
+    const auto &target = single.rows.front().target;
+    if (!run.empty() && (run.front()->rows.front().target.segment_id != target.segment_id ||
+                         run.front()->rows.front().target.generation != target.generation)) {
+      if (auto status = replay_engine_run(run); !status.ok()) {
+        return status;
+      }
+      run.clear();
     }
+    run.push_back(&single);
   }
-  return core::Status::success();
+  return replay_engine_run(run);
 }
 
 [[nodiscard]] auto SegmentedCollection::recover_durable_state(
     std::shared_ptr<RoutingSnapshot> &snapshot) -> core::Status {
   load_or_initializing_snapshot_ = snapshot;
-  auto checkpoint = CollectionCheckpointStore::load(wal_->directory());
+  const auto wal_directory = CollectionLogicalWal::directory_for(config_.wal.root);
+  checkpoints_ =
+      std::make_unique<CollectionCheckpointStore>(wal_directory, config_.wal.checkpoint_max_deltas);
+  auto checkpoint = checkpoints_->load();
   if (!checkpoint.ok()) {
     return checkpoint.status();
   }
@@ -873,25 +1021,102 @@ void SegmentedCollection::install_recovered_receipts(const WalMutationTransactio
       return status;
     }
   }
-  struct Pending {
-    WalMutationTransaction transaction{};
-    std::uint64_t transaction_id{};
-  };
   struct Committed {
     WalMutationTransaction transaction{};
     std::uint64_t transaction_id{};
     bool durable{};
-    bool publish_marker{};
+    bool replay{};
   };
-  std::map<std::uint64_t, Pending> pending;
-  std::vector<Committed> committed;
-  std::map<std::uint64_t, std::size_t> committed_index;
-  try {
-    for (const auto &frame : wal_->recovery_scan().frames) {
+  struct Unmarked {
+    std::uint64_t batch_op_id{};
+    bool durable{};
+  };
+  // The WAL is applied while it streams, so only what is still open stays in
+  // memory: prepares awaiting their commit, committed transactions waiting
+  // in the current engine run, and commits whose publish marker has not been
+  // seen yet.
+  std::map<std::uint64_t, WalMutationTransaction> pending;
+  std::vector<Committed> run;
+  std::map<std::uint64_t, Unmarked> unmarked;
+  auto watermark = snapshot->visibility_watermark;
+
+  const auto replay_started = std::chrono::steady_clock::now();
+  recovery_replay_ = CollectionReplayProgress{};
+  {
+    std::error_code ignored;
+    const auto bytes = std::filesystem::file_size(wal_directory / kCollectionWalFilename, ignored);
+    recovery_replay_.wal_bytes_total = ignored ? 0 : bytes;
+  }
+  const auto interval = std::max<std::uint64_t>(1, config_.recovery.replay_progress_interval);
+  auto next_report = interval;
+  auto report = [&](bool final_report) {
+    recovery_replay_.elapsed = std::chrono::steady_clock::now() - replay_started;
+    if (config_.recovery.replay_progress &&
+        (final_report || recovery_replay_.transactions_replayed >= next_report)) {
+      config_.recovery.replay_progress(recovery_replay_);
+      next_report = recovery_replay_.transactions_replayed + interval;
+    }
+  };
+
+  // Engines replay the run's transactions first, as runs on one segment
+  // instance; then every buffered commit is applied, in commit order, to
+  // `snapshot`. The snapshot is private to open() until it is published, so
+  // it is updated in place and apply_row_to_snapshot keeps the counts exact.
+  auto flush_run = [&]() -> core::Status {
+    std::vector<const WalMutationTransaction *> replay;
+    for (const auto &entry : run) {
+      if (entry.replay) {
+        replay.push_back(&entry.transaction);
+      }
+    }
+    if (auto status = replay_engine_run(replay); !status.ok()) {
+      return status;
+    }
+    auto &working = *snapshot;
+    for (const auto &entry : run) {
+      if (entry.replay) {
+        ++working.generation;
+        ++working.metadata_epoch;
+        for (const auto &row : entry.transaction.rows) {
+          apply_row_to_snapshot(working, row);
+        }
+        if (entry.durable) {
+          working.durable_watermark = working.visibility_watermark;
+        }
+        ++recovery_replay_.transactions_replayed;
+        recovery_replay_.rows_replayed += entry.transaction.rows.size();
+      }
+      install_recovered_receipts(entry.transaction,
+                                 working,
+                                 entry.durable ? DurabilityState::wal_fsync
+                                               : DurabilityState::searchable_not_durable);
+    }
+    run.clear();
+    report(false);
+    return core::Status::success();
+  };
+  // A run holds at most one progress interval of commits, so reports keep
+  // coming on a single-segment WAL, and replays on one segment instance.
+  auto run_accepts = [&](const Committed &entry) {
+    if (run.size() >= interval) {
+      return false;
+    }
+    const auto front = std::ranges::find_if(run, &Committed::replay);
+    if (!entry.replay || front == run.end()) {
+      return true;
+    }
+    const auto &target = front->transaction.rows.front().target;
+    const auto &next = entry.transaction.rows.front().target;
+    return next.segment_id == target.segment_id && next.generation == target.generation;
+  };
+
+  const auto on_frame = [&](const LogicalWalFrameView &frame) -> core::Status {
+    try {
+      recovery_replay_.wal_bytes_scanned = frame.offset + frame.size;
       maximum_recovered_op_id_ = std::max(maximum_recovered_op_id_, frame.op_id);
       if (frame.type == LogicalWalRecordType::checkpoint) {
         wal_cut = std::max(wal_cut, frame.op_id);
-        continue;
+        return core::Status::success();
       }
       if (frame.type == LogicalWalRecordType::prepare) {
         auto transaction = decode_wal_transaction(frame.payload);
@@ -904,21 +1129,33 @@ void SegmentedCollection::install_recovered_receipts(const WalMutationTransactio
         for (const auto &row : transaction.rows) {
           maximum_recovered_op_id_ = std::max(maximum_recovered_op_id_, row.op_id);
         }
-        pending.insert_or_assign(frame.op_id, Pending{std::move(transaction), frame.op_id});
-        continue;
+        pending.insert_or_assign(frame.op_id, std::move(transaction));
+        return core::Status::success();
       }
       if (frame.type == LogicalWalRecordType::commit) {
         const auto found = pending.find(frame.op_id);
-        if (found == pending.end() || committed_index.contains(frame.op_id)) {
-          continue;
+        if (found == pending.end()) {
+          return core::Status::success();
         }
-        committed_index.emplace(frame.op_id, committed.size());
-        committed.push_back(Committed{std::move(found->second.transaction),
-                                      frame.op_id,
-                                      (frame.flags & 1U) != 0,
-                                      false});
+        Committed entry{std::move(found->second), frame.op_id, (frame.flags & 1U) != 0, false};
         pending.erase(found);
-        continue;
+        // A commit repeated later in the WAL stays at or below the watermark
+        // its first copy left, so it is never replayed twice.
+        const auto maximum_row =
+            std::ranges::max(entry.transaction.rows, {}, &WalMutationRow::op_id).op_id;
+        if (maximum_row > wal_cut && maximum_row > watermark) {
+          watermark = maximum_row;
+          entry.replay = true;
+        }
+        if (!run_accepts(entry)) {
+          if (auto status = flush_run(); !status.ok()) {
+            return status;
+          }
+        }
+        unmarked.insert_or_assign(entry.transaction_id,
+                                  Unmarked{entry.transaction.batch_op_id, entry.durable});
+        run.push_back(std::move(entry));
+        return core::Status::success();
       }
       if ((frame.flags & 0x80U) != 0U) {
         auto receipt = decode_batch_receipt_marker(frame.payload);
@@ -929,18 +1166,29 @@ void SegmentedCollection::install_recovered_receipts(const WalMutationTransactio
                                      "batch receipt WAL marker identity is invalid");
         }
         batch_retry_receipts_.insert_or_assign(receipt.retry_token, std::move(receipt));
-        continue;
-      }
-      const auto found = committed_index.find(frame.op_id);
-      if (found != committed_index.end()) {
-        committed[found->second].publish_marker = true;
+        return core::Status::success();
       }
+      unmarked.erase(frame.op_id);
+      return core::Status::success();
+    } catch (const std::invalid_argument &error) {
+      return core::Status::error(core::StatusCode::corruption,
+                                 core::OperationStage::mutation_replay,
+                                 core::StatusDetail::malformed_struct,
+                                 error.what());
+    } catch (...) {
+      return core::status_from_exception(core::OperationStage::mutation_replay);
+    }
+  };
+  auto opened = CollectionLogicalWal::open(
+      config_.wal.root, config_.wal.namespace_name, config_.read_only, on_frame);
+  if (!opened.ok()) {
+    return opened.status();
+  }
+  wal_ = std::move(opened).value();
+  try {
+    if (auto status = flush_run(); !status.ok()) {
+      return status;
     }
-  } catch (const std::invalid_argument &error) {
-    return core::Status::error(core::StatusCode::corruption,
-                               core::OperationStage::mutation_replay,
-                               core::StatusDetail::malformed_struct,
-                               error.what());
   } catch (...) {
     return core::status_from_exception(core::OperationStage::mutation_replay);
   }
@@ -948,39 +1196,19 @@ void SegmentedCollection::install_recovered_receipts(const WalMutationTransactio
   const auto active = snapshot->find_active_mutable();
   if (active != nullptr) {
     core::MutationContext context;
-    for (const auto &[unused, transaction] : pending) {
+    for (const auto &[transaction_id, unused] : pending) {
       (void)unused;
       core::MutationToken token;
-      token.value = transaction.transaction_id;
+      token.value = transaction_id;
       (void)active->segment.abort_mutation(token, context);
     }
   }
-
-  for (auto &entry : committed) {
-    const auto maximum_row =
-        std::ranges::max(entry.transaction.rows, {}, &WalMutationRow::op_id).op_id;
-    if (maximum_row > wal_cut && maximum_row > snapshot->visibility_watermark) {
-      load_or_initializing_snapshot_ = snapshot;
-      auto status = replay_engine_transaction(entry.transaction);
-      if (!status.ok()) {
-        return status;
-      }
-      auto next = build_dark_snapshot(snapshot, entry.transaction, entry.durable);
-      if (!next.ok()) {
-        return next.status();
-      }
-      snapshot = std::move(next).value();
-      load_or_initializing_snapshot_ = snapshot;
-    }
-    install_recovered_receipts(entry.transaction,
-                               *snapshot,
-                               entry.durable ? DurabilityState::wal_fsync
-                                             : DurabilityState::searchable_not_durable);
-    if (!entry.publish_marker && !config_.read_only) {
+  if (!config_.read_only) {
+    for (const auto &[transaction_id, marker] : unmarked) {
       const auto status = wal_->append(LogicalWalRecordType::publish_marker,
-                                       entry.durable ? 1U : 0U,
-                                       entry.transaction_id,
-                                       entry.transaction.batch_op_id,
+                                       marker.durable ? 1U : 0U,
+                                       transaction_id,
+                                       marker.batch_op_id,
                                        {},
                                        LogicalWalSync::flush);
       if (!status.ok()) {
@@ -988,6 +1216,7 @@ void SegmentedCollection::install_recovered_receipts(const WalMutationTransactio
       }
     }
   }
+  report(true);
   load_or_initializing_snapshot_.reset();
   return core::Status::success();
 }
@@ -7,6 +7,21 @@
 #include "index/disk/laser_segment.hpp"
 
 namespace alaya::internal::collection {
+namespace {
+
+void accumulate_search_stats(core::SearchStats &into, const core::SearchStats &from) noexcept {
+  into.visited += from.visited;
+  into.io_bytes += from.io_bytes;
+  into.io_requests += from.io_requests;
+  into.cache_hits += from.cache_hits;
+  into.filter_candidates += from.filter_candidates;
+  into.rerank_count += from.rerank_count;
+  into.budget_wait_nanoseconds += from.budget_wait_nanoseconds;
+  into.device_reads += from.device_reads;
+  into.coalesced_reads += from.coalesced_reads;
+}
+
+}  // namespace
 
 [[nodiscard]] auto SegmentedCollection::search_at_snapshot(const RoutingSnapshotPtr &snapshot,
                                                            const CollectionSearchRequest &request,
@@ -41,6 +56,14 @@ namespace alaya::internal::collection {
   if (!status.ok()) {
     return status;
   }
+  // The first search waits out a background artifact verification; later
+  // ones read its settled verdict.
+  if (config_.artifact_verification != nullptr) {
+    status = config_.artifact_verification->wait();
+    if (!status.ok()) {
+      return status;
+    }
+  }
 
   CollectionSearchResult result;
   result.visibility_watermark = snapshot->visibility_watermark;
@@ -172,6 +195,246 @@ namespace alaya::internal::collection {
   return result;
 }
 
+// One segment's share of a fanout round. Everything the segment request
+// points into lives here, at a stable heap address, until the round has
+// consumed the response: make_*_search_extension() stores the address of its
+// argument, so the effort payloads must outlive every read through
+// `extensions`, including the one inside the segment search itself.
+struct SegmentedCollection::SegmentDispatch {
+  SegmentDispatch(std::shared_ptr<SegmentEntry> segment_entry,
+                  core::RowCount query_rows,
+                  core::RowCount rows,
+                  core::RowCount limit)
+      : entry(std::move(segment_entry)),
+        known_rows(rows),
+        candidate_limit(limit),
+        storage(query_rows, limit) {}
+
+  std::shared_ptr<SegmentEntry> entry{};
+  core::RowCount known_rows{};
+  core::RowCount candidate_limit{};
+  SegmentSearchStorage storage;
+  std::vector<core::AlgorithmSearchExtension> extensions{};
+  ::alaya::QgSearchExtension qg_effort{};
+  ::alaya::disk::LaserSegmentSearchExtension laser_effort{};
+  std::vector<std::uint64_t> filter_storage{};
+  // Planned I/O of one round of this segment (disk segments only).
+  std::uint64_t io_requests{};
+  std::uint64_t io_bytes{};
+  // Segments may run concurrently, so each gets a private copy of the
+  // caller's context and SearchStats; the stats are folded back afterwards.
+  // Its scratch lease and I/O credits are this segment's share of the
+  // caller's, never the whole budget (see share_search_budget).
+  core::SearchContext context{};
+  core::SearchStats stats{};
+  core::SearchRequest request{};
+  core::Status status{};
+};
+
+void SegmentedCollection::run_segment_dispatch(SegmentDispatch &dispatch,
+                                               const CollectionSearchRequest &request,
+                                               core::FilterExecution execution) noexcept {
+  try {
+    dispatch.status = core::validate_runtime_control(dispatch.context.deadline,
+                                                     dispatch.context.cancellation,
+                                                     core::OperationStage::search);
+    if (!dispatch.status.ok()) {
+      return;
+    }
+    const auto &entry = *dispatch.entry;
+    const auto reentrant = entry.segment.capabilities().concurrency.reentrant_search;
+    const auto search = [&](core::SearchRequest segment_request) {
+      if (reentrant) {
+        std::shared_lock operation_lock(entry.operation_mutex);
+        return entry.segment.search(std::move(segment_request));
+      }
+      std::unique_lock operation_lock(entry.operation_mutex);
+      return entry.segment.search(std::move(segment_request));
+    };
+    dispatch.status = search(dispatch.request);
+    if (!dispatch.status.ok() && execution == core::FilterExecution::traversal &&
+        request.filter.active() && dispatch.status.code() == core::StatusCode::not_supported &&
+        request.options.filter_policy == core::FilterPolicy::automatic) {
+      // This segment cannot execute the bitmap filter it was just
+      // handed (qg/disk_flat all still reject any non-none
+      // filter kind). Re-planning the whole query would cost a
+      // second selectivity pass; instead retry just this segment
+      // unfiltered -- the per-hit re-verify in fanout_search (already
+      // unconditional whenever execution == traversal &&
+      // request.filter.active(), independent of whether *this*
+      // segment's own request carried a filter) weeds out
+      // non-matching rows, and the existing overfetch/incomplete
+      // machinery covers any resulting shortfall. strict policy is
+      // deliberately excluded: it keeps today's fail-fast semantics
+      // (a strong-consistency request must not silently degrade).
+      auto retry_request = dispatch.request;
+      retry_request.filter = core::SegmentFilterView{};
+      dispatch.status = search(std::move(retry_request));
+    }
+  } catch (...) {
+    dispatch.status = core::status_from_exception(core::OperationStage::search);
+  }
+}
+
+void SegmentedCollection::share_search_budget(
+    std::vector<std::unique_ptr<SegmentDispatch>> &dispatches,
+    const core::SearchContext &context,
+    SegmentFanout fanout) noexcept {
+  // I/O credits are spent, not returned, so the round's disk segments split
+  // them in every mode: each gets its planned demand plus an even part of
+  // the surplus. A segment that does no I/O keeps the caller's credits.
+  const auto split = [&](std::uint64_t available, auto demand_of, auto assign) {
+    if (available == core::kUnlimitedResource) {
+      return;
+    }
+    std::uint64_t total{};
+    std::uint64_t disk{};
+    for (const auto &dispatch : dispatches) {
+      if (dispatch->io_requests != 0) {
+        total = core::checked_add(total, demand_of(*dispatch), total)
+                    ? total
+                    : core::kUnlimitedResource;
+        ++disk;
+      }
+    }
+    const auto surplus = disk == 0 || available <= total ? 0 : (available - total) / disk;
+    for (auto &dispatch : dispatches) {
+      if (dispatch->io_requests != 0) {
+        assign(*dispatch, std::min(available, demand_of(*dispatch) + surplus));
+      }
+    }
+  };
+  split(
+      context.io_credits.available_requests,
+      [](const SegmentDispatch &dispatch) { return dispatch.io_requests; },
+      [](SegmentDispatch &dispatch, std::uint64_t share) {
+        dispatch.context.io_credits.available_requests = share;
+      });
+  split(
+      context.io_credits.available_bytes,
+      [](const SegmentDispatch &dispatch) { return dispatch.io_bytes; },
+      [](SegmentDispatch &dispatch, std::uint64_t share) {
+        dispatch.context.io_credits.available_bytes = share;
+      });
+  // Scratch is released when a segment finishes, so only segments that run
+  // at the same time divide the lease. A segment that needs more than its
+  // slice reruns alone afterwards (run_segment_dispatches).
+  const auto scratch = context.query_scratch_lease.available_bytes;
+  if (scratch != core::kUnlimitedResource && fanout == SegmentFanout::parallel &&
+      dispatches.size() > 1) {
+    for (auto &dispatch : dispatches) {
+      dispatch->context.query_scratch_lease.available_bytes = scratch / dispatches.size();
+    }
+  }
+}
+
+void SegmentedCollection::run_segment_dispatches(
+    std::vector<std::unique_ptr<SegmentDispatch>> &dispatches,
+    const CollectionSearchRequest &request,
+    core::FilterExecution execution) {
+  if (request.fanout == SegmentFanout::sequential || dispatches.size() < 2) {
+    for (auto &dispatch : dispatches) {
+      run_segment_dispatch(*dispatch, request, execution);
+    }
+    return;
+  }
+  // The caller and helpers on the shared sync-adapter workers claim segments
+  // from one cursor. The caller keeps claiming until none are left, so the
+  // round never depends on a free worker (the caller may itself be one); it
+  // then waits only for segments a helper has already started. A helper that
+  // starts late touches nothing but the shared cursor.
+  struct Round {
+    std::atomic<std::size_t> next{};
+    std::mutex mutex{};
+    std::condition_variable finished{};
+    std::size_t completed{};
+  };
+  const auto count = dispatches.size();
+  auto round = std::make_shared<Round>();
+  const auto drain = [round, count, &dispatches, &request, execution] {
+    for (;;) {
+      const auto index = round->next.fetch_add(1, std::memory_order_acq_rel);
+      if (index >= count) {
+        return;
+      }
+      run_segment_dispatch(*dispatches[index], request, execution);
+      {
+        std::lock_guard lock(round->mutex);
+        ++round->completed;
+      }
+      round->finished.notify_all();
+    }
+  };
+  for (std::size_t helper = 1; helper < count; ++helper) {
+    try {
+      core::detail::SyncAdapterExecutor::instance().submit(drain);
+    } catch (...) {
+      break;  // The caller drains whatever no helper picks up.
+    }
+  }
+  drain();
+  {
+    std::unique_lock lock(round->mutex);
+    round->finished.wait(lock, [&] {
+      return round->completed == count;
+    });
+  }
+  // A segment whose slice of the scratch lease is below what it needs for
+  // the query refuses it up front. Those segments rerun one at a time with
+  // the whole lease, as the sequential fanout would have run them.
+  const auto &lease = request.context->query_scratch_lease;
+  for (auto &dispatch : dispatches) {
+    if (dispatch->status.code() == core::StatusCode::resource_exhausted &&
+        dispatch->status.detail() == core::StatusDetail::budget_denied &&
+        dispatch->context.query_scratch_lease.available_bytes < lease.available_bytes) {
+      dispatch->context.query_scratch_lease = lease;
+      run_segment_dispatch(*dispatch, request, execution);
+    }
+  }
+}
+
+void SegmentedCollection::merge_hit_runs(std::vector<CollectionHit> &hits,
+                                         const std::vector<std::size_t> &run_ends) {
+  struct Cursor {
+    std::size_t next{};
+    std::size_t end{};
+  };
+  std::vector<Cursor> cursors;
+  cursors.reserve(run_ends.size());
+  std::size_t begin{};
+  for (const auto end : run_ends) {
+    if (end > begin) {
+      const auto first = hits.begin() + static_cast<std::ptrdiff_t>(begin);
+      const auto last = hits.begin() + static_cast<std::ptrdiff_t>(end);
+      if (!std::is_sorted(first, last, hit_precedes)) {
+        std::sort(first, last, hit_precedes);
+      }
+      cursors.push_back({begin, end});
+    }
+    begin = end;
+  }
+  if (cursors.size() < 2) {
+    return;
+  }
+  const auto later = [&hits](const Cursor &lhs, const Cursor &rhs) {
+    return hit_precedes(hits[rhs.next], hits[lhs.next]);
+  };
+  std::make_heap(cursors.begin(), cursors.end(), later);
+  std::vector<CollectionHit> merged;
+  merged.reserve(hits.size());
+  while (!cursors.empty()) {
+    std::pop_heap(cursors.begin(), cursors.end(), later);
+    auto &cursor = cursors.back();
+    merged.push_back(std::move(hits[cursor.next++]));
+    if (cursor.next == cursor.end) {
+      cursors.pop_back();
+    } else {
+      std::push_heap(cursors.begin(), cursors.end(), later);
+    }
+  }
+  hits = std::move(merged);
+}
+
 [[nodiscard]] auto SegmentedCollection::fanout_search(const RoutingSnapshotPtr &snapshot,
                                                       const CollectionSearchRequest &request,
                                                       core::FilterExecution execution)
@@ -184,10 +447,14 @@ namespace alaya::internal::collection {
 
   for (std::uint32_t round = 0;; ++round) {
     std::vector<std::vector<Candidate>> candidates(static_cast<std::size_t>(request.queries.rows));
+    // Per query, the end offset of each segment's run inside candidates.
+    std::vector<std::vector<std::size_t>> run_ends(static_cast<std::size_t>(request.queries.rows));
     std::vector<bool> exhaustive(static_cast<std::size_t>(request.queries.rows), true);
     std::vector<core::Status> per_query_status(static_cast<std::size_t>(request.queries.rows),
                                                core::Status::success());
 
+    std::vector<std::unique_ptr<SegmentDispatch>> dispatches;
+    dispatches.reserve(snapshot->segments.size());
     for (const auto &entry : snapshot->segments) {
       const auto known_rows = snapshot->known_rows_for(*entry);
       if (known_rows == 0) {
@@ -203,33 +470,22 @@ namespace alaya::internal::collection {
                                    core::StatusDetail::arithmetic_overflow,
                                    "collection fanout sink size is not representable");
       }
-      SegmentSearchStorage storage(request.queries.rows, candidate_limit);
+      dispatches.push_back(std::make_unique<SegmentDispatch>(entry,
+                                                             request.queries.rows,
+                                                             known_rows,
+                                                             candidate_limit));
+      auto &dispatch = *dispatches.back();
+      auto &segment_extensions = dispatch.extensions;
       const auto descriptor = entry->segment.descriptor();
       const auto is_memory_graph = descriptor.algorithm_id == core::algorithm::qg;
       const auto is_qg_laser =
           is_memory_graph && descriptor.engine_factory_id == core::algorithm::laser;
-      std::vector<core::AlgorithmSearchExtension> segment_extensions;
       segment_extensions.reserve(request.options.extensions.size() + 1);
       for (const auto &extension : request.options.extensions) {
         if (extension.algorithm_id == descriptor.algorithm_id) {
           segment_extensions.push_back(extension);
         }
       }
-      // Declared at this scope (one per segment-loop iteration), not
-      // inside the `if` below: make_qg_search_extension() stores
-      // payload = std::addressof(its argument), and the resulting
-      // AlgorithmSearchExtension is read through segment_extensions well
-      // past that `if` block's closing brace (segment_request.options.
-      // extensions below, and again inside entry->segment.search()). A
-      // narrower scope here is a dangling-pointer bug -- caught here
-      // because an unrelated local added a few lines down
-      // (segment_filter_storage) perturbed the stack layout enough to
-      // turn latent UB into a real failure (a memory graph segment
-      // rejecting its own synthesized effort extension as corrupt).
-      // Pre-existing, unrelated to the admission contract; fixed in
-      // passing since it now reproduces deterministically.
-      ::alaya::QgSearchExtension qg_effort;
-      ::alaya::disk::LaserSegmentSearchExtension laser_effort;
       if (is_memory_graph) {
         if (candidate_limit > std::numeric_limits<std::uint32_t>::max()) {
           return core::Status::error(core::StatusCode::invalid_argument,
@@ -252,7 +508,7 @@ namespace alaya::internal::collection {
           }
           segment_extensions.push_back(make(effective));
         };  // NOLINT(readability/braces)
-        synthesize_effort(qg_effort, [](const auto &extension) {
+        synthesize_effort(dispatch.qg_effort, [](const auto &extension) {
           return ::alaya::make_qg_search_extension(extension);
         });
         if (is_qg_laser) {
@@ -286,22 +542,19 @@ namespace alaya::internal::collection {
           // reject, while the translated extension is the one this physical
           // engine owns.
           segment_extensions.clear();
-          laser_effort.effort = qg_effort.effort;
-          laser_effort.return_distances = true;
-          auto translated = ::alaya::disk::make_laser_segment_search_extension(laser_effort);
+          dispatch.laser_effort.effort = dispatch.qg_effort.effort;
+          dispatch.laser_effort.return_distances = true;
+          auto translated =
+              ::alaya::disk::make_laser_segment_search_extension(dispatch.laser_effort);
           translated.unknown_policy = core::UnknownExtensionPolicy::ignore_safe;
           segment_extensions.push_back(translated);
         }
       }
-      core::SearchRequest segment_request;
+      auto &segment_request = dispatch.request;
       segment_request.queries = request.queries;
       segment_request.options = request.options;
       segment_request.options.top_k = candidate_limit;
       segment_request.options.extensions = segment_extensions;
-      // segment_filter_storage must outlive the segment.search() call
-      // below (segment_request.filter.payload points into it); declaring
-      // it in this scope, alongside segment_request, guarantees that.
-      std::vector<std::uint64_t> segment_filter_storage;
       if (execution == core::FilterExecution::traversal && request.filter.active()) {
         // No segment type evaluates a LogicalFilter itself (all four
         // reject any non-none/non-bitmap filter kind), so Collection
@@ -309,6 +562,7 @@ namespace alaya::internal::collection {
         // in this segment's row space, and sends kind=bitmap rather
         // than kind=predicate. Segment admission contract section 3
         // (docs/design/segment-admission-contract.md).
+        auto &segment_filter_storage = dispatch.filter_storage;
         segment_filter_storage.assign((known_rows + 63) / 64, std::uint64_t{0});
         for (const auto &[logical_id, version] : snapshot->versions) {
           if (version.address.segment_id != entry->segment_id ||
@@ -335,81 +589,63 @@ namespace alaya::internal::collection {
         segment_request.filter.selectivity_hint =
             request.filter.selectivity_estimate().value_or(1.0);
       }
-      segment_request.context = request.context;
-      segment_request.response = &storage.response;
+      dispatch.context = *request.context;
+      dispatch.context.stats =
+          request.context->stats == nullptr && request.stats == nullptr ? nullptr : &dispatch.stats;
+      segment_request.context = &dispatch.context;
+      segment_request.response = &dispatch.storage.response;
       segment_request.lifetime_pin = std::const_pointer_cast<RoutingSnapshot>(snapshot);
 
-      const auto capabilities = entry->segment.capabilities();
-      if (request.stats != nullptr && descriptor.medium == core::Medium::disk) {
-        std::uint64_t requests{};
-        std::uint64_t bytes{};
+      if (descriptor.medium == core::Medium::disk) {
         std::uint64_t row_bytes{};
-        const auto accounted =
-            core::checked_multiply(request.queries.rows, std::uint64_t{1}, requests) &&
+        auto accounted =
+            core::checked_multiply(request.queries.rows, std::uint64_t{1}, dispatch.io_requests) &&
             core::checked_multiply(entry->segment.descriptor().dim, sizeof(float), row_bytes) &&
-            core::checked_multiply(known_rows, row_bytes, bytes) &&
-            core::checked_multiply(bytes, request.queries.rows, bytes) &&
-            core::checked_add(request.stats->io_requests_consumed,
-                              requests,
-                              request.stats->io_requests_consumed) &&
-            core::checked_add(request.stats->io_bytes_consumed,
-                              bytes,
-                              request.stats->io_bytes_consumed) &&
-            core::checked_add(request.stats->budget_consumed,
-                              bytes,
-                              request.stats->budget_consumed);
+            core::checked_multiply(known_rows, row_bytes, dispatch.io_bytes) &&
+            core::checked_multiply(dispatch.io_bytes, request.queries.rows, dispatch.io_bytes);
+        if (accounted && request.stats != nullptr) {
+          accounted = core::checked_add(request.stats->io_requests_consumed,
+                                        dispatch.io_requests,
+                                        request.stats->io_requests_consumed) &&
+                      core::checked_add(request.stats->io_bytes_consumed,
+                                        dispatch.io_bytes,
+                                        request.stats->io_bytes_consumed) &&
+                      core::checked_add(request.stats->budget_consumed,
+                                        dispatch.io_bytes,
+                                        request.stats->budget_consumed);
+        }
         if (!accounted) {
           return search_budget_denied("collection search runtime accounting overflowed");
         }
       }
-      core::Status segment_status;
-      if (capabilities.concurrency.reentrant_search) {
-        std::shared_lock operation_lock(entry->operation_mutex);
-        segment_status = entry->segment.search(std::move(segment_request));
-      } else {
-        std::unique_lock operation_lock(entry->operation_mutex);
-        segment_status = entry->segment.search(std::move(segment_request));
-      }
-      if (!segment_status.ok() && execution == core::FilterExecution::traversal &&
-          request.filter.active() && segment_status.code() == core::StatusCode::not_supported &&
-          request.options.filter_policy == core::FilterPolicy::automatic) {
-        // This segment cannot execute the bitmap filter it was just
-        // handed (qg/disk_flat all still reject any non-none
-        // filter kind). Re-planning the whole query would cost a
-        // second selectivity pass; instead retry just this segment
-        // unfiltered -- the per-hit re-verify a few lines down (already
-        // unconditional whenever execution == traversal &&
-        // request.filter.active(), independent of whether *this*
-        // segment's own request carried a filter) weeds out
-        // non-matching rows, and the existing overfetch/incomplete
-        // machinery covers any resulting shortfall. strict policy is
-        // deliberately excluded: it keeps today's fail-fast semantics
-        // (a strong-consistency request must not silently degrade).
-        core::SearchRequest retry_request;
-        retry_request.queries = request.queries;
-        retry_request.options = request.options;
-        retry_request.options.top_k = candidate_limit;
-        retry_request.options.extensions = segment_extensions;
-        retry_request.context = request.context;
-        retry_request.response = &storage.response;
-        retry_request.lifetime_pin = std::const_pointer_cast<RoutingSnapshot>(snapshot);
-        if (capabilities.concurrency.reentrant_search) {
-          std::shared_lock operation_lock(entry->operation_mutex);
-          segment_status = entry->segment.search(std::move(retry_request));
-        } else {
-          std::unique_lock operation_lock(entry->operation_mutex);
-          segment_status = entry->segment.search(std::move(retry_request));
-        }
+    }
+
+    share_search_budget(dispatches, *request.context, request.fanout);
+    run_segment_dispatches(dispatches, request, execution);
+    for (const auto &dispatch : dispatches) {
+      if (request.context->stats != nullptr) {
+        accumulate_search_stats(*request.context->stats, dispatch->stats);
+      }
+      if (request.stats != nullptr) {
+        request.stats->device_reads += dispatch->stats.device_reads;
+        request.stats->coalesced_reads += dispatch->stats.coalesced_reads;
       }
-      if (!segment_status.ok()) {
+    }
+
+    for (const auto &dispatch : dispatches) {
+      const auto &entry = dispatch->entry;
+      const auto known_rows = dispatch->known_rows;
+      const auto &storage = dispatch->storage;
+      if (!dispatch->status.ok()) {
         if (request.options.filter_policy != core::FilterPolicy::allow_partial) {
-          return segment_status;
+          return dispatch->status;
         }
         std::fill(exhaustive.begin(), exhaustive.end(), false);
         continue;
       }
-      auto response_status =
-          validate_segment_response(storage.response, request.queries.rows, candidate_limit);
+      auto response_status = validate_segment_response(storage.response,
+                                                       request.queries.rows,
+                                                       dispatch->candidate_limit);
       if (!response_status.ok()) {
         return response_status;
       }
@@ -479,6 +715,7 @@ namespace alaya::internal::collection {
                                                 entry,
                                                 &version->second.payload});
         }
+        run_ends[index].push_back(candidates[index].size());
       }
     }
 
@@ -503,7 +740,12 @@ namespace alaya::internal::collection {
         return normalized.status();
       }
       query_result.hits = std::move(normalized).value();
-      sort_hits(query_result.hits);
+      if (query_result.hits.size() == candidates[index].size()) {
+        merge_hit_runs(query_result.hits, run_ends[index]);
+      } else {
+        // A reranked NaN was dropped, so the run boundaries no longer hold.
+        sort_hits(query_result.hits);
+      }
       query_result.hits.erase(std::unique(query_result.hits.begin(),
                                           query_result.hits.end(),
                                           [](const CollectionHit &lhs, const CollectionHit &rhs) {
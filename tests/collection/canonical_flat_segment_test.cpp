@@ -0,0 +1,310 @@
+// SPDX-FileCopyrightText: 2026 AlayaDB.AI
+// SPDX-License-Identifier: AGPL-3.0-only
+
+#include <algorithm>
+#include <atomic>
+#include <cmath>
+#include <cstdint>
+#include <random>
+#include <thread>
+#include <vector>
+
+#include <gtest/gtest.h>
+
+#include "index/collection/detail/canonical_flat_segment.hpp"
+
+namespace alaya::internal::collection::detail {
+namespace {
+
+constexpr std::uint32_t kDim = 19;
+constexpr std::uint64_t kSegmentId = 7;
+constexpr std::uint64_t kGeneration = 3;
+
+struct SearchStorage {
+  SearchStorage(const void *queries,
+                core::ScalarType scalar_type,
+                core::RowCount query_count,
+                core::RowCount top_k)
+      : hits(static_cast<std::size_t>(query_count * top_k)),
+        offsets(static_cast<std::size_t>(query_count + 1)),
+        counts(static_cast<std::size_t>(query_count)),
+        statuses(static_cast<std::size_t>(query_count)),
+        completeness(static_cast<std::size_t>(query_count)) {
+    response.hits = hits;
+    response.offsets = offsets;
+    response.valid_counts = counts;
+    response.statuses = statuses;
+    response.completeness = completeness;
+    request.queries = {queries,
+                       scalar_type,
+                       query_count,
+                       kDim,
+                       kDim * core::scalar_type_size(scalar_type)};
+    request.options.top_k = top_k;
+    request.context = &context;
+    request.response = &response;
+  }
+
+  core::SearchContext context{};
+  std::vector<core::SearchHit> hits{};
+  std::vector<core::RowCount> offsets{};
+  std::vector<core::RowCount> counts{};
+  std::vector<core::Status> statuses{};
+  std::vector<core::SearchCompleteness> completeness{};
+  core::SearchResponse response{};
+  core::SearchRequest request{};
+};
+
+template <class T>
+auto write_row(CanonicalFlatSegment &segment,
+               std::uint64_t op_id,
+               std::uint64_t row_id,
+               const T *vector,
+               std::optional<std::uint64_t> previous = std::nullopt) -> core::Status {
+  SegmentMutationPayload payload;
+  payload.op_id = op_id;
+  payload.upsert_sequence = op_id;
+  payload.target = {kSegmentId, kGeneration, core::SegmentRowId(row_id)};
+  if (previous.has_value()) {
+    payload.previous = RowAddress{kSegmentId, kGeneration, core::SegmentRowId(*previous)};
+  }
+  payload.vector = core::TypedTensorView::contiguous(vector, 1, kDim);
+  core::OpaqueOperationRequest request;
+  request.payload = &payload;
+  request.payload_size = sizeof(payload);
+  core::MutationContext context;
+  return segment.replay_mutation(request, context);
+}
+
+auto erase_row(CanonicalFlatSegment &segment, std::uint64_t op_id, std::uint64_t row_id)
+    -> core::Status {
+  SegmentMutationPayload payload;
+  payload.action = SegmentMutationAction::erase;
+  payload.op_id = op_id;
+  payload.upsert_sequence = op_id;
+  payload.target = {kSegmentId, kGeneration, core::SegmentRowId(row_id)};
+  payload.previous = payload.target;
+  core::OpaqueOperationRequest request;
+  request.payload = &payload;
+  request.payload_size = sizeof(payload);
+  core::MutationContext context;
+  return segment.replay_mutation(request, context);
+}
+
+template <class T>
+auto oracle_distance(const T *query, const T *row, core::Metric metric) -> double {
+  double dot{};
+  double query_norm{};
+  double row_norm{};
+  double l2{};
+  for (std::uint32_t index = 0; index < kDim; ++index) {
+    const auto lhs = static_cast<double>(query[index]);
+    const auto rhs = static_cast<double>(row[index]);
+    l2 += (lhs - rhs) * (lhs - rhs);
+    dot += lhs * rhs;
+    query_norm += lhs * lhs;
+    row_norm += rhs * rhs;
+  }
+  if (metric == core::Metric::l2) {
+    return l2;
+  }
+  if (metric == core::Metric::inner_product) {
+    return -dot;
+  }
+  return query_norm == 0 || row_norm == 0 ? 0.0 : -dot / std::sqrt(query_norm * row_norm);
+}
+
+class CanonicalFlatMetricTest : public ::testing::TestWithParam<core::Metric> {};
+
+TEST_P(CanonicalFlatMetricTest, ArenaSearchMatchesBruteForceAcrossChunks) {
+  const auto metric = GetParam();
+  CanonicalFlatSegment segment({kDim, metric, core::ScalarType::float32}, kSegmentId, kGeneration);
+  // Spans three arena chunks, with a zero vector for the cosine edge case.
+  constexpr std::uint64_t kRows = 2600;
+  std::mt19937 random(20260516);
+  std::normal_distribution<float> value(0.0F, 1.0F);
+  std::vector<float> rows(kRows * kDim);
+  std::generate(rows.begin(), rows.end(), [&] { return value(random); });
+  std::fill_n(rows.begin() + 5 * kDim, kDim, 0.0F);
+  std::uint64_t op_id{};
+  for (std::uint64_t row = 0; row < kRows; ++row) {
+    ASSERT_TRUE(write_row(segment, ++op_id, row, rows.data() + row * kDim).ok());
+  }
+  std::vector<bool> live(kRows, true);
+  for (std::uint64_t row = 3; row < kRows; row += 7) {
+    ASSERT_TRUE(erase_row(segment, ++op_id, row).ok());
+    live[row] = false;
+  }
+  core::SegmentStats stats;
+  ASSERT_TRUE(segment.stats(stats).ok());
+  EXPECT_EQ(stats.live_rows, static_cast<core::RowCount>(std::ranges::count(live, true)));
+
+  constexpr core::RowCount kQueries = 3;
+  constexpr core::RowCount kTopK = 25;
+  std::vector<float> queries(kQueries * kDim);
+  std::generate(queries.begin(), queries.end(), [&] { return value(random); });
+  SearchStorage storage(queries.data(), core::ScalarType::float32, kQueries, kTopK);
+  ASSERT_TRUE(segment.batch_search(storage.request).ok());
+
+  for (std::size_t query = 0; query < kQueries; ++query) {
+    std::vector<std::pair<double, std::uint64_t>> expected;
+    for (std::uint64_t row = 0; row < kRows; ++row) {
+      if (live[row]) {
+        expected.emplace_back(
+            oracle_distance(queries.data() + query * kDim, rows.data() + row * kDim, metric),
+            row);
+      }
+    }
+    std::sort(expected.begin(), expected.end());
+    ASSERT_TRUE(storage.statuses[query].ok());
+    ASSERT_EQ(storage.counts[query], kTopK);
+    EXPECT_EQ(storage.completeness[query], core::SearchCompleteness::complete_k);
+    for (std::size_t rank = 0; rank < kTopK; ++rank) {
+      const auto &hit = storage.hits[storage.offsets[query] + rank];
+      EXPECT_EQ(static_cast<std::uint64_t>(hit.row_id), expected[rank].second) << rank;
+      EXPECT_NEAR(hit.score, expected[rank].first, 1.0e-4) << rank;
+      EXPECT_EQ(hit.row_version, static_cast<std::uint64_t>(hit.row_id) + 1);
+    }
+  }
+}
+
+INSTANTIATE_TEST_SUITE_P(Metrics,
+                         CanonicalFlatMetricTest,
+                         ::testing::Values(core::Metric::l2,
+                                           core::Metric::inner_product,
+                                           core::Metric::cosine));
+
+TEST(CanonicalFlatSegment, Int8RowsKeepExactScoresAndReportExhaustion) {
+  CanonicalFlatSegment segment({kDim, core::Metric::l2, core::ScalarType::int8},
+                               kSegmentId,
+                               kGeneration);
+  std::vector<std::int8_t> rows(4 * kDim);
+  for (std::size_t index = 0; index < rows.size(); ++index) {
+    rows[index] = static_cast<std::int8_t>(static_cast<int>(index % 23) - 11);
+  }
+  for (std::uint64_t row = 0; row < 4; ++row) {
+    ASSERT_TRUE(write_row(segment, row + 1, row, rows.data() + row * kDim).ok());
+  }
+  // A replacement retires the old row and publishes the new address.
+  ASSERT_TRUE(write_row(segment, 5, 4, rows.data(), 0).ok());
+
+  SearchStorage storage(rows.data(), core::ScalarType::int8, 1, 10);
+  ASSERT_TRUE(segment.search(storage.request).ok());
+  ASSERT_EQ(storage.counts[0], 4U);
+  EXPECT_EQ(storage.completeness[0], core::SearchCompleteness::eligible_exhausted);
+  EXPECT_EQ(static_cast<std::uint64_t>(storage.hits[0].row_id), 4U);
+  EXPECT_EQ(storage.hits[0].score, 0.0F);
+  for (std::size_t rank = 1; rank < 4; ++rank) {
+    const auto row = static_cast<std::uint64_t>(storage.hits[rank].row_id);
+    EXPECT_NE(row, 0U);
+    EXPECT_EQ(storage.hits[rank].score,
+              static_cast<float>(oracle_distance(rows.data(),
+                                                 rows.data() + row * kDim,
+                                                 core::Metric::l2)));
+  }
+}
+
+TEST(CanonicalFlatSegment, SearchDuringPublicationSeesOnlyCompleteRows) {
+  CanonicalFlatSegment segment({kDim, core::Metric::l2, core::ScalarType::float32},
+                               kSegmentId,
+                               kGeneration);
+  constexpr std::uint64_t kRows = 4096;
+  // Every component of row r equals r, so a torn or unpublished row would
+  // surface as a score that does not match its row ID.
+  std::vector<float> rows(kRows * kDim);
+  for (std::uint64_t row = 0; row < kRows; ++row) {
+    std::fill_n(rows.begin() + static_cast<std::ptrdiff_t>(row * kDim),
+                kDim,
+                static_cast<float>(row));
+  }
+  std::atomic_bool done{};
+  std::thread writer([&] {
+    for (std::uint64_t row = 0; row < kRows; ++row) {
+      EXPECT_TRUE(write_row(segment, row + 1, row, rows.data() + row * kDim).ok());
+    }
+    done.store(true);
+  });
+  const std::vector<float> query(kDim, 0.0F);
+  core::RowCount previous_count{};
+  while (!done.load()) {
+    SearchStorage storage(query.data(), core::ScalarType::float32, 1, 8);
+    ASSERT_TRUE(segment.search(storage.request).ok());
+    ASSERT_GE(storage.counts[0], previous_count);
+    previous_count = storage.counts[0];
+    for (std::size_t rank = 0; rank < storage.counts[0]; ++rank) {
+      const auto &hit = storage.hits[rank];
+      const auto row = static_cast<float>(static_cast<std::uint64_t>(hit.row_id));
+      EXPECT_EQ(static_cast<std::uint64_t>(hit.row_id), rank);
+      EXPECT_FLOAT_EQ(hit.score, row * row * kDim);
+      EXPECT_EQ(hit.row_version, static_cast<std::uint64_t>(hit.row_id) + 1);
+    }
+  }
+  writer.join();
+}
+
+TEST(CanonicalFlatSegment, SearchDuringRewriteSeesWholeVersionsOnly) {
+  CanonicalFlatSegment segment({kDim, core::Metric::l2, core::ScalarType::float32},
+                               kSegmentId,
+                               kGeneration);
+  // Version v of row 0 has every component equal to v and sequence v, so a
+  // reader that sees the new sequence with old bytes, or a mix of old and new
+  // bytes, gets a score that does not match the version it reports.
+  constexpr std::uint64_t kVersions = 256;
+  std::atomic_bool done{};
+  std::thread writer([&] {
+    for (std::uint64_t version = 1; version <= kVersions; ++version) {
+      const std::vector<float> row(kDim, static_cast<float>(version));
+      EXPECT_TRUE(write_row(segment, version, 0, row.data()).ok());
+    }
+    done.store(true);
+  });
+  const std::vector<float> query(kDim, 0.0F);
+  std::uint64_t seen{};
+  while (!done.load()) {
+    SearchStorage storage(query.data(), core::ScalarType::float32, 1, 1);
+    ASSERT_TRUE(segment.search(storage.request).ok());
+    if (storage.counts[0] == 0) {
+      continue;
+    }
+    const auto &hit = storage.hits[0];
+    const auto version = static_cast<float>(hit.row_version);
+    ASSERT_EQ(hit.score, version * version * kDim) << hit.row_version;
+    ASSERT_GE(hit.row_version, seen);
+    seen = hit.row_version;
+  }
+  writer.join();
+}
+
+TEST(CanonicalFlatSegment, SparseRowsGrowTheDirectoryAndRewritesCopyTheirChunk) {
+  CanonicalFlatSegment segment({kDim, core::Metric::l2, core::ScalarType::float32},
+                               kSegmentId,
+                               kGeneration);
+  // One row per chunk across 100 chunks outgrows the directory spine several
+  // times; component value c marks the chunk.
+  constexpr std::uint64_t kChunks = 100;
+  constexpr std::uint64_t kChunkRows = 1024;
+  std::uint64_t op_id{};
+  for (std::uint64_t chunk = 0; chunk < kChunks; ++chunk) {
+    const std::vector<float> row(kDim, static_cast<float>(chunk));
+    ASSERT_TRUE(write_row(segment, ++op_id, chunk * kChunkRows, row.data()).ok());
+  }
+  // Replaying a new version over a written row copies its chunk.
+  const std::vector<float> rewritten(kDim, 1000.0F);
+  ASSERT_TRUE(write_row(segment, ++op_id, 0, rewritten.data()).ok());
+
+  const std::vector<float> query(kDim, 0.0F);
+  SearchStorage storage(query.data(), core::ScalarType::float32, 1, kChunks);
+  ASSERT_TRUE(segment.search(storage.request).ok());
+  ASSERT_EQ(storage.counts[0], kChunks);
+  for (std::size_t rank = 0; rank < kChunks; ++rank) {
+    const auto &hit = storage.hits[rank];
+    const auto row_id = static_cast<std::uint64_t>(hit.row_id);
+    ASSERT_EQ(row_id % kChunkRows, 0U);
+    const auto value = row_id == 0 ? 1000.0F : static_cast<float>(row_id / kChunkRows);
+    EXPECT_FLOAT_EQ(hit.score, value * value * kDim) << row_id;
+  }
+  EXPECT_EQ(static_cast<std::uint64_t>(storage.hits[kChunks - 1].row_id), 0U);
+}
+
+}  // namespace
+}  // namespace alaya::internal::collection::detail
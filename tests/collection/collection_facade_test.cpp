@@ -447,6 +447,93 @@ TEST(CollectionFacade, FlatCompactPreservesRowsAndGcDeletesOnlyReleasedSources)
   ASSERT_TRUE(collection->close().ok());
 }
 
+TEST(CollectionFacade, RebuildFoldsEverySegmentIntoOneAndKeepsWrites) {
+  TemporaryDirectory temporary;
+  auto created = Collection::create(flat_options(temporary.path()));
+  ASSERT_TRUE(created.ok()) << created.status().diagnostic();
+  auto collection = std::move(created).value();
+
+  CollectionRebuildOptions retuned;
+  retuned.max_neighbors = 16;
+  auto untouched = collection->rebuild(retuned);
+  ASSERT_TRUE(untouched.ok()) << untouched.status().diagnostic();
+  EXPECT_EQ(untouched.value().rebuilt_rows, 0U);
+  EXPECT_TRUE(untouched.value().source_segment_ids.empty());
+  EXPECT_EQ(collection->options().max_neighbors, 16U);
+
+  const std::array<std::array<float, 2>, 6> vectors{
+      {{0.0F, 0.0F}, {1.0F, 0.0F}, {2.0F, 0.0F}, {3.0F, 0.0F}, {4.0F, 0.0F}, {5.0F, 0.0F}}};
+  for (std::size_t index = 0; index < 4; ++index) {
+    ASSERT_TRUE(collection->add(item("rebuild-" + std::to_string(index), vectors[index])).ok());
+  }
+  ASSERT_TRUE(collection->seal().ok());
+  ASSERT_TRUE(collection->gc().ok());
+  for (std::size_t index = 4; index < 6; ++index) {
+    ASSERT_TRUE(collection->add(item("rebuild-" + std::to_string(index), vectors[index])).ok());
+  }
+  const std::array<float, 2> moved{0.5F, 0.0F};
+  ASSERT_TRUE(collection->upsert(item("rebuild-3", moved)).ok());
+
+  const std::array<float, 2> query{};
+  auto before = collection->search(core::TypedTensorView::contiguous(query.data(), 1, 2), 10);
+  ASSERT_TRUE(before.ok()) << before.status().diagnostic();
+  ASSERT_EQ(before.value().ids.size(), 6U);
+
+  retuned.max_neighbors = 24;
+  retuned.ef_construction = 200;
+  auto rebuilt = collection->rebuild(retuned);
+  ASSERT_TRUE(rebuilt.ok()) << rebuilt.status().diagnostic();
+  EXPECT_EQ(rebuilt.value().source_segment_ids, (std::vector<std::uint64_t>{3, 4}));
+  EXPECT_EQ(rebuilt.value().successor_segment_id, 5U);
+  EXPECT_EQ(rebuilt.value().rebuilt_segment_id, 6U);
+  EXPECT_EQ(rebuilt.value().rebuilt_rows, 6U);
+  EXPECT_GT(rebuilt.value().rebuilt_bytes, 0U);
+  EXPECT_EQ(rebuilt.value().built_algorithm, core::algorithm::flat);
+  EXPECT_EQ(collection->options().max_neighbors, 24U);
+  EXPECT_EQ(collection->options().ef_construction, 200U);
+  {
+    const auto snapshot = internal::collection::CollectionTestAccess::pin_epoch(*collection);
+    expect_known_row_counts_match_reverse(*snapshot);
+    const auto active = snapshot->find_active_mutable();
+    ASSERT_NE(active, nullptr);
+    EXPECT_EQ(active->segment_id, 5U);
+    EXPECT_EQ(snapshot->known_rows_for(*active), 0U);
+  }
+  EXPECT_EQ(collection->stats().sealed_segments_count, 1U);
+  const auto manifest =
+      internal::collection::ArtifactManifestV2::load(temporary.path() / "collection_manifest.txt");
+  EXPECT_EQ(manifest.gc.retained_sources, (std::vector<std::string>{"seg_00000006"}));
+
+  auto after = collection->search(core::TypedTensorView::contiguous(query.data(), 1, 2), 10);
+  ASSERT_TRUE(after.ok()) << after.status().diagnostic();
+  EXPECT_EQ(after.value().ids, before.value().ids);
+  EXPECT_EQ(after.value().distances, before.value().distances);
+
+  const std::array<float, 2> late{9.0F, 0.0F};
+  ASSERT_TRUE(collection->add(item("rebuild-late", late)).ok());
+  EXPECT_EQ(collection->size(), 7U);
+
+  auto reclaimed = collection->gc();
+  ASSERT_TRUE(reclaimed.ok()) << reclaimed.status().diagnostic();
+  EXPECT_EQ(reclaimed.value().deferred, 0U);
+  EXPECT_FALSE(std::filesystem::exists(temporary.path() / "segments" / "seg_00000004"));
+  EXPECT_TRUE(std::filesystem::is_directory(temporary.path() / "segments" / "seg_00000006"));
+  ASSERT_TRUE(collection->close().ok());
+  collection.reset();
+
+  auto reopened = Collection::open(temporary.path());
+  ASSERT_TRUE(reopened.ok()) << reopened.status().diagnostic();
+  EXPECT_EQ(reopened.value()->size(), 7U);
+  EXPECT_EQ(reopened.value()->options().max_neighbors, 24U);
+  EXPECT_EQ(reopened.value()->options().ef_construction, 200U);
+  EXPECT_EQ(reopened.value()->stats().sealed_segments_count, 1U);
+  auto reopened_search =
+      reopened.value()->search(core::TypedTensorView::contiguous(query.data(), 1, 2), 6);
+  ASSERT_TRUE(reopened_search.ok()) << reopened_search.status().diagnostic();
+  EXPECT_EQ(reopened_search.value().ids, before.value().ids);
+  ASSERT_TRUE(reopened.value()->close().ok());
+}
+
 TEST(CollectionFacade, AutoSealRotatesAtConfiguredRowThreshold) {
   TemporaryDirectory temporary;
   auto configured = flat_options(temporary.path());
@@ -470,6 +557,58 @@ TEST(CollectionFacade, AutoSealRotatesAtConfiguredRowThreshold) {
   ASSERT_TRUE(reopened.value()->close().ok());
 }
 
+TEST(CollectionFacade, AutoSealWithoutWorkersSealsOnTheWritingThread) {
+  TemporaryDirectory temporary;
+  auto configured = flat_options(temporary.path());
+  configured.auto_seal_rows = 2;
+  configured.maintenance.worker_threads = 0;
+  auto created = Collection::create(configured);
+  ASSERT_TRUE(created.ok()) << created.status().diagnostic();
+  auto collection = std::move(created).value();
+  const std::array<float, 2> first{0.0F, 0.0F};
+  const std::array<float, 2> second{1.0F, 0.0F};
+  ASSERT_TRUE(collection->add(item("inline-a", first)).ok());
+  ASSERT_TRUE(collection->add(item("inline-b", second)).ok());
+  EXPECT_EQ(collection->stats().sealed_segments_count, 1U);
+  EXPECT_EQ(collection->stats().background_seals, 0U);
+  ASSERT_TRUE(collection->close().ok());
+}
+
+TEST(CollectionFacade, HardCapHoldsWritesUntilTheBackgroundSealRuns) {
+  TemporaryDirectory temporary;
+  auto configured = flat_options(temporary.path());
+  configured.auto_seal_rows = 2;
+  configured.maintenance.worker_threads = 1;
+  configured.maintenance.hard_cap_rows = 2;
+  configured.maintenance.compact_min_segments = 2;
+  auto created = Collection::create(configured);
+  ASSERT_TRUE(created.ok()) << created.status().diagnostic();
+  auto collection = std::move(created).value();
+  const std::array<std::array<float, 2>, 5> vectors{
+      {{0.0F, 0.0F}, {1.0F, 0.0F}, {2.0F, 0.0F}, {3.0F, 0.0F}, {4.0F, 0.0F}}};
+  for (std::size_t index = 0; index < vectors.size(); ++index) {
+    ASSERT_TRUE(collection->add(item("cap-" + std::to_string(index), vectors[index])).ok());
+    // A write admitted at the cap ran after the seal, so the active
+    // generation never holds more than the cap plus that write.
+    const auto snapshot = internal::collection::CollectionTestAccess::pin_epoch(*collection);
+    const auto active = snapshot->find_active_mutable();
+    ASSERT_NE(active, nullptr);
+    EXPECT_LE(snapshot->known_rows_for(*active), 3U);
+  }
+  ASSERT_TRUE(collection->wait_for_maintenance().ok());
+  const auto stats = collection->stats();
+  EXPECT_EQ(stats.size, 5U);
+  EXPECT_GE(stats.background_seals, 2U);
+  EXPECT_EQ(stats.background_failures, 0U);
+  // Two sealed Flat segments trigger a background compaction into one.
+  EXPECT_EQ(stats.sealed_segments_count, 1U);
+  const std::array<float, 2> query{};
+  auto found = collection->search(core::TypedTensorView::contiguous(query.data(), 1, 2), 10);
+  ASSERT_TRUE(found.ok()) << found.status().diagnostic();
+  EXPECT_EQ(found.value().ids.size(), 5U);
+  ASSERT_TRUE(collection->close().ok());
+}
+
 TEST(CollectionFacade, AutoSealRowsCapacityArithmeticAcceptsMaximumSafeValue) {
   TemporaryDirectory temporary;
   constexpr auto max_safe =
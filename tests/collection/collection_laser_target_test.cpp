@@ -426,6 +426,136 @@ TEST(CollectionLaserTargetTest, ResidentArenaResidencyViaEnvOverrideThroughColle
   ASSERT_TRUE(reopened->close().ok());
 }
 
+TEST(CollectionLaserTargetTest, RelayoutFromSampledQueriesKeepsResultsAndRowIds) {
+  // Sampling every query feeds the open segment's VisitSketch; relayout()
+  // rewrites the sealed segment in co-visit order under a new segment id.
+  // The resident arena is deterministic and labels move with their rows, so
+  // the relaid-out segment must answer byte-identically, also after reopen.
+  TemporaryDirectory temporary("relayout");
+  const auto dataset = make_dataset(kRows, /*seed=*/16180U);
+  const auto queries = make_queries(dataset, kQueryCount, /*seed=*/23U);
+
+  ::setenv("ALAYA_LASER_RESIDENCY", "resident_arena", 1);
+  ::setenv("ALAYA_LASER_VISIT_SAMPLE", "1", 1);
+  struct EnvGuard {
+    ~EnvGuard() {
+      ::unsetenv("ALAYA_LASER_RESIDENCY");
+      ::unsetenv("ALAYA_LASER_VISIT_SAMPLE");
+    }
+  } env_guard;
+
+  auto created = Collection::create(make_options(temporary.path(), core::Metric::l2));
+  ASSERT_TRUE(created.ok()) << created.status().diagnostic();
+  auto collection = std::move(created).value();
+  insert_dataset(*collection, dataset);
+  auto sealed = collection->seal();
+  ASSERT_TRUE(sealed.ok()) << sealed.status().diagnostic();
+  ASSERT_EQ(sealed.value().built_algorithm, core::algorithm::laser);
+
+  const auto view = core::TypedTensorView::contiguous(queries.data(), kQueryCount, kDim);
+  auto before = collection->batch_search(view, kTopK);
+  ASSERT_TRUE(before.ok()) << before.status().diagnostic();
+  expect_well_formed(before.value(), dataset, kQueryCount);
+
+  CollectionRelayoutOptions too_few;
+  too_few.min_sampled_queries = kQueryCount + 1;
+  auto refused = collection->relayout(too_few);
+  ASSERT_FALSE(refused.ok());
+  EXPECT_EQ(refused.status().code(), core::StatusCode::not_found);
+
+  CollectionRelayoutOptions options;
+  options.min_sampled_queries = kQueryCount;
+  auto relaid = collection->relayout(options);
+  ASSERT_TRUE(relaid.ok()) << relaid.status().diagnostic();
+  EXPECT_EQ(relaid.value().source_segment_id, sealed.value().sealed_segment_id);
+  EXPECT_NE(relaid.value().relayout_segment_id, sealed.value().sealed_segment_id);
+  EXPECT_EQ(relaid.value().rows, kRows);
+  EXPECT_EQ(relaid.value().sampled_queries, kQueryCount);
+  EXPECT_GT(relaid.value().output_bytes, 0U);
+  expect_laser_manifest(temporary.path());
+
+  auto after = collection->batch_search(view, kTopK);
+  ASSERT_TRUE(after.ok()) << after.status().diagnostic();
+  EXPECT_EQ(after.value().ids, before.value().ids);
+
+  auto collected = collection->gc();
+  ASSERT_TRUE(collected.ok()) << collected.status().diagnostic();
+  // The seal's retired active segment is reclaimed alongside the source.
+  EXPECT_EQ(collected.value().reclaimed, 2U);
+  EXPECT_FALSE(std::filesystem::exists(
+      temporary.path() / "segments" /
+      internal::collection::detail::collection_segment_name(sealed.value().sealed_segment_id)));
+
+  ASSERT_TRUE(collection->close().ok());
+  collection.reset();
+  auto opened = Collection::open(temporary.path());
+  ASSERT_TRUE(opened.ok()) << opened.status().diagnostic();
+  auto reopened = std::move(opened).value();
+  auto reopened_search = reopened->batch_search(view, kTopK);
+  ASSERT_TRUE(reopened_search.ok()) << reopened_search.status().diagnostic();
+  EXPECT_EQ(reopened_search.value().ids, before.value().ids);
+  ASSERT_TRUE(reopened->close().ok());
+}
+
+TEST(CollectionLaserTargetTest, RebuildExtendsTheSealedGraphInsteadOfRelinkingIt) {
+  // The sealed segment holds most rows after the follow-up writes, so the
+  // rebuild starts from its graph: carried rows keep their edges, removed
+  // rows are repaired around and new rows are inserted.
+  TemporaryDirectory temporary("rebuild-extend");
+  const auto dataset = make_dataset(kRows, /*seed=*/31337U);
+  auto created = Collection::create(make_options(temporary.path(), core::Metric::l2));
+  ASSERT_TRUE(created.ok()) << created.status().diagnostic();
+  auto collection = std::move(created).value();
+  insert_dataset(*collection, dataset);
+  auto sealed = collection->seal();
+  ASSERT_TRUE(sealed.ok()) << sealed.status().diagnostic();
+  ASSERT_EQ(sealed.value().built_algorithm, core::algorithm::laser);
+  EXPECT_EQ(sealed.value().reused_topology_rows, 0U);
+
+  constexpr core::RowCount kRemoved = 16;
+  constexpr core::RowCount kAdded = 64;
+  for (core::RowCount row = 0; row < kRemoved; ++row) {
+    ASSERT_TRUE(collection->remove(dataset.ids[static_cast<std::size_t>(row * 7)]).ok());
+  }
+  const auto added = make_dataset(kAdded, /*seed=*/27182U);
+  for (core::RowCount row = 0; row < kAdded; ++row) {
+    CollectionItem item;
+    item.logical_id = core::LogicalId::from_utf8("added-" + std::to_string(row));
+    item.vector = core::TypedTensorView::contiguous(
+        added.vectors.data() + static_cast<std::ptrdiff_t>(row) * kDim, 1, kDim);
+    item.metadata = {{"selected", false}};
+    ASSERT_TRUE(collection->add(item).ok());
+  }
+
+  auto rebuilt = collection->rebuild();
+  ASSERT_TRUE(rebuilt.ok()) << rebuilt.status().diagnostic();
+  EXPECT_EQ(rebuilt.value().built_algorithm, core::algorithm::laser);
+  EXPECT_EQ(rebuilt.value().rebuilt_rows, kRows - kRemoved + kAdded);
+  EXPECT_EQ(rebuilt.value().reused_topology_rows, kRows - kRemoved);
+  expect_laser_manifest(temporary.path());
+
+  // Carried and inserted rows are both reachable: each finds itself first.
+  std::size_t found = 0;
+  for (core::RowCount row = 0; row < kAdded; ++row) {
+    const auto query = core::TypedTensorView::contiguous(
+        added.vectors.data() + static_cast<std::ptrdiff_t>(row) * kDim, 1, kDim);
+    auto hits = collection->search(query, 1);
+    ASSERT_TRUE(hits.ok()) << hits.status().diagnostic();
+    found += !hits.value().ids.empty() &&
+             hits.value().ids.front() == core::LogicalId::from_utf8("added-" + std::to_string(row));
+  }
+  for (core::RowCount row = kRows - kAdded; row < kRows; ++row) {
+    const auto query = core::TypedTensorView::contiguous(
+        dataset.vectors.data() + static_cast<std::ptrdiff_t>(row) * kDim, 1, kDim);
+    auto hits = collection->search(query, 1);
+    ASSERT_TRUE(hits.ok()) << hits.status().diagnostic();
+    found += !hits.value().ids.empty() &&
+             hits.value().ids.front() == dataset.ids[static_cast<std::size_t>(row)];
+  }
+  EXPECT_GE(found * 10, std::size_t{2 * kAdded} * 9);
+  ASSERT_TRUE(collection->close().ok());
+}
+
 TEST(CollectionLaserTargetMetricAdmission, InnerProductMetricBuildsLaser) {
   TemporaryDirectory temporary("ip-native");
   const auto dataset = make_dataset(kRows, /*seed=*/4104U);
@@ -3,13 +3,21 @@
 
 #include <array>
 #include <cstddef>
+#include <cstdint>
 #include <filesystem>
 #include <fstream>
 #include <string>
+#include <thread>
 #include <vector>
 
 #include <gtest/gtest.h>
 
+#ifdef __linux__
+  #include <sys/resource.h>
+
+  #include <csignal>
+#endif
+
 #include "index/collection/logical_wal.hpp"
 
 namespace alaya::internal::collection {
@@ -116,6 +124,59 @@ TEST_F(LogicalWalTest, CorruptFrameNeverResynchronizesToACommitAfterTheDamage) {
   EXPECT_GT(std::filesystem::file_size(path), first_size);
 }
 
+TEST_F(LogicalWalTest, OpenStreamsFramesToReplayWithoutRetainingThem) {
+  std::filesystem::path path;
+  {
+    auto opened = CollectionLogicalWal::open(root_);
+    ASSERT_TRUE(opened.ok());
+    auto wal = std::move(opened).value();
+    const std::array<std::byte, 2> payload{std::byte{0x0a}, std::byte{0x0b}};
+    for (std::uint64_t op = 1; op <= 3; ++op) {
+      ASSERT_TRUE(
+          wal->append(LogicalWalRecordType::prepare, 0, op, op, payload, LogicalWalSync::flush)
+              .ok());
+      ASSERT_TRUE(
+          wal->append(LogicalWalRecordType::commit, 1, op, op, {}, LogicalWalSync::flush).ok());
+    }
+    path = wal->path();
+  }
+  const auto size = std::filesystem::file_size(path);
+  std::filesystem::resize_file(path, size - 1);
+
+  // A failing callback fails the open before the torn tail is repaired.
+  auto rejected = CollectionLogicalWal::open(
+      root_, kCollectionWalNamespace, false, [](const LogicalWalFrameView &) {
+        return core::Status::error(core::StatusCode::corruption,
+                                   core::OperationStage::mutation_replay,
+                                   core::StatusDetail::malformed_struct,
+                                   "rejected by the test");
+      });
+  ASSERT_FALSE(rejected.ok());
+  EXPECT_EQ(rejected.status().code(), core::StatusCode::corruption);
+  EXPECT_EQ(std::filesystem::file_size(path), size - 1);
+
+  std::vector<LogicalWalRecordType> types;
+  std::vector<std::uint64_t> ops;
+  std::uint64_t payload_bytes{};
+  auto opened = CollectionLogicalWal::open(
+      root_, kCollectionWalNamespace, false, [&](const LogicalWalFrameView &frame) {
+        types.push_back(frame.type);
+        ops.push_back(frame.op_id);
+        payload_bytes += frame.payload.size();
+        return core::Status::success();
+      });
+  ASSERT_TRUE(opened.ok()) << opened.status().diagnostic();
+  ASSERT_EQ(types.size(), 5U);
+  EXPECT_EQ(types.front(), LogicalWalRecordType::prepare);
+  EXPECT_EQ(types.back(), LogicalWalRecordType::prepare);
+  EXPECT_EQ(ops, (std::vector<std::uint64_t>{1, 1, 2, 2, 3}));
+  EXPECT_EQ(payload_bytes, 6U);
+  const auto &scan = opened.value()->recovery_scan();
+  EXPECT_TRUE(scan.frames.empty());
+  EXPECT_TRUE(scan.stopped_at_corrupt_or_torn_tail);
+  EXPECT_EQ(std::filesystem::file_size(path), scan.valid_bytes);
+}
+
 TEST_F(LogicalWalTest, CheckpointAtomicallyCutsTheWalToOneDurableMarker) {
   auto opened = CollectionLogicalWal::open(root_);
   ASSERT_TRUE(opened.ok());
@@ -130,5 +191,104 @@ TEST_F(LogicalWalTest, CheckpointAtomicallyCutsTheWalToOneDurableMarker) {
   EXPECT_EQ(scanned.value().frames[0].op_id, 8U);
 }
 
+TEST_F(LogicalWalTest, GroupSyncCoversEveryFrameAppendedBeforeItsLeaderRan) {
+  auto opened = CollectionLogicalWal::open(root_);
+  ASSERT_TRUE(opened.ok());
+  auto wal = std::move(opened).value();
+  ASSERT_TRUE(
+      wal->append(LogicalWalRecordType::prepare, 1, 1, 1, {}, LogicalWalSync::buffered).ok());
+  const auto first = wal->appended_position();
+  ASSERT_TRUE(wal->append(LogicalWalRecordType::commit, 1, 1, 1, {}, LogicalWalSync::flush).ok());
+  const auto second = wal->appended_position();
+  EXPECT_GT(second, first);
+
+  ASSERT_TRUE(wal->sync_through(second).ok());
+  EXPECT_EQ(wal->group_sync_count(), 1U);
+  ASSERT_TRUE(wal->sync_through(first).ok());
+  EXPECT_EQ(wal->group_sync_count(), 1U) << "an already covered position must not sync again";
+
+  ASSERT_TRUE(wal->append(LogicalWalRecordType::commit, 1, 2, 2, {}, LogicalWalSync::fsync).ok());
+  ASSERT_TRUE(wal->sync_through(wal->appended_position()).ok());
+  EXPECT_EQ(wal->group_sync_count(), 1U) << "an fsynced append already covers its own frame";
+  ASSERT_TRUE(wal->reset_to_checkpoint(2).ok());
+  ASSERT_TRUE(wal->sync_through(wal->appended_position()).ok());
+  EXPECT_EQ(wal->group_sync_count(), 1U) << "a checkpoint cut is durable when it returns";
+}
+
+TEST_F(LogicalWalTest, ConcurrentGroupSyncsMakeEveryAppenderDurable) {
+  constexpr std::size_t kWriters = 8;
+  constexpr std::uint64_t kFramesPerWriter = 32;
+  auto opened = CollectionLogicalWal::open(root_);
+  ASSERT_TRUE(opened.ok());
+  auto wal = std::move(opened).value();
+  std::array<bool, kWriters> succeeded{};
+  std::vector<std::thread> writers;
+  writers.reserve(kWriters);
+  for (std::size_t writer = 0; writer < kWriters; ++writer) {
+    writers.emplace_back([&, writer] {
+      for (std::uint64_t frame = 0; frame < kFramesPerWriter; ++frame) {
+        const auto op_id = writer * kFramesPerWriter + frame + 1;
+        auto status =
+            wal->append(LogicalWalRecordType::commit, 1, op_id, op_id, {}, LogicalWalSync::flush);
+        if (!status.ok() || !wal->sync_through(wal->appended_position()).ok()) {
+          return;
+        }
+      }
+      succeeded[writer] = true;
+    });
+  }
+  for (auto &writer : writers) {
+    writer.join();
+  }
+  for (const auto ok : succeeded) {
+    EXPECT_TRUE(ok);
+  }
+  EXPECT_GE(wal->group_sync_count(), 1U);
+  EXPECT_LE(wal->group_sync_count(), kWriters * kFramesPerWriter);
+
+  auto scanned = CollectionLogicalWal::scan_file(wal->path());
+  ASSERT_TRUE(scanned.ok());
+  EXPECT_EQ(scanned.value().frames.size(), kWriters * kFramesPerWriter);
+  EXPECT_EQ(scanned.value().valid_bytes, wal->appended_position());
+}
+
+#ifdef __linux__
+TEST_F(LogicalWalTest, FailedFlushLeavesNoFrameForALaterAppendToWrite) {
+  auto opened = CollectionLogicalWal::open(root_);
+  ASSERT_TRUE(opened.ok()) << opened.status().diagnostic();
+  auto wal = std::move(opened).value();
+  ASSERT_TRUE(wal->append(LogicalWalRecordType::prepare, 1, 1, 1, {}, LogicalWalSync::flush).ok());
+  ASSERT_TRUE(
+      wal->append(LogicalWalRecordType::prepare, 0, 2, 2, {}, LogicalWalSync::buffered).ok());
+  const auto size = std::filesystem::file_size(wal->path());
+
+  // A file-size limit just past the end makes the flush fail part-way.
+  rlimit original{};
+  ASSERT_EQ(::getrlimit(RLIMIT_FSIZE, &original), 0);
+  const auto previous_handler = std::signal(SIGXFSZ, SIG_IGN);
+  rlimit limited = original;
+  limited.rlim_cur = static_cast<rlim_t>(size + 16);
+  ASSERT_EQ(::setrlimit(RLIMIT_FSIZE, &limited), 0);
+  const std::vector<std::byte> payload(256, std::byte{0x7f});
+  const auto failed =
+      wal->append(LogicalWalRecordType::commit, 1, 2, 2, payload, LogicalWalSync::flush);
+  ASSERT_EQ(::setrlimit(RLIMIT_FSIZE, &original), 0);
+  std::signal(SIGXFSZ, previous_handler);
+  ASSERT_FALSE(failed.ok());
+  EXPECT_EQ(std::filesystem::file_size(wal->path()), size);
+
+  ASSERT_TRUE(
+      wal->append(LogicalWalRecordType::publish_marker, 1, 3, 3, {}, LogicalWalSync::flush).ok());
+  auto scanned = CollectionLogicalWal::scan_file(wal->path());
+  ASSERT_TRUE(scanned.ok());
+  EXPECT_FALSE(scanned.value().stopped_at_corrupt_or_torn_tail);
+  ASSERT_EQ(scanned.value().frames.size(), 3U);
+  EXPECT_EQ(scanned.value().frames[1].type, LogicalWalRecordType::prepare);
+  EXPECT_EQ(scanned.value().frames[1].op_id, 2U);
+  EXPECT_EQ(scanned.value().frames[2].type, LogicalWalRecordType::publish_marker);
+  EXPECT_EQ(scanned.value().frames[2].op_id, 3U);
+}
+#endif
+
 }  // namespace
 }  // namespace alaya::internal::collection
@@ -0,0 +1,105 @@
+// SPDX-FileCopyrightText: 2026 AlayaDB.AI
+// SPDX-License-Identifier: AGPL-3.0-only
+
+#include <atomic>
+#include <condition_variable>
+#include <mutex>
+
+#include <gtest/gtest.h>
+
+#include "index/collection/maintenance_scheduler.hpp"
+
+namespace alaya::internal::collection {
+namespace {
+
+// Holds the runner inside a task until released, so a test can queue work
+// while the same kind is running.
+class Gate {
+ public:
+  void hold() {
+    std::unique_lock lock(mutex_);
+    entered_ = true;
+    changed_.notify_all();
+    changed_.wait(lock, [&] { return released_; });
+  }
+  void wait_entered() {
+    std::unique_lock lock(mutex_);
+    changed_.wait(lock, [&] { return entered_; });
+  }
+  void release() {
+    std::lock_guard lock(mutex_);
+    released_ = true;
+    changed_.notify_all();
+  }
+
+ private:
+  std::mutex mutex_;
+  std::condition_variable changed_;
+  bool entered_{};
+  bool released_{};
+};
+
+TEST(MaintenanceScheduler, RequestsCoalesceIntoOneRerun) {
+  Gate gate;
+  std::atomic<int> seals{};
+  MaintenanceScheduler scheduler({1, 0}, [&](MaintenanceTask task) {
+    if (task == MaintenanceTask::seal && seals.fetch_add(1) == 0) {
+      gate.hold();
+    }
+    return core::Status::success();
+  });
+  scheduler.schedule(MaintenanceTask::seal);
+  gate.wait_entered();
+  for (int request = 0; request < 8; ++request) {
+    scheduler.schedule(MaintenanceTask::seal);
+  }
+  gate.release();
+  scheduler.wait(MaintenanceTask::seal);
+  EXPECT_EQ(seals.load(), 2);
+  EXPECT_EQ(scheduler.counters(MaintenanceTask::seal).completed, 2U);
+  EXPECT_TRUE(scheduler.take_failure().ok());
+}
+
+TEST(MaintenanceScheduler, KeepsFirstFailureUntilTaken) {
+  MaintenanceScheduler scheduler({2, 0}, [](MaintenanceTask task) {
+    if (task == MaintenanceTask::gc) {
+      return core::Status::error(core::StatusCode::conflict,
+                                 core::OperationStage::save,
+                                 core::StatusDetail::none,
+                                 "gc refused");
+    }
+    return core::Status::success();
+  });
+  scheduler.schedule(MaintenanceTask::compact);
+  scheduler.schedule(MaintenanceTask::gc);
+  scheduler.wait_idle();
+  EXPECT_EQ(scheduler.counters(MaintenanceTask::compact).completed, 1U);
+  EXPECT_EQ(scheduler.counters(MaintenanceTask::gc).failed, 1U);
+  const auto failure = scheduler.take_failure();
+  EXPECT_EQ(failure.code(), core::StatusCode::conflict);
+  EXPECT_TRUE(scheduler.take_failure().ok());
+}
+
+TEST(MaintenanceScheduler, StopDropsQueuedWorkAndReleasesWaiters) {
+  Gate gate;
+  std::atomic<int> runs{};
+  MaintenanceScheduler scheduler({1, 0}, [&](MaintenanceTask) {
+    if (runs.fetch_add(1) == 0) {
+      gate.hold();
+    }
+    return core::Status::success();
+  });
+  scheduler.schedule(MaintenanceTask::seal);
+  gate.wait_entered();
+  scheduler.schedule(MaintenanceTask::gc);
+  gate.release();
+  scheduler.stop();
+  scheduler.wait(MaintenanceTask::gc);
+  scheduler.schedule(MaintenanceTask::compact);
+  scheduler.stop();
+  EXPECT_LE(runs.load(), 2);
+  EXPECT_EQ(scheduler.counters(MaintenanceTask::compact).completed, 0U);
+}
+
+}  // namespace
+}  // namespace alaya::internal::collection
@@ -2,17 +2,23 @@
 // SPDX-License-Identifier: AGPL-3.0-only
 
 #include <array>
+#include <chrono>
 #include <cstddef>
 #include <cstdint>
 #include <filesystem>
+#include <fstream>
 #include <string>
+#include <string_view>
 #include <utility>
 #include <vector>
 
 #include <gtest/gtest.h>
 
+#include "fake_mutable_segment.hpp"
 #include "index/collection/manifest_dual_reader.hpp"
+#include "index/collection/segmented_collection.hpp"
 #include "index/collection/types.hpp"
+#include "index/collection/verified_digest_cache.hpp"
 #include "index/disk/disk_flat_builder.hpp"
 #include "platform/fs.hpp"
 
@@ -135,6 +141,87 @@ TEST(Sha256, KnownVectorsAndOwnedDigest) {
   EXPECT_THROW((void)Sha256Digest::from_hex("deadbeef"), std::invalid_argument);
 }
 
+TEST(Sha256, MultiBlockDigestIsIndependentOfChunking) {
+  EXPECT_EQ(sha256("abcdbcdecdefdefgefghfghighijhijkijkljklmklmnlmnomnopnopq").hex(),
+            "248d6a61d20638b8e5c026930c3e6039a33ce45964ff2167f6ecedd419db06c1");
+  const std::string million(1000000, 'a');
+  constexpr std::string_view kMillionDigest =
+      "cdc76e5c9914fb9281a1c7e284d73e67f1809a48a497200e046d39ccc7112cd0";
+  EXPECT_EQ(sha256(million).hex(), kMillionDigest);
+  for (const std::size_t chunk : {1U, 63U, 64U, 65U, 4095U}) {
+    Sha256 hasher;
+    for (std::size_t offset = 0; offset < million.size(); offset += chunk) {
+      hasher.update(std::string_view(million).substr(offset, chunk));
+    }
+    EXPECT_EQ(hasher.finalize().hex(), kMillionDigest) << chunk;
+  }
+}
+
+TEST(VerifiedDigestCache, AnswersOnlyForAnUnchangedFileIdentity) {
+  TemporaryDirectory temporary;
+  const auto path = temporary.path() / "payload.bin";
+  constexpr std::string_view original{"original-payload"};
+  platform::write_all_fsync(path, original.data(), original.size());
+  VerifiedDigestCache cache(2, std::chrono::nanoseconds::zero());
+  EXPECT_EQ(sha256_file_cached(path, &cache), sha256(original));
+  const auto identity = platform::file_identity(path);
+#ifndef _WIN32
+  ASSERT_TRUE(identity.has_value());
+  EXPECT_EQ(cache.find(*identity), sha256(original));
+  constexpr std::string_view rewritten{"rewritten-payload"};
+  platform::write_all_fsync(path, rewritten.data(), rewritten.size());
+  EXPECT_EQ(sha256_file_cached(path, &cache), sha256(rewritten));
+  EXPECT_EQ(cache.size(), 2U);
+  cache.remember({1, 1, 1, 1, 1}, sha256(original), 1);
+  EXPECT_EQ(cache.size(), 2U);
+  EXPECT_FALSE(cache.find(*identity).has_value());
+
+  // With the default window a file hashed right after it was written could
+  // still be rewritten within the same timestamp tick, so it is not trusted.
+  VerifiedDigestCache racy(2);
+  EXPECT_EQ(sha256_file_cached(path, &racy), sha256(rewritten));
+  EXPECT_EQ(racy.size(), 0U);
+#else
+  EXPECT_FALSE(identity.has_value());
+#endif
+}
+
+TEST(VerifiedDigestSidecar, RestoresDigestsAcrossCachesForUnchangedFilesOnly) {
+#ifndef _WIN32
+  TemporaryDirectory temporary;
+  const auto path = temporary.path() / "payload.bin";
+  const auto sidecar = temporary.path() / ".alaya_internal" / "digests";
+  constexpr std::string_view original{"original-payload"};
+  platform::write_all_fsync(path, original.data(), original.size());
+  VerifiedDigestCache writer(4, std::chrono::nanoseconds::zero());
+  ASSERT_EQ(sha256_file_cached(path, &writer), sha256(original));
+  const std::vector<std::filesystem::path> files{path};
+  VerifiedDigestSidecar::store(sidecar, files, writer);
+  ASSERT_TRUE(std::filesystem::is_regular_file(sidecar));
+
+  // A fresh process-level cache learns the digest without hashing.
+  VerifiedDigestCache restarted(4);
+  VerifiedDigestSidecar::load(sidecar, restarted);
+  const auto identity = platform::file_identity(path);
+  ASSERT_TRUE(identity.has_value());
+  EXPECT_EQ(restarted.find(*identity), sha256(original));
+
+  // A malformed line is skipped; a rewritten file is not vouched for.
+  {
+    std::ofstream append(sidecar, std::ios::app);
+    append << "not a digest line\n";
+  }
+  constexpr std::string_view rewritten{"rewritten-payload"};
+  platform::write_all_fsync(path, rewritten.data(), rewritten.size());
+  VerifiedDigestCache later(4);
+  VerifiedDigestSidecar::load(sidecar, later);
+  EXPECT_EQ(later.size(), 1U);
+  const auto changed = platform::file_identity(path);
+  ASSERT_TRUE(changed.has_value());
+  EXPECT_FALSE(later.find(*changed).has_value());
+#endif
+}
+
 TEST(ArtifactManifestV2, DeterministicRoundTripReconstructsEveryField) {
   const auto manifest = sample_manifest();
   const auto encoded = manifest.serialize();
@@ -279,5 +366,149 @@ TEST(ArtifactControlPlaneTransaction, V2RollForwardReaderVerifiesReadyAndRejects
   EXPECT_EQ(rejected.status().code(), core::StatusCode::corruption);
 }
 
+TEST(ArtifactControlPlaneTransaction, BackgroundVerificationReportsDamageAfterOpen) {
+  TemporaryDirectory temporary;
+  core::BuildContext context;
+  ArtifactTransactionOptions options;
+  options.collection_root = temporary.path();
+  options.target_relative_directory = "segments/seg_00000001";
+  options.transaction_id = "publish_background";
+  options.manifest_v2_writer = true;
+  auto begun = ArtifactControlPlaneTransaction::begin(options, context);
+  ASSERT_TRUE(begun.ok()) << begun.status().diagnostic();
+  auto transaction = std::move(begun).value();
+  auto writer = transaction->writer({{"data", "data.bin", true, {}}});
+  ASSERT_TRUE(writer.ok()) << writer.status().diagnostic();
+  constexpr std::string_view payload{"durable-payload"};
+  platform::write_all_fsync(std::filesystem::path(writer.value().find("data")),
+                            payload.data(),
+                            payload.size());
+  ASSERT_TRUE(transaction->prepare(transaction_segment()).ok());
+  ASSERT_TRUE(transaction->publish(transaction_manifest()).ok());
+
+  ManifestReaderOptions reader_options;
+  reader_options.verification = ArtifactVerification::background;
+  reader_options.verification_threads = 3;
+  auto opened = CollectionManifestDualReader::open(temporary.path(), reader_options);
+  ASSERT_TRUE(opened.ok()) << opened.status().diagnostic();
+  EXPECT_TRUE(opened.value().wait_for_verification().ok());
+
+  constexpr std::string_view damaged{"damaged-payload"};
+  platform::write_all_fsync(temporary.path() / "segments/seg_00000001/data.bin",
+                            damaged.data(),
+                            damaged.size());
+  // Presence and size still check out, so open succeeds and the content
+  // verdict arrives later.
+  auto deferred = CollectionManifestDualReader::open(temporary.path(), reader_options);
+  ASSERT_TRUE(deferred.ok()) << deferred.status().diagnostic();
+  const auto verdict = deferred.value().wait_for_verification();
+  EXPECT_EQ(verdict.code(), core::StatusCode::corruption);
+
+  // A collection that keeps the deferred verdict refuses to search.
+  auto producer = std::make_shared<test::FakeMutableSegment>();
+  auto erased = test::make_fake_mutable_any(producer);
+  ASSERT_TRUE(erased.ok());
+  SegmentRegistration registration;
+  registration.segment_id = test::FakeMutableSegment::kSegmentId;
+  registration.generation = 1;
+  registration.role = SegmentRole::active_mutable;
+  registration.segment = std::move(erased).value();
+  registration.atomic_mutation_bundle = true;
+  std::vector<SegmentRegistration> registrations;
+  registrations.push_back(std::move(registration));
+  CollectionConfig config;
+  config.artifact_verification = deferred.value().verification;
+  auto collection = SegmentedCollection::open({2, core::Metric::l2, core::ScalarType::float32},
+                                              std::move(registrations),
+                                              std::move(config));
+  ASSERT_TRUE(collection.ok()) << collection.status().diagnostic();
+  const std::array<float, 2> query{0.0F, 0.0F};
+  core::SearchContext search_context;
+  CollectionSearchRequest search;
+  search.queries = core::TypedTensorView::contiguous(query.data(), 1, 2);
+  search.options.top_k = 1;
+  search.context = &search_context;
+  EXPECT_EQ(collection.value()->search(search).status().code(), core::StatusCode::corruption);
+  EXPECT_TRUE(collection.value()->close().ok());
+
+  reader_options.verification = ArtifactVerification::eager;
+  reader_options.trust_verified_digests = false;
+  EXPECT_FALSE(CollectionManifestDualReader::open(temporary.path(), reader_options).ok());
+}
+
+TEST(ArtifactControlPlaneTransaction, StoppedBackgroundVerificationJoinsAsCancelled) {
+  TemporaryDirectory temporary;
+  core::BuildContext context;
+  ArtifactTransactionOptions options;
+  options.collection_root = temporary.path();
+  options.target_relative_directory = "segments/seg_00000001";
+  options.transaction_id = "publish_stopped";
+  options.manifest_v2_writer = true;
+  auto begun = ArtifactControlPlaneTransaction::begin(options, context);
+  ASSERT_TRUE(begun.ok()) << begun.status().diagnostic();
+  auto transaction = std::move(begun).value();
+  auto writer = transaction->writer({{"data", "data.bin", true, {}}});
+  ASSERT_TRUE(writer.ok()) << writer.status().diagnostic();
+  // Large enough that hashing is still running when stop() arrives.
+  const std::string payload(std::size_t{8} << 20U, 'p');
+  platform::write_all_fsync(std::filesystem::path(writer.value().find("data")),
+                            payload.data(),
+                            payload.size());
+  ASSERT_TRUE(transaction->prepare(transaction_segment()).ok());
+  ASSERT_TRUE(transaction->publish(transaction_manifest()).ok());
+
+  ManifestReaderOptions reader_options;
+  reader_options.verification = ArtifactVerification::background;
+  reader_options.verification_threads = 1;
+  auto opened = CollectionManifestDualReader::open(temporary.path(), reader_options);
+  ASSERT_TRUE(opened.ok()) << opened.status().diagnostic();
+  ASSERT_NE(opened.value().verification, nullptr);
+  opened.value().verification->stop();
+  EXPECT_EQ(opened.value().wait_for_verification().code(), core::StatusCode::cancelled);
+  // An unfinished verification vouches for nothing.
+  EXPECT_FALSE(std::filesystem::exists(temporary.path() / ".alaya_internal" /
+                                       kVerifiedDigestSidecarFilename));
+
+  reader_options.verification = ArtifactVerification::eager;
+  EXPECT_TRUE(CollectionManifestDualReader::open(temporary.path(), reader_options).ok());
+}
+
+TEST(ArtifactControlPlaneTransaction, WrongSidecarDigestIsRecheckedFromTheBytes) {
+#ifndef _WIN32
+  TemporaryDirectory temporary;
+  core::BuildContext context;
+  ArtifactTransactionOptions options;
+  options.collection_root = temporary.path();
+  options.target_relative_directory = "segments/seg_00000001";
+  options.transaction_id = "publish_sidecar";
+  options.manifest_v2_writer = true;
+  auto begun = ArtifactControlPlaneTransaction::begin(options, context);
+  ASSERT_TRUE(begun.ok()) << begun.status().diagnostic();
+  auto transaction = std::move(begun).value();
+  auto writer = transaction->writer({{"data", "data.bin", true, {}}});
+  ASSERT_TRUE(writer.ok()) << writer.status().diagnostic();
+  constexpr std::string_view payload{"durable-payload"};
+  const auto data = std::filesystem::path(writer.value().find("data"));
+  platform::write_all_fsync(data, payload.data(), payload.size());
+  ASSERT_TRUE(transaction->prepare(transaction_segment()).ok());
+  ASSERT_TRUE(transaction->publish(transaction_manifest()).ok());
+
+  // A sidecar that vouches for the wrong digest must not fail a good file.
+  const auto published = temporary.path() / "segments/seg_00000001/data.bin";
+  VerifiedDigestCache liar(4);
+  const auto identity = platform::file_identity(published);
+  ASSERT_TRUE(identity.has_value());
+  liar.remember_written(*identity, sha256(std::string_view{"something-else"}));
+  const std::vector<std::filesystem::path> files{published};
+  VerifiedDigestSidecar::store(
+      temporary.path() / ".alaya_internal" / kVerifiedDigestSidecarFilename, files, liar);
+
+  ManifestReaderOptions reader_options;
+  auto opened = CollectionManifestDualReader::open(temporary.path(), reader_options);
+  EXPECT_TRUE(opened.ok()) << opened.status().diagnostic();
+  VerifiedDigestCache::instance().clear();
+#endif
+}
+
 }  // namespace
 }  // namespace alaya::internal::collection
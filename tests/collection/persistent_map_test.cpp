@@ -0,0 +1,129 @@
+// SPDX-FileCopyrightText: 2026 AlayaDB.AI
+// SPDX-License-Identifier: AGPL-3.0-only
+
+#include <algorithm>
+#include <cstdint>
+#include <map>
+#include <random>
+#include <string>
+#include <utility>
+#include <vector>
+
+#include <gtest/gtest.h>
+
+#include "index/collection/persistent_map.hpp"
+
+namespace alaya::internal::collection {
+namespace {
+
+using Map = PersistentMap<std::uint64_t, std::string>;
+
+auto contents(const Map &map) -> std::vector<std::pair<std::uint64_t, std::string>> {
+  std::vector<std::pair<std::uint64_t, std::string>> result;
+  for (const auto &[key, value] : map) {
+    result.emplace_back(key, value);
+  }
+  return result;
+}
+
+auto contents(const std::map<std::uint64_t, std::string> &map)
+    -> std::vector<std::pair<std::uint64_t, std::string>> {
+  return {map.begin(), map.end()};
+}
+
+TEST(PersistentMap, InsertFindEraseMatchStdMapSemantics) {
+  Map map;
+  EXPECT_TRUE(map.empty());
+  EXPECT_TRUE(map.insert_or_assign(2, "two").second);
+  EXPECT_TRUE(map.insert_or_assign(1, "one").second);
+  EXPECT_FALSE(map.insert_or_assign(2, "TWO").second);
+  EXPECT_FALSE(map.emplace(1, "ignored").second);
+  EXPECT_TRUE(map.emplace(3, "three").second);
+
+  ASSERT_EQ(map.size(), 3U);
+  EXPECT_EQ(map.at(2), "TWO");
+  EXPECT_EQ(map.find(1)->second, "one");
+  EXPECT_EQ(map.find(4), map.end());
+  EXPECT_TRUE(map.contains(3));
+  EXPECT_THROW((void)map.at(4), std::out_of_range);
+
+  EXPECT_EQ(map.erase(4), 0U);
+  EXPECT_EQ(map.erase(2), 1U);
+  EXPECT_EQ(contents(map),
+            (std::vector<std::pair<std::uint64_t, std::string>>{{1, "one"}, {3, "three"}}));
+}
+
+TEST(PersistentMap, CopyIsAnIsolatedSnapshot) {
+  Map base;
+  for (std::uint64_t key = 0; key < 64; ++key) {
+    base.insert_or_assign(key, std::to_string(key));
+  }
+  const auto pinned = base;
+  const auto before = contents(pinned);
+
+  auto next = pinned;
+  next.insert_or_assign(7, "seven");
+  next.insert_or_assign(100, "hundred");
+  EXPECT_EQ(next.erase(0), 1U);
+  const auto odd_tail = [](const auto &item) { return item.first % 2 == 1 && item.first > 50; };
+  EXPECT_EQ(erase_if(next, odd_tail), 7U);
+
+  EXPECT_EQ(contents(pinned), before);
+  EXPECT_EQ(pinned.at(7), "7");
+  EXPECT_FALSE(pinned.contains(100));
+  EXPECT_EQ(next.at(7), "seven");
+  EXPECT_EQ(next.size(), 64U + 1U - 1U - 7U);
+}
+
+TEST(PersistentMap, IteratorFromFindContinuesInKeyOrder) {
+  Map map;
+  for (std::uint64_t key = 0; key < 200; key += 2) {
+    map.insert_or_assign(key, std::to_string(key));
+  }
+  auto found = map.find(100);
+  ASSERT_NE(found, map.end());
+  std::vector<std::uint64_t> keys;
+  for (; found != map.end(); ++found) {
+    keys.push_back(found->first);
+  }
+  ASSERT_EQ(keys.size(), 50U);
+  EXPECT_EQ(keys.front(), 100U);
+  EXPECT_EQ(keys.back(), 198U);
+  EXPECT_TRUE(std::ranges::is_sorted(keys));
+  EXPECT_EQ(std::ranges::count_if(map, [](const auto &item) { return item.first < 10; }), 5);
+}
+
+TEST(PersistentMap, RandomizedHistoryMatchesStdMapAtEveryVersion) {
+  std::mt19937_64 random(20260514);
+  std::vector<Map> versions(1);
+  std::vector<std::map<std::uint64_t, std::string>> oracle(1);
+  for (int step = 0; step < 4000; ++step) {
+    // Branch from a random historical version so shared subtrees are
+    // mutated from many different roots.
+    const auto from = random() % versions.size();
+    auto map = versions[from];
+    auto expected = oracle[from];
+    const auto key = random() % 512;
+    if (random() % 3 == 0) {
+      EXPECT_EQ(map.erase(key), expected.erase(key));
+    } else {
+      const auto value = std::to_string(random());
+      EXPECT_EQ(map.insert_or_assign(key, value).second,
+                expected.insert_or_assign(key, value).second);
+    }
+    ASSERT_EQ(map.size(), expected.size());
+    if (versions.size() < 64) {
+      versions.push_back(std::move(map));
+      oracle.push_back(std::move(expected));
+    } else {
+      versions[step % versions.size()] = std::move(map);
+      oracle[step % oracle.size()] = std::move(expected);
+    }
+  }
+  for (std::size_t index = 0; index < versions.size(); ++index) {
+    EXPECT_EQ(contents(versions[index]), contents(oracle[index])) << "version " << index;
+  }
+}
+
+}  // namespace
+}  // namespace alaya::internal::collection
@@ -26,6 +26,12 @@ namespace {
 
 using test::FakeMutableSegment;
 
+// Budgets the segments of one search were handed, by segment row count.
+struct BudgetProbe {
+  std::mutex mutex{};
+  std::map<std::size_t, core::SearchContext> seen{};
+};
+
 class StaticSegment {
  public:
   using Rows = std::map<std::uint64_t, std::array<float, 2>>;
@@ -53,11 +59,17 @@ class StaticSegment {
     descriptor.dim = 2;
     descriptor.metric = core::Metric::l2;
     descriptor.stored_scalar_type = core::ScalarType::float32;
-    descriptor.medium = core::Medium::memory;
+    descriptor.medium = budgets_ == nullptr ? core::Medium::memory : core::Medium::disk;
     descriptor.engine_factory_id = descriptor.algorithm_id;
     return descriptor;
   }
 
+  // Reports itself as a disk segment and records the context it searches with.
+  void record_budgets(std::shared_ptr<BudgetProbe> budgets) { budgets_ = std::move(budgets); }
+
+  // Refuses a scratch lease below `bytes`, like the disk segments do.
+  void require_scratch(std::uint64_t bytes) { required_scratch_ = bytes; }
+
   [[nodiscard]] auto search(const core::SearchRequest &request) const -> core::Status {
     if (request.queries.rows != 1) {
       return core::Status::error(core::StatusCode::invalid_argument,
@@ -81,6 +93,17 @@ class StaticSegment {
 
  private:
   [[nodiscard]] auto execute(const core::SearchRequest &request) const -> core::Status {
+    auto status = core::require_lease(request.context->query_scratch_lease,
+                                      required_scratch_,
+                                      core::OperationStage::search,
+                                      "StaticSegment query scratch lease is too small");
+    if (!status.ok()) {
+      return status;
+    }
+    if (budgets_ != nullptr) {
+      std::lock_guard lock(budgets_->mutex);
+      budgets_->seen[rows_.size()] = *request.context;
+    }
     auto &response = *request.response;
     response.query_count = request.queries.rows;
     response.score_kind = score_kind_;
@@ -133,6 +156,8 @@ class StaticSegment {
   core::ScoreKind score_kind_{core::ScoreKind::distance};
   bool emit_nan_{};
   std::shared_ptr<std::atomic_bool> destroyed_{};
+  std::shared_ptr<BudgetProbe> budgets_{};
+  std::uint64_t required_scratch_{};
 };
 
 [[nodiscard]] auto owned_payload(const std::array<float, 2> &vector,
@@ -865,6 +890,193 @@ TEST(SegmentedCollection, CrossSegmentFlatUpsertDeleteSuppressesOldVersions) {
   EXPECT_EQ(collection->stats().size, kRows - 1);
 }
 
+TEST(SegmentedCollection, SegmentDispatchesShareOneSearchBudget) {
+  auto budgets = std::make_shared<BudgetProbe>();
+  std::vector<SegmentRegistration> registrations;
+  for (std::uint32_t segment = 0; segment < 3; ++segment) {
+    const std::uint32_t row_count = 10 * (segment + 1);
+    StaticSegment::Rows rows;
+    SegmentRegistration registration;
+    registration.segment_id = 100 + segment;
+    registration.role = SegmentRole::sealed;
+    for (std::uint32_t row = 0; row < row_count; ++row) {
+      const std::array<float, 2> vector{static_cast<float>(row), 0.0F};
+      rows.emplace(row, vector);
+      registration.rows.push_back(
+          {core::LogicalId::from_utf8("s" + std::to_string(segment) + "-" + std::to_string(row)),
+           core::SegmentRowId(row),
+           0,
+           VersionState::live,
+           owned_payload(vector)});
+    }
+    auto producer = std::make_shared<StaticSegment>(std::move(rows));
+    producer->record_budgets(budgets);
+    registration.segment = readonly_any(producer);
+    registrations.push_back(std::move(registration));
+  }
+  auto opened = SegmentedCollection::open({2, core::Metric::l2, core::ScalarType::float32},
+                                          std::move(registrations));
+  ASSERT_TRUE(opened.ok()) << opened.status().diagnostic();
+  const auto collection = std::move(opened).value();
+
+  // One query over 60 rows of 8 bytes; the credits leave 120 bytes spare.
+  constexpr std::uint64_t kIoBytes = 600;
+  constexpr std::uint64_t kScratch = std::uint64_t{1} << 20U;
+  const std::array<float, 2> query{1.0F, 0.0F};
+  for (const auto fanout : {SegmentFanout::sequential, SegmentFanout::parallel}) {
+    budgets->seen.clear();
+    core::SearchContext context;
+    context.io_credits.available_requests = 9;
+    context.io_credits.available_bytes = kIoBytes;
+    context.query_scratch_lease.available_bytes = kScratch;
+    auto request = make_search_request(query.data(), 1, 5, context);
+    request.maximum_overfetch_rounds = 0;
+    request.fanout = fanout;
+    ASSERT_TRUE(collection->search(request).ok());
+    ASSERT_EQ(budgets->seen.size(), 3U);
+    std::uint64_t requests{};
+    std::uint64_t bytes{};
+    std::uint64_t scratch{};
+    for (const auto &[rows, seen] : budgets->seen) {
+      EXPECT_GE(seen.io_credits.available_bytes, rows * 8) << rows;
+      EXPECT_GE(seen.io_credits.available_requests, 1U) << rows;
+      requests += seen.io_credits.available_requests;
+      bytes += seen.io_credits.available_bytes;
+      scratch += seen.query_scratch_lease.available_bytes;
+    }
+    EXPECT_LE(requests, 9U);
+    EXPECT_LE(bytes, kIoBytes);
+    if (fanout == SegmentFanout::parallel) {
+      EXPECT_LE(scratch, kScratch);
+    } else {
+      EXPECT_EQ(scratch, 3 * kScratch);
+    }
+  }
+}
+
+TEST(SegmentedCollection, ParallelFanoutRerunsSegmentsItsScratchSliceStarves) {
+  constexpr std::uint64_t kScratch = std::uint64_t{1} << 16U;
+  constexpr std::uint64_t kRequiredScratch = kScratch / 2;
+  auto budgets = std::make_shared<BudgetProbe>();
+  std::vector<SegmentRegistration> registrations;
+  for (std::uint32_t segment = 0; segment < 3; ++segment) {
+    const std::uint32_t row_count = 10 * (segment + 1);
+    StaticSegment::Rows rows;
+    SegmentRegistration registration;
+    registration.segment_id = 100 + segment;
+    registration.role = SegmentRole::sealed;
+    for (std::uint32_t row = 0; row < row_count; ++row) {
+      const std::array<float, 2> vector{static_cast<float>(row) + 0.25F * segment, 0.0F};
+      rows.emplace(row, vector);
+      registration.rows.push_back(
+          {core::LogicalId::from_utf8("s" + std::to_string(segment) + "-" + std::to_string(row)),
+           core::SegmentRowId(row),
+           0,
+           VersionState::live,
+           owned_payload(vector)});
+    }
+    auto producer = std::make_shared<StaticSegment>(std::move(rows));
+    producer->record_budgets(budgets);
+    // The last segment fits in a third of the lease; the others do not.
+    producer->require_scratch(segment == 2 ? 1 : kRequiredScratch);
+    registration.segment = readonly_any(producer);
+    registrations.push_back(std::move(registration));
+  }
+  auto opened = SegmentedCollection::open({2, core::Metric::l2, core::ScalarType::float32},
+                                          std::move(registrations));
+  ASSERT_TRUE(opened.ok()) << opened.status().diagnostic();
+  const auto collection = std::move(opened).value();
+
+  const std::array<float, 2> query{3.0F, 0.0F};
+  std::vector<std::vector<CollectionHit>> results;
+  for (const auto fanout : {SegmentFanout::sequential, SegmentFanout::parallel}) {
+    budgets->seen.clear();
+    core::SearchContext context;
+    context.query_scratch_lease.available_bytes = kScratch;
+    auto request = make_search_request(query.data(), 1, 7, context);
+    request.fanout = fanout;
+    auto searched = collection->search(request);
+    ASSERT_TRUE(searched.ok()) << searched.status().diagnostic();
+    results.push_back(searched.value().queries.at(0).hits);
+    ASSERT_EQ(budgets->seen.size(), 3U);
+    EXPECT_EQ(budgets->seen.at(10).query_scratch_lease.available_bytes, kScratch);
+    EXPECT_EQ(budgets->seen.at(20).query_scratch_lease.available_bytes, kScratch);
+    EXPECT_EQ(budgets->seen.at(30).query_scratch_lease.available_bytes,
+              fanout == SegmentFanout::parallel ? kScratch / 3 : kScratch);
+  }
+  ASSERT_EQ(results[0].size(), results[1].size());
+  for (std::size_t index = 0; index < results[0].size(); ++index) {
+    EXPECT_EQ(results[0][index].logical_id, results[1][index].logical_id) << index;
+  }
+}
+
+TEST(SegmentedCollection, ParallelFanoutMergesSegmentsLikeSequentialFanout) {
+  // Several sealed segments with interleaved scores and equal-score ties, so
+  // the k-way merge must reproduce sort_hits' logical-ID tie break.
+  constexpr std::uint32_t kSegments = 6;
+  constexpr std::uint32_t kRowsPerSegment = 25;
+  std::vector<SegmentRegistration> registrations;
+  for (std::uint32_t segment = 0; segment < kSegments; ++segment) {
+    StaticSegment::Rows rows;
+    SegmentRegistration registration;
+    registration.segment_id = 100 + segment;
+    registration.role = SegmentRole::sealed;
+    for (std::uint32_t row = 0; row < kRowsPerSegment; ++row) {
+      const auto coordinate = static_cast<float>((row * kSegments + segment) % 37);
+      const std::array<float, 2> vector{coordinate, 0.0F};
+      rows.emplace(row, vector);
+      registration.rows.push_back(
+          {core::LogicalId::from_utf8("s" + std::to_string(segment) + "-" + std::to_string(row)),
+           core::SegmentRowId(row),
+           0,
+           VersionState::live,
+           owned_payload(vector)});
+    }
+    registration.segment = readonly_any(std::make_shared<StaticSegment>(std::move(rows)));
+    registrations.push_back(std::move(registration));
+  }
+  auto opened = SegmentedCollection::open({2, core::Metric::l2, core::ScalarType::float32},
+                                          std::move(registrations));
+  ASSERT_TRUE(opened.ok()) << opened.status().diagnostic();
+  const auto collection = std::move(opened).value();
+
+  const std::array<float, 6> queries{3.0F, 0.0F, 17.5F, 0.0F, 40.0F, 0.0F};
+  for (const auto top_k : {std::uint64_t{1}, std::uint64_t{9}, std::uint64_t{200}}) {
+    core::SearchContext sequential_context;
+    auto sequential_request = make_search_request(queries.data(), 3, top_k, sequential_context);
+    sequential_request.fanout = SegmentFanout::sequential;
+    const auto sequential = collection->search(sequential_request);
+    core::SearchContext parallel_context;
+    auto parallel_request = make_search_request(queries.data(), 3, top_k, parallel_context);
+    parallel_request.fanout = SegmentFanout::parallel;
+    const auto parallel = collection->search(parallel_request);
+    ASSERT_TRUE(sequential.ok()) << sequential.status().diagnostic();
+    ASSERT_TRUE(parallel.ok()) << parallel.status().diagnostic();
+    for (std::size_t query = 0; query < queries.size() / 2; ++query) {
+      const auto &expected = sequential.value().queries[query].hits;
+      const auto &actual = parallel.value().queries[query].hits;
+      ASSERT_EQ(actual.size(), std::min<std::uint64_t>(top_k, kSegments * kRowsPerSegment));
+      ASSERT_EQ(actual.size(), expected.size());
+      for (std::size_t rank = 0; rank < actual.size(); ++rank) {
+        EXPECT_EQ(actual[rank].logical_id, expected[rank].logical_id) << rank;
+        EXPECT_EQ(actual[rank].score, expected[rank].score) << rank;
+        EXPECT_EQ(actual[rank].source, expected[rank].source) << rank;
+      }
+      std::vector<CollectionHit> resorted(actual.begin(), actual.end());
+      std::sort(resorted.begin(), resorted.end(), [](const auto &lhs, const auto &rhs) {
+        if (lhs.score != rhs.score) {
+          return lhs.score < rhs.score;
+        }
+        return lhs.logical_id.compare(rhs.logical_id) < 0;
+      });
+      for (std::size_t rank = 0; rank < actual.size(); ++rank) {
+        EXPECT_EQ(actual[rank].logical_id, resorted[rank].logical_id) << rank;
+      }
+    }
+  }
+  EXPECT_EQ(collection->outstanding_search_leases(), 0U);
+}
+
 TEST(SegmentedCollection, SnapshotReferenceDelaysSegmentReclamation) {
   auto destroyed = std::make_shared<std::atomic_bool>(false);
   auto producer = std::make_shared<StaticSegment>(StaticSegment::Rows{},
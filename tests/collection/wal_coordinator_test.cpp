@@ -1,12 +1,14 @@
 // SPDX-FileCopyrightText: 2026 AlayaDB.AI
 // SPDX-License-Identifier: AGPL-3.0-only
 
+#include <algorithm>
 #include <array>
 #include <atomic>
 #include <chrono>
 #include <csignal>
 #include <cstddef>
 #include <cstdint>
+#include <cstring>
 #include <filesystem>
 #include <fstream>
 #include <memory>
@@ -48,7 +50,9 @@ class WalCoordinatorTest : public ::testing::Test {
                                    std::shared_ptr<FakeMutableSegment> &producer,
                                    bool atomic_bundle = true,
                                    MutationFailPoint fail_point = MutationFailPoint::none,
-                                   std::function<void(MutationFailPoint)> hook = {})
+                                   std::function<void(MutationFailPoint)> hook = {},
+                                   CollectionRecoveryOptions recovery = {},
+                                   std::uint32_t checkpoint_max_deltas = 8)
     -> core::Result<std::shared_ptr<SegmentedCollection>> {
   producer = std::make_shared<FakeMutableSegment>();
   auto erased = test::make_fake_mutable_any(producer);
@@ -65,6 +69,8 @@ class WalCoordinatorTest : public ::testing::Test {
   config.wal.root = root;
   config.fail_point = fail_point;
   config.failpoint_hook = std::move(hook);
+  config.recovery = std::move(recovery);
+  config.wal.checkpoint_max_deltas = checkpoint_max_deltas;
   return SegmentedCollection::open({2, core::Metric::l2, core::ScalarType::float32},
                                    {std::move(registration)},
                                    std::move(config));
@@ -352,6 +358,52 @@ TEST_F(WalCoordinatorTest, DuplicateCommittedFramesReplayWithoutAnotherVersion)
   EXPECT_EQ(opened.value()->stats().size, 1U);
 }
 
+TEST_F(WalCoordinatorTest, ReplayReportsProgressAndKeepsCountsExact) {
+  std::shared_ptr<FakeMutableSegment> producer;
+  auto opened = open_collection(root_, producer);
+  ASSERT_TRUE(opened.ok());
+  core::MutationContext context;
+  for (int row = 0; row < 10; ++row) {
+    const std::array<float, 2> vector{static_cast<float>(row), 1.0F};
+    ASSERT_TRUE(
+        opened.value()->write(write_request("row-" + std::to_string(row), vector), context).ok());
+  }
+  const std::array<float, 2> moved{7.0F, 7.0F};
+  ASSERT_TRUE(opened.value()->write(write_request("row-3", moved), context).ok());
+  ASSERT_TRUE(opened.value()->erase(core::LogicalId::from_utf8("row-4"), context).ok());
+  opened.value().reset();
+
+  std::vector<CollectionReplayProgress> reports;
+  CollectionRecoveryOptions recovery;
+  recovery.replay_progress = [&](const CollectionReplayProgress &progress) {
+    reports.push_back(progress);
+  };
+  recovery.replay_progress_interval = 5;
+  opened = open_collection(root_, producer, true, MutationFailPoint::none, {}, recovery);
+  ASSERT_TRUE(opened.ok()) << opened.status().diagnostic();
+  ASSERT_GE(reports.size(), 3U);
+  EXPECT_GT(reports.back().wal_bytes_total, 0U);
+  EXPECT_EQ(reports.back().wal_bytes_scanned, reports.back().wal_bytes_total);
+  EXPECT_EQ(reports.back().transactions_replayed, 12U);
+  EXPECT_EQ(reports.back().rows_replayed, 12U);
+  for (std::size_t i = 1; i < reports.size(); ++i) {
+    EXPECT_LE(reports[i - 1].transactions_replayed, reports[i].transactions_replayed);
+    EXPECT_LE(reports[i - 1].wal_bytes_scanned, reports[i].wal_bytes_scanned);
+  }
+
+  const auto stats = opened.value()->stats();
+  EXPECT_EQ(stats.recovery_replayed_transactions, 12U);
+  EXPECT_EQ(stats.recovery_replayed_rows, 12U);
+  EXPECT_EQ(stats.size, 9U);
+  EXPECT_EQ(stats.visibility_watermark, 12U);
+  EXPECT_EQ(stats.durable_watermark, 12U);
+  auto record = get(opened.value(), "row-3");
+  ASSERT_TRUE(record.ok());
+  EXPECT_EQ(record.value().upsert_sequence, 11U);
+  EXPECT_EQ(get(opened.value(), "row-4").status().code(), core::StatusCode::not_found);
+  EXPECT_EQ(producer->published_op_ids().size(), 12U);
+}
+
 TEST_F(WalCoordinatorTest, BatchModesCoverAllStableStatusesAndAtomicCapability) {
   std::shared_ptr<FakeMutableSegment> producer;
   auto opened = open_collection(root_, producer);
@@ -512,6 +564,178 @@ TEST_F(WalCoordinatorTest, CheckpointAdvancesCutManifestAndPreservesRetryLedger)
   EXPECT_GT(next.value().op_id, checkpoint.value().wal_cut);
 }
 
+TEST_F(WalCoordinatorTest, DeltaCheckpointsCoverOnlyChangedRowsAndMergeInTheBackground) {
+  const auto wal_directory = root_ / ".alaya_internal" / kCollectionWalNamespace;
+  const auto current_lines = [&] {
+    std::ifstream input(wal_directory / "CURRENT");
+    std::vector<std::string> lines;
+    for (std::string line; std::getline(input, line);) {
+      lines.push_back(line);
+    }
+    return lines;
+  };
+  const auto delta_count = [&] {
+    const auto lines = current_lines();
+    return std::count_if(lines.begin(), lines.end(), [](const std::string &line) {
+      return line.starts_with("delta=");
+    });
+  };
+  std::shared_ptr<FakeMutableSegment> producer;
+  auto opened = open_collection(root_, producer);
+  ASSERT_TRUE(opened.ok());
+  auto collection = std::move(opened).value();
+  core::MutationContext mutation_context;
+  core::CheckpointContext checkpoint_context;
+  checkpoint_context.durability_target = core::DurabilityTarget::full_checkpoint;
+  const std::array<float, 2> vector{1.0F, 1.0F};
+  for (int row = 0; row < 64; ++row) {
+    ASSERT_TRUE(
+        collection->write(write_request("row-" + std::to_string(row), vector), mutation_context)
+            .ok());
+  }
+  auto base = collection->checkpoint(checkpoint_context);
+  ASSERT_TRUE(base.ok()) << base.status().diagnostic();
+  EXPECT_EQ(delta_count(), 0);
+
+  const std::array<float, 2> changed{5.0F, 6.0F};
+  auto updated =
+      collection->write(write_request("row-1", changed, "delta-token"), mutation_context);
+  ASSERT_TRUE(updated.ok());
+  ASSERT_TRUE(
+      collection->erase(core::LogicalId::from_utf8("row-2"), mutation_context, WriteOptions{})
+          .ok());
+  auto delta = collection->checkpoint(checkpoint_context);
+  ASSERT_TRUE(delta.ok()) << delta.status().diagnostic();
+  EXPECT_NE(delta.value().checkpoint_name, base.value().checkpoint_name);
+  EXPECT_EQ(delta_count(), 1);
+  EXPECT_LT(std::filesystem::file_size(wal_directory / delta.value().checkpoint_name) * 8,
+            std::filesystem::file_size(wal_directory / base.value().checkpoint_name));
+  collection.reset();
+
+  opened = open_collection(root_, producer);
+  ASSERT_TRUE(opened.ok()) << opened.status().diagnostic();
+  collection = std::move(opened).value();
+  auto record = get(collection, "row-1");
+  ASSERT_TRUE(record.ok());
+  EXPECT_EQ(record.value().upsert_sequence, updated.value().op_id);
+  EXPECT_EQ(get(collection, "row-2").status().code(), core::StatusCode::not_found);
+  EXPECT_TRUE(get(collection, "row-63").ok());
+  auto retry = collection->write(write_request("row-1", changed, "delta-token"), mutation_context);
+  ASSERT_TRUE(retry.ok());
+  EXPECT_EQ(retry.value().op_id, updated.value().op_id);
+
+  // After a reopen the first checkpoint rebases; then every checkpoint adds a
+  // delta until the background merge folds the chain back into one base.
+  for (int round = 0; round < 12; ++round) {
+    ASSERT_TRUE(collection->write(write_request("round-" + std::to_string(round), vector),
+                                  mutation_context)
+                    .ok());
+    ASSERT_TRUE(collection->checkpoint(checkpoint_context).ok());
+  }
+  const auto stats = collection->stats();
+  ASSERT_TRUE(collection->close().ok());
+  ASSERT_TRUE(collection->drain().ok());
+  const auto lines = current_lines();
+  EXPECT_LE(delta_count(), 8);
+  std::size_t images{};
+  for (const auto &entry : std::filesystem::directory_iterator(wal_directory)) {
+    const auto name = entry.path().filename().string();
+    images += name.starts_with("checkpoint_") && name.ends_with(".bin") ? 1U : 0U;
+  }
+  EXPECT_EQ(images, lines.size() - 1);
+  collection.reset();
+
+  opened = open_collection(root_, producer);
+  ASSERT_TRUE(opened.ok()) << opened.status().diagnostic();
+  collection = std::move(opened).value();
+  EXPECT_EQ(collection->stats().accepted_count, stats.accepted_count);
+  EXPECT_EQ(collection->stats().visibility_watermark, stats.visibility_watermark);
+  EXPECT_TRUE(get(collection, "round-11").ok());
+  EXPECT_EQ(get(collection, "row-2").status().code(), core::StatusCode::not_found);
+}
+
+TEST_F(WalCoordinatorTest, LongDeltaChainsWithinTheConfiguredBoundReopen) {
+  const auto wal_directory = root_ / ".alaya_internal" / kCollectionWalNamespace;
+  std::shared_ptr<FakeMutableSegment> producer;
+  auto opened = open_collection(root_, producer, true, MutationFailPoint::none, {}, {}, 1000);
+  ASSERT_TRUE(opened.ok());
+  auto collection = std::move(opened).value();
+  core::MutationContext mutation_context;
+  core::CheckpointContext checkpoint_context;
+  checkpoint_context.durability_target = core::DurabilityTarget::full_checkpoint;
+  const std::array<float, 2> vector{1.0F, 1.0F};
+  for (int round = 0; round < 200; ++round) {
+    ASSERT_TRUE(collection->write(write_request("round-" + std::to_string(round), vector),
+                                  mutation_context)
+                    .ok());
+    ASSERT_TRUE(collection->checkpoint(checkpoint_context).ok());
+  }
+  ASSERT_TRUE(collection->close().ok());
+  ASSERT_TRUE(collection->drain().ok());
+  // 199 deltas: far more CURRENT than a fixed 4 KiB read limit allowed.
+  EXPECT_GT(std::filesystem::file_size(wal_directory / "CURRENT"), 4096U);
+  collection.reset();
+
+  opened = open_collection(root_, producer, true, MutationFailPoint::none, {}, {}, 1000);
+  ASSERT_TRUE(opened.ok()) << opened.status().diagnostic();
+  collection = std::move(opened).value();
+  EXPECT_TRUE(get(collection, "round-0").ok());
+  EXPECT_TRUE(get(collection, "round-199").ok());
+}
+
+TEST_F(WalCoordinatorTest, FailedBackgroundMergeIsReportedByALaterCheckpoint) {
+  const auto wal_directory = root_ / ".alaya_internal" / kCollectionWalNamespace;
+  std::shared_ptr<FakeMutableSegment> producer;
+  auto opened = open_collection(root_, producer, true, MutationFailPoint::none, {}, {}, 1);
+  ASSERT_TRUE(opened.ok());
+  auto collection = std::move(opened).value();
+  core::MutationContext mutation_context;
+  core::CheckpointContext checkpoint_context;
+  checkpoint_context.durability_target = core::DurabilityTarget::full_checkpoint;
+  const std::array<float, 2> vector{1.0F, 1.0F};
+  const auto checkpoint_round = [&](int round) {
+    EXPECT_TRUE(collection->write(write_request("round-" + std::to_string(round), vector),
+                                  mutation_context)
+                    .ok());
+    return collection->checkpoint(checkpoint_context);
+  };
+  auto base = checkpoint_round(0);
+  ASSERT_TRUE(base.ok()) << base.status().diagnostic();
+  EXPECT_TRUE(base.value().merge_status.ok());
+  {
+    // Deltas are diffed in memory, so only the merge reads the damaged base.
+    std::fstream image(wal_directory / base.value().checkpoint_name,
+                       std::ios::in | std::ios::out | std::ios::binary);
+    image.seekp(24);
+    image.put('\x5A');
+  }
+
+  // The second checkpoint starts a merge over the damaged base; the fourth
+  // rebases the chain, which waits for that merge.
+  std::size_t reported{};
+  for (int round = 1; round <= 3; ++round) {
+    auto receipt = checkpoint_round(round);
+    ASSERT_TRUE(receipt.ok()) << receipt.status().diagnostic();
+    if (!receipt.value().merge_status.ok()) {
+      EXPECT_EQ(receipt.value().merge_status.code(), core::StatusCode::corruption);
+      ++reported;
+    }
+  }
+  EXPECT_GE(reported, 1U);
+  auto healthy = checkpoint_round(4);
+  ASSERT_TRUE(healthy.ok()) << healthy.status().diagnostic();
+  EXPECT_TRUE(healthy.value().merge_status.ok());
+  ASSERT_TRUE(collection->close().ok());
+  ASSERT_TRUE(collection->drain().ok());
+  collection.reset();
+
+  opened = open_collection(root_, producer, true, MutationFailPoint::none, {}, {}, 1);
+  ASSERT_TRUE(opened.ok()) << opened.status().diagnostic();
+  collection = std::move(opened).value();
+  EXPECT_TRUE(get(collection, "round-0").ok());
+  EXPECT_TRUE(get(collection, "round-4").ok());
+}
+
 TEST_F(WalCoordinatorTest, CheckpointClosesAdmissionAndDrainsAnAdmittedMutationBeforeItsCut) {
   std::shared_ptr<FakeMutableSegment> producer;
   auto opened = open_collection(root_, producer);
@@ -550,6 +774,189 @@ TEST_F(WalCoordinatorTest, CheckpointClosesAdmissionAndDrainsAnAdmittedMutationB
   EXPECT_TRUE(get(collection, "before-cut").ok());
 }
 
+TEST_F(WalCoordinatorTest, ConcurrentDurableWritersAllReplayAfterGroupCommit) {
+  constexpr std::size_t kWriters = 4;
+  constexpr std::size_t kWritesPerWriter = 16;
+  std::shared_ptr<FakeMutableSegment> producer;
+  auto opened = open_collection(root_, producer);
+  ASSERT_TRUE(opened.ok()) << opened.status().diagnostic();
+  auto collection = std::move(opened).value();
+  std::array<std::size_t, kWriters> durable_receipts{};
+  std::vector<std::thread> writers;
+  writers.reserve(kWriters);
+  for (std::size_t writer = 0; writer < kWriters; ++writer) {
+    writers.emplace_back([&, writer] {
+      core::MutationContext context;
+      for (std::size_t index = 0; index < kWritesPerWriter; ++index) {
+        const std::array<float, 2> vector{static_cast<float>(writer), static_cast<float>(index)};
+        const auto id = "group-" + std::to_string(writer) + "-" + std::to_string(index);
+        auto receipt = collection->write(write_request(id, vector), context);
+        if (receipt.ok() && receipt.value().durability == DurabilityState::wal_fsync &&
+            receipt.value().durable_watermark >= receipt.value().op_id) {
+          ++durable_receipts[writer];
+        }
+      }
+    });
+  }
+  for (auto &writer : writers) {
+    writer.join();
+  }
+  for (const auto count : durable_receipts) {
+    EXPECT_EQ(count, kWritesPerWriter);
+  }
+  const auto watermark = collection->stats().durable_watermark;
+  collection.reset();
+
+  opened = open_collection(root_, producer);
+  ASSERT_TRUE(opened.ok()) << opened.status().diagnostic();
+  collection = std::move(opened).value();
+  EXPECT_EQ(collection->stats().durable_watermark, watermark);
+  for (std::size_t writer = 0; writer < kWriters; ++writer) {
+    for (std::size_t index = 0; index < kWritesPerWriter; ++index) {
+      EXPECT_TRUE(
+          get(collection, "group-" + std::to_string(writer) + "-" + std::to_string(index)).ok());
+    }
+  }
+}
+
+TEST_F(WalCoordinatorTest, DurableWatermarkAdvancesOnlyAfterTheGroupSyncReturns) {
+  std::shared_ptr<FakeMutableSegment> producer;
+  std::shared_ptr<SegmentedCollection> observed;
+  std::vector<CollectionStats> before_sync;
+  std::vector<core::Status> read_before_sync;
+  std::vector<std::size_t> hits_before_sync;
+  const std::array<float, 2> vector{1.0F, 2.0F};
+  auto opened = open_collection(
+      root_, producer, true, MutationFailPoint::none, [&](MutationFailPoint point) {
+        if (point == MutationFailPoint::before_group_sync && observed != nullptr) {
+          before_sync.push_back(observed->stats());
+          read_before_sync.push_back(get(observed, "synced").status());
+          core::SearchContext search_context;
+          CollectionSearchRequest search;
+          search.queries = core::TypedTensorView::contiguous(vector.data(), 1, 2);
+          search.options.top_k = 1;
+          search.context = &search_context;
+          auto searched = observed->search(search);
+          hits_before_sync.push_back(searched.ok() ? searched.value().queries[0].hits.size() : 0);
+        }
+      });
+  ASSERT_TRUE(opened.ok()) << opened.status().diagnostic();
+  auto collection = std::move(opened).value();
+  observed = collection;
+  core::MutationContext context;
+  auto written = collection->write(write_request("synced", vector, "synced-token"), context);
+  ASSERT_TRUE(written.ok()) << written.status().diagnostic();
+  ASSERT_EQ(before_sync.size(), 1U);
+  EXPECT_EQ(before_sync[0].visibility_watermark, written.value().visibility_watermark);
+  EXPECT_LT(before_sync[0].durable_watermark, before_sync[0].visibility_watermark)
+      << "a published row is not durable until its group sync returns";
+  // The documented window: the row is readable before its sync returns.
+  ASSERT_EQ(read_before_sync.size(), 1U);
+  EXPECT_TRUE(read_before_sync[0].ok()) << read_before_sync[0].diagnostic();
+  EXPECT_EQ(hits_before_sync, std::vector<std::size_t>{1});
+  EXPECT_EQ(written.value().durable_watermark, written.value().op_id);
+  const auto after_sync = collection->stats();
+  EXPECT_EQ(after_sync.durable_watermark, written.value().visibility_watermark);
+  EXPECT_GT(after_sync.routing_generation, before_sync[0].routing_generation);
+  EXPECT_GT(after_sync.metadata_epoch, before_sync[0].metadata_epoch);
+
+  auto retried = collection->write(write_request("synced", vector, "synced-token"), context);
+  ASSERT_TRUE(retried.ok()) << retried.status().diagnostic();
+  EXPECT_EQ(retried.value(), written.value());
+  observed.reset();
+}
+
+TEST_F(WalCoordinatorTest, FailedGroupSyncLeavesTheDurableWatermarkBehind) {
+  std::shared_ptr<FakeMutableSegment> producer;
+  auto opened = open_collection(root_, producer, true, MutationFailPoint::before_group_sync);
+  ASSERT_TRUE(opened.ok()) << opened.status().diagnostic();
+  auto collection = std::move(opened).value();
+  core::MutationContext context;
+  const std::array<float, 2> vector{1.0F, 2.0F};
+  auto failed = collection->write(write_request("unsynced", vector), context);
+  ASSERT_FALSE(failed.ok());
+  EXPECT_EQ(failed.status().stage(), core::OperationStage::mutation_publish);
+  const auto stats = collection->stats();
+  EXPECT_LT(stats.durable_watermark, stats.visibility_watermark);
+  auto rejected = collection->write(write_request("rejected", vector), context);
+  ASSERT_FALSE(rejected.ok());
+  EXPECT_EQ(rejected.status().detail(), core::StatusDetail::readonly_instance);
+}
+
+TEST_F(WalCoordinatorTest, WritesPreparedBeforeTheMutationLockReplayTheirExactPayloads) {
+  constexpr std::size_t kWriters = 4;
+  constexpr std::size_t kWritesPerWriter = 12;
+  std::shared_ptr<FakeMutableSegment> producer;
+  auto opened = open_collection(root_, producer);
+  ASSERT_TRUE(opened.ok()) << opened.status().diagnostic();
+  auto collection = std::move(opened).value();
+  std::vector<std::thread> writers;
+  writers.reserve(kWriters);
+  for (std::size_t writer = 0; writer < kWriters; ++writer) {
+    writers.emplace_back([&, writer] {
+      core::MutationContext context;
+      for (std::size_t index = 0; index < kWritesPerWriter; ++index) {
+        const std::array<float, 2> vector{static_cast<float>(writer), static_cast<float>(index)};
+        const auto id = "prepared-" + std::to_string(writer) + "-" + std::to_string(index);
+        if (index % 2 == 0) {
+          auto request = write_request(id, vector);
+          request.document = "doc-" + id;
+          EXPECT_TRUE(collection->write(request, context).ok());
+          continue;
+        }
+        std::array<BatchRowMutation, 2> rows{};
+        rows[0].logical_id = core::LogicalId::from_utf8(id);
+        rows[0].vector = core::TypedTensorView::contiguous(vector.data(), 1, 2);
+        rows[0].document = "doc-" + id;
+        rows[1].logical_id = core::LogicalId::from_utf8(id + "-bad");
+        rows[1].vector = core::TypedTensorView::contiguous(vector.data(), 1, 1);
+        BatchMutationRequest batch;
+        batch.rows = rows;
+        auto receipt = collection->mutate_batch(batch, context);
+        ASSERT_TRUE(receipt.ok()) << receipt.status().diagnostic();
+        EXPECT_EQ(receipt.value().rows[0].row_status, RowMutationStatus::inserted);
+        EXPECT_EQ(receipt.value().rows[1].row_status, RowMutationStatus::invalid_argument);
+      }
+    });
+  }
+  for (auto &writer : writers) {
+    writer.join();
+  }
+
+  // A retry is answered from the ledger before the request is validated
+  // again, even though its validation now runs before the lock.
+  core::MutationContext context;
+  const std::array<float, 2> vector{1.0F, 2.0F};
+  ASSERT_TRUE(collection->write(write_request("retried", vector, "prepared-token"), context).ok());
+  auto invalid_retry = write_request("retried", vector, "prepared-token");
+  invalid_retry.vector = core::TypedTensorView::contiguous(vector.data(), 1, 1);
+  EXPECT_TRUE(collection->write(invalid_retry, context).ok());
+  invalid_retry.options.retry_token.clear();
+  auto rejected = collection->write(invalid_retry, context);
+  ASSERT_FALSE(rejected.ok());
+  EXPECT_EQ(rejected.status().code(), core::StatusCode::invalid_argument);
+  EXPECT_EQ(rejected.status().stage(), core::OperationStage::validation);
+  collection.reset();
+
+  opened = open_collection(root_, producer);
+  ASSERT_TRUE(opened.ok()) << opened.status().diagnostic();
+  collection = std::move(opened).value();
+  for (std::size_t writer = 0; writer < kWriters; ++writer) {
+    for (std::size_t index = 0; index < kWritesPerWriter; ++index) {
+      const auto id = "prepared-" + std::to_string(writer) + "-" + std::to_string(index);
+      auto record = get(collection, id);
+      ASSERT_TRUE(record.ok()) << id;
+      EXPECT_EQ(record.value().document, "doc-" + id);
+      ASSERT_TRUE(record.value().vector.has_value());
+      const std::array<float, 2> expected{static_cast<float>(writer), static_cast<float>(index)};
+      const auto bytes = record.value().vector->bytes();
+      ASSERT_EQ(bytes.size(), sizeof(expected));
+      EXPECT_EQ(std::memcmp(bytes.data(), expected.data(), sizeof(expected)), 0);
+      EXPECT_FALSE(get(collection, id + "-bad").ok());
+    }
+  }
+}
+
 #ifndef _WIN32
 TEST_F(WalCoordinatorTest, SigkillProvesDurableReplayAndWeakSearchableCrashLoss) {
   const std::array<float, 2> vector{4.0F, 4.0F};
@@ -290,8 +290,11 @@ TEST_P(NonFiniteParam, NegInfComponentThrows) {
   EXPECT_THROW(b.add_batch(vectors.data(), labels.data(), kN), std::exception);
 }
 
-INSTANTIATE_TEST_SUITE_P(AllMetrics, NonFiniteParam,
-                         ::testing::Values(core::Metric::l2, core::Metric::inner_product, core::Metric::cosine));
+INSTANTIATE_TEST_SUITE_P(AllMetrics,
+                         NonFiniteParam,
+                         ::testing::Values(core::Metric::l2,
+                                           core::Metric::inner_product,
+                                           core::Metric::cosine));
 
 TEST_F(DiskFlatBuilderTest, NZeroAddBatchIsNoop) {
   DiskFlatBuilder b(8, core::Metric::l2);
@@ -5,18 +5,21 @@
 #include <gtest/gtest.h>
 #include <unistd.h>
 #include <algorithm>
+#include <chrono>
 #include <cmath>
 #include <cstddef>
 #include <cstdint>
 #include <cstring>
 #include <filesystem>  // NOLINT(build/c++17)
 #include <fstream>
+#include <future>
 #include <limits>
 #include <numeric>
 #include <random>
 #include <stdexcept>
 #include <string>
 #include <vector>
+#include "core/any_segment.hpp"
 #include "index/disk/disk_flat_builder.hpp"
 #include "index/disk/disk_flat_searcher.hpp"
 #include "index/disk/segment_manifest.hpp"
@@ -371,8 +374,120 @@ TEST_P(NonFiniteQueryParam, PosInfQueryThrows) {
   EXPECT_THROW(s.search(query.data(), opts), std::invalid_argument);
 }
 
-INSTANTIATE_TEST_SUITE_P(AllMetrics, NonFiniteQueryParam,
-                         ::testing::Values(core::Metric::l2, core::Metric::inner_product, core::Metric::cosine));
+INSTANTIATE_TEST_SUITE_P(AllMetrics,
+                         NonFiniteQueryParam,
+                         ::testing::Values(core::Metric::l2,
+                                           core::Metric::inner_product,
+                                           core::Metric::cosine));
+
+// 200k rows give three 65536-row scan workers, so the merge sees partial
+// heaps from every range, including the short last one.
+TEST_F(DiskFlatSearcherTest, ParallelScanMatchesSerialScanBitForBit) {
+  constexpr uint32_t kDim = 8;
+  constexpr uint64_t kN = 200000;
+  auto vectors = make_random_vectors(kN, kDim, 71);
+  auto labels = sequential_labels(kN);
+  auto seg_dir = build_segment(core::Metric::l2, vectors, labels, kDim, "seg_00000001");
+
+  DiskFlatSegmentSearcher s(seg_dir);
+  DiskSearchOptions serial;
+  serial.top_k = 50;
+  DiskSearchOptions parallel = serial;
+  parallel.scan_threads = 8;
+  for (uint32_t seed = 400; seed < 404; ++seed) {
+    auto query = make_random_vectors(1, kDim, seed);
+    auto expected = s.search(query.data(), serial);
+    auto actual = s.search(query.data(), parallel);
+    ASSERT_EQ(actual.size(), expected.size());
+    for (size_t i = 0; i < expected.size(); ++i) {
+      EXPECT_EQ(actual[i].label, expected[i].label) << "seed " << seed << " rank " << i;
+      EXPECT_EQ(actual[i].distance, expected[i].distance) << "seed " << seed << " rank " << i;
+    }
+  }
+}
+
+// The scan ranges run on the shared sync-adapter workers. A search that is
+// itself running on one of them (as start_search does) must still finish
+// when every other worker is busy or absent: the caller scans the ranges no
+// helper has picked up.
+TEST_F(DiskFlatSearcherTest, ParallelScanFinishesOnASharedAdapterWorker) {
+  constexpr uint32_t kDim = 8;
+  constexpr uint64_t kN = 200000;
+  auto vectors = make_random_vectors(kN, kDim, 73);
+  auto labels = sequential_labels(kN);
+  auto seg_dir = build_segment(core::Metric::l2, vectors, labels, kDim, "seg_00000001");
+
+  DiskFlatSegmentSearcher s(seg_dir);
+  DiskSearchOptions serial;
+  serial.top_k = 20;
+  DiskSearchOptions parallel = serial;
+  parallel.scan_threads = 64;
+  auto query = make_random_vectors(1, kDim, 405);
+  const auto expected = s.search(query.data(), serial);
+
+  std::promise<std::vector<DiskSearchHit>> done;
+  auto result = done.get_future();
+  core::detail::SyncAdapterExecutor::instance().submit([&] {
+    done.set_value(s.search(query.data(), parallel));
+  });
+  ASSERT_EQ(result.wait_for(std::chrono::seconds(60)), std::future_status::ready);
+  const auto actual = result.get();
+  ASSERT_EQ(actual.size(), expected.size());
+  for (size_t i = 0; i < expected.size(); ++i) {
+    EXPECT_EQ(actual[i].label, expected[i].label) << "rank " << i;
+    EXPECT_EQ(actual[i].distance, expected[i].distance) << "rank " << i;
+  }
+}
+
+class BatchSearchParam : public DiskFlatSearcherTest,
+                         public ::testing::WithParamInterface<core::Metric> {};
+
+// 256-dim rows are 1 KiB, so 700 rows and 300 queries span three row tiles
+// and two query tiles, both ending in a partial tile.
+TEST_P(BatchSearchParam, TiledBatchMatchesPerQuerySearchBitForBit) {
+  constexpr uint32_t kDim = 256;
+  constexpr uint64_t kN = 700;
+  constexpr uint32_t kQueries = 300;
+  auto vectors = make_random_vectors(kN, kDim, 61);
+  auto labels = sequential_labels(kN);
+  auto seg_dir = build_segment(GetParam(), vectors, labels, kDim, "seg_00000001");
+
+  DiskFlatSegmentSearcher s(seg_dir);
+  auto queries = make_random_vectors(kQueries, kDim, 301);
+  DiskSearchOptions opts;
+  opts.top_k = 7;
+  auto batched = s.batch_search(queries.data(), kQueries, opts);
+  ASSERT_EQ(batched.size(), kQueries);
+  for (uint32_t q = 0; q < kQueries; ++q) {
+    auto single = s.search(queries.data() + static_cast<size_t>(q) * kDim, opts);
+    ASSERT_EQ(batched[q].size(), single.size()) << "query " << q;
+    for (size_t i = 0; i < single.size(); ++i) {
+      EXPECT_EQ(batched[q][i].label, single[i].label) << "query " << q << " rank " << i;
+      EXPECT_EQ(batched[q][i].distance, single[i].distance) << "query " << q << " rank " << i;
+    }
+  }
+}
+
+TEST_P(BatchSearchParam, TiledBatchRejectsAnyNonFiniteQuery) {
+  constexpr uint32_t kDim = 8;
+  auto vectors = make_random_vectors(10, kDim, 62);
+  auto labels = sequential_labels(10);
+  auto seg_dir = build_segment(GetParam(), vectors, labels, kDim, "seg_00000001");
+
+  DiskFlatSegmentSearcher s(seg_dir);
+  auto queries = make_random_vectors(3, kDim, 302);
+  queries[kDim + 2] = std::numeric_limits<float>::quiet_NaN();
+  DiskSearchOptions opts;
+  opts.top_k = 3;
+  EXPECT_THROW(s.batch_search(queries.data(), 3, opts), std::invalid_argument);
+  EXPECT_TRUE(s.batch_search(queries.data(), 0, opts).empty());
+}
+
+INSTANTIATE_TEST_SUITE_P(AllMetrics,
+                         BatchSearchParam,
+                         ::testing::Values(core::Metric::l2,
+                                           core::Metric::inner_product,
+                                           core::Metric::cosine));
 
 TEST_F(DiskFlatSearcherTest, TopKZeroThrows) {
   constexpr uint32_t kDim = 4;
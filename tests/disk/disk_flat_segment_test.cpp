@@ -8,6 +8,7 @@
 #include <cstdint>
 #include <filesystem>
 #include <fstream>
+#include <limits>
 #include <memory>
 #include <span>
 #include <stdexcept>
@@ -254,5 +255,67 @@ TEST(DiskFlatSegment, BuildOpenAndSearchRejectInsufficientResources) {
   EXPECT_EQ(typed_status.code(), core::StatusCode::not_supported);
 }
 
+TEST(DiskFlatSegment, BatchSearchMatchesSingleSearchAndIsolatesInvalidRows) {
+  TemporaryDirectory temporary;
+  FixtureRows rows;
+  auto segment = build_segment(rows, temporary.path() / "batch");
+  constexpr core::RowCount kQueries = 3;
+  constexpr std::uint64_t kTopK = 4;
+
+  SearchCall batch(rows.vectors.data(), kQueries, FixtureRows::kDim, kTopK);
+  ASSERT_TRUE(segment->batch_search(batch.request).ok());
+  for (core::RowCount row = 0; row < kQueries; ++row) {
+    SearchCall single(rows.vectors.data() + row * FixtureRows::kDim, 1, FixtureRows::kDim, kTopK);
+    ASSERT_TRUE(segment->search(single.request).ok());
+    ASSERT_TRUE(batch.statuses[row].ok());
+    ASSERT_EQ(batch.counts[row], single.counts[0]);
+    for (core::RowCount index = 0; index < single.counts[0]; ++index) {
+      const auto &expected = single.hits[index];
+      const auto &actual = batch.hits[batch.offsets[row] + index];
+      EXPECT_EQ(actual.row_id.value, expected.row_id.value) << "query " << row << " rank " << index;
+      EXPECT_EQ(actual.score, expected.score) << "query " << row << " rank " << index;
+    }
+  }
+
+  auto queries = rows.vectors;
+  queries[FixtureRows::kDim + 1] = std::numeric_limits<float>::quiet_NaN();
+  SearchCall mixed(queries.data(), kQueries, FixtureRows::kDim, kTopK);
+  ASSERT_TRUE(segment->batch_search(mixed.request).ok());
+  EXPECT_TRUE(mixed.statuses[0].ok());
+  EXPECT_FALSE(mixed.statuses[1].ok());
+  EXPECT_EQ(mixed.completeness[1], core::SearchCompleteness::failed);
+  EXPECT_TRUE(mixed.statuses[2].ok());
+  EXPECT_EQ(mixed.counts[2], kTopK);
+}
+
+TEST(DiskFlatSegment, ScanThreadsExtensionIsValidatedAndKeepsResults) {
+  TemporaryDirectory temporary;
+  FixtureRows rows;
+  auto segment = build_segment(rows, temporary.path() / "threads");
+  constexpr core::RowCount kQueries = 2;
+  constexpr std::uint64_t kTopK = 5;
+
+  SearchCall serial(rows.vectors.data(), kQueries, FixtureRows::kDim, kTopK);
+  ASSERT_TRUE(segment->batch_search(serial.request).ok());
+
+  DiskFlatSegmentSearchExtension threads;
+  threads.scan_threads = 4;
+  const std::array extensions{DiskFlatSegment::make_search_extension(threads)};
+  SearchCall parallel(rows.vectors.data(), kQueries, FixtureRows::kDim, kTopK);
+  parallel.request.options.extensions = extensions;
+  ASSERT_TRUE(segment->batch_search(parallel.request).ok());
+  for (std::size_t index = 0; index < serial.hits.size(); ++index) {
+    EXPECT_EQ(parallel.hits[index].row_id.value, serial.hits[index].row_id.value);
+    EXPECT_EQ(parallel.hits[index].score, serial.hits[index].score);
+  }
+
+  threads.scan_threads = 0;
+  SearchCall invalid(rows.vectors.data(), 1, FixtureRows::kDim, kTopK);
+  invalid.request.options.extensions = extensions;
+  const auto status = segment->search(invalid.request);
+  EXPECT_EQ(status.code(), core::StatusCode::invalid_argument);
+  EXPECT_EQ(status.detail(), core::StatusDetail::malformed_struct);
+}
+
 }  // namespace
 }  // namespace alaya::disk
@@ -431,6 +431,8 @@ TEST(LaserSegment, DifferentialRankOnlyManifestGateCollectionRejectionAndPerform
   }
   ASSERT_EQ(rerank_calls, 5U);
   EXPECT_GT(standalone_stats.rerank_nanoseconds, 0U);
+  // The paged search reports the page reads it made, or joined, itself.
+  EXPECT_GT(standalone_stats.device_reads + standalone_stats.coalesced_reads, 0U);
 
   // The same Collection route with the explicit numeric-result switch must
   // bypass its exact_rerank callback: LASER's score is already a comparable
@@ -2,11 +2,14 @@
 //
 // SPDX-License-Identifier: AGPL-3.0-only
 
+#include "index/collection/sha256.hpp"
+#include "index/collection/verified_digest_cache.hpp"
 #include "index/disk/laser_segment_importer.hpp"
 #include "index/disk/segment_factory.hpp"
 #include "index/disk/segment_manifest.hpp"
 #include "index/graph/laser/utils/rotator.hpp"
 #include "core/value_types.hpp"
+#include "platform/fs.hpp"
 
 #include <gtest/gtest.h>
 #include <unistd.h>
@@ -403,6 +406,65 @@ TEST_F(LaserSegmentImporterTest, native_artifact_byte_identical_to_source) {
   }
 }
 
+TEST_F(LaserSegmentImporterTest, move_files_renames_sources_into_the_segment) {
+  skip_if_laser_gate_not_ready();
+  auto ids = labels();
+  const auto target = seg_dir();
+  populate_artifacts(target.filename().string());
+  const auto index_name = index_filename(target.filename().string(), {});
+  const auto expected = read_bytes(src_dir_ / index_name);
+
+  LaserSegmentImportParams params;
+  params.move_files = true;
+  LaserSegmentImporter importer(kDim, core::Metric::l2, params);
+  importer.import_from(src_dir_, ids.data(), ids.size(), target);
+
+  EXPECT_EQ(read_bytes(target / index_name), expected);
+  EXPECT_FALSE(std::filesystem::exists(src_dir_ / index_name));
+  EXPECT_FALSE(std::filesystem::exists(src_dir_ / (index_name + "_rotator")));
+  EXPECT_TRUE(std::filesystem::exists(src_dir_ / "dsqg_seg_00000001_pca_base.fbin"));
+  expect_no_tmp_debris(seg_parent_);
+}
+
+TEST_F(LaserSegmentImporterTest, ids_digest_is_remembered_without_reading_the_file) {
+  skip_if_laser_gate_not_ready();
+  auto ids = labels();
+  const auto target = seg_dir();
+  populate_artifacts(target.filename().string());
+
+  LaserSegmentImporter importer(kDim, core::Metric::l2, {});
+  importer.import_from(src_dir_, ids.data(), ids.size(), target);
+
+  const auto identity = platform::file_identity(target / "ids.u64.bin");
+  ASSERT_TRUE(identity.has_value());
+  const auto remembered =
+      internal::collection::VerifiedDigestCache::instance().find(*identity);
+  ASSERT_TRUE(remembered.has_value());
+  EXPECT_EQ(*remembered, internal::collection::sha256_file(target / "ids.u64.bin"));
+}
+
+TEST_F(LaserSegmentImporterTest, source_digests_are_remembered_for_renamed_artifacts) {
+  skip_if_laser_gate_not_ready();
+  auto ids = labels();
+  const auto target = seg_dir();
+  populate_artifacts(target.filename().string());
+  const auto rotator_name = index_filename(target.filename().string(), {}) + "_rotator";
+
+  LaserSegmentImportParams params;
+  params.move_files = true;
+  params.source_digests.emplace(rotator_name,
+                                internal::collection::sha256_file(src_dir_ / rotator_name));
+  LaserSegmentImporter importer(kDim, core::Metric::l2, params);
+  importer.import_from(src_dir_, ids.data(), ids.size(), target);
+
+  const auto identity = platform::file_identity(target / rotator_name);
+  ASSERT_TRUE(identity.has_value());
+  const auto remembered =
+      internal::collection::VerifiedDigestCache::instance().find(*identity);
+  ASSERT_TRUE(remembered.has_value());
+  EXPECT_EQ(*remembered, internal::collection::sha256_file(target / rotator_name));
+}
+
 #else
 
 TEST(LaserSegmentImporterUnsupportedBuildTest, stub_throws_dual_substring_message) {
@@ -11,6 +11,8 @@
 #include <cstring>
 #include <filesystem>
 #include <fstream>
+#include <iterator>
+#include <map>
 #include <random>
 #include <string>
 #include <vector>
@@ -191,4 +193,43 @@ TEST_F(LaserPageLayoutRoundTripTest, BuilderPacksLowDimNodesPerReadPathLayout) {
   }
 }
 
+TEST_F(LaserPageLayoutRoundTripTest, InMemoryBuildWritesTheSameFilesAsTheFileBuild) {
+  const auto snapshot = make_graph_snapshot();
+  {
+    alaya::laser::QuantizedGraph graph(kNumPoints, kDegree, kMainDim, kDim, kSeed);
+    alaya::laser::QGBuilder builder(graph, /*ef_build=*/64, /*num_threads=*/2);
+    builder.build_from_graph(snapshot, prefix_.string().c_str());
+  }
+  // No _pca_base.fbin next to the in-memory output: it must not be read.
+  const auto memory_prefix = root_ / "memory" / "tiny";
+  std::filesystem::create_directories(memory_prefix.parent_path());
+  std::map<std::string, std::vector<char>> observed;
+  {
+    alaya::laser::QuantizedGraph graph(kNumPoints, kDegree, kMainDim, kDim, kSeed);
+    alaya::laser::QGBuilder builder(graph, /*ef_build=*/64, /*num_threads=*/2);
+    builder.set_file_bytes_observer([&](const std::string &path, const char *bytes, size_t len) {
+      observed[path].insert(observed[path].end(), bytes, bytes + len);
+    });
+    builder.build_in_memory(snapshot, vectors_.data(), memory_prefix.string().c_str());
+  }
+
+  auto read_all = [](const std::string &path) {
+    std::ifstream in(path, std::ios::binary);
+    return std::vector<char>(std::istreambuf_iterator<char>(in), {});
+  };
+  const std::string suffix =
+      "_R" + std::to_string(kDegree) + "_MD" + std::to_string(kMainDim) + ".index";
+  for (const auto *tail : {"", "_rotator", "_cache_ids", "_cache_nodes"}) {
+    SCOPED_TRACE(tail);
+    const auto expected = read_all(prefix_.string() + suffix + tail);
+    ASSERT_FALSE(expected.empty());
+    EXPECT_EQ(read_all(memory_prefix.string() + suffix + tail), expected);
+    EXPECT_EQ(observed[memory_prefix.string() + suffix + tail], expected);
+  }
+  EXPECT_EQ(observed.size(), 4U);
+  EXPECT_EQ(std::distance(std::filesystem::directory_iterator(memory_prefix.parent_path()),
+                          std::filesystem::directory_iterator()),
+            4);
+}
+
 }  // namespace
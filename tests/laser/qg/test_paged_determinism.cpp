@@ -11,6 +11,7 @@
 
 #include <unistd.h>
 
+#include <algorithm>
 #include <array>
 #include <atomic>
 #include <barrier>
@@ -203,5 +204,47 @@ TEST_F(PagedDeterminismTest, ConcurrentLanesMatchSerialTopK) {
   EXPECT_FALSE(mismatch.load()) << mismatch_detail;
 }
 
+TEST_F(PagedDeterminismTest, InterleavedBatchMatchesSerialTopK) {
+  auto graph = open_zero_cache_graph();
+  std::vector<float> queries(kQueryCount * kDim);
+  std::vector<PID> expected(kQueryCount * kTopK);
+  for (size_t query_index = 0; query_index < kQueryCount; ++query_index) {
+    std::copy_n(query(query_index), kDim, queries.begin() + query_index * kDim);
+    const auto serial = search(*graph, query_index);
+    std::copy(serial.begin(), serial.end(), expected.begin() + query_index * kTopK);
+  }
+
+  for (size_t repeat = 0; repeat < kSerialRepeats; ++repeat) {
+    std::vector<PID> actual(kQueryCount * kTopK);
+    graph->batch_search(queries.data(),
+                        kTopK,
+                        actual.data(),
+                        kQueryCount,
+                        kEfSearch,
+                        kBeamWidth);
+    EXPECT_EQ(actual, expected) << "repeat=" << repeat;
+  }
+}
+
+TEST_F(PagedDeterminismTest, RowCacheHitsLeaveTopKUnchanged) {
+  auto uncached = open_zero_cache_graph();
+  auto cached = open_zero_cache_graph();
+  cached->set_row_cache_budget(size_t{4} << 20U);
+
+  // Pass 0 fills the cache (each row is admitted on its second miss); later
+  // passes are served largely from it and must not move a single result.
+  for (size_t pass = 0; pass < 3; ++pass) {
+    for (size_t query_index = 0; query_index < kQueryCount; ++query_index) {
+      EXPECT_EQ(search(*cached, query_index), search(*uncached, query_index))
+          << "pass=" << pass << ", query=" << query_index;
+    }
+  }
+  const auto stats = cached->row_cache_stats();
+  EXPECT_GT(stats.hits, 0U);
+  EXPECT_GT(stats.admitted, 0U);
+  EXPECT_GT(stats.hit_rate(), 0.0);
+  EXPECT_EQ(uncached->row_cache_stats().hits + uncached->row_cache_stats().misses, 0U);
+}
+
 }  // namespace
 }  // namespace alaya::laser
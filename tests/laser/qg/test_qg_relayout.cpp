@@ -0,0 +1,251 @@
+// SPDX-FileCopyrightText: 2026 AlayaDB.AI
+//
+// SPDX-License-Identifier: AGPL-3.0-only
+
+// Tests for the query-log-driven page relayout (qg_relayout.hpp):
+//   1. plan_qg_relayout packs co-visited rows onto shared pages and returns a
+//      valid permutation with cold rows kept in source order.
+//   2. relayout_qg_index writes an index whose arena search results, mapped
+//      back through new_to_old, are the source's, with the hot rows cached
+//      first.
+
+#include <gtest/gtest.h>
+
+#include <unistd.h>
+
+#include <algorithm>
+#include <atomic>
+#include <cstdint>
+#include <filesystem>
+#include <fstream>
+#include <random>
+#include <string>
+#include <thread>
+#include <vector>
+
+#include "index/graph/laser/qg/qg.hpp"
+#include "index/graph/laser/qg/qg_builder.hpp"
+#include "index/graph/laser/qg/qg_relayout.hpp"
+#include "index/graph/vamana/vamana_builder.hpp"
+#include "index/graph/vamana/vamana_writer.hpp"
+
+namespace alaya::laser {
+namespace {
+
+constexpr size_t kDim = 64;
+constexpr size_t kDeg = 64;
+constexpr size_t kN = 2000;
+
+std::vector<float> make_data(size_t n, size_t dim, uint32_t seed) {
+  std::mt19937 gen(seed);
+  std::normal_distribution<float> dist(0.0F, 1.0F);
+  std::vector<float> data(n * dim);
+  for (auto &v : data) {
+    v = dist(gen);
+  }
+  return data;
+}
+
+void write_fbin(const std::string &path, const float *data, int32_t n, int32_t dim) {
+  std::ofstream out(path, std::ios::binary | std::ios::trunc);
+  ASSERT_TRUE(out.is_open());
+  out.write(reinterpret_cast<const char *>(&n), 4);
+  out.write(reinterpret_cast<const char *>(&dim), 4);
+  out.write(reinterpret_cast<const char *>(data),
+            static_cast<std::streamsize>(sizeof(float) * n * dim));
+}
+
+struct TinyIndex {
+  std::filesystem::path dir;
+  std::string prefix;
+  std::vector<float> data;
+
+  static TinyIndex build(uint32_t seed) {
+    TinyIndex t;
+    t.dir = std::filesystem::temp_directory_path() /
+            ("qg_relayout_test_" + std::to_string(::getpid()) + "_" + std::to_string(seed));
+    std::filesystem::create_directories(t.dir);
+    t.prefix = (t.dir / "tiny").string();
+    t.data = make_data(kN, kDim, seed);
+
+    alaya::vamana::VamanaBuildParams vp;
+    vp.R = kDeg;
+    vp.L = 64;
+    vp.alpha = 1.2F;
+    vp.num_threads = 1;
+    alaya::vamana::VamanaBuilder vb(t.data.data(), kN, kDim, vp);
+    vb.build();
+    const std::string vamana_path = t.prefix + "_vamana.index";
+    alaya::vamana::save_graph(vb.graph(), vamana_path, kDeg, vb.medoid());
+
+    write_fbin(t.prefix + "_pca_base.fbin", t.data.data(), kN, kDim);
+
+    QuantizedGraph qg(kN, kDeg, kDim, kDim, /*rotator_seed=*/7);
+    QGBuilder builder(qg, /*ef_build=*/64, /*num_threads=*/1);
+    builder.build(vamana_path.c_str(), t.prefix.c_str());
+    return t;
+  }
+
+  ~TinyIndex() {
+    std::error_code ec;
+    std::filesystem::remove_all(dir, ec);
+  }
+};
+
+auto index_suffix() -> std::string {
+  return "_R" + std::to_string(kDeg) + "_MD" + std::to_string(kDim) + ".index";
+}
+
+TEST(QGRelayout, PlanPacksCoVisitedRows) {
+  constexpr size_t kRows = 64;
+  constexpr size_t kPerPage = 4;
+  VisitSketch sketch(kRows, 1);
+  // Three groups that search always expands together, interleaved in PID
+  // order so the source layout scatters each over separate pages.
+  for (int round = 0; round < 20; ++round) {
+    sketch.record(std::vector<PID>{3, 17, 40, 58});
+    sketch.record(std::vector<PID>{5, 21, 33});
+    sketch.record(std::vector<PID>{9, 50});
+  }
+
+  const auto plan = plan_qg_relayout(kRows, kPerPage, sketch);
+  ASSERT_EQ(plan.new_to_old.size(), kRows);
+  ASSERT_EQ(plan.old_to_new.size(), kRows);
+  EXPECT_EQ(plan.hot_rows, 9U);
+  for (size_t p = 0; p < kRows; ++p) {
+    EXPECT_EQ(plan.old_to_new[plan.new_to_old[p]], p);
+  }
+
+  auto page_of = [&](PID old_id) { return plan.old_to_new[old_id] / kPerPage; };
+  EXPECT_EQ(page_of(3), page_of(17));
+  EXPECT_EQ(page_of(3), page_of(40));
+  EXPECT_EQ(page_of(3), page_of(58));
+  EXPECT_EQ(page_of(5), page_of(21));
+  EXPECT_EQ(page_of(5), page_of(33));
+  EXPECT_NE(page_of(3), page_of(5));
+
+  // Cold rows follow the hot ones in their original order.
+  for (size_t p = plan.hot_rows + 1; p < kRows; ++p) {
+    EXPECT_LT(plan.new_to_old[p - 1], plan.new_to_old[p]);
+  }
+
+  VisitSketch wrong(kRows + 1, 1);
+  EXPECT_THROW((void)plan_qg_relayout(kRows, kPerPage, wrong), std::invalid_argument);
+}
+
+TEST(QGRelayout, PlanStaysAPermutationWhileSearchesKeepRecording) {
+  constexpr size_t kRows = 256;
+  constexpr size_t kPerPage = 4;
+  VisitSketch sketch(kRows, 1);
+  std::atomic<bool> stop{false};
+  std::thread recorder([&] {
+    std::vector<PID> trace(6);
+    for (PID round = 0; !stop.load(std::memory_order_relaxed); ++round) {
+      for (size_t i = 0; i < trace.size(); ++i) {
+        trace[i] = static_cast<PID>((round * 7 + i * 31) % kRows);
+      }
+      sketch.record(trace);
+    }
+  });
+  for (int attempt = 0; attempt < 50; ++attempt) {
+    const auto plan = plan_qg_relayout(kRows, kPerPage, sketch);
+    ASSERT_EQ(plan.new_to_old.size(), kRows);
+    std::vector<bool> seen(kRows, false);
+    for (const auto old_id : plan.new_to_old) {
+      ASSERT_LT(old_id, kRows);
+      ASSERT_FALSE(seen[old_id]);
+      seen[old_id] = true;
+    }
+  }
+  stop.store(true, std::memory_order_relaxed);
+  recorder.join();
+}
+
+TEST(QGRelayout, RelaidOutIndexAnswersLikeTheSource) {
+  const TinyIndex tiny = TinyIndex::build(/*seed=*/41);
+  const std::string suffix = index_suffix();
+
+  QuantizedGraph source(kN, kDeg, kDim, kDim, /*rotator_seed=*/7);
+  source.load_disk_index(tiny.prefix.c_str(), /*search_DRAM_budget=*/0.0005F);
+  source.set_params(/*ef_search=*/96, /*num_threads=*/1, /*beam_width=*/4);
+  auto sketch = std::make_shared<VisitSketch>(kN, 1);
+  source.set_visit_sketch(sketch);
+
+  constexpr uint32_t kK = 10;
+  constexpr uint32_t kQueries = 32;
+  std::vector<std::vector<uint32_t>> want(kQueries, std::vector<uint32_t>(kK));
+  for (uint32_t qi = 0; qi < kQueries; ++qi) {
+    const float *query = tiny.data.data() + static_cast<size_t>(qi * 13 % kN) * kDim;
+    source.search(query, kK, want[qi].data());
+  }
+  ASSERT_EQ(sketch->sampled_queries(), kQueries);
+  ASSERT_FALSE(sketch->co_visits().empty());
+
+  const std::string dst_prefix = (tiny.dir / "relaid").string();
+  const auto plan = relayout_qg_index(tiny.prefix, dst_prefix, kDeg, kDim, *sketch);
+  ASSERT_EQ(plan.new_to_old.size(), kN);
+  EXPECT_GT(plan.hot_rows, 0U);
+  std::filesystem::copy_file(tiny.prefix + suffix + "_rotator", dst_prefix + suffix + "_rotator");
+  for (const auto *tail : {"_medoids", "_pca.bin"}) {
+    if (std::filesystem::exists(tiny.prefix + tail)) {
+      std::filesystem::copy_file(tiny.prefix + tail, dst_prefix + tail);
+    }
+  }
+  EXPECT_EQ(std::filesystem::file_size(dst_prefix + suffix),
+            std::filesystem::file_size(tiny.prefix + suffix));
+
+  // The truncated cache keeps its size and now leads with the hot rows.
+  std::ifstream ids(dst_prefix + suffix + "_cache_ids", std::ios::binary);
+  size_t cached = 0;
+  ids.read(reinterpret_cast<char *>(&cached), sizeof(cached));
+  std::ifstream old_ids(tiny.prefix + suffix + "_cache_ids", std::ios::binary);
+  size_t old_cached = 0;
+  old_ids.read(reinterpret_cast<char *>(&old_cached), sizeof(old_cached));
+  EXPECT_EQ(cached, old_cached);
+  std::vector<PID> cache(cached);
+  ids.read(reinterpret_cast<char *>(cache.data()),
+           static_cast<std::streamsize>(sizeof(PID) * cached));
+  for (size_t i = 0; i < std::min(cached, plan.hot_rows); ++i) {
+    EXPECT_EQ(cache[i], i);
+  }
+
+  QuantizedGraph relaid(kN, kDeg, kDim, kDim, /*rotator_seed=*/7);
+  relaid.load_disk_index(dst_prefix.c_str(), /*search_DRAM_budget=*/0.0005F);
+  relaid.set_params(96, 1, 4);
+  // The paged beam expands cached rows ahead of page reads, and the cache now
+  // holds other rows, so results may differ near the tail of the top-k.
+  size_t overlap = 0;
+  for (uint32_t qi = 0; qi < kQueries; ++qi) {
+    const float *query = tiny.data.data() + static_cast<size_t>(qi * 13 % kN) * kDim;
+    std::vector<uint32_t> got(kK);
+    relaid.search(query, kK, got.data());
+    EXPECT_EQ(plan.new_to_old[got.front()], want[qi].front());
+    for (const auto id : got) {
+      overlap += std::count(want[qi].begin(), want[qi].end(), plan.new_to_old[id]);
+    }
+  }
+  EXPECT_GE(overlap * 10, size_t{kQueries} * kK * 9);
+
+  // The arena kernel expands rows in a layout-independent order, so it must
+  // return exactly the source's neighbors.
+  source.ensure_resident_arena();
+  relaid.ensure_resident_arena();
+  for (uint32_t qi = 0; qi < 8; ++qi) {
+    const float *query = tiny.data.data() + static_cast<size_t>(qi * 29 % kN) * kDim;
+    std::vector<uint32_t> expected(kK);
+    std::vector<uint32_t> got(kK);
+    source.arena_search_qg(query, kK, expected.data());
+    relaid.arena_search_qg(query, kK, got.data());
+    for (auto &id : got) {
+      id = plan.new_to_old[id];
+    }
+    EXPECT_EQ(got, expected) << "relaid-out arena search diverged (query " << qi << ")";
+  }
+
+  VisitSketch wrong(kN - 1, 1);
+  EXPECT_THROW((void)relayout_qg_index(tiny.prefix, dst_prefix + "_x", kDeg, kDim, wrong),
+               std::invalid_argument);
+}
+
+}  // namespace
+}  // namespace alaya::laser
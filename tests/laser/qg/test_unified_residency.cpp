@@ -11,16 +11,24 @@
 //      is a load-time policy, not a build-time family choice.
 //   4. QGUpdater's write_at mirror keeps resident searches fresh across
 //      insert + writeback (append row and reverse-edge patches both land).
+//   5. map_resident_arena serves the same results from the mapped index file
+//      while its background prefault runs to completion.
+//   6. The chunked O_DIRECT arena loader produces the same bytes as reading
+//      the index file page by page, whatever the chunk size.
 
 #include <gtest/gtest.h>
 
 #include <unistd.h>
 
+#include <algorithm>
+#include <chrono>
 #include <cstdint>
+#include <cstring>
 #include <filesystem>
 #include <fstream>
 #include <random>
 #include <string>
+#include <thread>
 #include <vector>
 
 #include "index/graph/laser/qg/detail/qg_updater_core.hpp"
@@ -31,6 +39,41 @@
 #include "index/graph/vamana/vamana_writer.hpp"
 
 namespace alaya::laser {
+
+class QuantizedGraphTestAccess {
+ public:
+  static constexpr size_t kArenaChunkBytes = QuantizedGraph::kArenaChunkBytes;
+
+  static auto node_per_page(const QuantizedGraph &qg) -> size_t { return qg.node_per_page_; }
+  static auto page_size(const QuantizedGraph &qg) -> size_t { return qg.page_size_; }
+
+  // Reference arena: every page read in file order and its rows copied out.
+  static auto sequential_arena(const QuantizedGraph &qg) -> std::vector<char> {
+    std::ifstream in(qg.index_file_name_, std::ios::binary);
+    std::vector<char> arena(qg.num_points_ * qg.node_len_);
+    std::vector<char> page(qg.page_size_);
+    for (size_t base = 0; base < qg.num_points_; base += qg.node_per_page_) {
+      in.seekg(static_cast<std::streamoff>(kSectorLen + base / qg.node_per_page_ * qg.page_size_));
+      in.read(page.data(), static_cast<std::streamsize>(page.size()));
+      const size_t rows = std::min(qg.node_per_page_, qg.num_points_ - base);
+      std::memcpy(arena.data() + base * qg.node_len_, page.data(), rows * qg.node_len_);
+    }
+    return in ? arena : std::vector<char>{};
+  }
+
+  // Poisoned first, so a row the loader skips or cuts short cannot pass as
+  // zeros.
+  static auto chunked_arena(QuantizedGraph &qg, size_t chunk_bytes) -> std::vector<char> {
+    std::vector<char> arena(qg.num_points_ * qg.node_len_, static_cast<char>(0xA5));
+    qg.load_arena_pages(arena.data(), chunk_bytes);
+    return arena;
+  }
+
+  static auto resident_arena(const QuantizedGraph &qg) -> std::vector<char> {
+    return {qg.cache_nodes_.begin(), qg.cache_nodes_.end()};
+  }
+};
+
 namespace {
 
 constexpr size_t kDim = 64;
@@ -73,27 +116,27 @@ struct TinyIndex {
   std::string prefix;
   std::vector<float> data;
 
-  static TinyIndex build(uint32_t seed) {
+  static TinyIndex build(uint32_t seed, size_t n = kN) {
     TinyIndex t;
     t.dir = std::filesystem::temp_directory_path() /
             ("unified_residency_test_" + std::to_string(::getpid()) + "_" + std::to_string(seed));
     std::filesystem::create_directories(t.dir);
     t.prefix = (t.dir / "tiny").string();
-    t.data = make_data(kN, kDim, seed);
+    t.data = make_data(n, kDim, seed);
 
     alaya::vamana::VamanaBuildParams vp;
     vp.R = kDeg;
     vp.L = 64;
     vp.alpha = 1.2F;
     vp.num_threads = kRunningTsan ? 1 : 4;
-    alaya::vamana::VamanaBuilder vb(t.data.data(), kN, kDim, vp);
+    alaya::vamana::VamanaBuilder vb(t.data.data(), n, kDim, vp);
     vb.build();
     const std::string vamana_path = t.prefix + "_vamana.index";
     alaya::vamana::save_graph(vb.graph(), vamana_path, kDeg, vb.medoid());
 
-    write_fbin(t.prefix + "_pca_base.fbin", t.data.data(), kN, kDim);
+    write_fbin(t.prefix + "_pca_base.fbin", t.data.data(), static_cast<int32_t>(n), kDim);
 
-    QuantizedGraph qg(kN, kDeg, kDim, kDim, /*rotator_seed=*/7);
+    QuantizedGraph qg(n, kDeg, kDim, kDim, /*rotator_seed=*/7);
     QGBuilder builder(qg, /*ef_build=*/64, /*num_threads=*/kRunningTsan ? 1 : 4);
     builder.build(vamana_path.c_str(), t.prefix.c_str());
     return t;
@@ -134,8 +177,10 @@ TEST(UnifiedResidency, PrefetchDefaultBudget) {
 TEST(UnifiedResidency, ResidencyModeStrings) {
   EXPECT_EQ(residency_mode_from_string("paged_pool"), ResidencyMode::kPagedPool);
   EXPECT_EQ(residency_mode_from_string("resident_arena"), ResidencyMode::kResidentArena);
+  EXPECT_EQ(residency_mode_from_string("mapped_arena"), ResidencyMode::kMappedArena);
   EXPECT_EQ(residency_mode_to_string(ResidencyMode::kPagedPool), "paged_pool");
   EXPECT_EQ(residency_mode_to_string(ResidencyMode::kResidentArena), "resident_arena");
+  EXPECT_EQ(residency_mode_to_string(ResidencyMode::kMappedArena), "mapped_arena");
   EXPECT_THROW((void)residency_mode_from_string("mmap"), std::invalid_argument);
 }
 
@@ -215,6 +260,84 @@ TEST(UnifiedResidency, EnsureResidentArenaFromFile) {
   }
 }
 
+TEST(UnifiedResidency, MappedArenaMatchesResidentArena) {
+  const TinyIndex tiny = TinyIndex::build(/*seed=*/29);
+
+  QuantizedGraph full(kN, kDeg, kDim, kDim, /*rotator_seed=*/7);
+  full.load_disk_index(tiny.prefix.c_str(), /*search_DRAM_budget=*/4.0F);
+  full.ensure_resident_arena();
+  full.set_params(96, 1, 4);
+
+  QuantizedGraph mapped(kN, kDeg, kDim, kDim, /*rotator_seed=*/7);
+  mapped.load_disk_index(tiny.prefix.c_str(), /*search_DRAM_budget=*/0.000001F);
+  mapped.set_params(96, 1, 4);
+  auto provider = make_residency_provider(ResidencyMode::kMappedArena);
+  EXPECT_EQ(provider->mode(), ResidencyMode::kMappedArena);
+  provider->prepare(mapped);
+  provider->prepare(mapped);  // idempotent
+  ASSERT_TRUE(mapped.arena_mapped());
+  EXPECT_FALSE(mapped.arena_resident()) << "the mapped arena must not copy rows to the heap";
+
+  constexpr uint32_t kK = 10;
+  auto expect_same = [&](const char *phase) {
+    for (uint32_t qi = 0; qi < 16; ++qi) {
+      const float *query = tiny.data.data() + static_cast<size_t>(qi * 11 % kN) * kDim;
+      std::vector<uint32_t> want(kK);
+      full.arena_search_qg(query, kK, want.data());
+      EXPECT_EQ(run_search(*provider, mapped, query, kK), want)
+          << phase << ": mapped arena must match the heap arena (query " << qi << ")";
+    }
+  };
+  // Searches need not wait for the prefault.
+  expect_same("during prefault");
+
+  const auto deadline = std::chrono::steady_clock::now() + std::chrono::seconds(30);
+  while (!MappedArenaProvider::readiness(mapped).complete() &&
+         std::chrono::steady_clock::now() < deadline) {
+    std::this_thread::sleep_for(std::chrono::milliseconds(1));
+  }
+  const auto readiness = MappedArenaProvider::readiness(mapped);
+  EXPECT_TRUE(readiness.complete());
+  EXPECT_EQ(readiness.pages_ready, readiness.pages_total);
+  EXPECT_GT(readiness.pages_total, 0U);
+  EXPECT_DOUBLE_EQ(readiness.fraction(), 1.0);
+  expect_same("after prefault");
+}
+
+TEST(UnifiedResidency, ChunkedArenaLoadMatchesSequentialRead) {
+  // One row past a whole number of pages (node_per_page is 2 at this
+  // geometry), so the last page ends short.
+  constexpr size_t kOddN = kN + 1;
+  const TinyIndex tiny = TinyIndex::build(/*seed=*/41, kOddN);
+
+  QuantizedGraph qg(kOddN, kDeg, kDim, kDim, /*rotator_seed=*/7);
+  qg.load_disk_index(tiny.prefix.c_str(), /*search_DRAM_budget=*/0.000001F);
+  const size_t node_per_page = QuantizedGraphTestAccess::node_per_page(qg);
+  const size_t page_size = QuantizedGraphTestAccess::page_size(qg);
+  const size_t num_pages = (kOddN + node_per_page - 1) / node_per_page;
+  ASSERT_NE(kOddN % node_per_page, 0U) << "the last page must end short of a full page of rows";
+
+  const auto want = QuantizedGraphTestAccess::sequential_arena(qg);
+  ASSERT_FALSE(want.empty());
+
+  // One page per chunk, a chunk size that leaves a short last chunk, and the
+  // default size (the whole file in one chunk).
+  size_t uneven_pages = 2;
+  while (num_pages % uneven_pages == 0) {
+    ++uneven_pages;
+  }
+  for (const size_t chunk_bytes : {page_size,
+                                   uneven_pages * page_size,
+                                   QuantizedGraphTestAccess::kArenaChunkBytes}) {
+    SCOPED_TRACE("chunk_bytes=" + std::to_string(chunk_bytes));
+    EXPECT_TRUE(QuantizedGraphTestAccess::chunked_arena(qg, chunk_bytes) == want);
+  }
+
+  qg.ensure_resident_arena();
+  ASSERT_TRUE(qg.arena_resident());
+  EXPECT_TRUE(QuantizedGraphTestAccess::resident_arena(qg) == want);
+}
+
 TEST(UnifiedResidency, UpdaterMirrorKeepsArenaFresh) {
   const TinyIndex tiny = TinyIndex::build(/*seed=*/37);
 
@@ -14,7 +14,6 @@
 #include "index/graph/laser/utils/aligned_file_reader.hpp"
 #include "index/graph/laser/utils/buffer.hpp"
 #include "index/graph/laser/utils/concurrent_queue.hpp"
-#include "index/graph/laser/utils/freq_relayout.hpp"
 #include "index/graph/laser/utils/io.hpp"
 #include "index/graph/laser/utils/memory.hpp"
 #include "index/graph/laser/utils/pca_transform.hpp"
@@ -22,11 +21,13 @@
 #include "index/graph/laser/utils/scalar_quantize.hpp"
 #include "index/graph/laser/utils/stopw.hpp"
 #include "index/graph/laser/utils/tools.hpp"
+#include "index/graph/laser/utils/visit_sketch.hpp"
 #include "index/graph/laser/quantization/fastscan_impl.hpp"
 #include "index/graph/laser/quantization/rabitq.hpp"
 #include "index/graph/laser/qg/qg.hpp"
 #include "index/graph/laser/qg/qg_builder.hpp"
 #include "index/graph/laser/qg/qg_query.hpp"
+#include "index/graph/laser/qg/qg_relayout.hpp"
 #include "index/graph/laser/qg/qg_scanner.hpp"
 #include "third_party/ngt/hashset.hpp"
 #include "index/graph/laser/utils/array.hpp"
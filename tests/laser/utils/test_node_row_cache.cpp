@@ -0,0 +1,128 @@
+// SPDX-FileCopyrightText: 2026 AlayaDB.AI
+//
+// SPDX-License-Identifier: AGPL-3.0-only
+
+#include <gtest/gtest.h>
+
+#include <atomic>
+#include <cstddef>
+#include <cstring>
+#include <thread>
+#include <vector>
+
+#include "index/graph/laser/utils/node_row_cache.hpp"
+
+namespace alaya::laser {
+namespace {
+
+constexpr size_t kRowLen = 64;
+
+auto make_row(PID id) -> std::vector<char> {
+  std::vector<char> row(kRowLen);
+  for (size_t i = 0; i < kRowLen; ++i) {
+    row[i] = static_cast<char>((id * 31 + i) & 0x7fU);
+  }
+  return row;
+}
+
+TEST(NodeRowCacheTest, AdmitsOnSecondMissAndServesCopies) {
+  NodeRowCache cache(/*budget_bytes=*/64 * kRowLen, kRowLen);
+  ASSERT_EQ(cache.capacity_rows(), 64U);
+  std::vector<char> out(kRowLen);
+  const auto row = make_row(7);
+
+  EXPECT_FALSE(cache.lookup(7, out.data()));
+  cache.admit(7, row.data(), cache.epoch(7));  // first sighting: doorkeeper only
+  EXPECT_FALSE(cache.lookup(7, out.data()));
+  cache.admit(7, row.data(), cache.epoch(7));
+  ASSERT_TRUE(cache.lookup(7, out.data()));
+  EXPECT_EQ(out, row);
+
+  const auto stats = cache.stats();
+  EXPECT_EQ(stats.hits, 1U);
+  EXPECT_EQ(stats.misses, 2U);
+  EXPECT_EQ(stats.admitted, 1U);
+  EXPECT_EQ(stats.rejected, 1U);
+  EXPECT_DOUBLE_EQ(stats.hit_rate(), 1.0 / 3.0);
+}
+
+TEST(NodeRowCacheTest, InvalidateDropsRow) {
+  NodeRowCache cache(64 * kRowLen, kRowLen);
+  const auto row = make_row(3);
+  cache.admit(3, row.data(), cache.epoch(3));
+  cache.admit(3, row.data(), cache.epoch(3));
+  std::vector<char> out(kRowLen);
+  ASSERT_TRUE(cache.lookup(3, out.data()));
+  cache.invalidate(3);
+  EXPECT_FALSE(cache.lookup(3, out.data()));
+}
+
+TEST(NodeRowCacheTest, ReadIssuedBeforeInvalidateIsNotAdmitted) {
+  NodeRowCache cache(64 * kRowLen, kRowLen);
+  const auto stale = make_row(5);
+  const auto issued = cache.epoch(5);
+  cache.admit(5, stale.data(), issued);  // doorkeeper mark
+  cache.invalidate(5);                   // a write lands while a read is in flight
+  cache.admit(5, stale.data(), issued);
+  std::vector<char> out(kRowLen);
+  EXPECT_FALSE(cache.lookup(5, out.data()));
+  EXPECT_EQ(cache.stats().admitted, 0U);
+
+  cache.admit(5, stale.data(), cache.epoch(5));
+  EXPECT_TRUE(cache.lookup(5, out.data()));
+}
+
+TEST(NodeRowCacheTest, BudgetBoundsResidentRows) {
+  NodeRowCache cache(16 * kRowLen, kRowLen);
+  for (int round = 0; round < 2; ++round) {
+    for (PID id = 0; id < 256; ++id) {
+      cache.admit(id, make_row(id).data(), cache.epoch(id));
+    }
+  }
+  std::vector<char> out(kRowLen);
+  size_t resident = 0;
+  for (PID id = 0; id < 256; ++id) {
+    if (cache.lookup(id, out.data())) {
+      ++resident;
+      EXPECT_EQ(out, make_row(id)) << id;
+    }
+  }
+  EXPECT_GT(resident, 0U);
+  EXPECT_LE(resident, cache.capacity_rows());
+  EXPECT_GT(cache.stats().evicted, 0U);
+}
+
+TEST(NodeRowCacheTest, TooSmallBudgetAlwaysMisses) {
+  NodeRowCache cache(kRowLen, kRowLen);
+  EXPECT_EQ(cache.capacity_rows(), 0U);
+  const auto row = make_row(1);
+  cache.admit(1, row.data(), cache.epoch(1));
+  cache.admit(1, row.data(), cache.epoch(1));
+  std::vector<char> out(kRowLen);
+  EXPECT_FALSE(cache.lookup(1, out.data()));
+}
+
+TEST(NodeRowCacheTest, ConcurrentReadersNeverSeeTornRows) {
+  NodeRowCache cache(32 * kRowLen, kRowLen);
+  std::atomic_bool torn{false};
+  std::vector<std::thread> threads;
+  for (size_t t = 0; t < 4; ++t) {
+    threads.emplace_back([&, t] {
+      std::vector<char> out(kRowLen);
+      for (size_t i = 0; i < 20000; ++i) {
+        const auto id = static_cast<PID>((i * 7 + t) % 97);
+        if (cache.lookup(id, out.data())) {
+          if (out != make_row(id)) torn.store(true);
+        } else {
+          cache.admit(id, make_row(id).data(), cache.epoch(id));
+        }
+        if (i % 101 == 0) cache.invalidate(id);
+      }
+    });
+  }
+  for (auto &thread : threads) thread.join();
+  EXPECT_FALSE(torn.load());
+}
+
+}  // namespace
+}  // namespace alaya::laser
@@ -0,0 +1,153 @@
+// SPDX-FileCopyrightText: 2026 AlayaDB.AI
+//
+// SPDX-License-Identifier: AGPL-3.0-only
+
+#include <gtest/gtest.h>
+
+#include <cstddef>
+#include <memory>
+#include <span>
+#include <vector>
+
+#include "index/graph/laser/utils/page_reader_adapter.hpp"
+
+namespace alaya::laser {
+namespace {
+
+namespace io = storage::io;
+
+constexpr std::size_t kPage = 4096;
+
+// Holds every submitted read until complete_all(), then fills each buffer
+// with a byte derived from its offset.
+class DeferredPageReader final : public io::PageReader {
+ public:
+  [[nodiscard]] auto constraints() const noexcept -> io::ReadConstraints override {
+    return {kPage, kPage, kPage, 64, false};
+  }
+
+  [[nodiscard]] auto submit(std::span<const io::ReadRequest> requests, io::Completion completion)
+      -> io::BatchHandle override {
+    for (const auto &request : requests) {
+      pending_.push_back({request, completion});
+    }
+    return make_batch_handle([]() noexcept {
+      return io::CancelResult::already_complete;
+    });
+  }
+
+  void shutdown() noexcept override {}
+
+  void complete_all() {
+    auto pending = std::move(pending_);
+    pending_.clear();
+    for (const auto &[request, completion] : pending) {
+      std::memset(request.buffer.data(), fill_for(request.offset), request.buffer.size());
+      completion.fn(completion.context, {.id = request.id, .bytes = request.buffer.size()});
+    }
+  }
+
+  [[nodiscard]] auto pending() const -> std::size_t { return pending_.size(); }
+
+  static auto fill_for(std::uint64_t offset) -> int { return static_cast<int>(offset / kPage); }
+
+ private:
+  std::vector<std::pair<io::ReadRequest, io::Completion>> pending_;
+};
+
+struct Page {
+  alignas(kPage) std::byte bytes[kPage];
+};
+
+TEST(SharedPageReadsTest, DuplicateInFlightPagesShareOneDeviceRead) {
+  DeferredPageReader reader;
+  SharedPageReads shared;
+  auto first = std::make_shared<PageReadCompletions>();
+  auto second = std::make_shared<PageReadCompletions>();
+  std::vector<Page> pages(4);
+
+  const std::vector<io::ReadRequest> a = {
+      {.id = 10, .offset = kPage, .buffer = pages[0].bytes},
+      {.id = 11, .offset = 3 * kPage, .buffer = pages[1].bytes},
+  };
+  const std::vector<io::ReadRequest> b = {
+      {.id = 20, .offset = kPage, .buffer = pages[2].bytes},
+      {.id = 21, .offset = 5 * kPage, .buffer = pages[3].bytes},
+  };
+  EXPECT_EQ(shared.submit(reader, a, first), 2U);
+  EXPECT_EQ(shared.submit(reader, b, second), 2U);
+  EXPECT_EQ(reader.pending(), 3U) << "the second read of page 1 must attach, not resubmit";
+  reader.complete_all();
+
+  std::vector<io::ReadResult> results;
+  ASSERT_EQ(poll_page_reads(*first, 8, results), 2U);
+  EXPECT_EQ(results[0].id + results[1].id, 21U);
+  ASSERT_EQ(poll_page_reads(*second, 8, results), 2U);
+  EXPECT_EQ(results[0].id + results[1].id, 41U);
+  for (const auto &result : results) {
+    EXPECT_EQ(result.bytes, kPage);
+  }
+  EXPECT_EQ(pages[2].bytes[0], std::byte{1}) << "the attached buffer receives the leader's bytes";
+  EXPECT_EQ(pages[2].bytes[kPage - 1], std::byte{1});
+  EXPECT_EQ(pages[3].bytes[0], std::byte{5});
+
+  const auto stats = shared.stats();
+  EXPECT_EQ(stats.device_reads, 3U);
+  EXPECT_EQ(stats.coalesced_reads, 1U);
+
+  // Once the read has landed the page is no longer in flight.
+  EXPECT_EQ(shared.submit(reader, std::span(b).first(1), second), 1U);
+  EXPECT_EQ(reader.pending(), 1U);
+  reader.complete_all();
+  EXPECT_EQ(shared.stats().device_reads, 4U);
+}
+
+TEST(SharedPageReadsTest, ReadsIssuedBeforeAPageWriteTakeNoNewParties) {
+  DeferredPageReader reader;
+  SharedPageReads shared;
+  auto first = std::make_shared<PageReadCompletions>();
+  auto second = std::make_shared<PageReadCompletions>();
+  std::vector<Page> pages(2);
+  const std::vector<io::ReadRequest> a = {{.id = 1, .offset = kPage, .buffer = pages[0].bytes}};
+  const std::vector<io::ReadRequest> b = {{.id = 2, .offset = kPage, .buffer = pages[1].bytes}};
+  EXPECT_EQ(shared.submit(reader, a, first), 1U);
+  shared.page_written(kPage);
+  EXPECT_EQ(shared.submit(reader, b, second), 1U);
+  EXPECT_EQ(reader.pending(), 2U) << "a request after the write must read the page itself";
+  reader.complete_all();
+
+  std::vector<io::ReadResult> results;
+  ASSERT_EQ(poll_page_reads(*first, 8, results), 1U);
+  EXPECT_EQ(results[0].id, 1U);
+  ASSERT_EQ(poll_page_reads(*second, 8, results), 1U);
+  EXPECT_EQ(results[0].id, 2U);
+  EXPECT_EQ(shared.stats().device_reads, 2U);
+  EXPECT_EQ(shared.stats().coalesced_reads, 0U);
+}
+
+TEST(SharedPageReadsTest, TallyCountsOnlyTheReadsOfItsOwnScope) {
+  DeferredPageReader reader;
+  SharedPageReads shared;
+  auto completions = std::make_shared<PageReadCompletions>();
+  std::vector<Page> pages(3);
+  const std::vector<io::ReadRequest> outside = {
+      {.id = 1, .offset = kPage, .buffer = pages[0].bytes}};
+  EXPECT_EQ(shared.submit(reader, outside, completions), 1U);
+  SharedPageReadStats counted;
+  {
+    PageReadTally tally;
+    const std::vector<io::ReadRequest> inside = {
+        {.id = 2, .offset = kPage, .buffer = pages[1].bytes},
+        {.id = 3, .offset = 2 * kPage, .buffer = pages[2].bytes},
+    };
+    EXPECT_EQ(shared.submit(reader, inside, completions), 2U);
+    counted = tally.stats();
+  }
+  EXPECT_EQ(counted.device_reads, 1U);
+  EXPECT_EQ(counted.coalesced_reads, 1U);
+  EXPECT_EQ(shared.stats().device_reads, 2U);
+  reader.complete_all();
+}
+
+}  // namespace
+}  // namespace alaya::laser
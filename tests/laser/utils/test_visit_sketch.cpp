@@ -0,0 +1,87 @@
+// SPDX-FileCopyrightText: 2026 AlayaDB.AI
+//
+// SPDX-License-Identifier: AGPL-3.0-only
+
+#include <gtest/gtest.h>
+
+#include <algorithm>
+#include <cstddef>
+#include <filesystem>
+#include <memory>
+#include <vector>
+
+#include "index/graph/laser/utils/visit_sketch.hpp"
+
+namespace alaya::laser {
+namespace {
+
+auto pair_count(const VisitSketch &sketch, PID a, PID b) -> uint32_t {
+  const auto pairs = sketch.co_visits();
+  const auto found = std::find_if(pairs.begin(), pairs.end(), [&](const CoVisit &pair) {
+    return pair.first == std::min(a, b) && pair.second == std::max(a, b);
+  });
+  return found == pairs.end() ? 0 : found->count;
+}
+
+TEST(VisitSketchTest, SamplesOneQueryInN) {
+  VisitSketch sketch(16, /*sample_every=*/4);
+  size_t sampled = 0;
+  for (size_t q = 0; q < 40; ++q) {
+    sampled += sketch.sample() ? 1 : 0;
+  }
+  EXPECT_EQ(sampled, 10U);
+
+  VisitSketch every(16, /*sample_every=*/0);  // clamped to 1
+  EXPECT_EQ(every.sample_every(), 1U);
+  EXPECT_TRUE(every.sample());
+  EXPECT_TRUE(every.sample());
+}
+
+TEST(VisitSketchTest, CountsVisitsAndWindowPairs) {
+  VisitSketch sketch(32, 1);
+  const std::vector<PID> trace{1, 2, 3, 4, 5, 6, 99};  // 99 is out of range
+  sketch.record(trace);
+  sketch.record(std::vector<PID>{1, 2});
+
+  EXPECT_EQ(sketch.sampled_queries(), 2U);
+  EXPECT_EQ(sketch.visits(1), 2U);
+  EXPECT_EQ(sketch.visits(6), 1U);
+  EXPECT_EQ(sketch.visits(7), 0U);
+  EXPECT_EQ(sketch.visits(99), 0U);
+
+  EXPECT_EQ(pair_count(sketch, 1, 2), 2U);
+  EXPECT_EQ(pair_count(sketch, 1, 5), 1U);  // kWindow steps apart
+  EXPECT_EQ(pair_count(sketch, 1, 6), 0U);  // outside the window
+  EXPECT_EQ(pair_count(sketch, 6, 99), 0U);
+}
+
+TEST(VisitSketchTest, BoundedPairTableKeepsHeavyPairs) {
+  VisitSketch sketch(1U << 16U, 1, /*pair_capacity=*/1024);
+  ASSERT_EQ(sketch.pair_capacity(), 1024U);
+  for (PID round = 0; round < 4000; ++round) {
+    sketch.record(std::vector<PID>{7, 8});
+    // One-off pairs, far more than the table holds.
+    sketch.record(std::vector<PID>{static_cast<PID>(100 + 2 * round),
+                                   static_cast<PID>(101 + 2 * round)});
+  }
+  EXPECT_LE(sketch.co_visits().size(), sketch.pair_capacity());
+  EXPECT_GE(pair_count(sketch, 7, 8), 3000U);
+}
+
+TEST(VisitSketchTest, RegistryHoldsWeakEntries) {
+  auto &registry = VisitSketchRegistry::instance();
+  const auto dir = std::filesystem::temp_directory_path() / "visit_sketch_registry_test";
+  const auto key = VisitSketchRegistry::key_for(dir / "." / "seg");
+  EXPECT_EQ(key, VisitSketchRegistry::key_for(dir / "seg"));
+
+  auto sketch = std::make_shared<VisitSketch>(8, 1);
+  registry.publish(key, sketch);
+  EXPECT_EQ(registry.find(key), sketch);
+  EXPECT_EQ(registry.find(key + "_other"), nullptr);
+
+  sketch.reset();
+  EXPECT_EQ(registry.find(key), nullptr);
+}
+
+}  // namespace
+}  // namespace alaya::laser
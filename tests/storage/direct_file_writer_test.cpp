@@ -0,0 +1,91 @@
+// SPDX-FileCopyrightText: 2026 AlayaDB.AI
+//
+// SPDX-License-Identifier: AGPL-3.0-only
+
+#include <gtest/gtest.h>
+#include <cstddef>
+#include <cstdlib>
+#include <cstring>
+#include <filesystem>  // NOLINT(build/c++17)
+#include <fstream>
+#include <iterator>
+#include <memory>
+#include <string>
+#include <system_error>
+#include <vector>
+
+#ifndef _WIN32
+#include <unistd.h>
+#include "storage/io/direct_file_writer.hpp"
+#endif
+
+namespace alaya::storage::io {
+
+namespace {
+
+#ifndef _WIN32
+
+constexpr std::size_t kBytes = 2 * DirectFileWriter::kAlignment;
+
+auto read_all(const std::filesystem::path &path) -> std::vector<char> {
+  std::ifstream in(path, std::ios::binary);
+  return {std::istreambuf_iterator<char>(in), std::istreambuf_iterator<char>()};
+}
+
+// tmpfs (/dev/shm) is where an O_DIRECT open used to create the file and then
+// fail, so each case runs there as well as in the temp directory.
+auto writer_roots() -> std::vector<std::filesystem::path> {
+  std::vector<std::filesystem::path> roots{std::filesystem::temp_directory_path()};
+  std::error_code ec;
+  if (std::filesystem::is_directory("/dev/shm", ec)) {
+    roots.emplace_back("/dev/shm");
+  }
+  return roots;
+}
+
+TEST(DirectFileWriterTest, WritesAlignedBlocksAtTheirOffsetsOnEveryFilesystem) {
+  std::unique_ptr<char, decltype(&std::free)> buffer(
+      static_cast<char *>(std::aligned_alloc(DirectFileWriter::kAlignment, kBytes)), &std::free);
+  ASSERT_NE(buffer, nullptr);
+  for (std::size_t i = 0; i < kBytes; ++i) {
+    buffer.get()[i] = static_cast<char>(i * 7);
+  }
+  for (const auto &root : writer_roots()) {
+    SCOPED_TRACE(root.string());
+    const auto path = root / ("alaya_direct_file_writer_test_" + std::to_string(::getpid()));
+    std::filesystem::remove(path);
+    {
+      DirectFileWriter writer(path);
+      writer.write_at(DirectFileWriter::kAlignment,
+                      buffer.get() + DirectFileWriter::kAlignment,
+                      DirectFileWriter::kAlignment);
+      writer.write_at(0, buffer.get(), DirectFileWriter::kAlignment);
+      writer.finish();
+    }
+    const auto written = read_all(path);
+    ASSERT_EQ(written.size(), kBytes);
+    EXPECT_EQ(std::memcmp(written.data(), buffer.get(), kBytes), 0);
+    std::filesystem::remove(path);
+  }
+}
+
+TEST(DirectFileWriterTest, RefusesAnExistingFileWithoutTouchingIt) {
+  for (const auto &root : writer_roots()) {
+    SCOPED_TRACE(root.string());
+    const auto path = root / ("alaya_direct_file_writer_existing_" + std::to_string(::getpid()));
+    {
+      std::ofstream out(path, std::ios::binary | std::ios::trunc);
+      out << "keep";
+    }
+    EXPECT_THROW(DirectFileWriter writer(path), std::system_error);
+    const auto kept = read_all(path);
+    EXPECT_EQ(std::string(kept.begin(), kept.end()), "keep");
+    std::filesystem::remove(path);
+  }
+}
+
+#endif
+
+}  // namespace
+
+}  // namespace alaya::storage::io
@@ -0,0 +1,124 @@
+// SPDX-FileCopyrightText: 2026 AlayaDB.AI
+//
+// SPDX-License-Identifier: AGPL-3.0-only
+
+#include <gtest/gtest.h>
+#include <cstddef>
+#include <cstdint>
+#include <filesystem>  // NOLINT(build/c++17)
+#include <fstream>
+#include <iterator>
+#include <numeric>
+#include <string>
+#include <vector>
+#include "storage/io/file_transfer.hpp"
+
+#ifndef _WIN32
+#include <unistd.h>
+#endif
+
+namespace alaya::storage::io {
+
+namespace {
+
+#ifndef _WIN32
+
+class FileTransferTest : public ::testing::Test {
+ protected:
+  void SetUp() override {
+    dir_ = std::filesystem::temp_directory_path() /
+           ("alaya_file_transfer_test_" + std::to_string(::getpid()) + "_" +
+            ::testing::UnitTest::GetInstance()->current_test_info()->name());
+    std::filesystem::remove_all(dir_);
+    std::filesystem::create_directories(dir_);
+  }
+
+  void TearDown() override {
+    std::error_code ec;
+    std::filesystem::remove_all(dir_, ec);
+  }
+
+  auto write_pattern(const std::string &name, std::size_t bytes) -> std::vector<char> {
+    std::vector<char> data(bytes);
+    std::iota(data.begin(), data.end(), char{7});
+    std::ofstream out(dir_ / name, std::ios::binary | std::ios::trunc);
+    out.write(data.data(), static_cast<std::streamsize>(data.size()));
+    return data;
+  }
+
+  auto read_all(const std::string &name) -> std::vector<char> {
+    std::ifstream in(dir_ / name, std::ios::binary);
+    return {std::istreambuf_iterator<char>(in), std::istreambuf_iterator<char>()};
+  }
+
+  std::filesystem::path dir_;
+};
+
+TEST_F(FileTransferTest, ChunkedCopyHandsBytesOverInFileOrder) {
+  const auto expected = write_pattern("src.bin", 10 * 4096 + 123);
+  std::vector<char> observed;
+  TransferOptions options;
+  options.force_chunked = true;
+  options.threads = 4;
+  options.chunk_bytes = 4096;
+  options.on_bytes = [&](std::span<const std::byte> bytes) {
+    const auto *begin = reinterpret_cast<const char *>(bytes.data());
+    observed.insert(observed.end(), begin, begin + bytes.size());
+  };
+
+  EXPECT_EQ(transfer_file(dir_ / "src.bin", dir_ / "dst.bin", options),
+            TransferMethod::chunk_copied);
+  EXPECT_EQ(read_all("dst.bin"), expected);
+  EXPECT_EQ(observed, expected);
+  EXPECT_EQ(read_all("src.bin"), expected);
+}
+
+TEST_F(FileTransferTest, CopiesEmptyFile) {
+  write_pattern("src.bin", 0);
+  TransferOptions options;
+  options.force_chunked = true;
+  EXPECT_EQ(transfer_file(dir_ / "src.bin", dir_ / "dst.bin", options),
+            TransferMethod::chunk_copied);
+  EXPECT_TRUE(std::filesystem::exists(dir_ / "dst.bin"));
+  EXPECT_EQ(std::filesystem::file_size(dir_ / "dst.bin"), 0U);
+}
+
+TEST_F(FileTransferTest, RenameGivesTheSourceUp) {
+  const auto expected = write_pattern("src.bin", 5000);
+  TransferOptions options;
+  options.allow_rename = true;
+  EXPECT_EQ(transfer_file(dir_ / "src.bin", dir_ / "dst.bin", options), TransferMethod::renamed);
+  EXPECT_EQ(read_all("dst.bin"), expected);
+  EXPECT_FALSE(std::filesystem::exists(dir_ / "src.bin"));
+}
+
+TEST_F(FileTransferTest, DefaultCopyKeepsTheSource) {
+  const auto expected = write_pattern("src.bin", 3 * 4096);
+  EXPECT_NE(transfer_file(dir_ / "src.bin", dir_ / "dst.bin", {}), TransferMethod::renamed);
+  EXPECT_EQ(read_all("dst.bin"), expected);
+  EXPECT_EQ(read_all("src.bin"), expected);
+}
+
+TEST_F(FileTransferTest, RefusesAnExistingDestination) {
+  write_pattern("src.bin", 100);
+  const auto existing = write_pattern("dst.bin", 10);
+  EXPECT_THROW((void)transfer_file(dir_ / "src.bin", dir_ / "dst.bin", {}), std::system_error);
+  EXPECT_EQ(read_all("dst.bin"), existing);
+}
+
+TEST_F(FileTransferTest, RenameRefusesAnExistingDestination) {
+  const auto source = write_pattern("src.bin", 100);
+  const auto existing = write_pattern("dst.bin", 10);
+  TransferOptions options;
+  options.allow_rename = true;
+  EXPECT_THROW((void)transfer_file(dir_ / "src.bin", dir_ / "dst.bin", options),
+               std::system_error);
+  EXPECT_EQ(read_all("dst.bin"), existing);
+  EXPECT_EQ(read_all("src.bin"), source);
+}
+
+#endif
+
+}  // namespace
+
+}  // namespace alaya::storage::io
@@ -11,7 +11,10 @@
 #include <filesystem>
 #include <fstream>
 #include <map>
+#include <memory>
 #include <mutex>
+#include <string_view>
+#include <system_error>
 #include <thread>
 #include <vector>
 
@@ -22,6 +25,15 @@
 namespace alaya::storage::io {
 namespace {
 
+#if defined(__linux__) && defined(ALAYA_LASER_USE_IO_URING) && ALAYA_LASER_USE_IO_URING
+// CI sets ALAYA_REQUIRE_IO_URING, so a runner that cannot host the io_uring
+// backend fails instead of skipping its tests.
+[[nodiscard]] auto io_uring_required() -> bool {
+  const char *value = std::getenv("ALAYA_REQUIRE_IO_URING");
+  return value != nullptr && *value != '\0' && std::string_view(value) != "0";
+}
+#endif
+
 class TemporaryFile {
  public:
   TemporaryFile() {
@@ -107,6 +119,16 @@ struct TestTask {
 
 class PageReaderContract : public testing::TestWithParam<PageReaderBackend> {
  protected:
+  void SetUp() override {
+#if defined(__linux__) && defined(ALAYA_LASER_USE_IO_URING) && ALAYA_LASER_USE_IO_URING
+    if (GetParam() == PageReaderBackend::io_uring && !UringPageReader::is_available()) {
+      if (io_uring_required()) {
+        FAIL() << "ALAYA_REQUIRE_IO_URING is set but io_uring is unavailable";
+      }
+      GTEST_SKIP() << "io_uring not available on this kernel";
+    }
+#endif
+  }
   auto open(const TemporaryFile &file, std::uint32_t depth = 16) {
     return open_page_reader(file.path(),
                             {.mode = OpenMode::automatic, .queue_depth = depth},
@@ -114,7 +136,21 @@ class PageReaderContract : public testing::TestWithParam<PageReaderBackend> {
   }
 };
 
-#if defined(__linux__) && defined(ALAYA_LASER_USE_LIBAIO) && ALAYA_LASER_USE_LIBAIO
+#if defined(__linux__) && defined(ALAYA_LASER_USE_IO_URING) && ALAYA_LASER_USE_IO_URING && \
+    defined(ALAYA_LASER_USE_LIBAIO) && ALAYA_LASER_USE_LIBAIO
+INSTANTIATE_TEST_SUITE_P(AllBackends,
+                         PageReaderContract,
+                         testing::Values(PageReaderBackend::sync,
+                                         PageReaderBackend::libaio,
+                                         PageReaderBackend::threadpool,
+                                         PageReaderBackend::io_uring));
+#elif defined(__linux__) && defined(ALAYA_LASER_USE_IO_URING) && ALAYA_LASER_USE_IO_URING
+INSTANTIATE_TEST_SUITE_P(AllBackends,
+                         PageReaderContract,
+                         testing::Values(PageReaderBackend::sync,
+                                         PageReaderBackend::threadpool,
+                                         PageReaderBackend::io_uring));
+#elif defined(__linux__) && defined(ALAYA_LASER_USE_LIBAIO) && ALAYA_LASER_USE_LIBAIO
 INSTANTIATE_TEST_SUITE_P(AllBackends,
                          PageReaderContract,
                          testing::Values(PageReaderBackend::sync,
@@ -318,6 +354,82 @@ TEST(LibaioPageReaderTest, SupportsConcurrentBatchesInFlight) {
 }
 #endif
 
+#if defined(__linux__) && defined(ALAYA_LASER_USE_IO_URING) && ALAYA_LASER_USE_IO_URING
+TEST(UringPageReaderTest, ReadsIntoRegisteredBuffersAndCancelsBatches) {
+  if (!UringPageReader::is_available()) {
+    if (io_uring_required()) FAIL() << "ALAYA_REQUIRE_IO_URING is set but io_uring is unavailable";
+    GTEST_SKIP() << "io_uring not available on this kernel";
+  }
+  TemporaryFile file;
+  UringPageReader reader(file.path(), {.queue_depth = 8}, {.sqpoll = false});
+  const auto c = reader.constraints();
+  AlignedBuffer registered(4 * c.size_alignment, c.buffer_alignment);
+  (void)reader.register_buffer(registered.span());
+  std::array<ReadRequest, 4> requests;
+  for (std::size_t i = 0; i < requests.size(); ++i) {
+    requests[i] = {.id = i,
+                   .offset = i * c.offset_alignment,
+                   .buffer = registered.span().subspan(i * c.size_alignment, c.size_alignment),
+                   .deadline = Clock::now() + std::chrono::seconds(30)};
+  }
+  const auto results = read_pages_blocking(reader, requests);
+  ASSERT_EQ(results.size(), requests.size());
+  for (const auto &result : results) EXPECT_EQ(result.status, ReadStatus::ok);
+  const auto bytes = registered.span();
+  for (std::size_t i = 0; i < bytes.size(); ++i) {
+    ASSERT_EQ(bytes[i], static_cast<std::byte>(i % 251)) << i;
+  }
+
+  std::atomic_size_t completed{0};
+  const auto callback = [](void *raw, ReadResult result) noexcept {
+    EXPECT_TRUE(result.status == ReadStatus::ok || result.status == ReadStatus::cancelled);
+    static_cast<std::atomic_size_t *>(raw)->fetch_add(1, std::memory_order_release);
+  };
+  auto handle = reader.submit(requests, {callback, &completed});
+  (void)handle.cancel();
+  reader.shutdown();
+  EXPECT_EQ(completed.load(std::memory_order_acquire), requests.size());
+  EXPECT_EQ(handle.cancel(), CancelResult::already_complete);
+}
+
+TEST(UringPageReaderTest, CancelStormsUnderSqpollWaitForSubmissionEntries) {
+  if (!UringPageReader::is_available()) {
+    if (io_uring_required()) FAIL() << "ALAYA_REQUIRE_IO_URING is set but io_uring is unavailable";
+    GTEST_SKIP() << "io_uring not available on this kernel";
+  }
+  TemporaryFile file;
+  std::unique_ptr<UringPageReader> reader;
+  try {
+    reader = std::make_unique<UringPageReader>(
+        file.path(), ReaderOptions{.queue_depth = 2}, UringOptions{.sqpoll = true});
+  } catch (const std::system_error &) {
+    GTEST_SKIP() << "SQPOLL rings are not permitted here";
+  }
+  const auto c = reader->constraints();
+  AlignedBuffer buffer(2 * c.size_alignment, c.buffer_alignment);
+  std::array<ReadRequest, 2> requests;
+  for (std::size_t i = 0; i < requests.size(); ++i) {
+    requests[i] = {.id = i,
+                   .offset = i * c.offset_alignment,
+                   .buffer = buffer.span().subspan(i * c.size_alignment, c.size_alignment),
+                   .deadline = Clock::now() + std::chrono::seconds(30)};
+  }
+  std::atomic_size_t completed{0};
+  const auto callback = [](void *raw, ReadResult result) noexcept {
+    EXPECT_TRUE(result.status == ReadStatus::ok || result.status == ReadStatus::cancelled);
+    static_cast<std::atomic_size_t *>(raw)->fetch_add(1, std::memory_order_release);
+  };
+  // Reads, linked timeouts and cancels together overrun the eight-entry ring.
+  constexpr std::size_t kBatches = 200;
+  for (std::size_t batch = 0; batch < kBatches; ++batch) {
+    auto handle = reader->submit(requests, {callback, &completed});
+    (void)handle.cancel();
+  }
+  reader->shutdown();
+  EXPECT_EQ(completed.load(std::memory_order_acquire), kBatches * requests.size());
+}
+#endif
+
 TEST(ThreadpoolPageReaderTest, BoundedQueueRejectsOversizedBatch) {
   TemporaryFile file;
   ThreadpoolPageReader reader(file.path(), {.queue_depth = 2});
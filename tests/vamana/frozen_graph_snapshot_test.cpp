@@ -4,10 +4,13 @@
 
 #include <gtest/gtest.h>
 
+#include <algorithm>
 #include <cstdint>
 #include <filesystem>
 #include <fstream>
 #include <iterator>
+#include <limits>
+#include <queue>
 #include <random>
 #include <string>
 #include <type_traits>
@@ -98,4 +101,114 @@ TEST_F(FrozenGraphSnapshotTest, VamanaConstructionTransfersAdjacencyOwnership) {
   static_assert(std::is_nothrow_move_constructible_v<alaya::FrozenGraphSnapshot>);
 }
 
+TEST_F(FrozenGraphSnapshotTest, ExtendCarriesSurvivingEdgesAndLinksNewRows) {
+  constexpr std::uint32_t kOldRows = 200;
+  constexpr std::uint32_t kNewRows = 40;
+  constexpr std::uint32_t kDim = 8;
+  constexpr std::uint32_t kDegree = 12;
+  std::mt19937 rng(7);
+  std::uniform_real_distribution<float> distribution(-1.0F, 1.0F);
+  std::vector<float> old_vectors(static_cast<std::size_t>(kOldRows) * kDim);
+  for (auto &value : old_vectors) {
+    value = distribution(rng);
+  }
+  alaya::vamana::VamanaBuildParams params;
+  params.R = kDegree;
+  params.L = 32;
+  params.num_threads = 2;
+  alaya::vamana::VamanaBuilder old_builder(old_vectors.data(), kOldRows, kDim, params);
+  old_builder.build();
+  auto predecessor = alaya::FrozenGraphSnapshot::from_vamana(std::move(old_builder));
+
+  // Every tenth old row is dropped, survivors are renumbered in reverse, and
+  // new rows follow them.
+  std::vector<std::uint32_t> predecessor_row;
+  std::vector<float> vectors;
+  for (std::uint32_t old_row = kOldRows; old_row-- > 0;) {
+    if (old_row % 10 == 3) {
+      continue;
+    }
+    predecessor_row.push_back(old_row);
+    const auto *row = old_vectors.data() + static_cast<std::size_t>(old_row) * kDim;
+    vectors.insert(vectors.end(), row, row + kDim);
+  }
+  const auto carried = static_cast<std::uint32_t>(predecessor_row.size());
+  for (std::uint32_t row = 0; row < kNewRows; ++row) {
+    predecessor_row.push_back(alaya::kNoPredecessorRow);
+    for (std::uint32_t d = 0; d < kDim; ++d) {
+      vectors.push_back(distribution(rng));
+    }
+  }
+  const auto rows = static_cast<std::uint32_t>(predecessor_row.size());
+
+  auto extended =
+      alaya::extend_vamana_snapshot(predecessor, predecessor_row, vectors.data(), kDim, params);
+  ASSERT_TRUE(extended.has_value());
+  ASSERT_NO_THROW(extended->validate());
+  ASSERT_EQ(extended->num_points(), rows);
+  EXPECT_EQ(extended->max_degree(), kDegree);
+
+  // Most carried edges survive the repair and the reverse-edge inserts.
+  std::size_t kept = 0;
+  std::size_t total = 0;
+  for (std::uint32_t row = 0; row < carried; ++row) {
+    for (const auto neighbor : extended->adjacency()[row]) {
+      if (neighbor >= carried) {
+        continue;
+      }
+      ++total;
+      const auto &old_neighbors = predecessor.adjacency()[predecessor_row[row]];
+      kept += std::ranges::count(old_neighbors, predecessor_row[neighbor]);
+    }
+  }
+  EXPECT_GE(kept * 10, total * 7);
+
+  std::vector<bool> reached(rows, false);
+  std::queue<std::uint32_t> frontier;
+  frontier.push(extended->entry_point());
+  reached[extended->entry_point()] = true;
+  while (!frontier.empty()) {
+    for (const auto neighbor : extended->adjacency()[frontier.front()]) {
+      if (!reached[neighbor]) {
+        reached[neighbor] = true;
+        frontier.push(neighbor);
+      }
+    }
+    frontier.pop();
+  }
+  EXPECT_EQ(std::ranges::count(reached, true), rows);
+
+  // RobustPrune keeps the closest candidate, so inserted rows link to their
+  // exact nearest neighbor whenever the search found it.
+  std::size_t nearest_linked = 0;
+  for (std::uint32_t row = carried; row < rows; ++row) {
+    std::uint32_t nearest = row == 0 ? 1 : 0;
+    float best = std::numeric_limits<float>::max();
+    for (std::uint32_t other = 0; other < rows; ++other) {
+      float distance = 0.0F;
+      for (std::uint32_t d = 0; d < kDim; ++d) {
+        const float diff = vectors[static_cast<std::size_t>(row) * kDim + d] -
+                           vectors[static_cast<std::size_t>(other) * kDim + d];
+        distance += diff * diff;
+      }
+      if (other != row && distance < best) {
+        best = distance;
+        nearest = other;
+      }
+    }
+    nearest_linked += std::ranges::count(extended->adjacency()[row], nearest);
+  }
+  EXPECT_GE(nearest_linked * 10, std::size_t{kNewRows} * 9);
+
+  const std::vector<std::uint32_t> nothing_carried(rows, alaya::kNoPredecessorRow);
+  EXPECT_FALSE(
+      alaya::extend_vamana_snapshot(predecessor, nothing_carried, vectors.data(), kDim, params)
+          .has_value());
+  std::vector<std::uint32_t> duplicated(predecessor_row);
+  duplicated[1] = duplicated[0];
+  EXPECT_THROW(
+      (void)alaya::extend_vamana_snapshot(predecessor, duplicated, vectors.data(), kDim, params),
+      std::invalid_argument);
+}
+
 }  // namespace
@@ -2,7 +2,8 @@
 //
 // SPDX-License-Identifier: AGPL-3.0-only
 
-// Framework-layer tests for the shared Physical WAL v1 envelope (wal/frame.hpp).
+// Framework-layer tests for the shared Physical WAL v1 envelope (wal/frame.hpp,
+// wal/frame_stream.hpp, wal/append_file.hpp).
 // Locks the byte format (golden), the structural scan, the one-envelope /
 // two-family contract (unified-wal-vocabulary.md acceptance 3), and the
 // collection layer's loud rejection of a foreign record type.
@@ -17,10 +18,14 @@
 #include <fstream>
 #include <span>
 #include <string>
+#include <utility>
 #include <vector>
 
 #include "index/collection/logical_wal.hpp"
+#include "wal/append_file.hpp"
+#include "wal/crc32.hpp"
 #include "wal/frame.hpp"
+#include "wal/frame_stream.hpp"
 
 namespace alaya::wal {
 namespace {
@@ -53,6 +58,45 @@ TEST(WalFrameGolden, MakeFrameByteSequenceIsStable) {
   }
 }
 
+// Every CRC kernel must agree with the bitwise oracle on every length and
+// alignment, or WAL files written on one host stop validating on another.
+TEST(WalFrameCrc32, KernelsMatchBitwiseOracleAcrossLengthsAndOffsets) {
+  const std::string check = "123456789";
+  EXPECT_EQ(crc32(std::as_bytes(std::span(check))), 0xcbf43926U);
+  EXPECT_EQ(crc32({}), 0U);
+
+  std::vector<std::byte> buffer(4096 + 16);
+  std::uint32_t state = 0x9e3779b9U;
+  for (auto &byte : buffer) {
+    state = state * 1664525U + 1013904223U;
+    byte = static_cast<std::byte>(state >> 24U);
+  }
+  std::vector<std::pair<const char *, Crc32UpdateFn>> kernels = {
+      {"slice8", crc32_update_slice8},
+      {"slice16", crc32_update_slice16},
+      {"dispatched", get_crc32_update_func()},
+  };
+#ifdef ALAYA_ARCH_X86
+  const auto &features = simd::get_cpu_features();
+  if (features.pclmul_ && features.sse4_1_) {
+    kernels.emplace_back("pclmul", crc32_update_pclmul);
+  }
+#endif
+  for (const std::size_t offset : {0, 1, 3, 7, 8, 15}) {
+    for (std::size_t size = 0; size <= 4096; size += size < 300 ? 1 : 61) {
+      const auto *data = buffer.data() + offset;
+      const auto expected = crc32_update_bitwise(0xffffffffU, data, size);
+      for (const auto &[name, update] : kernels) {
+        ASSERT_EQ(update(0xffffffffU, data, size), expected)
+            << name << " offset " << offset << " size " << size;
+        const auto head = size / 3;
+        ASSERT_EQ(update(update(0xffffffffU, data, head), data + head, size - head), expected)
+            << name << " split at " << head << " size " << size;
+      }
+    }
+  }
+}
+
 TEST(WalFrameScan, RoundTripsEveryHeaderField) {
   const auto payload = bytes_of({1, 2, 3, 4, 5});
   const auto frame = make_frame(7, 0x80, 0xAABBCCDDULL, 0x99ULL, payload);
@@ -384,5 +428,154 @@ TEST(WalFileStreamingApi, StreamTruncateToDoesNotRetainPayload) {
   std::filesystem::remove_all(root);
 }
 
+// Drains a FrameStream into owned frames so it can be compared with scan_path.
+auto drain(FrameStream &stream) -> std::vector<ScannedFrame> {
+  std::vector<ScannedFrame> frames;
+  while (const auto frame = stream.next()) {
+    ScannedFrame owned;
+    owned.type = frame->type;
+    owned.flags = frame->flags;
+    owned.op_id = frame->op_id;
+    owned.batch_id = frame->batch_id;
+    owned.payload.assign(frame->payload.begin(), frame->payload.end());
+    owned.offset = frame->offset;
+    owned.size = frame->size;
+    frames.push_back(std::move(owned));
+  }
+  return frames;
+}
+
+void expect_same_frames(const std::vector<ScannedFrame> &streamed,
+                        const std::vector<ScannedFrame> &scanned) {
+  ASSERT_EQ(streamed.size(), scanned.size());
+  for (std::size_t i = 0; i < streamed.size(); ++i) {
+    EXPECT_EQ(streamed[i].type, scanned[i].type) << i;
+    EXPECT_EQ(streamed[i].flags, scanned[i].flags) << i;
+    EXPECT_EQ(streamed[i].op_id, scanned[i].op_id) << i;
+    EXPECT_EQ(streamed[i].batch_id, scanned[i].batch_id) << i;
+    EXPECT_EQ(streamed[i].payload, scanned[i].payload) << i;
+    EXPECT_EQ(streamed[i].offset, scanned[i].offset) << i;
+    EXPECT_EQ(streamed[i].size, scanned[i].size) << i;
+  }
+}
+
+// FrameStream hands out exactly what scan_path() accepts, in order, whatever
+// the block size: frames straddling blocks, frames longer than a block, a
+// torn tail, and a CRC failure in the middle of a block.
+TEST(WalFrameStream, MatchesEagerScanAcrossBlockBoundariesAndDamage) {
+  const auto root = std::filesystem::temp_directory_path() /
+                    ("wal_frame_pipelined_" + std::to_string(::getpid()));
+  std::filesystem::create_directories(root);
+  const auto path = root / "seg.opwal";
+  {
+    WalFile wal(path);
+    for (unsigned i = 0; i < 40; ++i) {
+      std::vector<std::byte> payload((i * 37U) % 300U, static_cast<std::byte>(i));
+      wal.append(static_cast<std::uint8_t>(1 + i % 4),
+                 static_cast<std::uint8_t>(i),
+                 i,
+                 i * 3,
+                 payload,
+                 WalFile::Sync::flush);
+    }
+  }
+  const auto eager = WalFile::scan_path(path);
+  ASSERT_EQ(eager.frames.size(), 40U);
+  for (const std::size_t block_bytes : {std::size_t{64}, std::size_t{200}, std::size_t{1} << 20U}) {
+    FrameStreamOptions options;
+    options.block_bytes = block_bytes;
+    options.blocks_ahead = 2;
+    options.verify_threads = 3;
+    FrameStream stream(path, options);
+    expect_same_frames(drain(stream), eager.frames);
+    EXPECT_EQ(stream.valid_bytes(), eager.valid_bytes);
+    EXPECT_FALSE(stream.stopped_at_corrupt_or_torn_tail());
+  }
+
+  {
+    std::ofstream out(path, std::ios::binary | std::ios::app);
+    const char junk[9] = {'W', 'A', 'L', '7', 1, 5, 0, 0, 0};
+    out.write(junk, sizeof(junk));
+  }
+  {
+    FrameStreamOptions options;
+    options.block_bytes = 128;
+    FrameStream stream(path, options);
+    expect_same_frames(drain(stream), eager.frames);
+    EXPECT_EQ(stream.valid_bytes(), eager.valid_bytes);
+    EXPECT_TRUE(stream.stopped_at_corrupt_or_torn_tail());
+  }
+
+  // Flip one payload byte of frame 17: its CRC fails and nothing after it
+  // may be handed out, even frames already verified in later blocks.
+  const auto damaged_at = eager.frames[17].offset + kHeaderBytes;
+  ASSERT_GT(eager.frames[17].payload.size(), 0U);
+  {
+    std::fstream file(path, std::ios::binary | std::ios::in | std::ios::out);
+    file.seekp(static_cast<std::streamoff>(damaged_at));
+    const char flipped =
+        static_cast<char>(~static_cast<unsigned char>(eager.frames[17].payload[0]));
+    file.write(&flipped, 1);
+  }
+  const auto damaged = WalFile::scan_path(path);
+  ASSERT_EQ(damaged.frames.size(), 17U);
+  for (const std::size_t block_bytes : {std::size_t{100}, std::size_t{1} << 20U}) {
+    FrameStreamOptions options;
+    options.block_bytes = block_bytes;
+    FrameStream stream(path, options);
+    expect_same_frames(drain(stream), damaged.frames);
+    EXPECT_EQ(stream.valid_bytes(), damaged.valid_bytes);
+    EXPECT_TRUE(stream.stopped_at_corrupt_or_torn_tail());
+  }
+  std::filesystem::remove_all(root);
+}
+
+TEST(WalFrameStream, EmptyAndMissingFilesEndCleanly) {
+  const auto root = std::filesystem::temp_directory_path() /
+                    ("wal_frame_pipelined_empty_" + std::to_string(::getpid()));
+  std::filesystem::create_directories(root);
+  {
+    FrameStream missing(root / "missing.wal");
+    EXPECT_FALSE(missing.next().has_value());
+    EXPECT_FALSE(missing.stopped_at_corrupt_or_torn_tail());
+  }
+  std::ofstream(root / "empty.wal").close();
+  FrameStream empty(root / "empty.wal");
+  EXPECT_FALSE(empty.next().has_value());
+  EXPECT_EQ(empty.valid_bytes(), 0U);
+  EXPECT_FALSE(empty.stopped_at_corrupt_or_torn_tail());
+  std::filesystem::remove_all(root);
+}
+
+TEST(WalAppendFile, ReservedBlocksNeverMoveTheEndOfTheLog) {
+  const auto root = std::filesystem::temp_directory_path() /
+                    ("wal_append_file_" + std::to_string(::getpid()));
+  std::filesystem::create_directories(root);
+  const auto path = root / "append.wal";
+  std::vector<std::byte> payload(1000, std::byte{0x5a});
+  {
+    AppendFile file(path, 0, std::uint64_t{1} << 20U);
+    for (std::uint64_t op = 1; op <= 10; ++op) {
+      file.write(make_frame(1, 0, op, op, payload));
+      file.start_writeback(0);
+      // Readers and torn-tail repair rely on the size being the log's end.
+      ASSERT_EQ(std::filesystem::file_size(path), file.end());
+    }
+    file.sync_data();
+  }
+  {
+    AppendFile reopened(path, std::filesystem::file_size(path), 0);
+    reopened.write(make_frame(2, 0, 11, 11, {}));
+    reopened.sync_data();
+    EXPECT_EQ(std::filesystem::file_size(path), reopened.end());
+  }
+  const auto scan = WalFile::scan_path(path);
+  ASSERT_EQ(scan.frames.size(), 11U);
+  EXPECT_FALSE(scan.stopped_at_corrupt_or_torn_tail);
+  EXPECT_EQ(scan.frames.back().op_id, 11U);
+  EXPECT_EQ(scan.valid_bytes, std::filesystem::file_size(path));
+  std::filesystem::remove_all(root);
+}
+
 }  // namespace
 }  // namespace alaya::wal